@@ -0,0 +1,238 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_Point_new(RexValue f_x, RexValue f_y);
+static RexValue rex_user_churn(RexValue count);
+static RexValue rex_user_pairs(RexValue count);
+static RexValue rex_user_worker(RexValue count);
+static RexValue rex_user_bench(RexValue threads, RexValue count);
+static RexValue rex_user_main();
+static const char* rex_fields_Point[] = {"x", "y"};
+typedef struct RexNative_Point { int64_t f_x; int64_t f_y; } RexNative_Point;
+static const unsigned char rex_kinds_Point[] = {REX_FIELD_INT, REX_FIELD_INT};
+static const size_t rex_offsets_Point[] = {offsetof(RexNative_Point, f_x), offsetof(RexNative_Point, f_y)};
+static const RexStructLayout rex_layout_Point = {"Point", rex_fields_Point, rex_kinds_Point, rex_offsets_Point, 2, sizeof(RexNative_Point)};
+static RexValue rex_Point_new(RexValue f_x, RexValue f_y) {
+  RexNative_Point __rex_native = {rex_wrap_i32(rex_unbox_int(f_x)), rex_wrap_i32(rex_unbox_int(f_y))};
+  return rex_struct_new_native(&rex_layout_Point, &__rex_native);
+}
+
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_1 = { { 14, 0, 0, REX_STR_STATIC }, "worker total: " };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[10]; } rex_strlit_2 = { { 9, 0, 0, REX_STR_STATIC }, "threads: " };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[11]; } rex_strlit_3 = { { 10, 0, 0, REX_STR_STATIC }, " elapsed: " };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_4 = { { 2, 0, 0, REX_STR_STATIC }, "ms" };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+
+typedef struct __RexSpawnCtx1 {
+  RexValue count;
+} __RexSpawnCtx1;
+static void __rex_spawn_fn_1(void* __ctx) {
+  __RexSpawnCtx1* __rex_ctx = (__RexSpawnCtx1*)__ctx;
+  RexValue count = __rex_ctx->count;
+  free(__rex_ctx);
+  rex_user_worker(count);
+}
+
+
+static RexValue rex_user_churn(RexValue count) {
+  double sum_1 = 0.0;
+  int64_t __start1 = 0;
+  int64_t __end1 = rex_wrap_i32(rex_unbox_int(count));
+  for (int64_t __idx1 = __start1; __idx1 < __end1; __idx1++) {
+    int64_t i_1 = __idx1;
+    RexValue p_1 = rex_Point_new(rex_int(i_1), rex_int(rex_wrap_i32(rex_int_add(i_1, 1))));
+    sum_1 = ((sum_1 + ((double)((RexNative_Point*)rex_struct_data(p_1, &rex_layout_Point))->f_y)) - ((double)((RexNative_Point*)rex_struct_data(p_1, &rex_layout_Point))->f_x));
+    rex_drop(p_1);
+  }
+  return rex_num(sum_1);
+  return rex_nil();
+}
+
+static RexValue rex_user_pairs(RexValue count) {
+  RexValue m_1 = rex_collections_map_new();
+  rex_collections_map_put(rex_ref_mut(&m_1), rex_num(1), rex_num(2));
+  rex_collections_map_put(rex_ref_mut(&m_1), rex_num(3), rex_num(4));
+  double total_1 = 0.0;
+  int64_t __start2 = 0;
+  int64_t __end2 = rex_wrap_i32(rex_unbox_int(count));
+  for (int64_t __idx2 = __start2; __idx2 < __end2; __idx2++) {
+    int64_t i_2 = __idx2;
+    RexValue items_1 = rex_collections_map_items(rex_ref(&m_1));
+    RexValue __iter3 = items_1;
+    RexVecView __view3 = rex_collections_vec_view(__iter3);
+    for (int64_t __idx3 = 0; __idx3 < __view3.count; __idx3++) {
+      rex_vec_view_check(&__view3);
+      RexValue pair_1 = rex_vec_view_get(&__view3, __idx3);
+      total_1 = (total_1 + 1.0);
+      rex_drop(pair_1);
+    }
+    rex_drop(items_1);
+  }
+  RexValue __ret4 = rex_num(total_1);
+  rex_drop(m_1);
+  return __ret4;
+  return rex_nil();
+}
+
+static RexValue rex_user_worker(RexValue count) {
+  int64_t total_2 = rex_wrap_i32(rex_int_add(rex_wrap_i32(rex_unbox_int(rex_user_churn(count))), rex_wrap_i32(rex_unbox_int(rex_user_pairs(rex_int(rex_wrap_i32(rex_int_div(rex_wrap_i32(rex_unbox_int(count)), 4))))))));
+  RexValue __tmp5 = rex_format(rex_int(total_2));
+  RexValue __tmp6 = rex_add(rex_strval_1, __tmp5);
+  rex_println(__tmp6);
+  rex_drop(__tmp5);
+  rex_drop(__tmp6);
+  return rex_nil();
+}
+
+static RexValue rex_user_bench(RexValue threads, RexValue count) {
+  double start_1 = rex_unbox_num(rex_now_ms());
+  int64_t __start7 = 0;
+  int64_t __end7 = rex_wrap_i32(rex_unbox_int(threads));
+  for (int64_t __idx7 = __start7; __idx7 < __end7; __idx7++) {
+    int64_t t_1 = __idx7;
+    {
+      __RexSpawnCtx1* __rex_ctx = (__RexSpawnCtx1*)malloc(sizeof(__RexSpawnCtx1));
+      if (!__rex_ctx) { rex_panic("spawn out of memory"); }
+      __rex_ctx->count = count;
+      rex_spawn(__rex_spawn_fn_1, __rex_ctx);
+    }
+  }
+  rex_wait_all();
+  double end_1 = rex_unbox_num(rex_now_ms());
+  RexValue __tmp8 = rex_format(threads);
+  RexValue __tmp9 = rex_add(rex_strval_2, __tmp8);
+  RexValue __tmp10 = rex_add(__tmp9, rex_strval_3);
+  RexValue __tmp11 = rex_format(rex_num((end_1 - start_1)));
+  RexValue __tmp12 = rex_add(__tmp10, __tmp11);
+  RexValue __tmp13 = rex_add(__tmp12, rex_strval_4);
+  rex_println(__tmp13);
+  rex_drop(__tmp8);
+  rex_drop(__tmp9);
+  rex_drop(__tmp10);
+  rex_drop(__tmp11);
+  rex_drop(__tmp12);
+  rex_drop(__tmp13);
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  rex_user_bench(rex_num(1), rex_num(1000000));
+  rex_user_bench(rex_num(4), rex_num(1000000));
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  rex_wait_all();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,289 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[9]; } rex_strlit_1 = { { 8, 0, 0, REX_STR_STATIC }, "manual: " };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_2 = { { 4, 0, 0, REX_STR_STATIC }, " in " };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_3 = { { 2, 0, 0, REX_STR_STATIC }, "ms" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_4 = { { 7, 0, 0, REX_STR_STATIC }, "fused: " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[13]; } rex_strlit_5 = { { 12, 0, 0, REX_STR_STATIC }, "first five: " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_6 = { { 11, 0, 0, REX_STR_STATIC }, " ending at " };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_7 = { { 6, 0, 0, REX_STR_STATIC }, "hits: " };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[9]; } rex_strlit_8 = { { 8, 0, 0, REX_STR_STATIC }, " found: " };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+
+
+static RexValue rex_user_main() {
+  double count_1 = 2000000.0;
+  RexValue v_1 = rex_collections_vec_new_typed(REX_VEC_I64);
+  int64_t __start1 = 0;
+  double __end1_num = count_1;
+  int64_t __end1 = rex_range_end(__end1_num, 1);
+  for (int64_t __idx1 = __start1; __idx1 < __end1; __idx1++) {
+    double i_1 = ((double)__idx1);
+    rex_collections_vec_push_f64(rex_ref_mut(&v_1), i_1);
+  }
+  double start_1 = rex_unbox_num(rex_now_ms());
+  RexValue thirds_1 = rex_collections_vec_new_typed(REX_VEC_I64);
+  RexValue __iter2 = rex_ref(&v_1);
+  RexVecView __view2 = rex_collections_vec_view(__iter2);
+  for (int64_t __idx2 = 0; __idx2 < __view2.count; __idx2++) {
+    rex_vec_view_check(&__view2);
+    int64_t x_1 = rex_vec_view_i64(&__view2, __idx2);
+    if ((rex_int_mod(x_1, 3) == 0)) {
+      rex_collections_vec_push_i64(rex_ref_mut(&thirds_1), x_1);
+    }
+  }
+  RexValue squares_1 = rex_collections_vec_new_typed(REX_VEC_I64);
+  RexValue __iter3 = rex_ref(&thirds_1);
+  RexVecView __view3 = rex_collections_vec_view(__iter3);
+  for (int64_t __idx3 = 0; __idx3 < __view3.count; __idx3++) {
+    rex_vec_view_check(&__view3);
+    int64_t x_2 = rex_vec_view_i64(&__view3, __idx3);
+    rex_collections_vec_push_i64(rex_ref_mut(&squares_1), rex_int_mod(rex_int_mul(x_2, x_2), 1000));
+  }
+  double manual_1 = 0.0;
+  RexValue __iter4 = rex_ref(&squares_1);
+  RexVecView __view4 = rex_collections_vec_view(__iter4);
+  for (int64_t __idx4 = 0; __idx4 < __view4.count; __idx4++) {
+    rex_vec_view_check(&__view4);
+    int64_t x_3 = rex_vec_view_i64(&__view4, __idx4);
+    manual_1 = (manual_1 + ((double)x_3));
+  }
+  double manual_end_1 = rex_unbox_num(rex_now_ms());
+  RexValue __pipe5;
+  {
+    RexVecView __view5 = rex_collections_vec_view(rex_ref(&v_1));
+    int64_t __acc5 = 0;
+    for (int64_t __idx5 = 0; __idx5 < __view5.count; __idx5++) {
+      rex_vec_view_check(&__view5);
+      int64_t x_4 = rex_vec_view_i64(&__view5, __idx5);
+      int __keep5_1 = (rex_int_mod(x_4, 3) == 0);
+      if (!__keep5_1) { continue; }
+      int64_t x_5 = x_4;
+      int64_t __item5_2 = rex_int_mod(rex_int_mul(x_5, x_5), 1000);
+      __acc5 = rex_int_add(__acc5, __item5_2);
+    }
+    __pipe5 = rex_int(__acc5);
+  }
+  int64_t fused_1 = rex_unbox_int(__pipe5);
+  double fused_end_1 = rex_unbox_num(rex_now_ms());
+  RexValue __pipe6;
+  {
+    RexVecView __view6 = rex_collections_vec_view(rex_ref(&v_1));
+    int64_t __take6_3 = 5;
+    int __done6 = 0;
+    if (__take6_3 <= 0) { __done6 = 1; }
+    __pipe6 = rex_collections_vec_new_typed(REX_VEC_I64);
+    for (int64_t __idx6 = 0; !__done6 && __idx6 < __view6.count; __idx6++) {
+      rex_vec_view_check(&__view6);
+      int64_t x_6 = rex_vec_view_i64(&__view6, __idx6);
+      int __keep6_1 = (rex_int_mod(x_6, 7) == 3);
+      if (!__keep6_1) { continue; }
+      int64_t x_7 = x_6;
+      int64_t __item6_2 = rex_int_mul(x_7, 2);
+      if (--__take6_3 <= 0) { __done6 = 1; }
+      rex_collections_vec_push_i64(__pipe6, __item6_2);
+    }
+  }
+  RexValue firsts_1 = __pipe6;
+  RexValue __pipe7;
+  {
+    RexVecView __view7 = rex_collections_vec_view(rex_ref(&v_1));
+    int64_t __acc7 = 0;
+    for (int64_t __idx7 = 0; __idx7 < __view7.count; __idx7++) {
+      rex_vec_view_check(&__view7);
+      int64_t x_8 = rex_vec_view_i64(&__view7, __idx7);
+      int __keep7_1 = (rex_int_mod(x_8, 1000) == 0);
+      if (!__keep7_1) { continue; }
+      __acc7++;
+    }
+    __pipe7 = rex_int(__acc7);
+  }
+  int64_t hits_1 = rex_unbox_int(__pipe7);
+  RexValue __pipe8;
+  {
+    RexVecView __view8 = rex_collections_vec_view(rex_ref(&v_1));
+    int __acc8 = 0;
+    for (int64_t __idx8 = 0; __idx8 < __view8.count; __idx8++) {
+      rex_vec_view_check(&__view8);
+      int64_t x_9 = rex_vec_view_i64(&__view8, __idx8);
+      int __hit8 = (x_9 == 1234567);
+      if (__hit8) { __acc8 = 1; break; }
+    }
+    __pipe8 = rex_bool(__acc8);
+  }
+  int found_1 = rex_is_truthy(__pipe8);
+  RexValue __tmp9 = rex_format(rex_num(manual_1));
+  RexValue __tmp10 = rex_add(rex_strval_1, __tmp9);
+  RexValue __tmp11 = rex_add(__tmp10, rex_strval_2);
+  RexValue __tmp12 = rex_format(rex_num((manual_end_1 - start_1)));
+  RexValue __tmp13 = rex_add(__tmp11, __tmp12);
+  RexValue __tmp14 = rex_add(__tmp13, rex_strval_3);
+  rex_println(__tmp14);
+  rex_drop(__tmp9);
+  rex_drop(__tmp10);
+  rex_drop(__tmp11);
+  rex_drop(__tmp12);
+  rex_drop(__tmp13);
+  rex_drop(__tmp14);
+  RexValue __tmp15 = rex_format(rex_int(fused_1));
+  RexValue __tmp16 = rex_add(rex_strval_4, __tmp15);
+  RexValue __tmp17 = rex_add(__tmp16, rex_strval_2);
+  RexValue __tmp18 = rex_format(rex_num((fused_end_1 - manual_end_1)));
+  RexValue __tmp19 = rex_add(__tmp17, __tmp18);
+  RexValue __tmp20 = rex_add(__tmp19, rex_strval_3);
+  rex_println(__tmp20);
+  rex_drop(__tmp15);
+  rex_drop(__tmp16);
+  rex_drop(__tmp17);
+  rex_drop(__tmp18);
+  rex_drop(__tmp19);
+  rex_drop(__tmp20);
+  RexValue __tmp21 = rex_format(rex_collections_vec_len(rex_ref(&firsts_1)));
+  RexValue __tmp22 = rex_add(rex_strval_5, __tmp21);
+  RexValue __tmp23 = rex_add(__tmp22, rex_strval_6);
+  RexValue __tmp24 = rex_format(rex_collections_vec_last(rex_ref(&firsts_1)));
+  RexValue __tmp25 = rex_add(__tmp23, __tmp24);
+  rex_println(__tmp25);
+  rex_drop(__tmp21);
+  rex_drop(__tmp22);
+  rex_drop(__tmp23);
+  rex_drop(__tmp24);
+  rex_drop(__tmp25);
+  RexValue __tmp26 = rex_format(rex_int(hits_1));
+  RexValue __tmp27 = rex_add(rex_strval_7, __tmp26);
+  RexValue __tmp28 = rex_add(__tmp27, rex_strval_8);
+  RexValue __tmp29 = rex_format(rex_bool(found_1));
+  RexValue __tmp30 = rex_add(__tmp28, __tmp29);
+  rex_println(__tmp30);
+  rex_drop(__tmp26);
+  rex_drop(__tmp27);
+  rex_drop(__tmp28);
+  rex_drop(__tmp29);
+  rex_drop(__tmp30);
+  rex_drop(firsts_1);
+  rex_drop(squares_1);
+  rex_drop(thirds_1);
+  rex_drop(v_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_bench(RexValue count);
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_1 = { { 6, 0, 0, REX_STR_STATIC }, "keys: " };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_2 = { { 6, 0, 0, REX_STR_STATIC }, " sum: " };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[10]; } rex_strlit_3 = { { 9, 0, 0, REX_STR_STATIC }, "elapsed: " };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_4 = { { 2, 0, 0, REX_STR_STATIC }, "ms" };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[13]; } rex_strlit_5 = { { 12, 0, 0, REX_STR_STATIC }, "for (k, v): " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_6 = { { 4, 0, 0, REX_STR_STATIC }, " in " };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_7 = { { 11, 0, 0, REX_STR_STATIC }, "map_items: " };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_8 = { { 7, 0, 0, REX_STR_STATIC }, "drain: " };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_9 = { { 6, 0, 0, REX_STR_STATIC }, " then " };
+static const RexValue rex_strval_9 = REX_STR_LITERAL(rex_strlit_9.s);
+
+
+static RexValue rex_user_bench(RexValue count) {
+  double start_1 = rex_unbox_num(rex_now_ms());
+  RexValue m_1 = rex_collections_map_new();
+  int64_t __start1 = 0;
+  int64_t __end1 = rex_wrap_i32(rex_unbox_int(count));
+  for (int64_t __idx1 = __start1; __idx1 < __end1; __idx1++) {
+    int64_t i_1 = __idx1;
+    rex_collections_map_put(rex_ref_mut(&m_1), rex_int(i_1), rex_int(rex_wrap_i32(rex_int_mul(i_1, 2))));
+  }
+  double sum_1 = 0.0;
+  int64_t __start2 = 0;
+  int64_t __end2 = rex_wrap_i32(rex_unbox_int(count));
+  for (int64_t __idx2 = __start2; __idx2 < __end2; __idx2++) {
+    int64_t i_2 = __idx2;
+    sum_1 = (sum_1 + rex_unbox_num(rex_collections_map_get(rex_ref(&m_1), rex_int(i_2))));
+  }
+  double end_1 = rex_unbox_num(rex_now_ms());
+  RexValue __tmp3 = rex_format(rex_collections_map_len(rex_ref(&m_1)));
+  RexValue __tmp4 = rex_add(rex_strval_1, __tmp3);
+  RexValue __tmp5 = rex_add(__tmp4, rex_strval_2);
+  RexValue __tmp6 = rex_format(rex_num(sum_1));
+  RexValue __tmp7 = rex_add(__tmp5, __tmp6);
+  rex_println(__tmp7);
+  rex_drop(__tmp3);
+  rex_drop(__tmp4);
+  rex_drop(__tmp5);
+  rex_drop(__tmp6);
+  rex_drop(__tmp7);
+  RexValue __tmp8 = rex_format(rex_num((end_1 - start_1)));
+  RexValue __tmp9 = rex_add(rex_strval_3, __tmp8);
+  RexValue __tmp10 = rex_add(__tmp9, rex_strval_4);
+  rex_println(__tmp10);
+  rex_drop(__tmp8);
+  rex_drop(__tmp9);
+  rex_drop(__tmp10);
+  double walked_1 = 0.0;
+  RexValue __iter11 = rex_ref(&m_1);
+  RexMapView __view11 = rex_collections_map_view(__iter11);
+  for (int64_t __idx11 = 0; __idx11 < __view11.count; __idx11++) {
+    rex_map_view_check(&__view11);
+    if (rex_map_view_removed(&__view11, __idx11)) {
+      continue;
+    }
+    int64_t k_1 = rex_wrap_i32(rex_unbox_int(rex_map_view_key(&__view11, __idx11)));
+    int64_t v_1 = rex_wrap_i32(rex_unbox_int(rex_map_view_value(&__view11, __idx11)));
+    walked_1 = ((walked_1 + ((double)k_1)) + ((double)v_1));
+  }
+  double loop_end_1 = rex_unbox_num(rex_now_ms());
+  double copied_1 = 0.0;
+  RexValue items_1 = rex_collections_map_items(rex_ref(&m_1));
+  RexValue __iter12 = items_1;
+  RexVecView __view12 = rex_collections_vec_view(__iter12);
+  for (int64_t __idx12 = 0; __idx12 < __view12.count; __idx12++) {
+    rex_vec_view_check(&__view12);
+    RexValue item_1 = rex_vec_view_get(&__view12, __idx12);
+    RexValue __tmp13 = item_1;
+    RexValue k_2 = rex_tuple_get(__tmp13, 0);
+    RexValue v_2 = rex_tuple_get(__tmp13, 1);
+    copied_1 = ((copied_1 + rex_unbox_num(k_2)) + rex_unbox_num(v_2));
+  }
+  double items_end_1 = rex_unbox_num(rex_now_ms());
+  RexValue __tmp14 = rex_format(rex_num(walked_1));
+  RexValue __tmp15 = rex_add(rex_strval_5, __tmp14);
+  RexValue __tmp16 = rex_add(__tmp15, rex_strval_6);
+  RexValue __tmp17 = rex_format(rex_num((loop_end_1 - end_1)));
+  RexValue __tmp18 = rex_add(__tmp16, __tmp17);
+  RexValue __tmp19 = rex_add(__tmp18, rex_strval_4);
+  rex_println(__tmp19);
+  rex_drop(__tmp14);
+  rex_drop(__tmp15);
+  rex_drop(__tmp16);
+  rex_drop(__tmp17);
+  rex_drop(__tmp18);
+  rex_drop(__tmp19);
+  RexValue __tmp20 = rex_format(rex_num(copied_1));
+  RexValue __tmp21 = rex_add(rex_strval_7, __tmp20);
+  RexValue __tmp22 = rex_add(__tmp21, rex_strval_6);
+  RexValue __tmp23 = rex_format(rex_num((items_end_1 - loop_end_1)));
+  RexValue __tmp24 = rex_add(__tmp22, __tmp23);
+  RexValue __tmp25 = rex_add(__tmp24, rex_strval_4);
+  rex_println(__tmp25);
+  rex_drop(__tmp20);
+  rex_drop(__tmp21);
+  rex_drop(__tmp22);
+  rex_drop(__tmp23);
+  rex_drop(__tmp24);
+  rex_drop(__tmp25);
+  int64_t __start26 = 0;
+  int64_t __end26 = rex_wrap_i32(rex_unbox_int(count));
+  for (int64_t __idx26 = __start26; __idx26 < __end26; __idx26++) {
+    int64_t i_3 = __idx26;
+    if ((rex_wrap_i32(rex_int_mod(i_3, 2)) == 0)) {
+      rex_collections_map_remove(rex_ref_mut(&m_1), rex_int(i_3));
+    }
+  }
+  double half_1 = rex_unbox_num(rex_collections_map_len(rex_ref(&m_1)));
+  int64_t __start27 = 0;
+  int64_t __end27 = rex_wrap_i32(rex_unbox_int(count));
+  for (int64_t __idx27 = __start27; __idx27 < __end27; __idx27++) {
+    int64_t i_4 = __idx27;
+    rex_collections_map_remove(rex_ref_mut(&m_1), rex_int(i_4));
+  }
+  double drain_end_1 = rex_unbox_num(rex_now_ms());
+  RexValue __tmp28 = rex_format(rex_num(half_1));
+  RexValue __tmp29 = rex_add(rex_strval_8, __tmp28);
+  RexValue __tmp30 = rex_add(__tmp29, rex_strval_9);
+  RexValue __tmp31 = rex_format(rex_collections_map_len(rex_ref(&m_1)));
+  RexValue __tmp32 = rex_add(__tmp30, __tmp31);
+  RexValue __tmp33 = rex_add(__tmp32, rex_strval_6);
+  RexValue __tmp34 = rex_format(rex_num((drain_end_1 - items_end_1)));
+  RexValue __tmp35 = rex_add(__tmp33, __tmp34);
+  RexValue __tmp36 = rex_add(__tmp35, rex_strval_4);
+  rex_println(__tmp36);
+  rex_drop(__tmp28);
+  rex_drop(__tmp29);
+  rex_drop(__tmp30);
+  rex_drop(__tmp31);
+  rex_drop(__tmp32);
+  rex_drop(__tmp33);
+  rex_drop(__tmp34);
+  rex_drop(__tmp35);
+  rex_drop(__tmp36);
+  rex_drop(items_1);
+  rex_drop(m_1);
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  rex_user_bench(rex_num(1000));
+  rex_user_bench(rex_num(100000));
+  rex_user_bench(rex_num(1000000));
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
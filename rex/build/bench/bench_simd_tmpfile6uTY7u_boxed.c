@@ -0,0 +1,255 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_1 = { { 5, 0, 0, REX_STR_STATIC }, "sum: " };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[4]; } rex_strlit_2 = { { 3, 0, 0, REX_STR_STATIC }, " / " };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_3 = { { 5, 0, 0, REX_STR_STATIC }, "dot: " };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_4 = { { 5, 0, 0, REX_STR_STATIC }, "min: " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_5 = { { 5, 0, 0, REX_STR_STATIC }, "max: " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_6 = { { 6, 0, 0, REX_STR_STATIC }, "loop: " };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_7 = { { 2, 0, 0, REX_STR_STATIC }, "ms" };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[10]; } rex_strlit_8 = { { 9, 0, 0, REX_STR_STATIC }, "kernels: " };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+static const struct { RexStrHeader h; char s[19]; } rex_strlit_9 = { { 18, 0, 0, REX_STR_STATIC }, "scaled+added sum: " };
+static const RexValue rex_strval_9 = REX_STR_LITERAL(rex_strlit_9.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_10 = { { 11, 0, 0, REX_STR_STATIC }, "scale+add: " };
+static const RexValue rex_strval_10 = REX_STR_LITERAL(rex_strlit_10.s);
+
+
+static RexValue rex_user_main() {
+  double count_1 = 1000000.0;
+  RexValue a_1 = rex_collections_vec_new_typed(REX_VEC_F64);
+  RexValue b_1 = rex_collections_vec_new_typed(REX_VEC_F64);
+  int64_t __start1 = 0;
+  double __end1_num = count_1;
+  int64_t __end1 = rex_range_end(__end1_num, 1);
+  for (int64_t __idx1 = __start1; __idx1 < __end1; __idx1++) {
+    double i_1 = ((double)__idx1);
+    rex_collections_vec_push_f64(rex_ref_mut(&a_1), (i_1 * 0.5));
+    rex_collections_vec_push_f64(rex_ref_mut(&b_1), 2.0);
+  }
+  double loop_start_1 = rex_unbox_num(rex_now_ms());
+  double sum_1 = 0.0;
+  double dot_1 = 0.0;
+  double lo_1 = rex_collections_vec_get_f64(rex_ref(&a_1), 0);
+  double hi_1 = rex_collections_vec_get_f64(rex_ref(&a_1), 0);
+  int64_t __start2 = 0;
+  double __end2_num = count_1;
+  int64_t __end2 = rex_range_end(__end2_num, 1);
+  for (int64_t __idx2 = __start2; __idx2 < __end2; __idx2++) {
+    double i_2 = ((double)__idx2);
+    double x_1 = rex_unbox_num(rex_collections_vec_get(rex_ref(&a_1), rex_num(i_2)));
+    sum_1 = (sum_1 + x_1);
+    dot_1 = (dot_1 + (x_1 * rex_unbox_num(rex_collections_vec_get(rex_ref(&b_1), rex_num(i_2)))));
+    if ((x_1 < lo_1)) {
+      lo_1 = x_1;
+    }
+    if ((x_1 > hi_1)) {
+      hi_1 = x_1;
+    }
+  }
+  double loop_end_1 = rex_unbox_num(rex_now_ms());
+  double kernel_start_1 = rex_unbox_num(rex_now_ms());
+  double ksum_1 = rex_unbox_num(rex_collections_vec_sum(rex_ref(&a_1)));
+  double kdot_1 = rex_unbox_num(rex_collections_vec_dot(rex_ref(&a_1), rex_ref(&b_1)));
+  double klo_1 = rex_unbox_num(rex_collections_vec_min(rex_ref(&a_1)));
+  double khi_1 = rex_unbox_num(rex_collections_vec_max(rex_ref(&a_1)));
+  double kernel_end_1 = rex_unbox_num(rex_now_ms());
+  RexValue __tmp3 = rex_fmt_fixed(rex_num(sum_1), rex_num(1));
+  RexValue __tmp4 = rex_add(rex_strval_1, __tmp3);
+  RexValue __tmp5 = rex_add(__tmp4, rex_strval_2);
+  RexValue __tmp6 = rex_fmt_fixed(rex_num(ksum_1), rex_num(1));
+  RexValue __tmp7 = rex_add(__tmp5, __tmp6);
+  rex_println(__tmp7);
+  rex_drop(__tmp3);
+  rex_drop(__tmp4);
+  rex_drop(__tmp5);
+  rex_drop(__tmp6);
+  rex_drop(__tmp7);
+  RexValue __tmp8 = rex_fmt_fixed(rex_num(dot_1), rex_num(1));
+  RexValue __tmp9 = rex_add(rex_strval_3, __tmp8);
+  RexValue __tmp10 = rex_add(__tmp9, rex_strval_2);
+  RexValue __tmp11 = rex_fmt_fixed(rex_num(kdot_1), rex_num(1));
+  RexValue __tmp12 = rex_add(__tmp10, __tmp11);
+  rex_println(__tmp12);
+  rex_drop(__tmp8);
+  rex_drop(__tmp9);
+  rex_drop(__tmp10);
+  rex_drop(__tmp11);
+  rex_drop(__tmp12);
+  RexValue __tmp13 = rex_fmt_fixed(rex_num(lo_1), rex_num(1));
+  RexValue __tmp14 = rex_add(rex_strval_4, __tmp13);
+  RexValue __tmp15 = rex_add(__tmp14, rex_strval_2);
+  RexValue __tmp16 = rex_fmt_fixed(rex_num(klo_1), rex_num(1));
+  RexValue __tmp17 = rex_add(__tmp15, __tmp16);
+  rex_println(__tmp17);
+  rex_drop(__tmp13);
+  rex_drop(__tmp14);
+  rex_drop(__tmp15);
+  rex_drop(__tmp16);
+  rex_drop(__tmp17);
+  RexValue __tmp18 = rex_fmt_fixed(rex_num(hi_1), rex_num(1));
+  RexValue __tmp19 = rex_add(rex_strval_5, __tmp18);
+  RexValue __tmp20 = rex_add(__tmp19, rex_strval_2);
+  RexValue __tmp21 = rex_fmt_fixed(rex_num(khi_1), rex_num(1));
+  RexValue __tmp22 = rex_add(__tmp20, __tmp21);
+  rex_println(__tmp22);
+  rex_drop(__tmp18);
+  rex_drop(__tmp19);
+  rex_drop(__tmp20);
+  rex_drop(__tmp21);
+  rex_drop(__tmp22);
+  RexValue __tmp23 = rex_format(rex_num((loop_end_1 - loop_start_1)));
+  RexValue __tmp24 = rex_add(rex_strval_6, __tmp23);
+  RexValue __tmp25 = rex_add(__tmp24, rex_strval_7);
+  rex_println(__tmp25);
+  rex_drop(__tmp23);
+  rex_drop(__tmp24);
+  rex_drop(__tmp25);
+  RexValue __tmp26 = rex_format(rex_num((kernel_end_1 - kernel_start_1)));
+  RexValue __tmp27 = rex_add(rex_strval_8, __tmp26);
+  RexValue __tmp28 = rex_add(__tmp27, rex_strval_7);
+  rex_println(__tmp28);
+  rex_drop(__tmp26);
+  rex_drop(__tmp27);
+  rex_drop(__tmp28);
+  double update_start_1 = rex_unbox_num(rex_now_ms());
+  rex_collections_vec_scale(rex_ref_mut(&a_1), rex_num(2.0));
+  rex_collections_vec_add(rex_ref_mut(&a_1), rex_ref(&b_1));
+  double update_end_1 = rex_unbox_num(rex_now_ms());
+  RexValue __tmp29 = rex_fmt_fixed(rex_collections_vec_sum(rex_ref(&a_1)), rex_num(1));
+  RexValue __tmp30 = rex_add(rex_strval_9, __tmp29);
+  rex_println(__tmp30);
+  rex_drop(__tmp29);
+  rex_drop(__tmp30);
+  RexValue __tmp31 = rex_format(rex_num((update_end_1 - update_start_1)));
+  RexValue __tmp32 = rex_add(rex_strval_10, __tmp31);
+  RexValue __tmp33 = rex_add(__tmp32, rex_strval_7);
+  rex_println(__tmp33);
+  rex_drop(__tmp31);
+  rex_drop(__tmp32);
+  rex_drop(__tmp33);
+  rex_drop(b_1);
+  rex_drop(a_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
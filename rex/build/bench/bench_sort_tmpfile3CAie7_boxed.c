@@ -0,0 +1,259 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_Order_new(RexValue id, RexValue price);
+static RexValue rex_user_main();
+static const char* rex_fields_Order[] = {"id", "price"};
+typedef struct RexNative_Order { int64_t f_id; double f_price; } RexNative_Order;
+static const unsigned char rex_kinds_Order[] = {REX_FIELD_INT, REX_FIELD_NUM};
+static const size_t rex_offsets_Order[] = {offsetof(RexNative_Order, f_id), offsetof(RexNative_Order, f_price)};
+static const RexStructLayout rex_layout_Order = {"Order", rex_fields_Order, rex_kinds_Order, rex_offsets_Order, 2, sizeof(RexNative_Order)};
+static RexValue rex_Order_new(RexValue f_id, RexValue f_price) {
+  RexNative_Order __rex_native = {rex_unbox_int(f_id), rex_unbox_num(f_price)};
+  return rex_struct_new_native(&rex_layout_Order, &__rex_native);
+}
+
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_1 = { { 5, 0, 0, REX_STR_STATIC }, "user_" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_2 = { { 5, 0, 0, REX_STR_STATIC }, "price" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[17]; } rex_strlit_3 = { { 16, 0, 0, REX_STR_STATIC }, "f64 first/last: " };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[4]; } rex_strlit_4 = { { 3, 0, 0, REX_STR_STATIC }, " / " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[17]; } rex_strlit_5 = { { 16, 0, 0, REX_STR_STATIC }, "i64 first/last: " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[17]; } rex_strlit_6 = { { 16, 0, 0, REX_STR_STATIC }, "str first/last: " };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[17]; } rex_strlit_7 = { { 16, 0, 0, REX_STR_STATIC }, "cheapest order: " };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_8 = { { 4, 0, 0, REX_STR_STATIC }, " at " };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+static const struct { RexStrHeader h; char s[11]; } rex_strlit_9 = { { 10, 0, 0, REX_STR_STATIC }, "sort f64: " };
+static const RexValue rex_strval_9 = REX_STR_LITERAL(rex_strlit_9.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_10 = { { 2, 0, 0, REX_STR_STATIC }, "ms" };
+static const RexValue rex_strval_10 = REX_STR_LITERAL(rex_strlit_10.s);
+static const struct { RexStrHeader h; char s[11]; } rex_strlit_11 = { { 10, 0, 0, REX_STR_STATIC }, "sort i64: " };
+static const RexValue rex_strval_11 = REX_STR_LITERAL(rex_strlit_11.s);
+static const struct { RexStrHeader h; char s[11]; } rex_strlit_12 = { { 10, 0, 0, REX_STR_STATIC }, "sort str: " };
+static const RexValue rex_strval_12 = REX_STR_LITERAL(rex_strlit_12.s);
+static const struct { RexStrHeader h; char s[14]; } rex_strlit_13 = { { 13, 0, 0, REX_STR_STATIC }, "sort_by_key: " };
+static const RexValue rex_strval_13 = REX_STR_LITERAL(rex_strlit_13.s);
+
+
+static RexValue rex_user_main() {
+  double count_1 = 1000000.0;
+  rex_random_seed(rex_num(42));
+  RexValue floats_1 = rex_collections_vec_new_typed(REX_VEC_F64);
+  RexValue ints_1 = rex_collections_vec_new_typed(REX_VEC_I64);
+  RexValue names_1 = rex_collections_vec_new();
+  RexValue orders_1 = rex_collections_vec_new();
+  int64_t __start1 = 0;
+  double __end1_num = count_1;
+  int64_t __end1 = rex_range_end(__end1_num, 1);
+  for (int64_t __idx1 = __start1; __idx1 < __end1; __idx1++) {
+    double i_1 = ((double)__idx1);
+    double r_1 = rex_unbox_num(rex_random_int(rex_num(0), rex_num(1000000000)));
+    rex_collections_vec_push_f64(rex_ref_mut(&floats_1), ((r_1 * 0.001) - 500000.0));
+    rex_collections_vec_push_f64(rex_ref_mut(&ints_1), (r_1 - 500000000.0));
+    RexValue __tmp2 = rex_format(rex_num(r_1));
+    rex_collections_vec_push(rex_ref_mut(&names_1), rex_add(rex_strval_1, __tmp2));
+    rex_drop(__tmp2);
+    rex_collections_vec_push(rex_ref_mut(&orders_1), rex_Order_new(rex_num(i_1), rex_num((rex_unbox_num(rex_random_int(rex_num(0), rex_num(10000))) * 0.01))));
+  }
+  double f_start_1 = rex_unbox_num(rex_now_ms());
+  rex_collections_vec_sort(rex_ref_mut(&floats_1));
+  double f_end_1 = rex_unbox_num(rex_now_ms());
+  rex_collections_vec_sort(rex_ref_mut(&ints_1));
+  double i_end_1 = rex_unbox_num(rex_now_ms());
+  rex_collections_vec_sort(rex_ref_mut(&names_1));
+  double s_end_1 = rex_unbox_num(rex_now_ms());
+  rex_collections_vec_sort_by_key(rex_ref_mut(&orders_1), rex_strval_2);
+  double k_end_1 = rex_unbox_num(rex_now_ms());
+  RexValue __tmp3 = rex_fmt_fixed(rex_collections_vec_get_at(rex_ref(&floats_1), 0), rex_num(3));
+  RexValue __tmp4 = rex_add(rex_strval_3, __tmp3);
+  RexValue __tmp5 = rex_add(__tmp4, rex_strval_4);
+  RexValue __tmp6 = rex_fmt_fixed(rex_collections_vec_get(rex_ref(&floats_1), rex_num((count_1 - 1.0))), rex_num(3));
+  RexValue __tmp7 = rex_add(__tmp5, __tmp6);
+  rex_println(__tmp7);
+  rex_drop(__tmp3);
+  rex_drop(__tmp4);
+  rex_drop(__tmp5);
+  rex_drop(__tmp6);
+  rex_drop(__tmp7);
+  RexValue __tmp8 = rex_format(rex_collections_vec_get_at(rex_ref(&ints_1), 0));
+  RexValue __tmp9 = rex_add(rex_strval_5, __tmp8);
+  RexValue __tmp10 = rex_add(__tmp9, rex_strval_4);
+  RexValue __tmp11 = rex_format(rex_collections_vec_get(rex_ref(&ints_1), rex_num((count_1 - 1.0))));
+  RexValue __tmp12 = rex_add(__tmp10, __tmp11);
+  rex_println(__tmp12);
+  rex_drop(__tmp8);
+  rex_drop(__tmp9);
+  rex_drop(__tmp10);
+  rex_drop(__tmp11);
+  rex_drop(__tmp12);
+  RexValue __tmp13 = rex_add(rex_strval_6, rex_collections_vec_get_at(rex_ref(&names_1), 0));
+  RexValue __tmp14 = rex_add(__tmp13, rex_strval_4);
+  RexValue __tmp15 = rex_add(__tmp14, rex_collections_vec_get(rex_ref(&names_1), rex_num((count_1 - 1.0))));
+  rex_println(__tmp15);
+  rex_drop(__tmp13);
+  rex_drop(__tmp14);
+  rex_drop(__tmp15);
+  RexValue cheapest_1 = rex_collections_vec_get_at(rex_ref(&orders_1), 0);
+  RexValue __tmp16 = rex_format(rex_int(((RexNative_Order*)rex_struct_data(cheapest_1, &rex_layout_Order))->f_id));
+  RexValue __tmp17 = rex_add(rex_strval_7, __tmp16);
+  RexValue __tmp18 = rex_add(__tmp17, rex_strval_8);
+  RexValue __tmp19 = rex_fmt_fixed(rex_num(((RexNative_Order*)rex_struct_data(cheapest_1, &rex_layout_Order))->f_price), rex_num(2));
+  RexValue __tmp20 = rex_add(__tmp18, __tmp19);
+  rex_println(__tmp20);
+  rex_drop(__tmp16);
+  rex_drop(__tmp17);
+  rex_drop(__tmp18);
+  rex_drop(__tmp19);
+  rex_drop(__tmp20);
+  RexValue __tmp21 = rex_format(rex_num((f_end_1 - f_start_1)));
+  RexValue __tmp22 = rex_add(rex_strval_9, __tmp21);
+  RexValue __tmp23 = rex_add(__tmp22, rex_strval_10);
+  rex_println(__tmp23);
+  rex_drop(__tmp21);
+  rex_drop(__tmp22);
+  rex_drop(__tmp23);
+  RexValue __tmp24 = rex_format(rex_num((i_end_1 - f_end_1)));
+  RexValue __tmp25 = rex_add(rex_strval_11, __tmp24);
+  RexValue __tmp26 = rex_add(__tmp25, rex_strval_10);
+  rex_println(__tmp26);
+  rex_drop(__tmp24);
+  rex_drop(__tmp25);
+  rex_drop(__tmp26);
+  RexValue __tmp27 = rex_format(rex_num((s_end_1 - i_end_1)));
+  RexValue __tmp28 = rex_add(rex_strval_12, __tmp27);
+  RexValue __tmp29 = rex_add(__tmp28, rex_strval_10);
+  rex_println(__tmp29);
+  rex_drop(__tmp27);
+  rex_drop(__tmp28);
+  rex_drop(__tmp29);
+  RexValue __tmp30 = rex_format(rex_num((k_end_1 - s_end_1)));
+  RexValue __tmp31 = rex_add(rex_strval_13, __tmp30);
+  RexValue __tmp32 = rex_add(__tmp31, rex_strval_10);
+  rex_println(__tmp32);
+  rex_drop(__tmp30);
+  rex_drop(__tmp31);
+  rex_drop(__tmp32);
+  rex_drop(orders_1);
+  rex_drop(names_1);
+  rex_drop(ints_1);
+  rex_drop(floats_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_Particle_new(RexValue f_x, RexValue f_y, RexValue f_vx, RexValue f_vy, RexValue f_mass);
+static RexValue rex_user_step(RexValue ps, RexValue dt);
+static RexValue rex_user_main();
+static const char* rex_fields_Particle[] = {"x", "y", "vx", "vy", "mass"};
+typedef struct RexNative_Particle { double f_x; double f_y; double f_vx; double f_vy; double f_mass; } RexNative_Particle;
+static const unsigned char rex_kinds_Particle[] = {REX_FIELD_NUM, REX_FIELD_NUM, REX_FIELD_NUM, REX_FIELD_NUM, REX_FIELD_NUM};
+static const size_t rex_offsets_Particle[] = {offsetof(RexNative_Particle, f_x), offsetof(RexNative_Particle, f_y), offsetof(RexNative_Particle, f_vx), offsetof(RexNative_Particle, f_vy), offsetof(RexNative_Particle, f_mass)};
+static const RexStructLayout rex_layout_Particle = {"Particle", rex_fields_Particle, rex_kinds_Particle, rex_offsets_Particle, 5, sizeof(RexNative_Particle)};
+static RexValue rex_Particle_new(RexValue f_x, RexValue f_y, RexValue f_vx, RexValue f_vy, RexValue f_mass) {
+  RexNative_Particle __rex_native = {rex_unbox_num(f_x), rex_unbox_num(f_y), rex_unbox_num(f_vx), rex_unbox_num(f_vy), rex_unbox_num(f_mass)};
+  return rex_struct_new_native(&rex_layout_Particle, &__rex_native);
+}
+
+static const struct { RexStrHeader h; char s[29]; } rex_strlit_1 = { { 28, 0, 0, REX_STR_STATIC }, "particles: 1000 frames: 1000" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[9]; } rex_strlit_2 = { { 8, 0, 0, REX_STR_STATIC }, "energy: " };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[10]; } rex_strlit_3 = { { 9, 0, 0, REX_STR_STATIC }, "elapsed: " };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_4 = { { 2, 0, 0, REX_STR_STATIC }, "ms" };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+
+
+static RexValue rex_user_step(RexValue ps, RexValue dt) {
+  int64_t __start1 = 0;
+  double __end1_num = rex_unbox_num(rex_collections_vec_len(ps));
+  int64_t __end1 = rex_range_end(__end1_num, 1);
+  for (int64_t __idx1 = __start1; __idx1 < __end1; __idx1++) {
+    double i_1 = ((double)__idx1);
+    RexValue p_1 = rex_collections_vec_get(ps, rex_num(i_1));
+    ((RexNative_Particle*)rex_struct_data_mut(p_1, &rex_layout_Particle))->f_vy = (((RexNative_Particle*)rex_struct_data(p_1, &rex_layout_Particle))->f_vy - (9.8 * rex_unbox_num(dt)));
+    ((RexNative_Particle*)rex_struct_data_mut(p_1, &rex_layout_Particle))->f_x = (((RexNative_Particle*)rex_struct_data(p_1, &rex_layout_Particle))->f_x + (((RexNative_Particle*)rex_struct_data(p_1, &rex_layout_Particle))->f_vx * rex_unbox_num(dt)));
+    ((RexNative_Particle*)rex_struct_data_mut(p_1, &rex_layout_Particle))->f_y = (((RexNative_Particle*)rex_struct_data(p_1, &rex_layout_Particle))->f_y + (((RexNative_Particle*)rex_struct_data(p_1, &rex_layout_Particle))->f_vy * rex_unbox_num(dt)));
+    if ((((RexNative_Particle*)rex_struct_data(p_1, &rex_layout_Particle))->f_y < 0.0)) {
+      ((RexNative_Particle*)rex_struct_data_mut(p_1, &rex_layout_Particle))->f_y = (0.0 - ((RexNative_Particle*)rex_struct_data(p_1, &rex_layout_Particle))->f_y);
+      ((RexNative_Particle*)rex_struct_data_mut(p_1, &rex_layout_Particle))->f_vy = (0.0 - (((RexNative_Particle*)rex_struct_data(p_1, &rex_layout_Particle))->f_vy * 0.9));
+    }
+  }
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  RexValue ps_1 = rex_collections_vec_new();
+  int64_t __start2 = 0;
+  int64_t __end2 = 1000;
+  for (int64_t __idx2 = __start2; __idx2 < __end2; __idx2++) {
+    double i_2 = ((double)__idx2);
+    rex_collections_vec_push(rex_ref_mut(&ps_1), rex_Particle_new(rex_num(i_2), rex_num(100), rex_num(1), rex_num(0), rex_num(1)));
+  }
+  double start_1 = rex_unbox_num(rex_now_ms());
+  int64_t __start3 = 0;
+  int64_t __end3 = 1000;
+  for (int64_t __idx3 = __start3; __idx3 < __end3; __idx3++) {
+    double frame_1 = ((double)__idx3);
+    rex_user_step(rex_ref_mut(&ps_1), rex_num(0.01));
+  }
+  double end_1 = rex_unbox_num(rex_now_ms());
+  double energy_1 = 0.0;
+  RexValue __iter4 = ps_1;
+  RexVecView __view4 = rex_collections_vec_view(__iter4);
+  for (int64_t __idx4 = 0; __idx4 < __view4.count; __idx4++) {
+    rex_vec_view_check(&__view4);
+    RexValue p_2 = rex_vec_view_get(&__view4, __idx4);
+    energy_1 = (energy_1 + (((RexNative_Particle*)rex_struct_data(p_2, &rex_layout_Particle))->f_mass * ((RexNative_Particle*)rex_struct_data(p_2, &rex_layout_Particle))->f_y));
+  }
+  rex_println(rex_strval_1);
+  RexValue __tmp5 = rex_fmt_fixed(rex_num(energy_1), rex_num(3));
+  RexValue __tmp6 = rex_add(rex_strval_2, __tmp5);
+  rex_println(__tmp6);
+  rex_drop(__tmp5);
+  rex_drop(__tmp6);
+  RexValue __tmp7 = rex_format(rex_num((end_1 - start_1)));
+  RexValue __tmp8 = rex_add(rex_strval_3, __tmp7);
+  RexValue __tmp9 = rex_add(__tmp8, rex_strval_4);
+  rex_println(__tmp9);
+  rex_drop(__tmp7);
+  rex_drop(__tmp8);
+  rex_drop(__tmp9);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[121]; } rex_strlit_1 = { { 120, 0, 0, REX_STR_STATIC }, "2026-10-17T12:00:00Z INFO  request handled in 12ms path=/api/v1/items/42?expand=owner,tags user-agent=rex-client/1.0   \n" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_2 = { { 11, 0, 0, REX_STR_STATIC }, "log bytes: " };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_3 = { { 7, 0, 0, REX_STR_STATIC }, "lines: " };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_4 = { { 7, 0, 0, REX_STR_STATIC }, "words: " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[16]; } rex_strlit_5 = { { 15, 0, 0, REX_STR_STATIC }, "trimmed bytes: " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_6 = { { 2, 0, 0, REX_STR_STATIC }, "ms" };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[13]; } rex_strlit_7 = { { 12, 0, 0, REX_STR_STATIC }, "trim+split: " };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+
+
+static RexValue rex_user_main() {
+  RexValue entry_1 = rex_strval_1;
+  RexValue log_1 = rex_text_repeat(rex_ref(&entry_1), rex_num(200000));
+  RexValue __tmp1 = rex_format(rex_text_len_bytes(rex_ref(&log_1)));
+  RexValue __tmp2 = rex_add(rex_strval_2, __tmp1);
+  rex_println(__tmp2);
+  rex_drop(__tmp1);
+  rex_drop(__tmp2);
+  double start_1 = rex_unbox_num(rex_now_ms());
+  RexValue lines_1 = rex_text_lines(rex_ref(&log_1));
+  double split_end_1 = rex_unbox_num(rex_now_ms());
+  double count_1 = rex_unbox_num(rex_collections_vec_len(rex_ref(&lines_1)));
+  double words_1 = 0.0;
+  double bytes_1 = 0.0;
+  RexValue __iter3 = lines_1;
+  RexVecView __view3 = rex_collections_vec_view(__iter3);
+  for (int64_t __idx3 = 0; __idx3 < __view3.count; __idx3++) {
+    rex_vec_view_check(&__view3);
+    RexValue line_1 = rex_vec_view_get(&__view3, __idx3);
+    RexValue trimmed_1 = rex_text_trim(rex_ref(&line_1));
+    bytes_1 = (bytes_1 + rex_unbox_num(rex_text_len_bytes(rex_ref(&trimmed_1))));
+    RexValue parts_1 = rex_text_split_words(rex_ref(&trimmed_1));
+    words_1 = (words_1 + rex_unbox_num(rex_collections_vec_len(rex_ref(&parts_1))));
+    rex_drop(parts_1);
+    rex_drop(trimmed_1);
+  }
+  double scan_end_1 = rex_unbox_num(rex_now_ms());
+  RexValue __tmp4 = rex_format(rex_num(count_1));
+  RexValue __tmp5 = rex_add(rex_strval_3, __tmp4);
+  rex_println(__tmp5);
+  rex_drop(__tmp4);
+  rex_drop(__tmp5);
+  RexValue __tmp6 = rex_format(rex_num(words_1));
+  RexValue __tmp7 = rex_add(rex_strval_4, __tmp6);
+  rex_println(__tmp7);
+  rex_drop(__tmp6);
+  rex_drop(__tmp7);
+  RexValue __tmp8 = rex_format(rex_num(bytes_1));
+  RexValue __tmp9 = rex_add(rex_strval_5, __tmp8);
+  rex_println(__tmp9);
+  rex_drop(__tmp8);
+  rex_drop(__tmp9);
+  RexValue __tmp10 = rex_format(rex_num((split_end_1 - start_1)));
+  RexValue __tmp11 = rex_add(rex_strval_3, __tmp10);
+  RexValue __tmp12 = rex_add(__tmp11, rex_strval_6);
+  rex_println(__tmp12);
+  rex_drop(__tmp10);
+  rex_drop(__tmp11);
+  rex_drop(__tmp12);
+  RexValue __tmp13 = rex_format(rex_num((scan_end_1 - split_end_1)));
+  RexValue __tmp14 = rex_add(rex_strval_7, __tmp13);
+  RexValue __tmp15 = rex_add(__tmp14, rex_strval_6);
+  rex_println(__tmp15);
+  rex_drop(__tmp13);
+  rex_drop(__tmp14);
+  rex_drop(__tmp15);
+  rex_drop(lines_1);
+  rex_drop(log_1);
+  rex_drop(entry_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
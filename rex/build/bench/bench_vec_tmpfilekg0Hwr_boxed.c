@@ -0,0 +1,268 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[10]; } rex_strlit_1 = { { 9, 0, 0, REX_STR_STATIC }, "vec_len: " };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[10]; } rex_strlit_2 = { { 9, 0, 0, REX_STR_STATIC }, "elapsed: " };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_3 = { { 2, 0, 0, REX_STR_STATIC }, "ms" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_4 = { { 1, 0, 0, REX_STR_STATIC }, "x" };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_5 = { { 11, 0, 0, REX_STR_STATIC }, "bytes i32: " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_6 = { { 11, 0, 0, REX_STR_STATIC }, "bytes f64: " };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[11]; } rex_strlit_7 = { { 10, 0, 0, REX_STR_STATIC }, "bytes u8: " };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[18]; } rex_strlit_8 = { { 17, 0, 0, REX_STR_STATIC }, "bytes str x1000: " };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+static const struct { RexStrHeader h; char s[14]; } rex_strlit_9 = { { 13, 0, 0, REX_STR_STATIC }, "push f64+u8: " };
+static const RexValue rex_strval_9 = REX_STR_LITERAL(rex_strlit_9.s);
+static const struct { RexStrHeader h; char s[10]; } rex_strlit_10 = { { 9, 0, 0, REX_STR_STATIC }, "sum i32: " };
+static const RexValue rex_strval_10 = REX_STR_LITERAL(rex_strlit_10.s);
+static const struct { RexStrHeader h; char s[10]; } rex_strlit_11 = { { 9, 0, 0, REX_STR_STATIC }, "sum f64: " };
+static const RexValue rex_strval_11 = REX_STR_LITERAL(rex_strlit_11.s);
+static const struct { RexStrHeader h; char s[9]; } rex_strlit_12 = { { 8, 0, 0, REX_STR_STATIC }, "sum u8: " };
+static const RexValue rex_strval_12 = REX_STR_LITERAL(rex_strlit_12.s);
+static const struct { RexStrHeader h; char s[10]; } rex_strlit_13 = { { 9, 0, 0, REX_STR_STATIC }, "iterate: " };
+static const RexValue rex_strval_13 = REX_STR_LITERAL(rex_strlit_13.s);
+
+
+static RexValue rex_user_main() {
+  double count_1 = 200000.0;
+  double start_1 = rex_unbox_num(rex_now_ms());
+  RexValue v_1 = rex_collections_vec_new_typed(REX_VEC_I64);
+  int64_t __start1 = 0;
+  double __end1_num = count_1;
+  int64_t __end1 = rex_range_end(__end1_num, 1);
+  for (int64_t __idx1 = __start1; __idx1 < __end1; __idx1++) {
+    double i_1 = ((double)__idx1);
+    rex_collections_vec_push_f64(rex_ref_mut(&v_1), i_1);
+  }
+  double end_1 = rex_unbox_num(rex_now_ms());
+  RexValue __tmp2 = rex_format(rex_collections_vec_len(rex_ref(&v_1)));
+  RexValue __tmp3 = rex_add(rex_strval_1, __tmp2);
+  rex_println(__tmp3);
+  rex_drop(__tmp2);
+  rex_drop(__tmp3);
+  RexValue __tmp4 = rex_format(rex_num((end_1 - start_1)));
+  RexValue __tmp5 = rex_add(rex_strval_2, __tmp4);
+  RexValue __tmp6 = rex_add(__tmp5, rex_strval_3);
+  rex_println(__tmp6);
+  rex_drop(__tmp4);
+  rex_drop(__tmp5);
+  rex_drop(__tmp6);
+  RexValue floats_1 = rex_collections_vec_new_typed(REX_VEC_F64);
+  RexValue bytes_1 = rex_collections_vec_new_typed(REX_VEC_U8);
+  RexValue boxed_1 = rex_collections_vec_new();
+  double push_start_1 = rex_unbox_num(rex_now_ms());
+  int64_t __start7 = 0;
+  double __end7_num = count_1;
+  int64_t __end7 = rex_range_end(__end7_num, 1);
+  for (int64_t __idx7 = __start7; __idx7 < __end7; __idx7++) {
+    double i_2 = ((double)__idx7);
+    rex_collections_vec_push_f64(rex_ref_mut(&floats_1), (i_2 * 0.5));
+    rex_collections_vec_push_f64(rex_ref_mut(&bytes_1), i_2);
+  }
+  double push_end_1 = rex_unbox_num(rex_now_ms());
+  int64_t __start8 = 0;
+  int64_t __end8 = 1000;
+  for (int64_t __idx8 = __start8; __idx8 < __end8; __idx8++) {
+    double i_3 = ((double)__idx8);
+    rex_collections_vec_push(rex_ref_mut(&boxed_1), rex_strval_4);
+  }
+  RexValue __tmp9 = rex_format(rex_collections_vec_bytes(rex_ref(&v_1)));
+  RexValue __tmp10 = rex_add(rex_strval_5, __tmp9);
+  rex_println(__tmp10);
+  rex_drop(__tmp9);
+  rex_drop(__tmp10);
+  RexValue __tmp11 = rex_format(rex_collections_vec_bytes(rex_ref(&floats_1)));
+  RexValue __tmp12 = rex_add(rex_strval_6, __tmp11);
+  rex_println(__tmp12);
+  rex_drop(__tmp11);
+  rex_drop(__tmp12);
+  RexValue __tmp13 = rex_format(rex_collections_vec_bytes(rex_ref(&bytes_1)));
+  RexValue __tmp14 = rex_add(rex_strval_7, __tmp13);
+  rex_println(__tmp14);
+  rex_drop(__tmp13);
+  rex_drop(__tmp14);
+  RexValue __tmp15 = rex_format(rex_collections_vec_bytes(rex_ref(&boxed_1)));
+  RexValue __tmp16 = rex_add(rex_strval_8, __tmp15);
+  rex_println(__tmp16);
+  rex_drop(__tmp15);
+  rex_drop(__tmp16);
+  RexValue __tmp17 = rex_format(rex_num((push_end_1 - push_start_1)));
+  RexValue __tmp18 = rex_add(rex_strval_9, __tmp17);
+  RexValue __tmp19 = rex_add(__tmp18, rex_strval_3);
+  rex_println(__tmp19);
+  rex_drop(__tmp17);
+  rex_drop(__tmp18);
+  rex_drop(__tmp19);
+  double iter_start_1 = rex_unbox_num(rex_now_ms());
+  int64_t total_1 = 0;
+  RexValue __iter20 = v_1;
+  RexVecView __view20 = rex_collections_vec_view(__iter20);
+  for (int64_t __idx20 = 0; __idx20 < __view20.count; __idx20++) {
+    rex_vec_view_check(&__view20);
+    int64_t x_1 = rex_wrap_i32(rex_vec_view_i64(&__view20, __idx20));
+    total_1 = rex_int_add(total_1, x_1);
+  }
+  double ftotal_1 = 0.0;
+  RexValue __iter21 = floats_1;
+  RexVecView __view21 = rex_collections_vec_view(__iter21);
+  for (int64_t __idx21 = 0; __idx21 < __view21.count; __idx21++) {
+    rex_vec_view_check(&__view21);
+    double y_1 = rex_vec_view_f64(&__view21, __idx21);
+    ftotal_1 = (ftotal_1 + y_1);
+  }
+  int64_t btotal_1 = 0;
+  RexValue __iter22 = bytes_1;
+  RexVecView __view22 = rex_collections_vec_view(__iter22);
+  for (int64_t __idx22 = 0; __idx22 < __view22.count; __idx22++) {
+    rex_vec_view_check(&__view22);
+    int64_t b_1 = rex_wrap_u8(rex_vec_view_i64(&__view22, __idx22));
+    btotal_1 = rex_int_add(btotal_1, b_1);
+  }
+  double iter_end_1 = rex_unbox_num(rex_now_ms());
+  RexValue __tmp23 = rex_format(rex_int(total_1));
+  RexValue __tmp24 = rex_add(rex_strval_10, __tmp23);
+  rex_println(__tmp24);
+  rex_drop(__tmp23);
+  rex_drop(__tmp24);
+  RexValue __tmp25 = rex_format(rex_num(ftotal_1));
+  RexValue __tmp26 = rex_add(rex_strval_11, __tmp25);
+  rex_println(__tmp26);
+  rex_drop(__tmp25);
+  rex_drop(__tmp26);
+  RexValue __tmp27 = rex_format(rex_int(btotal_1));
+  RexValue __tmp28 = rex_add(rex_strval_12, __tmp27);
+  rex_println(__tmp28);
+  rex_drop(__tmp27);
+  rex_drop(__tmp28);
+  RexValue __tmp29 = rex_format(rex_num((iter_end_1 - iter_start_1)));
+  RexValue __tmp30 = rex_add(rex_strval_13, __tmp29);
+  RexValue __tmp31 = rex_add(__tmp30, rex_strval_3);
+  rex_println(__tmp31);
+  rex_drop(__tmp29);
+  rex_drop(__tmp30);
+  rex_drop(__tmp31);
+  rex_drop(boxed_1);
+  rex_drop(bytes_1);
+  rex_drop(floats_1);
+  rex_drop(v_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_1 = { { 14, 0, 0, REX_STR_STATIC }, "out of order: " };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[17]; } rex_strlit_2 = { { 16, 0, 0, REX_STR_STATIC }, "f64 first/last: " };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[4]; } rex_strlit_3 = { { 3, 0, 0, REX_STR_STATIC }, " / " };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_4 = { { 14, 0, 0, REX_STR_STATIC }, "par_sort f64: " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_5 = { { 2, 0, 0, REX_STR_STATIC }, "ms" };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_6 = { { 14, 0, 0, REX_STR_STATIC }, "par_sort i64: " };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+
+
+static RexValue rex_user_main() {
+  double count_1 = 4000000.0;
+  rex_random_seed(rex_num(7));
+  RexValue floats_1 = rex_collections_vec_new_typed(REX_VEC_F64);
+  RexValue ints_1 = rex_collections_vec_new_typed(REX_VEC_I64);
+  int64_t __start1 = 0;
+  double __end1_num = count_1;
+  int64_t __end1 = rex_range_end(__end1_num, 1);
+  for (int64_t __idx1 = __start1; __idx1 < __end1; __idx1++) {
+    double i_1 = ((double)__idx1);
+    double r_1 = rex_unbox_num(rex_random_int(rex_num(0), rex_num(1000000000)));
+    rex_collections_vec_push_f64(rex_ref_mut(&floats_1), ((r_1 * 0.001) - 500000.0));
+    rex_collections_vec_push_f64(rex_ref_mut(&ints_1), (r_1 - 500000000.0));
+  }
+  double f_start_1 = rex_unbox_num(rex_now_ms());
+  rex_collections_vec_par_sort(rex_ref_mut(&floats_1));
+  double f_end_1 = rex_unbox_num(rex_now_ms());
+  rex_collections_vec_par_sort(rex_ref_mut(&ints_1));
+  double i_end_1 = rex_unbox_num(rex_now_ms());
+  double unsorted_1 = 0.0;
+  int64_t __start2 = 1;
+  double __end2_num = count_1;
+  int64_t __end2 = rex_range_end(__end2_num, 1);
+  for (int64_t __idx2 = __start2; __idx2 < __end2; __idx2++) {
+    double i_2 = ((double)__idx2);
+    if ((rex_unbox_num(rex_collections_vec_get(rex_ref(&floats_1), rex_num((i_2 - 1.0)))) > rex_unbox_num(rex_collections_vec_get(rex_ref(&floats_1), rex_num(i_2))))) {
+      unsorted_1 = (unsorted_1 + 1.0);
+    }
+    if ((rex_unbox_int(rex_collections_vec_get(rex_ref(&ints_1), rex_num((i_2 - 1.0)))) > rex_unbox_int(rex_collections_vec_get(rex_ref(&ints_1), rex_num(i_2))))) {
+      unsorted_1 = (unsorted_1 + 1.0);
+    }
+  }
+  RexValue __tmp3 = rex_format(rex_num(unsorted_1));
+  RexValue __tmp4 = rex_add(rex_strval_1, __tmp3);
+  rex_println(__tmp4);
+  rex_drop(__tmp3);
+  rex_drop(__tmp4);
+  RexValue __tmp5 = rex_fmt_fixed(rex_collections_vec_get_at(rex_ref(&floats_1), 0), rex_num(3));
+  RexValue __tmp6 = rex_add(rex_strval_2, __tmp5);
+  RexValue __tmp7 = rex_add(__tmp6, rex_strval_3);
+  RexValue __tmp8 = rex_fmt_fixed(rex_collections_vec_get(rex_ref(&floats_1), rex_num((count_1 - 1.0))), rex_num(3));
+  RexValue __tmp9 = rex_add(__tmp7, __tmp8);
+  rex_println(__tmp9);
+  rex_drop(__tmp5);
+  rex_drop(__tmp6);
+  rex_drop(__tmp7);
+  rex_drop(__tmp8);
+  rex_drop(__tmp9);
+  RexValue __tmp10 = rex_format(rex_num((f_end_1 - f_start_1)));
+  RexValue __tmp11 = rex_add(rex_strval_4, __tmp10);
+  RexValue __tmp12 = rex_add(__tmp11, rex_strval_5);
+  rex_println(__tmp12);
+  rex_drop(__tmp10);
+  rex_drop(__tmp11);
+  rex_drop(__tmp12);
+  RexValue __tmp13 = rex_format(rex_num((i_end_1 - f_end_1)));
+  RexValue __tmp14 = rex_add(rex_strval_6, __tmp13);
+  RexValue __tmp15 = rex_add(__tmp14, rex_strval_5);
+  rex_println(__tmp15);
+  rex_drop(__tmp13);
+  rex_drop(__tmp14);
+  rex_drop(__tmp15);
+  rex_drop(ints_1);
+  rex_drop(floats_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_work(RexValue id);
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_1 = { { 7, 0, 0, REX_STR_STATIC }, "worker " };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[16]; } rex_strlit_2 = { { 15, 0, 0, REX_STR_STATIC }, " out of order: " };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+
+typedef struct __RexSpawnCtx1 {
+  RexValue id;
+} __RexSpawnCtx1;
+static void __rex_spawn_fn_1(void* __ctx) {
+  __RexSpawnCtx1* __rex_ctx = (__RexSpawnCtx1*)__ctx;
+  RexValue id = __rex_ctx->id;
+  free(__rex_ctx);
+  rex_user_work(id);
+}
+
+
+static RexValue rex_user_work(RexValue id) {
+  RexValue v_1 = rex_collections_vec_new_typed(REX_VEC_I64);
+  int64_t __start1 = 0;
+  int64_t __end1 = 300000;
+  for (int64_t __idx1 = __start1; __idx1 < __end1; __idx1++) {
+    double i_1 = ((double)__idx1);
+    rex_collections_vec_push_f64(rex_ref_mut(&v_1), fmod(((i_1 * 7919.0) + ((double)rex_int_mul(rex_unbox_int(id), 13))), 1000003.0));
+  }
+  rex_collections_vec_par_sort(rex_ref_mut(&v_1));
+  double bad_1 = 0.0;
+  int64_t __start2 = 1;
+  int64_t __end2 = 300000;
+  for (int64_t __idx2 = __start2; __idx2 < __end2; __idx2++) {
+    double i_2 = ((double)__idx2);
+    if ((rex_unbox_int(rex_collections_vec_get(rex_ref(&v_1), rex_num((i_2 - 1.0)))) > rex_unbox_int(rex_collections_vec_get(rex_ref(&v_1), rex_num(i_2))))) {
+      bad_1 = (bad_1 + 1.0);
+    }
+  }
+  RexValue __tmp3 = rex_format(id);
+  RexValue __tmp4 = rex_add(rex_strval_1, __tmp3);
+  RexValue __tmp5 = rex_add(__tmp4, rex_strval_2);
+  RexValue __tmp6 = rex_format(rex_num(bad_1));
+  RexValue __tmp7 = rex_add(__tmp5, __tmp6);
+  rex_println(__tmp7);
+  rex_drop(__tmp3);
+  rex_drop(__tmp4);
+  rex_drop(__tmp5);
+  rex_drop(__tmp6);
+  rex_drop(__tmp7);
+  rex_drop(v_1);
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  int64_t __start8 = 0;
+  int64_t __end8 = 4;
+  for (int64_t __idx8 = __start8; __idx8 < __end8; __idx8++) {
+    double i_3 = ((double)__idx8);
+    RexValue id_1 = rex_num(i_3);
+    {
+      __RexSpawnCtx1* __rex_ctx = (__RexSpawnCtx1*)malloc(sizeof(__RexSpawnCtx1));
+      if (!__rex_ctx) { rex_panic("spawn out of memory"); }
+      __rex_ctx->id = id_1;
+      rex_spawn(__rex_spawn_fn_1, __rex_ctx);
+    }
+  }
+  rex_wait_all();
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  rex_wait_all();
+  return 0;
+}
\ No newline at end of file
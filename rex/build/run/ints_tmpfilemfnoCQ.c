@@ -0,0 +1,194 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_Pair_new(RexValue f_a, RexValue f_b);
+static RexValue rex_user_add8(RexValue x, RexValue y);
+static RexValue rex_user_big();
+static RexValue rex_user_main();
+static const char* rex_fields_Pair[] = {"a", "b"};
+typedef struct RexNative_Pair { int64_t f_a; int64_t f_b; } RexNative_Pair;
+static const unsigned char rex_kinds_Pair[] = {REX_FIELD_INT, REX_FIELD_U64};
+static const size_t rex_offsets_Pair[] = {offsetof(RexNative_Pair, f_a), offsetof(RexNative_Pair, f_b)};
+static const RexStructLayout rex_layout_Pair = {"Pair", rex_fields_Pair, rex_kinds_Pair, rex_offsets_Pair, 2, sizeof(RexNative_Pair)};
+static RexValue rex_Pair_new(RexValue f_a, RexValue f_b) {
+  RexNative_Pair __rex_native = {rex_wrap_u8(rex_unbox_int(f_a)), rex_unbox_int(f_b)};
+  return rex_struct_new_native(&rex_layout_Pair, &__rex_native);
+}
+
+static const struct { RexStrHeader h; char s[4]; } rex_strlit_1 = { { 3, 0, 0, REX_STR_STATIC }, "odd" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_2 = { { 4, 0, 0, REX_STR_STATIC }, "even" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+
+
+static RexValue rex_user_add8(RexValue x, RexValue y) {
+  return rex_int(rex_wrap_u8(rex_int_add(rex_wrap_u8(rex_unbox_int(x)), rex_wrap_u8(rex_unbox_int(y)))));
+  return rex_nil();
+}
+
+static RexValue rex_user_big() {
+  return rex_uint((uint64_t)((int64_t)UINT64_C(18446744073709551615)));
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  int64_t b_1 = rex_wrap_u8(250);
+  b_1 = rex_wrap_u8(rex_int_add(b_1, 10));
+  rex_println(rex_int(b_1));
+  int64_t i_1 = rex_wrap_i32(2147483647);
+  i_1 = rex_wrap_i32(rex_int_add(i_1, 1));
+  rex_println(rex_int(i_1));
+  int64_t n_1 = rex_wrap_i8(rex_int_neg(128));
+  rex_println(rex_int(rex_wrap_i8(rex_int_neg(n_1))));
+  int64_t s_1 = rex_wrap_i16(40000);
+  rex_println(rex_int(s_1));
+  rex_println(rex_user_add8(rex_num(200), rex_num(100)));
+  int64_t m_1 = rex_unbox_int(rex_user_big());
+  rex_println(rex_uint((uint64_t)(m_1)));
+  rex_println(rex_uint((uint64_t)(rex_uint_div(m_1, 2))));
+  rex_println(rex_uint((uint64_t)(rex_uint_mod(m_1, 10))));
+  rex_println(rex_bool(((uint64_t)m_1 > (uint64_t)1)));
+  int64_t exact_1 = 9007199254740993;
+  rex_println(rex_int(exact_1));
+  rex_println(rex_int(rex_int_add(exact_1, 2)));
+  RexValue v_1 = rex_collections_vec_new_typed(REX_VEC_I64);
+  rex_collections_vec_push_i64(rex_ref_mut(&v_1), exact_1);
+  rex_println(rex_collections_vec_get_at(rex_ref(&v_1), 0));
+  RexValue mp_1 = rex_collections_map_new();
+  rex_collections_map_put(rex_ref_mut(&mp_1), rex_int(exact_1), rex_strval_1);
+  rex_collections_map_put(rex_ref_mut(&mp_1), rex_int(9007199254740992), rex_strval_2);
+  rex_println(rex_collections_map_get(rex_ref(&mp_1), rex_int(exact_1)));
+  rex_println(rex_collections_map_get(rex_ref(&mp_1), rex_int(9007199254740992)));
+  RexValue p_1 = rex_Pair_new(rex_num(255), rex_uint((uint64_t)(m_1)));
+  rex_println(rex_int(rex_wrap_u8(rex_int_add(((RexNative_Pair*)rex_struct_data(p_1, &rex_layout_Pair))->f_a, 1))));
+  rex_println(rex_uint((uint64_t)(((RexNative_Pair*)rex_struct_data(p_1, &rex_layout_Pair))->f_b)));
+  RexValue u_1 = rex_collections_vec_new_typed(REX_VEC_U64);
+  rex_collections_vec_push(rex_ref_mut(&u_1), rex_uint((uint64_t)(m_1)));
+  rex_collections_vec_push_f64(rex_ref_mut(&u_1), 1.0);
+  rex_collections_vec_sort(rex_ref_mut(&u_1));
+  rex_println(rex_collections_vec_get_at(rex_ref(&u_1), 1));
+  RexValue __tmp1 = rex_fmt_hex(rex_uint((uint64_t)(m_1)));
+  rex_println(__tmp1);
+  rex_drop(__tmp1);
+  int mixed_1 = (exact_1 == 9007199254740992);
+  rex_println(rex_bool(mixed_1));
+  int64_t w_1 = rex_wrap_u32(4294967295);
+  rex_println(rex_int(rex_wrap_u32(rex_int_mul(w_1, w_1))));
+  rex_drop(u_1);
+  rex_drop(p_1);
+  rex_drop(mp_1);
+  rex_drop(v_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_stash(RexValue v, RexValue s);
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[24]; } rex_strlit_1 = { { 23, 0, 0, REX_STR_STATIC }, "borrowed string number " };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[1]; } rex_strlit_2 = { { 0, 0, 0, REX_STR_STATIC }, "" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[28]; } rex_strlit_3 = { { 27, 0, 0, REX_STR_STATIC }, "dereferenced string number " };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[40]; } rex_strlit_4 = { { 39, 0, 0, REX_STR_STATIC }, "filler string that reuses freed blocks " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_5 = { { 2, 0, 0, REX_STR_STATIC }, ", " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+
+
+static RexValue rex_user_stash(RexValue v, RexValue s) {
+  rex_collections_vec_push(v, rex_deref(s));
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  RexValue keep_1 = rex_collections_vec_new();
+  int64_t __start1 = 0;
+  int64_t __end1 = 3;
+  for (int64_t __idx1 = __start1; __idx1 < __end1; __idx1++) {
+    double i_1 = ((double)__idx1);
+    RexValue __tmp2 = rex_format(rex_num(i_1));
+    RexValue a_1 = rex_add(rex_strval_1, __tmp2);
+    rex_drop(__tmp2);
+    rex_user_stash(rex_ref_mut(&keep_1), rex_ref(&a_1));
+    RexValue r_1 = rex_ref(&a_1);
+    rex_user_stash(rex_ref_mut(&keep_1), r_1);
+  }
+  RexValue last_1 = rex_strval_2;
+  int64_t __start3 = 0;
+  int64_t __end3 = 3;
+  for (int64_t __idx3 = __start3; __idx3 < __end3; __idx3++) {
+    double i_2 = ((double)__idx3);
+    RexValue __tmp4 = rex_format(rex_num(i_2));
+    RexValue d_1 = rex_add(rex_strval_3, __tmp4);
+    rex_drop(__tmp4);
+    RexValue r_2 = rex_ref(&d_1);
+    last_1 = rex_deref(r_2);
+    RexValue __tmp5 = rex_format(rex_num(i_2));
+    RexValue filler_1 = rex_add(rex_strval_4, __tmp5);
+    rex_drop(__tmp5);
+    rex_println(filler_1);
+    rex_drop(filler_1);
+  }
+  RexValue sep_1 = rex_strval_5;
+  RexValue __tmp6 = rex_fmt_join(rex_ref(&keep_1), rex_ref(&sep_1));
+  rex_println(__tmp6);
+  rex_drop(__tmp6);
+  rex_println(last_1);
+  rex_drop(sep_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_Sample_new(RexValue f_data, RexValue f_weight, RexValue f_count);
+static RexValue rex_Tagged_new(RexValue f_values, RexValue f_data);
+static RexValue rex_Keywords_new(RexValue f_int, RexValue f_char, RexValue f_static);
+static RexValue rex_user_main();
+static const char* rex_fields_Sample[] = {"data", "weight", "count"};
+typedef struct RexNative_Sample { double f_data; double f_weight; int64_t f_count; } RexNative_Sample;
+static const unsigned char rex_kinds_Sample[] = {REX_FIELD_NUM, REX_FIELD_NUM, REX_FIELD_INT};
+static const size_t rex_offsets_Sample[] = {offsetof(RexNative_Sample, f_data), offsetof(RexNative_Sample, f_weight), offsetof(RexNative_Sample, f_count)};
+static const RexStructLayout rex_layout_Sample = {"Sample", rex_fields_Sample, rex_kinds_Sample, rex_offsets_Sample, 3, sizeof(RexNative_Sample)};
+static RexValue rex_Sample_new(RexValue f_data, RexValue f_weight, RexValue f_count) {
+  RexNative_Sample __rex_native = {rex_unbox_num(f_data), rex_unbox_num(f_weight), rex_unbox_int(f_count)};
+  return rex_struct_new_native(&rex_layout_Sample, &__rex_native);
+}
+
+static const char* rex_fields_Tagged[] = {"values", "data"};
+static RexValue rex_Tagged_new(RexValue f_values, RexValue f_data) {
+  RexValue __rex_values[] = {f_values, f_data};
+  return rex_struct_new("Tagged", rex_fields_Tagged, __rex_values, 2);
+}
+
+static const char* rex_fields_Keywords[] = {"int", "char", "static"};
+typedef struct RexNative_Keywords { int64_t f_int; double f_char; int f_static; } RexNative_Keywords;
+static const unsigned char rex_kinds_Keywords[] = {REX_FIELD_INT, REX_FIELD_NUM, REX_FIELD_BOOL};
+static const size_t rex_offsets_Keywords[] = {offsetof(RexNative_Keywords, f_int), offsetof(RexNative_Keywords, f_char), offsetof(RexNative_Keywords, f_static)};
+static const RexStructLayout rex_layout_Keywords = {"Keywords", rex_fields_Keywords, rex_kinds_Keywords, rex_offsets_Keywords, 3, sizeof(RexNative_Keywords)};
+static RexValue rex_Keywords_new(RexValue f_int, RexValue f_char, RexValue f_static) {
+  RexNative_Keywords __rex_native = {rex_unbox_int(f_int), rex_unbox_num(f_char), rex_unbox_bool(f_static)};
+  return rex_struct_new_native(&rex_layout_Keywords, &__rex_native);
+}
+
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_1 = { { 1, 0, 0, REX_STR_STATIC }, "a" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_2 = { { 1, 0, 0, REX_STR_STATIC }, "b" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+
+
+static RexValue rex_user_main() {
+  RexValue s_1 = rex_Sample_new(rex_num(1.5), rex_num(2), rex_num(0));
+  ((RexNative_Sample*)rex_struct_data_mut(s_1, &rex_layout_Sample))->f_count = rex_int_add(((RexNative_Sample*)rex_struct_data(s_1, &rex_layout_Sample))->f_count, 1);
+  rex_println(rex_num((((RexNative_Sample*)rex_struct_data(s_1, &rex_layout_Sample))->f_data * ((RexNative_Sample*)rex_struct_data(s_1, &rex_layout_Sample))->f_weight)));
+  rex_println(rex_int(((RexNative_Sample*)rex_struct_data(s_1, &rex_layout_Sample))->f_count));
+  RexValue t_1 = rex_Tagged_new(rex_strval_1, rex_strval_2);
+  RexValue __tmp1 = rex_add(rex_struct_get_at(t_1, rex_fields_Tagged, 0), rex_struct_get_at(t_1, rex_fields_Tagged, 1));
+  rex_println(__tmp1);
+  rex_drop(__tmp1);
+  RexValue k_1 = rex_Keywords_new(rex_num(7), rex_num(0.5), rex_bool(1));
+  rex_println(rex_int(((RexNative_Keywords*)rex_struct_data(k_1, &rex_layout_Keywords))->f_int));
+  rex_println(rex_num(((RexNative_Keywords*)rex_struct_data(k_1, &rex_layout_Keywords))->f_char));
+  rex_println(rex_bool(((RexNative_Keywords*)rex_struct_data(k_1, &rex_layout_Keywords))->f_static));
+  rex_drop(k_1);
+  rex_drop(t_1);
+  rex_drop(s_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,256 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_handle(RexValue id);
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_1 = { { 4, 0, 0, REX_STR_STATIC }, "tag-" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_2 = { { 2, 0, 0, REX_STR_STATIC }, "id" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_3 = { { 4, 0, 0, REX_STR_STATIC }, "tags" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_4 = { { 14, 0, 0, REX_STR_STATIC }, "decode error: " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_5 = { { 14, 0, 0, REX_STR_STATIC }, "encode error: " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_6 = { { 7, 0, 0, REX_STR_STATIC }, "bytes: " };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_7 = { { 6, 0, 0, REX_STR_STATIC }, "seen: " };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[9]; } rex_strlit_8 = { { 8, 0, 0, REX_STR_STATIC }, " order: " };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_9 = { { 6, 0, 0, REX_STR_STATIC }, " ids: " };
+static const RexValue rex_strval_9 = REX_STR_LITERAL(rex_strlit_9.s);
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_10 = { { 6, 0, 0, REX_STR_STATIC }, "last: " };
+static const RexValue rex_strval_10 = REX_STR_LITERAL(rex_strlit_10.s);
+
+
+static RexValue rex_user_handle(RexValue id) {
+  RexValue tags_1 = rex_collections_vec_new();
+  int64_t __start1 = 0;
+  int64_t __end1 = 8;
+  for (int64_t __idx1 = __start1; __idx1 < __end1; __idx1++) {
+    double i_1 = ((double)__idx1);
+    RexValue __tmp2 = rex_format(rex_num((rex_unbox_num(id) + i_1)));
+    rex_collections_vec_push(rex_ref_mut(&tags_1), rex_add(rex_strval_1, __tmp2));
+    rex_drop(__tmp2);
+  }
+  RexValue payload_1 = rex_collections_map_new();
+  rex_collections_map_put(rex_ref_mut(&payload_1), rex_strval_2, id);
+  rex_collections_map_put(rex_ref_mut(&payload_1), rex_strval_3, tags_1);
+  double size_1 = 0.0;
+  {
+    RexValue __match1 = rex_json_encode(payload_1);
+    if (rex_tag_is(__match1, "Ok")) {
+      RexValue body_1 = rex_tag_value(__match1);
+      {
+        RexValue __match2 = rex_json_decode(rex_ref(&body_1));
+        if (rex_tag_is(__match2, "Ok")) {
+          RexValue v_1 = rex_tag_value(__match2);
+          size_1 = rex_unbox_num(rex_text_len_bytes(rex_ref(&body_1)));
+        }
+        else if (rex_tag_is(__match2, "Err")) {
+          RexValue e_1 = rex_tag_value(__match2);
+          rex_println(rex_add(rex_strval_4, e_1));
+        }
+        else {
+          rex_panic("non-exhaustive match");
+        }
+      }
+    }
+    else if (rex_tag_is(__match1, "Err")) {
+      RexValue e_2 = rex_tag_value(__match1);
+      rex_println(rex_add(rex_strval_5, e_2));
+    }
+    else {
+      rex_panic("non-exhaustive match");
+    }
+  }
+  return rex_num(size_1);
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  RexValue arena_1 = rex_mem_arena_new();
+  double bytes_1 = 0.0;
+  int64_t __start3 = 0;
+  int64_t __end3 = 50000;
+  for (int64_t __idx3 = __start3; __idx3 < __end3; __idx3++) {
+    double id_1 = ((double)__idx3);
+    {
+      RexValue __arena4 = arena_1;
+      rex_mem_arena_enter(__arena4);
+      bytes_1 = (bytes_1 + rex_unbox_num(rex_user_handle(rex_num(id_1))));
+      rex_mem_arena_leave(__arena4);
+    }
+    rex_mem_arena_reset(rex_ref_mut(&arena_1));
+  }
+  RexValue __tmp5 = rex_format(rex_num(bytes_1));
+  RexValue __tmp6 = rex_add(rex_strval_6, __tmp5);
+  rex_println(__tmp6);
+  rex_drop(__tmp5);
+  rex_drop(__tmp6);
+  RexValue seen_1 = rex_collections_map_new();
+  RexValue order_1 = rex_collections_vec_new_typed(REX_VEC_I64);
+  RexValue ids_1 = rex_collections_set_new();
+  int64_t __start7 = 0;
+  int64_t __end7 = 20;
+  for (int64_t __idx7 = __start7; __idx7 < __end7; __idx7++) {
+    double round_1 = ((double)__idx7);
+    {
+      RexValue __arena8 = arena_1;
+      rex_mem_arena_enter(__arena8);
+      int64_t __start9 = 0;
+      int64_t __end9 = 500;
+      for (int64_t __idx9 = __start9; __idx9 < __end9; __idx9++) {
+        double i_2 = ((double)__idx9);
+        double id_2 = ((round_1 * 500.0) + i_2);
+        rex_collections_map_put(rex_ref_mut(&seen_1), rex_num(id_2), rex_user_handle(rex_num(id_2)));
+        rex_collections_vec_push_f64(rex_ref_mut(&order_1), id_2);
+        rex_collections_set_add(rex_ref_mut(&ids_1), rex_num(id_2));
+      }
+      rex_mem_arena_leave(__arena8);
+    }
+    rex_mem_arena_reset(rex_ref_mut(&arena_1));
+  }
+  rex_collections_map_put(rex_ref_mut(&seen_1), rex_num((-1.0)), rex_num(0));
+  RexValue __tmp10 = rex_format(rex_collections_map_len(rex_ref(&seen_1)));
+  RexValue __tmp11 = rex_add(rex_strval_7, __tmp10);
+  RexValue __tmp12 = rex_add(__tmp11, rex_strval_8);
+  RexValue __tmp13 = rex_format(rex_collections_vec_len(rex_ref(&order_1)));
+  RexValue __tmp14 = rex_add(__tmp12, __tmp13);
+  RexValue __tmp15 = rex_add(__tmp14, rex_strval_9);
+  RexValue __tmp16 = rex_format(rex_collections_set_len(rex_ref(&ids_1)));
+  RexValue __tmp17 = rex_add(__tmp15, __tmp16);
+  rex_println(__tmp17);
+  rex_drop(__tmp10);
+  rex_drop(__tmp11);
+  rex_drop(__tmp12);
+  rex_drop(__tmp13);
+  rex_drop(__tmp14);
+  rex_drop(__tmp15);
+  rex_drop(__tmp16);
+  rex_drop(__tmp17);
+  RexValue __tmp18 = rex_format(rex_collections_map_get(rex_ref(&seen_1), rex_num(9999)));
+  RexValue __tmp19 = rex_add(rex_strval_10, __tmp18);
+  rex_println(__tmp19);
+  rex_drop(__tmp18);
+  rex_drop(__tmp19);
+  rex_drop(ids_1);
+  rex_drop(order_1);
+  rex_drop(seen_1);
+  rex_drop(arena_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,267 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[14]; } rex_strlit_1 = { { 13, 0, 0, REX_STR_STATIC }, "manual copy: " };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_2 = { { 4, 0, 0, REX_STR_STATIC }, " in " };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_3 = { { 2, 0, 0, REX_STR_STATIC }, "ms" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[14]; } rex_strlit_4 = { { 13, 0, 0, REX_STR_STATIC }, "2000 clones: " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[14]; } rex_strlit_5 = { { 13, 0, 0, REX_STR_STATIC }, "first write: " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_6 = { { 4, 0, 0, REX_STR_STATIC }, " vs " };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[17]; } rex_strlit_7 = { { 16, 0, 0, REX_STR_STATIC }, "after rollback: " };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_8 = { { 1, 0, 0, REX_STR_STATIC }, " " };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+
+
+static RexValue rex_user_main() {
+  double count_1 = 1000000.0;
+  RexValue v_1 = rex_collections_vec_new_typed(REX_VEC_I64);
+  RexValue m_1 = rex_collections_map_new();
+  int64_t __start1 = 0;
+  double __end1_num = count_1;
+  int64_t __end1 = rex_range_end(__end1_num, 1);
+  for (int64_t __idx1 = __start1; __idx1 < __end1; __idx1++) {
+    double i_1 = ((double)__idx1);
+    rex_collections_vec_push_f64(rex_ref_mut(&v_1), i_1);
+    rex_collections_map_put(rex_ref_mut(&m_1), rex_num(i_1), rex_num((i_1 * 2.0)));
+  }
+  double start_1 = rex_unbox_num(rex_now_ms());
+  RexValue copied_1 = rex_collections_vec_new_typed(REX_VEC_I64);
+  RexValue __iter2 = rex_ref(&v_1);
+  RexVecView __view2 = rex_collections_vec_view(__iter2);
+  for (int64_t __idx2 = 0; __idx2 < __view2.count; __idx2++) {
+    rex_vec_view_check(&__view2);
+    int64_t x_1 = rex_vec_view_i64(&__view2, __idx2);
+    rex_collections_vec_push_i64(rex_ref_mut(&copied_1), x_1);
+  }
+  double copy_end_1 = rex_unbox_num(rex_now_ms());
+  double snapshots_1 = 0.0;
+  int64_t __start3 = 0;
+  int64_t __end3 = 1000;
+  for (int64_t __idx3 = __start3; __idx3 < __end3; __idx3++) {
+    double i_2 = ((double)__idx3);
+    RexValue snap_1 = rex_collections_vec_clone(rex_ref(&v_1));
+    RexValue keys_1 = rex_collections_map_clone(rex_ref(&m_1));
+    snapshots_1 = ((snapshots_1 + (rex_unbox_num(rex_collections_vec_len(rex_ref(&snap_1))) / count_1)) + (rex_unbox_num(rex_collections_map_len(rex_ref(&keys_1))) / count_1));
+    rex_drop(snap_1);
+    rex_drop(keys_1);
+  }
+  double clone_end_1 = rex_unbox_num(rex_now_ms());
+  RexValue edited_1 = rex_collections_vec_clone(rex_ref(&v_1));
+  rex_collections_vec_set_f64(rex_ref_mut(&edited_1), 0, (-1.0));
+  double write_end_1 = rex_unbox_num(rex_now_ms());
+  RexBondAction* __rex_bond_actions_1 = NULL;
+  int __rex_bond_count_1 = 0;
+  int __rex_bond_cap_1 = 0; int __bond_snap_5 = 0; int __bond_snap_6 = 0;
+  RexValue batch_1 = rex_num(0);
+  int64_t __start4 = 0;
+  int64_t __end4 = 1000;
+  for (int64_t __idx4 = __start4; __idx4 < __end4; __idx4++) {
+    double i_3 = ((double)__idx4);
+    if (!__bond_snap_5) { __bond_snap_5 = 1; __rex_bond_push_snapshot(&__rex_bond_actions_1, &__rex_bond_count_1, &__rex_bond_cap_1, v_1); }
+    rex_collections_vec_push_f64(rex_ref_mut(&v_1), i_3);
+    if (!__bond_snap_6) { __bond_snap_6 = 1; __rex_bond_push_snapshot(&__rex_bond_actions_1, &__rex_bond_count_1, &__rex_bond_cap_1, m_1); }
+    rex_collections_map_put(rex_ref_mut(&m_1), rex_num((count_1 + i_3)), rex_num(i_3));
+  }
+  if (!__bond_snap_6) { __bond_snap_6 = 1; __rex_bond_push_snapshot(&__rex_bond_actions_1, &__rex_bond_count_1, &__rex_bond_cap_1, m_1); }
+  rex_collections_map_remove(rex_ref_mut(&m_1), rex_num(0));
+  double rollback_start_1 = rex_unbox_num(rex_now_ms());
+  __rex_bond_apply_rollback(__rex_bond_actions_1, __rex_bond_count_1);
+  __rex_bond_reset(&__rex_bond_actions_1, &__rex_bond_count_1, &__rex_bond_cap_1);
+  batch_1 = rex_nil();
+  double rollback_end_1 = rex_unbox_num(rex_now_ms());
+  RexValue __tmp7 = rex_format(rex_collections_vec_len(rex_ref(&copied_1)));
+  RexValue __tmp8 = rex_add(rex_strval_1, __tmp7);
+  RexValue __tmp9 = rex_add(__tmp8, rex_strval_2);
+  RexValue __tmp10 = rex_format(rex_num((copy_end_1 - start_1)));
+  RexValue __tmp11 = rex_add(__tmp9, __tmp10);
+  RexValue __tmp12 = rex_add(__tmp11, rex_strval_3);
+  rex_println(__tmp12);
+  rex_drop(__tmp7);
+  rex_drop(__tmp8);
+  rex_drop(__tmp9);
+  rex_drop(__tmp10);
+  rex_drop(__tmp11);
+  rex_drop(__tmp12);
+  RexValue __tmp13 = rex_format(rex_num(snapshots_1));
+  RexValue __tmp14 = rex_add(rex_strval_4, __tmp13);
+  RexValue __tmp15 = rex_add(__tmp14, rex_strval_2);
+  RexValue __tmp16 = rex_format(rex_num((clone_end_1 - copy_end_1)));
+  RexValue __tmp17 = rex_add(__tmp15, __tmp16);
+  RexValue __tmp18 = rex_add(__tmp17, rex_strval_3);
+  rex_println(__tmp18);
+  rex_drop(__tmp13);
+  rex_drop(__tmp14);
+  rex_drop(__tmp15);
+  rex_drop(__tmp16);
+  rex_drop(__tmp17);
+  rex_drop(__tmp18);
+  RexValue __tmp19 = rex_format(rex_collections_vec_get_at(rex_ref(&edited_1), 0));
+  RexValue __tmp20 = rex_add(rex_strval_5, __tmp19);
+  RexValue __tmp21 = rex_add(__tmp20, rex_strval_6);
+  RexValue __tmp22 = rex_format(rex_collections_vec_get_at(rex_ref(&v_1), 0));
+  RexValue __tmp23 = rex_add(__tmp21, __tmp22);
+  RexValue __tmp24 = rex_add(__tmp23, rex_strval_2);
+  RexValue __tmp25 = rex_format(rex_num((write_end_1 - clone_end_1)));
+  RexValue __tmp26 = rex_add(__tmp24, __tmp25);
+  RexValue __tmp27 = rex_add(__tmp26, rex_strval_3);
+  rex_println(__tmp27);
+  rex_drop(__tmp19);
+  rex_drop(__tmp20);
+  rex_drop(__tmp21);
+  rex_drop(__tmp22);
+  rex_drop(__tmp23);
+  rex_drop(__tmp24);
+  rex_drop(__tmp25);
+  rex_drop(__tmp26);
+  rex_drop(__tmp27);
+  RexValue __tmp28 = rex_format(rex_collections_vec_len(rex_ref(&v_1)));
+  RexValue __tmp29 = rex_add(rex_strval_7, __tmp28);
+  RexValue __tmp30 = rex_add(__tmp29, rex_strval_8);
+  RexValue __tmp31 = rex_format(rex_collections_map_len(rex_ref(&m_1)));
+  RexValue __tmp32 = rex_add(__tmp30, __tmp31);
+  RexValue __tmp33 = rex_add(__tmp32, rex_strval_8);
+  RexValue __tmp34 = rex_format(rex_collections_map_has(rex_ref(&m_1), rex_num(0)));
+  RexValue __tmp35 = rex_add(__tmp33, __tmp34);
+  RexValue __tmp36 = rex_add(__tmp35, rex_strval_2);
+  RexValue __tmp37 = rex_format(rex_num((rollback_end_1 - rollback_start_1)));
+  RexValue __tmp38 = rex_add(__tmp36, __tmp37);
+  RexValue __tmp39 = rex_add(__tmp38, rex_strval_3);
+  rex_println(__tmp39);
+  rex_drop(__tmp28);
+  rex_drop(__tmp29);
+  rex_drop(__tmp30);
+  rex_drop(__tmp31);
+  rex_drop(__tmp32);
+  rex_drop(__tmp33);
+  rex_drop(__tmp34);
+  rex_drop(__tmp35);
+  rex_drop(__tmp36);
+  rex_drop(__tmp37);
+  rex_drop(__tmp38);
+  rex_drop(__tmp39);
+  rex_drop(edited_1);
+  rex_drop(copied_1);
+  rex_drop(m_1);
+  rex_drop(v_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,541 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_Pipe_new(RexValue f_x, RexValue f_gap_y, RexValue f_passed);
+static RexValue rex_user_rects_overlap(RexValue ax, RexValue ay, RexValue aw, RexValue ah, RexValue bx, RexValue by, RexValue bw, RexValue bh);
+static RexValue rex_user_clamp(RexValue v, RexValue lo, RexValue hi);
+static RexValue rex_user_main();
+static const char* rex_fields_Pipe[] = {"x", "gap_y", "passed"};
+typedef struct RexNative_Pipe { double f_x; double f_gap_y; int f_passed; } RexNative_Pipe;
+static const unsigned char rex_kinds_Pipe[] = {REX_FIELD_NUM, REX_FIELD_NUM, REX_FIELD_BOOL};
+static const size_t rex_offsets_Pipe[] = {offsetof(RexNative_Pipe, f_x), offsetof(RexNative_Pipe, f_gap_y), offsetof(RexNative_Pipe, f_passed)};
+static const RexStructLayout rex_layout_Pipe = {"Pipe", rex_fields_Pipe, rex_kinds_Pipe, rex_offsets_Pipe, 3, sizeof(RexNative_Pipe)};
+static RexValue rex_Pipe_new(RexValue f_x, RexValue f_gap_y, RexValue f_passed) {
+  RexNative_Pipe __rex_native = {rex_unbox_num(f_x), rex_unbox_num(f_gap_y), rex_unbox_bool(f_passed)};
+  return rex_struct_new_native(&rex_layout_Pipe, &__rex_native);
+}
+
+static const struct { RexStrHeader h; char s[16]; } rex_strlit_1 = { { 15, 0, 0, REX_STR_STATIC }, "Rex Flappy Bird" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[43]; } rex_strlit_2 = { { 42, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/background-day.png" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[45]; } rex_strlit_3 = { { 44, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/background-night.png" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[33]; } rex_strlit_4 = { { 32, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/base.png" };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[44]; } rex_strlit_5 = { { 43, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/bluebird-upflap.png" };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[45]; } rex_strlit_6 = { { 44, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/bluebird-midflap.png" };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[46]; } rex_strlit_7 = { { 45, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/bluebird-downflap.png" };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[37]; } rex_strlit_8 = { { 36, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/pipe-red.png" };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+static const struct { RexStrHeader h; char s[30]; } rex_strlit_9 = { { 29, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/0.png" };
+static const RexValue rex_strval_9 = REX_STR_LITERAL(rex_strlit_9.s);
+static const struct { RexStrHeader h; char s[30]; } rex_strlit_10 = { { 29, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/1.png" };
+static const RexValue rex_strval_10 = REX_STR_LITERAL(rex_strlit_10.s);
+static const struct { RexStrHeader h; char s[30]; } rex_strlit_11 = { { 29, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/2.png" };
+static const RexValue rex_strval_11 = REX_STR_LITERAL(rex_strlit_11.s);
+static const struct { RexStrHeader h; char s[30]; } rex_strlit_12 = { { 29, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/3.png" };
+static const RexValue rex_strval_12 = REX_STR_LITERAL(rex_strlit_12.s);
+static const struct { RexStrHeader h; char s[30]; } rex_strlit_13 = { { 29, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/4.png" };
+static const RexValue rex_strval_13 = REX_STR_LITERAL(rex_strlit_13.s);
+static const struct { RexStrHeader h; char s[30]; } rex_strlit_14 = { { 29, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/5.png" };
+static const RexValue rex_strval_14 = REX_STR_LITERAL(rex_strlit_14.s);
+static const struct { RexStrHeader h; char s[30]; } rex_strlit_15 = { { 29, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/6.png" };
+static const RexValue rex_strval_15 = REX_STR_LITERAL(rex_strlit_15.s);
+static const struct { RexStrHeader h; char s[30]; } rex_strlit_16 = { { 29, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/7.png" };
+static const RexValue rex_strval_16 = REX_STR_LITERAL(rex_strlit_16.s);
+static const struct { RexStrHeader h; char s[30]; } rex_strlit_17 = { { 29, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/8.png" };
+static const RexValue rex_strval_17 = REX_STR_LITERAL(rex_strlit_17.s);
+static const struct { RexStrHeader h; char s[30]; } rex_strlit_18 = { { 29, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/ic/9.png" };
+static const RexValue rex_strval_18 = REX_STR_LITERAL(rex_strlit_18.s);
+static const struct { RexStrHeader h; char s[40]; } rex_strlit_19 = { { 39, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/sound/sfx_wing.wav" };
+static const RexValue rex_strval_19 = REX_STR_LITERAL(rex_strlit_19.s);
+static const struct { RexStrHeader h; char s[39]; } rex_strlit_20 = { { 38, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/sound/sfx_hit.wav" };
+static const RexValue rex_strval_20 = REX_STR_LITERAL(rex_strlit_20.s);
+static const struct { RexStrHeader h; char s[39]; } rex_strlit_21 = { { 38, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/sound/sfx_die.wav" };
+static const RexValue rex_strval_21 = REX_STR_LITERAL(rex_strlit_21.s);
+static const struct { RexStrHeader h; char s[41]; } rex_strlit_22 = { { 40, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/sound/sfx_point.wav" };
+static const RexValue rex_strval_22 = REX_STR_LITERAL(rex_strlit_22.s);
+static const struct { RexStrHeader h; char s[45]; } rex_strlit_23 = { { 44, 0, 0, REX_STR_STATIC }, "examples/flappy-bird/sound/sfx_swooshing.wav" };
+static const RexValue rex_strval_23 = REX_STR_LITERAL(rex_strlit_23.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_24 = { { 7, 0, 0, REX_STR_STATIC }, "#4ec0ca" };
+static const RexValue rex_strval_24 = REX_STR_LITERAL(rex_strlit_24.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_25 = { { 11, 0, 0, REX_STR_STATIC }, "Press Space" };
+static const RexValue rex_strval_25 = REX_STR_LITERAL(rex_strlit_25.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_26 = { { 7, 0, 0, REX_STR_STATIC }, "#ffffff" };
+static const RexValue rex_strval_26 = REX_STR_LITERAL(rex_strlit_26.s);
+static const struct { RexStrHeader h; char s[10]; } rex_strlit_27 = { { 9, 0, 0, REX_STR_STATIC }, "Game Over" };
+static const RexValue rex_strval_27 = REX_STR_LITERAL(rex_strlit_27.s);
+static const struct { RexStrHeader h; char s[17]; } rex_strlit_28 = { { 16, 0, 0, REX_STR_STATIC }, "Space to restart" };
+static const RexValue rex_strval_28 = REX_STR_LITERAL(rex_strlit_28.s);
+
+
+static RexValue rex_user_rects_overlap(RexValue ax, RexValue ay, RexValue aw, RexValue ah, RexValue bx, RexValue by, RexValue bw, RexValue bh) {
+  return rex_bool(((((rex_unbox_num(ax) < (rex_unbox_num(bx) + rex_unbox_num(bw))) && ((rex_unbox_num(ax) + rex_unbox_num(aw)) > rex_unbox_num(bx))) && (rex_unbox_num(ay) < (rex_unbox_num(by) + rex_unbox_num(bh)))) && ((rex_unbox_num(ay) + rex_unbox_num(ah)) > rex_unbox_num(by))));
+  return rex_nil();
+}
+
+static RexValue rex_user_clamp(RexValue v, RexValue lo, RexValue hi) {
+  if ((rex_unbox_num(v) < rex_unbox_num(lo))) {
+    return lo;
+  }
+  if ((rex_unbox_num(v) > rex_unbox_num(hi))) {
+    return hi;
+  }
+  return v;
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  rex_random_seed(rex_now_ms());
+  RexValue title_1 = rex_strval_1;
+  int64_t win_w_1 = rex_wrap_i32(288);
+  int64_t win_h_1 = rex_wrap_i32(512);
+  RexValue bg_day_1 = rex_ui_image_load(rex_strval_2);
+  RexValue bg_night_1 = rex_ui_image_load(rex_strval_3);
+  RexValue base_img_1 = rex_ui_image_load(rex_strval_4);
+  RexValue bird_up_1 = rex_ui_image_load(rex_strval_5);
+  RexValue bird_mid_1 = rex_ui_image_load(rex_strval_6);
+  RexValue bird_down_1 = rex_ui_image_load(rex_strval_7);
+  RexValue pipe_img_1 = rex_ui_image_load(rex_strval_8);
+  RexValue digits_1 = rex_collections_vec_from(10, (RexValue[]){rex_ui_image_load(rex_strval_9), rex_ui_image_load(rex_strval_10), rex_ui_image_load(rex_strval_11), rex_ui_image_load(rex_strval_12), rex_ui_image_load(rex_strval_13), rex_ui_image_load(rex_strval_14), rex_ui_image_load(rex_strval_15), rex_ui_image_load(rex_strval_16), rex_ui_image_load(rex_strval_17), rex_ui_image_load(rex_strval_18)});
+  RexValue sfx_wing_1 = rex_strval_19;
+  RexValue sfx_hit_1 = rex_strval_20;
+  RexValue sfx_die_1 = rex_strval_21;
+  RexValue sfx_point_1 = rex_strval_22;
+  RexValue sfx_swoosh_1 = rex_strval_23;
+  double base_w_1 = rex_unbox_num(rex_ui_image_w(rex_ref(&base_img_1)));
+  double base_h_1 = rex_unbox_num(rex_ui_image_h(rex_ref(&base_img_1)));
+  double bird_w_1 = rex_unbox_num(rex_ui_image_w(rex_ref(&bird_mid_1)));
+  double bird_h_1 = rex_unbox_num(rex_ui_image_h(rex_ref(&bird_mid_1)));
+  double pipe_w_1 = rex_unbox_num(rex_ui_image_w(rex_ref(&pipe_img_1)));
+  double pipe_h_1 = rex_unbox_num(rex_ui_image_h(rex_ref(&pipe_img_1)));
+  double ground_y_1 = (((double)win_h_1) - base_h_1);
+  double gravity_1 = 0.35;
+  double flap_vy_1 = (-5.8);
+  double max_fall_1 = 8.5;
+  double pipe_speed_1 = 2.0;
+  double pipe_gap_1 = 100.0;
+  double pipe_spacing_1 = 160.0;
+  double pipe_count_1 = 3.0;
+  double tilt_up_1 = 25.0;
+  double tilt_down_1 = (-90.0);
+  double tilt_scale_1 = 10.0;
+  double gap_min_1 = 60.0;
+  double gap_max_1 = rex_unbox_num(rex_user_clamp(rex_num(((ground_y_1 - pipe_gap_1) - 60.0)), rex_num(80), rex_num((ground_y_1 - pipe_gap_1))));
+  int64_t state_1 = rex_wrap_i32(0);
+  double score_1 = 0.0;
+  double best_1 = 0.0;
+  int played_die_1 = 0;
+  double bird_x_1 = (((double)win_w_1) * 0.32);
+  double bird_y_1 = (((double)win_h_1) * 0.4);
+  double bird_vy_1 = 0.0;
+  double bird_rot_1 = 0.0;
+  double anim_timer_1 = 0.0;
+  int64_t anim_frame_1 = rex_wrap_i32(0);
+  double idle_offset_1 = 0.0;
+  double idle_dir_1 = 1.0;
+  double ground_x_1 = 0.0;
+  double spawn_x_1 = ((double)rex_wrap_i32(rex_int_add(win_w_1, 120)));
+  RexValue pipes_1 = rex_collections_vec_new();
+  int flap_queued_1 = 0;
+  double last_1 = rex_unbox_num(rex_now_ms());
+  double acc_1 = 0.0;
+  while (rex_is_truthy(rex_ui_begin(rex_ref(&title_1), rex_int(win_w_1), rex_int(win_h_1)))) {
+    rex_ui_redraw();
+    double now_1 = rex_unbox_num(rex_now_ms());
+    double dt_1 = (now_1 - last_1);
+    if ((dt_1 < 0.0)) {
+      dt_1 = 0.0;
+    }
+    if ((dt_1 > 80.0)) {
+      dt_1 = 80.0;
+    }
+    last_1 = now_1;
+    acc_1 = (acc_1 + dt_1);
+    if ((rex_is_truthy(rex_ui_key_space()) || rex_is_truthy(rex_ui_mouse_pressed()))) {
+      flap_queued_1 = 1;
+    }
+    while ((acc_1 >= 16.0)) {
+      acc_1 = (acc_1 - 16.0);
+      if ((state_1 != 2)) {
+        anim_timer_1 = (anim_timer_1 + 16.0);
+        if ((anim_timer_1 >= 90.0)) {
+          anim_timer_1 = 0.0;
+          anim_frame_1 = rex_wrap_i32(rex_int_mod(rex_wrap_i32(rex_int_add(anim_frame_1, 1)), 3));
+        }
+      }
+      if ((state_1 == 0)) {
+        idle_offset_1 = (idle_offset_1 + (idle_dir_1 * 0.25));
+        if ((idle_offset_1 > 6.0)) {
+          idle_offset_1 = 6.0;
+          idle_dir_1 = (-1.0);
+        }
+        if ((idle_offset_1 < (-6.0))) {
+          idle_offset_1 = (-6.0);
+          idle_dir_1 = 1.0;
+        }
+        bird_y_1 = ((((double)win_h_1) * 0.4) + idle_offset_1);
+        bird_vy_1 = 0.0;
+        bird_rot_1 = 0.0;
+        if (flap_queued_1) {
+          state_1 = rex_wrap_i32(1);
+          score_1 = 0.0;
+          bird_x_1 = (((double)win_w_1) * 0.32);
+          bird_y_1 = (((double)win_h_1) * 0.4);
+          bird_vy_1 = flap_vy_1;
+          bird_rot_1 = tilt_up_1;
+          anim_frame_1 = rex_wrap_i32(0);
+          anim_timer_1 = 0.0;
+          idle_offset_1 = 0.0;
+          ground_x_1 = 0.0;
+          pipes_1 = rex_collections_vec_new();
+          spawn_x_1 = ((double)rex_wrap_i32(rex_int_add(win_w_1, 120)));
+          double i_1 = 0.0;
+          while ((i_1 < pipe_count_1)) {
+            double gap_1 = rex_unbox_num(rex_random_int(rex_num(gap_min_1), rex_num(gap_max_1)));
+            rex_collections_vec_push(rex_ref_mut(&pipes_1), rex_Pipe_new(rex_num(spawn_x_1), rex_num(gap_1), rex_bool(0)));
+            spawn_x_1 = (spawn_x_1 + pipe_spacing_1);
+            i_1 = (i_1 + 1.0);
+          }
+          rex_audio_play(rex_ref(&sfx_swoosh_1));
+          played_die_1 = 0;
+          flap_queued_1 = 0;
+        }
+      } else {
+        if ((state_1 == 1)) {
+          if (flap_queued_1) {
+            bird_vy_1 = flap_vy_1;
+            bird_rot_1 = tilt_up_1;
+            rex_audio_play(rex_ref(&sfx_wing_1));
+            flap_queued_1 = 0;
+          }
+          bird_vy_1 = (bird_vy_1 + gravity_1);
+          if ((bird_vy_1 > max_fall_1)) {
+            bird_vy_1 = max_fall_1;
+          }
+          bird_y_1 = (bird_y_1 + bird_vy_1);
+          bird_rot_1 = rex_unbox_num(rex_user_clamp(rex_num(((-bird_vy_1) * tilt_scale_1)), rex_num(tilt_down_1), rex_num(tilt_up_1)));
+          ground_x_1 = (ground_x_1 - pipe_speed_1);
+          if ((ground_x_1 <= (-base_w_1))) {
+            ground_x_1 = (ground_x_1 + base_w_1);
+          }
+          RexValue next_pipes_1 = rex_collections_vec_new();
+          double n_1 = rex_unbox_num(rex_collections_vec_len(rex_ref(&pipes_1)));
+          double i_2 = 0.0;
+          while ((i_2 < n_1)) {
+            RexValue p_1 = rex_collections_vec_get(rex_ref(&pipes_1), rex_num(i_2));
+            double nx_1 = (((RexNative_Pipe*)rex_struct_data(p_1, &rex_layout_Pipe))->f_x - pipe_speed_1);
+            if (((nx_1 + pipe_w_1) <= 0.0)) {
+              double gap_2 = rex_unbox_num(rex_random_int(rex_num(gap_min_1), rex_num(gap_max_1)));
+              rex_collections_vec_push(rex_ref_mut(&next_pipes_1), rex_Pipe_new(rex_num(spawn_x_1), rex_num(gap_2), rex_bool(0)));
+              spawn_x_1 = (spawn_x_1 + pipe_spacing_1);
+            } else {
+              int passed_1 = ((RexNative_Pipe*)rex_struct_data(p_1, &rex_layout_Pipe))->f_passed;
+              if (((!passed_1) && ((nx_1 + pipe_w_1) < bird_x_1))) {
+                passed_1 = 1;
+                score_1 = (score_1 + 1.0);
+                rex_audio_play(rex_ref(&sfx_point_1));
+              }
+              rex_collections_vec_push(rex_ref_mut(&next_pipes_1), rex_Pipe_new(rex_num(nx_1), rex_num(((RexNative_Pipe*)rex_struct_data(p_1, &rex_layout_Pipe))->f_gap_y), rex_bool(passed_1)));
+            }
+            i_2 = (i_2 + 1.0);
+          }
+          pipes_1 = next_pipes_1;
+          int hit_ground_1 = 0;
+          int hit_pipe_1 = 0;
+          if (((bird_y_1 < 0.0) || ((bird_y_1 + bird_h_1) >= ground_y_1))) {
+            hit_ground_1 = 1;
+          }
+          double pn_1 = rex_unbox_num(rex_collections_vec_len(rex_ref(&pipes_1)));
+          double pi_1 = 0.0;
+          while ((pi_1 < pn_1)) {
+            RexValue p_2 = rex_collections_vec_get(rex_ref(&pipes_1), rex_num(pi_1));
+            double top_x_1 = ((RexNative_Pipe*)rex_struct_data(p_2, &rex_layout_Pipe))->f_x;
+            double top_y_1 = (((RexNative_Pipe*)rex_struct_data(p_2, &rex_layout_Pipe))->f_gap_y - pipe_h_1);
+            double bot_x_1 = ((RexNative_Pipe*)rex_struct_data(p_2, &rex_layout_Pipe))->f_x;
+            double bot_y_1 = (((RexNative_Pipe*)rex_struct_data(p_2, &rex_layout_Pipe))->f_gap_y + pipe_gap_1);
+            if (rex_is_truthy(rex_user_rects_overlap(rex_num(bird_x_1), rex_num(bird_y_1), rex_num(bird_w_1), rex_num(bird_h_1), rex_num(top_x_1), rex_num(top_y_1), rex_num(pipe_w_1), rex_num(pipe_h_1)))) {
+              hit_pipe_1 = 1;
+            }
+            if (rex_is_truthy(rex_user_rects_overlap(rex_num(bird_x_1), rex_num(bird_y_1), rex_num(bird_w_1), rex_num(bird_h_1), rex_num(bot_x_1), rex_num(bot_y_1), rex_num(pipe_w_1), rex_num(pipe_h_1)))) {
+              hit_pipe_1 = 1;
+            }
+            pi_1 = (pi_1 + 1.0);
+          }
+          if ((hit_pipe_1 || hit_ground_1)) {
+            state_1 = rex_wrap_i32(2);
+            if ((score_1 > best_1)) {
+              best_1 = score_1;
+            }
+            anim_frame_1 = rex_wrap_i32(1);
+            anim_timer_1 = 0.0;
+            if (hit_pipe_1) {
+              rex_audio_play(rex_ref(&sfx_hit_1));
+            }
+            if (hit_ground_1) {
+              rex_audio_play(rex_ref(&sfx_die_1));
+              played_die_1 = 1;
+            } else {
+              played_die_1 = 0;
+            }
+          }
+        } else {
+          if ((bird_y_1 < (ground_y_1 - bird_h_1))) {
+            bird_vy_1 = (bird_vy_1 + gravity_1);
+            if ((bird_vy_1 > max_fall_1)) {
+              bird_vy_1 = max_fall_1;
+            }
+            bird_y_1 = (bird_y_1 + bird_vy_1);
+          }
+          if ((bird_y_1 >= (ground_y_1 - bird_h_1))) {
+            bird_y_1 = (ground_y_1 - bird_h_1);
+            bird_vy_1 = 0.0;
+            bird_rot_1 = tilt_down_1;
+            if ((!played_die_1)) {
+              rex_audio_play(rex_ref(&sfx_die_1));
+              played_die_1 = 1;
+            }
+          } else {
+            bird_rot_1 = rex_unbox_num(rex_user_clamp(rex_num(((-bird_vy_1) * tilt_scale_1)), rex_num(tilt_down_1), rex_num(tilt_up_1)));
+          }
+          if (flap_queued_1) {
+            state_1 = rex_wrap_i32(1);
+            score_1 = 0.0;
+            bird_x_1 = (((double)win_w_1) * 0.32);
+            bird_y_1 = (((double)win_h_1) * 0.4);
+            bird_vy_1 = flap_vy_1;
+            bird_rot_1 = tilt_up_1;
+            anim_frame_1 = rex_wrap_i32(0);
+            anim_timer_1 = 0.0;
+            idle_offset_1 = 0.0;
+            ground_x_1 = 0.0;
+            pipes_1 = rex_collections_vec_new();
+            spawn_x_1 = ((double)rex_wrap_i32(rex_int_add(win_w_1, 120)));
+            double i_3 = 0.0;
+            while ((i_3 < pipe_count_1)) {
+              double gap_3 = rex_unbox_num(rex_random_int(rex_num(gap_min_1), rex_num(gap_max_1)));
+              rex_collections_vec_push(rex_ref_mut(&pipes_1), rex_Pipe_new(rex_num(spawn_x_1), rex_num(gap_3), rex_bool(0)));
+              spawn_x_1 = (spawn_x_1 + pipe_spacing_1);
+              i_3 = (i_3 + 1.0);
+            }
+            rex_audio_play(rex_ref(&sfx_swoosh_1));
+            played_die_1 = 0;
+            flap_queued_1 = 0;
+          }
+        }
+      }
+    }
+    rex_ui_clear(rex_strval_24);
+    int night_1 = ((score_1 >= 10.0) && (fmod(score_1, 20.0) >= 10.0));
+    if (night_1) {
+      rex_ui_image(rex_ref(&bg_night_1), rex_num(0), rex_num(0));
+    } else {
+      rex_ui_image(rex_ref(&bg_day_1), rex_num(0), rex_num(0));
+    }
+    double pn_2 = rex_unbox_num(rex_collections_vec_len(rex_ref(&pipes_1)));
+    double pi_2 = 0.0;
+    while ((pi_2 < pn_2)) {
+      RexValue p_3 = rex_collections_vec_get(rex_ref(&pipes_1), rex_num(pi_2));
+      double top_x_2 = ((RexNative_Pipe*)rex_struct_data(p_3, &rex_layout_Pipe))->f_x;
+      double top_y_2 = (((RexNative_Pipe*)rex_struct_data(p_3, &rex_layout_Pipe))->f_gap_y - pipe_h_1);
+      double bot_x_2 = ((RexNative_Pipe*)rex_struct_data(p_3, &rex_layout_Pipe))->f_x;
+      double bot_y_2 = (((RexNative_Pipe*)rex_struct_data(p_3, &rex_layout_Pipe))->f_gap_y + pipe_gap_1);
+      rex_ui_image_rot(rex_ref(&pipe_img_1), rex_num((top_x_2 + (pipe_w_1 / 2.0))), rex_num((top_y_2 + (pipe_h_1 / 2.0))), rex_num(180));
+      rex_ui_image(rex_ref(&pipe_img_1), rex_num(bot_x_2), rex_num(bot_y_2));
+      pi_2 = (pi_2 + 1.0);
+    }
+    double gx_1 = ground_x_1;
+    while ((gx_1 < ((double)win_w_1))) {
+      rex_ui_image(rex_ref(&base_img_1), rex_num(gx_1), rex_num(ground_y_1));
+      gx_1 = (gx_1 + base_w_1);
+    }
+    double bird_cx_1 = (bird_x_1 + (bird_w_1 / 2.0));
+    double bird_cy_1 = (bird_y_1 + (bird_h_1 / 2.0));
+    if ((anim_frame_1 == 0)) {
+      rex_ui_image_rot(rex_ref(&bird_up_1), rex_num(bird_cx_1), rex_num(bird_cy_1), rex_num(bird_rot_1));
+    } else {
+      if ((anim_frame_1 == 1)) {
+        rex_ui_image_rot(rex_ref(&bird_mid_1), rex_num(bird_cx_1), rex_num(bird_cy_1), rex_num(bird_rot_1));
+      } else {
+        rex_ui_image_rot(rex_ref(&bird_down_1), rex_num(bird_cx_1), rex_num(bird_cy_1), rex_num(bird_rot_1));
+      }
+    }
+    double digit_spacing_1 = 2.0;
+    double tmp_1 = score_1;
+    if ((tmp_1 < 0.0)) {
+      tmp_1 = 0.0;
+    }
+    RexValue digits_vec_1 = rex_collections_vec_new_typed(REX_VEC_F64);
+    if ((tmp_1 == 0.0)) {
+      rex_collections_vec_push_f64(rex_ref_mut(&digits_vec_1), 0.0);
+    } else {
+      while ((tmp_1 > 0.0)) {
+        double d_1 = fmod(tmp_1, 10.0);
+        rex_collections_vec_push_f64(rex_ref_mut(&digits_vec_1), d_1);
+        tmp_1 = ((tmp_1 - d_1) / 10.0);
+      }
+    }
+    double dn_1 = rex_unbox_num(rex_collections_vec_len(rex_ref(&digits_vec_1)));
+    double total_w_1 = 0.0;
+    double i_4 = (dn_1 - 1.0);
+    while ((i_4 >= 0.0)) {
+      double d_2 = rex_unbox_num(rex_collections_vec_get(rex_ref(&digits_vec_1), rex_num(i_4)));
+      RexValue img_1 = rex_collections_vec_get(rex_ref(&digits_1), rex_num(d_2));
+      total_w_1 = (total_w_1 + rex_unbox_num(rex_ui_image_w(rex_ref(&img_1))));
+      if ((i_4 > 0.0)) {
+        total_w_1 = (total_w_1 + digit_spacing_1);
+      }
+      if ((i_4 == 0.0)) {
+        break;
+      }
+      i_4 = (i_4 - 1.0);
+    }
+    double x_1 = ((((double)win_w_1) - total_w_1) / 2.0);
+    double y_1 = 20.0;
+    i_4 = (dn_1 - 1.0);
+    while ((i_4 >= 0.0)) {
+      double d_3 = rex_unbox_num(rex_collections_vec_get(rex_ref(&digits_vec_1), rex_num(i_4)));
+      RexValue img_2 = rex_collections_vec_get(rex_ref(&digits_1), rex_num(d_3));
+      rex_ui_image(rex_ref(&img_2), rex_num(x_1), rex_num(y_1));
+      x_1 = ((x_1 + rex_unbox_num(rex_ui_image_w(rex_ref(&img_2)))) + digit_spacing_1);
+      if ((i_4 == 0.0)) {
+        break;
+      }
+      i_4 = (i_4 - 1.0);
+    }
+    if ((state_1 == 0)) {
+      rex_ui_text(rex_int(rex_wrap_i32(rex_int_div(rex_wrap_i32(rex_int_sub(win_w_1, 130)), 2))), rex_int(rex_wrap_i32(rex_int_sub(rex_wrap_i32(rex_int_div(win_h_1, 2)), 20))), rex_strval_25, rex_strval_26);
+    } else {
+      if ((state_1 == 2)) {
+        rex_ui_text(rex_int(rex_wrap_i32(rex_int_div(rex_wrap_i32(rex_int_sub(win_w_1, 110)), 2))), rex_int(rex_wrap_i32(rex_int_sub(rex_wrap_i32(rex_int_div(win_h_1, 2)), 30))), rex_strval_27, rex_strval_26);
+        rex_ui_text(rex_int(rex_wrap_i32(rex_int_div(rex_wrap_i32(rex_int_sub(win_w_1, 170)), 2))), rex_int(rex_wrap_i32(rex_int_div(win_h_1, 2))), rex_strval_28, rex_strval_26);
+      }
+    }
+    rex_ui_end();
+    rex_drop(digits_vec_1);
+  }
+  rex_drop(sfx_swoosh_1);
+  rex_drop(sfx_point_1);
+  rex_drop(sfx_die_1);
+  rex_drop(sfx_hit_1);
+  rex_drop(sfx_wing_1);
+  rex_drop(digits_1);
+  rex_drop(title_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_test_commit();
+static RexValue rex_user_test_rollback();
+static RexValue rex_user_test_copy_types();
+static RexValue rex_user_test_sequential_bonds();
+static RexValue rex_user_test_conditional_bond();
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_1 = { { 14, 0, 0, REX_STR_STATIC }, "test_commit ok" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[17]; } rex_strlit_2 = { { 16, 0, 0, REX_STR_STATIC }, "test_rollback ok" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[19]; } rex_strlit_3 = { { 18, 0, 0, REX_STR_STATIC }, "test_copy_types ok" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[19]; } rex_strlit_4 = { { 18, 0, 0, REX_STR_STATIC }, "test_sequential ok" };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[20]; } rex_strlit_5 = { { 19, 0, 0, REX_STR_STATIC }, "test_conditional ok" };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[21]; } rex_strlit_6 = { { 20, 0, 0, REX_STR_STATIC }, "Rex Bonds Test Suite" };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[17]; } rex_strlit_7 = { { 16, 0, 0, REX_STR_STATIC }, "All tests passed" };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+
+
+static RexValue rex_user_test_commit() {
+  RexBondAction* __rex_bond_actions_1 = NULL;
+  int __rex_bond_count_1 = 0;
+  int __rex_bond_cap_1 = 0;
+  RexValue x_1 = rex_num(42);
+  __rex_bond_push_assign(&__rex_bond_actions_1, &__rex_bond_count_1, &__rex_bond_cap_1, &x_1, x_1);
+  x_1 = rex_num(100);
+  __rex_bond_push_assign(&__rex_bond_actions_1, &__rex_bond_count_1, &__rex_bond_cap_1, &x_1, x_1);
+  x_1 = rex_num(200);
+  __rex_bond_reset(&__rex_bond_actions_1, &__rex_bond_count_1, &__rex_bond_cap_1);
+  rex_println(rex_strval_1);
+  return rex_nil();
+}
+
+static RexValue rex_user_test_rollback() {
+  RexBondAction* __rex_bond_actions_2 = NULL;
+  int __rex_bond_count_2 = 0;
+  int __rex_bond_cap_2 = 0;
+  RexValue y_1 = rex_num(10);
+  __rex_bond_push_assign(&__rex_bond_actions_2, &__rex_bond_count_2, &__rex_bond_cap_2, &y_1, y_1);
+  y_1 = rex_num(20);
+  __rex_bond_apply_rollback(__rex_bond_actions_2, __rex_bond_count_2);
+  __rex_bond_reset(&__rex_bond_actions_2, &__rex_bond_count_2, &__rex_bond_cap_2);
+  y_1 = rex_nil();
+  rex_println(rex_strval_2);
+  return rex_nil();
+}
+
+static RexValue rex_user_test_copy_types() {
+  RexBondAction* __rex_bond_actions_3 = NULL;
+  int __rex_bond_count_3 = 0;
+  int __rex_bond_cap_3 = 0;
+  RexValue count_1 = rex_num(42);
+  __rex_bond_push_assign(&__rex_bond_actions_3, &__rex_bond_count_3, &__rex_bond_cap_3, &count_1, count_1);
+  count_1 = rex_num(100);
+  __rex_bond_push_assign(&__rex_bond_actions_3, &__rex_bond_count_3, &__rex_bond_cap_3, &count_1, count_1);
+  count_1 = rex_num(200);
+  __rex_bond_reset(&__rex_bond_actions_3, &__rex_bond_count_3, &__rex_bond_cap_3);
+  rex_println(rex_strval_3);
+  return rex_nil();
+}
+
+static RexValue rex_user_test_sequential_bonds() {
+  RexBondAction* __rex_bond_actions_4 = NULL;
+  int __rex_bond_count_4 = 0;
+  int __rex_bond_cap_4 = 0;
+  RexValue a_1 = rex_num(1);
+  __rex_bond_push_assign(&__rex_bond_actions_4, &__rex_bond_count_4, &__rex_bond_cap_4, &a_1, a_1);
+  a_1 = rex_num(2);
+  __rex_bond_reset(&__rex_bond_actions_4, &__rex_bond_count_4, &__rex_bond_cap_4);
+  RexBondAction* __rex_bond_actions_5 = NULL;
+  int __rex_bond_count_5 = 0;
+  int __rex_bond_cap_5 = 0;
+  RexValue b_1 = rex_num(10);
+  __rex_bond_push_assign(&__rex_bond_actions_5, &__rex_bond_count_5, &__rex_bond_cap_5, &b_1, b_1);
+  b_1 = rex_num(20);
+  __rex_bond_reset(&__rex_bond_actions_5, &__rex_bond_count_5, &__rex_bond_cap_5);
+  rex_println(rex_strval_4);
+  return rex_nil();
+}
+
+static RexValue rex_user_test_conditional_bond() {
+  RexBondAction* __rex_bond_actions_6 = NULL;
+  int __rex_bond_count_6 = 0;
+  int __rex_bond_cap_6 = 0;
+  RexValue val_1 = rex_num(0);
+  __rex_bond_push_assign(&__rex_bond_actions_6, &__rex_bond_count_6, &__rex_bond_cap_6, &val_1, val_1);
+  val_1 = rex_num(100);
+  __rex_bond_reset(&__rex_bond_actions_6, &__rex_bond_count_6, &__rex_bond_cap_6);
+  rex_println(rex_strval_5);
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  rex_println(rex_strval_6);
+  rex_user_test_commit();
+  rex_user_test_rollback();
+  rex_user_test_copy_types();
+  rex_user_test_sequential_bonds();
+  rex_user_test_conditional_bond();
+  rex_println(rex_strval_7);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
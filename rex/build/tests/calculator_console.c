@@ -0,0 +1,172 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[23]; } rex_strlit_1 = { { 22, 0, 0, REX_STR_STATIC }, "Rex Console Calculator" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[42]; } rex_strlit_2 = { { 41, 0, 0, REX_STR_STATIC }, "type expressions like: 2+2, 14 / 2, 3.5*8" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[21]; } rex_strlit_3 = { { 20, 0, 0, REX_STR_STATIC }, "press Ctrl+C to quit" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_4 = { { 4, 0, 0, REX_STR_STATIC }, "op> " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_5 = { { 2, 0, 0, REX_STR_STATIC }, "= " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_6 = { { 7, 0, 0, REX_STR_STATIC }, "error: " };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[4]; } rex_strlit_7 = { { 3, 0, 0, REX_STR_STATIC }, "bye" };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+
+
+static RexValue rex_user_main() {
+  rex_println(rex_strval_1);
+  rex_println(rex_strval_2);
+  rex_println(rex_strval_3);
+  while (1) {
+    rex_print(rex_strval_4);
+    {
+      RexValue __match1 = rex_io_read_line();
+      if (rex_tag_is(__match1, "Ok")) {
+        RexValue line_1 = rex_tag_value(__match1);
+        {
+          RexValue __match2 = rex_math_eval(rex_ref(&line_1));
+          if (rex_tag_is(__match2, "Ok")) {
+            RexValue value_1 = rex_tag_value(__match2);
+            rex_println(rex_add(rex_strval_5, rex_format(value_1)));
+          }
+          else if (rex_tag_is(__match2, "Err")) {
+            RexValue e_1 = rex_tag_value(__match2);
+            rex_println(rex_add(rex_strval_6, e_1));
+          }
+          else {
+            rex_panic("non-exhaustive match");
+          }
+        }
+      }
+      else if (rex_tag_is(__match1, "Err")) {
+        RexValue e_2 = rex_tag_value(__match1);
+        RexValue __tmp1 = rex_add(rex_strval_6, e_2);
+        rex_println(__tmp1);
+        rex_drop(__tmp1);
+        rex_println(rex_strval_7);
+        break;
+      }
+      else {
+        rex_panic("non-exhaustive match");
+      }
+    }
+  }
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_1 = { { 5, 0, 0, REX_STR_STATIC }, "pop: " };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[14]; } rex_strlit_2 = { { 13, 0, 0, REX_STR_STATIC }, "after clear: " };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_3 = { { 1, 0, 0, REX_STR_STATIC }, "a" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_4 = { { 7, 0, 0, REX_STR_STATIC }, "has a: " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_5 = { { 5, 0, 0, REX_STR_STATIC }, "key: " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_6 = { { 11, 0, 0, REX_STR_STATIC }, "removed a: " };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_7 = { { 1, 0, 0, REX_STR_STATIC }, "x" };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_8 = { { 11, 0, 0, REX_STR_STATIC }, "removed x: " };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+
+
+static RexValue rex_user_main() {
+  RexValue v_1 = rex_collections_vec_from_typed(REX_VEC_F64, 4, (RexValue[]){rex_num(10), rex_num(20), rex_num(30), rex_num(40)});
+  rex_collections_vec_set_f64(v_1, 1, 99.0);
+  rex_println(rex_collections_vec_get_at(v_1, 1));
+  RexValue slice_1 = rex_collections_slice(v_1, rex_num(0), rex_num(2));
+  rex_println(rex_collections_vec_len(rex_ref(&slice_1)));
+  RexValue extra_1 = rex_collections_vec_from_typed(REX_VEC_F64, 3, (RexValue[]){rex_num(7), rex_num(8), rex_num(9)});
+  rex_collections_vec_push_f64(rex_ref_mut(&extra_1), 10.0);
+  rex_println(rex_collections_vec_len(rex_ref(&extra_1)));
+  rex_collections_vec_insert(rex_ref_mut(&extra_1), rex_num(1), rex_num(99));
+  rex_collections_vec_sort(rex_ref_mut(&extra_1));
+  RexValue __tmp1 = rex_add(rex_strval_1, rex_collections_vec_pop(rex_ref_mut(&extra_1)));
+  rex_println(__tmp1);
+  rex_drop(__tmp1);
+  rex_collections_vec_clear(rex_ref_mut(&extra_1));
+  RexValue __tmp2 = rex_add(rex_strval_2, rex_collections_vec_len(rex_ref(&extra_1)));
+  rex_println(__tmp2);
+  rex_drop(__tmp2);
+  RexValue m_1 = rex_collections_map_new();
+  rex_collections_map_put(rex_ref_mut(&m_1), rex_strval_3, rex_num(42));
+  rex_println(rex_collections_map_get(rex_ref(&m_1), rex_strval_3));
+  RexValue __tmp3 = rex_add(rex_strval_4, rex_collections_map_has(rex_ref(&m_1), rex_strval_3));
+  rex_println(__tmp3);
+  rex_drop(__tmp3);
+  RexValue keys_1 = rex_collections_map_keys(rex_ref(&m_1));
+  RexValue __iter4 = keys_1;
+  RexVecView __view4 = rex_collections_vec_view(__iter4);
+  for (int64_t __idx4 = 0; __idx4 < __view4.count; __idx4++) {
+    rex_vec_view_check(&__view4);
+    RexValue k_1 = rex_vec_view_get(&__view4, __idx4);
+    RexValue __tmp5 = rex_add(rex_strval_5, k_1);
+    rex_println(__tmp5);
+    rex_drop(__tmp5);
+  }
+  RexValue __tmp6 = rex_add(rex_strval_6, rex_collections_map_remove(rex_ref_mut(&m_1), rex_strval_3));
+  rex_println(__tmp6);
+  rex_drop(__tmp6);
+  RexValue s_1 = rex_collections_set_new();
+  rex_collections_set_add(rex_ref_mut(&s_1), rex_strval_7);
+  rex_println(rex_collections_set_has(rex_ref(&s_1), rex_strval_7));
+  RexValue __tmp7 = rex_add(rex_strval_8, rex_collections_set_remove(rex_ref_mut(&s_1), rex_strval_7));
+  rex_println(__tmp7);
+  rex_drop(__tmp7);
+  rex_drop(s_1);
+  rex_drop(keys_1);
+  rex_drop(m_1);
+  rex_drop(extra_1);
+  rex_drop(slice_1);
+  rex_drop(v_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
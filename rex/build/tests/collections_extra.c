@@ -0,0 +1,174 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[4]; } rex_strlit_1 = { { 3, 0, 0, REX_STR_STATIC }, "rex" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_2 = { { 4, 0, 0, REX_STR_STATIC }, "lang" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_3 = { { 6, 0, 0, REX_STR_STATIC }, "native" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_4 = { { 1, 0, 0, REX_STR_STATIC }, "-" };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_5 = { { 1, 0, 0, REX_STR_STATIC }, "a" };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_6 = { { 1, 0, 0, REX_STR_STATIC }, "b" };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_7 = { { 1, 0, 0, REX_STR_STATIC }, "x" };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_8 = { { 1, 0, 0, REX_STR_STATIC }, "y" };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+
+
+static RexValue rex_user_main() {
+  RexValue nums_1 = rex_collections_vec_from_typed(REX_VEC_F64, 4, (RexValue[]){rex_num(1), rex_num(2), rex_num(3), rex_num(2)});
+  RexValue twos_1 = rex_collections_vec_from_typed(REX_VEC_F64, 3, (RexValue[]){rex_num(2), rex_num(2), rex_num(2)});
+  RexValue words_1 = rex_collections_vec_from(3, (RexValue[]){rex_strval_1, rex_strval_2, rex_strval_3});
+  RexValue dash_1 = rex_strval_4;
+  rex_println(rex_collections_vec_find(rex_ref(&nums_1), rex_num(2)));
+  rex_println(rex_collections_vec_any(rex_ref(&nums_1), rex_num(3)));
+  rex_println(rex_collections_vec_all(rex_ref(&twos_1), rex_num(2)));
+  rex_println(rex_collections_vec_contains(rex_ref(&nums_1), rex_num(1)));
+  rex_println(rex_collections_vec_first(rex_ref(&nums_1)));
+  rex_println(rex_collections_vec_last(rex_ref(&nums_1)));
+  rex_println(rex_collections_vec_join(rex_ref(&words_1), rex_ref(&dash_1)));
+  RexValue changed_1 = rex_collections_vec_from_typed(REX_VEC_F64, 4, (RexValue[]){rex_num(5), rex_num(6), rex_num(7), rex_num(8)});
+  rex_println(rex_collections_vec_remove_at(rex_ref_mut(&changed_1), rex_num(1)));
+  rex_collections_vec_reverse(rex_ref_mut(&changed_1));
+  rex_println(rex_collections_vec_first(rex_ref(&changed_1)));
+  rex_println(rex_collections_vec_last(rex_ref(&changed_1)));
+  RexValue m_1 = rex_collections_map_new();
+  rex_collections_map_put(rex_ref_mut(&m_1), rex_strval_5, rex_num(10));
+  rex_collections_map_put(rex_ref_mut(&m_1), rex_strval_6, rex_num(20));
+  RexValue values_1 = rex_collections_map_values(rex_ref(&m_1));
+  RexValue items_1 = rex_collections_map_items(rex_ref(&m_1));
+  rex_println(rex_collections_vec_len(rex_ref(&values_1)));
+  rex_println(rex_collections_vec_len(rex_ref(&items_1)));
+  rex_println(rex_collections_map_len(rex_ref(&m_1)));
+  RexValue s_1 = rex_collections_set_new();
+  rex_collections_set_add(rex_ref_mut(&s_1), rex_strval_7);
+  rex_collections_set_add(rex_ref_mut(&s_1), rex_strval_8);
+  rex_println(rex_collections_set_len(rex_ref(&s_1)));
+  rex_drop(s_1);
+  rex_drop(items_1);
+  rex_drop(values_1);
+  rex_drop(m_1);
+  rex_drop(changed_1);
+  rex_drop(dash_1);
+  rex_drop(words_1);
+  rex_drop(twos_1);
+  rex_drop(nums_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
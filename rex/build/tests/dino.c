@@ -0,0 +1,762 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_Cloud_new(RexValue f_x, RexValue f_y, RexValue f_gap);
+static RexValue rex_Obstacle_new(RexValue f_x, RexValue f_y, RexValue f_w, RexValue f_h, RexValue f_kind, RexValue f_gap, RexValue f_size);
+static RexValue rex_Star_new(RexValue f_x, RexValue f_y, RexValue f_src_y);
+static RexValue rex_user_clamp(RexValue v, RexValue lo, RexValue hi);
+static RexValue rex_user_rects_overlap(RexValue ax, RexValue ay, RexValue aw, RexValue ah, RexValue bx, RexValue by, RexValue bw, RexValue bh);
+static RexValue rex_user_main();
+static const char* rex_fields_Cloud[] = {"x", "y", "gap"};
+typedef struct RexNative_Cloud { double f_x; double f_y; double f_gap; } RexNative_Cloud;
+static const unsigned char rex_kinds_Cloud[] = {REX_FIELD_NUM, REX_FIELD_NUM, REX_FIELD_NUM};
+static const size_t rex_offsets_Cloud[] = {offsetof(RexNative_Cloud, f_x), offsetof(RexNative_Cloud, f_y), offsetof(RexNative_Cloud, f_gap)};
+static const RexStructLayout rex_layout_Cloud = {"Cloud", rex_fields_Cloud, rex_kinds_Cloud, rex_offsets_Cloud, 3, sizeof(RexNative_Cloud)};
+static RexValue rex_Cloud_new(RexValue f_x, RexValue f_y, RexValue f_gap) {
+  RexNative_Cloud __rex_native = {rex_unbox_num(f_x), rex_unbox_num(f_y), rex_unbox_num(f_gap)};
+  return rex_struct_new_native(&rex_layout_Cloud, &__rex_native);
+}
+
+static const char* rex_fields_Obstacle[] = {"x", "y", "w", "h", "kind", "gap", "size"};
+typedef struct RexNative_Obstacle { double f_x; double f_y; double f_w; double f_h; int64_t f_kind; double f_gap; int64_t f_size; } RexNative_Obstacle;
+static const unsigned char rex_kinds_Obstacle[] = {REX_FIELD_NUM, REX_FIELD_NUM, REX_FIELD_NUM, REX_FIELD_NUM, REX_FIELD_INT, REX_FIELD_NUM, REX_FIELD_INT};
+static const size_t rex_offsets_Obstacle[] = {offsetof(RexNative_Obstacle, f_x), offsetof(RexNative_Obstacle, f_y), offsetof(RexNative_Obstacle, f_w), offsetof(RexNative_Obstacle, f_h), offsetof(RexNative_Obstacle, f_kind), offsetof(RexNative_Obstacle, f_gap), offsetof(RexNative_Obstacle, f_size)};
+static const RexStructLayout rex_layout_Obstacle = {"Obstacle", rex_fields_Obstacle, rex_kinds_Obstacle, rex_offsets_Obstacle, 7, sizeof(RexNative_Obstacle)};
+static RexValue rex_Obstacle_new(RexValue f_x, RexValue f_y, RexValue f_w, RexValue f_h, RexValue f_kind, RexValue f_gap, RexValue f_size) {
+  RexNative_Obstacle __rex_native = {rex_unbox_num(f_x), rex_unbox_num(f_y), rex_unbox_num(f_w), rex_unbox_num(f_h), rex_wrap_i32(rex_unbox_int(f_kind)), rex_unbox_num(f_gap), rex_wrap_i32(rex_unbox_int(f_size))};
+  return rex_struct_new_native(&rex_layout_Obstacle, &__rex_native);
+}
+
+static const char* rex_fields_Star[] = {"x", "y", "src_y"};
+typedef struct RexNative_Star { double f_x; double f_y; double f_src_y; } RexNative_Star;
+static const unsigned char rex_kinds_Star[] = {REX_FIELD_NUM, REX_FIELD_NUM, REX_FIELD_NUM};
+static const size_t rex_offsets_Star[] = {offsetof(RexNative_Star, f_x), offsetof(RexNative_Star, f_y), offsetof(RexNative_Star, f_src_y)};
+static const RexStructLayout rex_layout_Star = {"Star", rex_fields_Star, rex_kinds_Star, rex_offsets_Star, 3, sizeof(RexNative_Star)};
+static RexValue rex_Star_new(RexValue f_x, RexValue f_y, RexValue f_src_y) {
+  RexNative_Star __rex_native = {rex_unbox_num(f_x), rex_unbox_num(f_y), rex_unbox_num(f_src_y)};
+  return rex_struct_new_native(&rex_layout_Star, &__rex_native);
+}
+
+static const struct { RexStrHeader h; char s[9]; } rex_strlit_1 = { { 8, 0, 0, REX_STR_STATIC }, "Rex Dino" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_2 = { { 7, 0, 0, REX_STR_STATIC }, "#F7F7F7" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_3 = { { 7, 0, 0, REX_STR_STATIC }, "#202124" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_4 = { { 14, 0, 0, REX_STR_STATIC }, "Space to start" };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[26]; } rex_strlit_5 = { { 25, 0, 0, REX_STR_STATIC }, "Space or click to restart" };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[10]; } rex_strlit_6 = { { 9, 0, 0, REX_STR_STATIC }, "Game Over" };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[40]; } rex_strlit_7 = { { 39, 0, 0, REX_STR_STATIC }, "examples/dino/ic/200-offline-sprite.png" };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[35]; } rex_strlit_8 = { { 34, 0, 0, REX_STR_STATIC }, "examples/dino/sound/jump_sound.wav" };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+static const struct { RexStrHeader h; char s[34]; } rex_strlit_9 = { { 33, 0, 0, REX_STR_STATIC }, "examples/dino/sound/100points.mp3" };
+static const RexValue rex_strval_9 = REX_STR_LITERAL(rex_strlit_9.s);
+static const struct { RexStrHeader h; char s[29]; } rex_strlit_10 = { { 28, 0, 0, REX_STR_STATIC }, "examples/dino/sound/lose.mp3" };
+static const RexValue rex_strval_10 = REX_STR_LITERAL(rex_strlit_10.s);
+
+
+static RexValue rex_user_clamp(RexValue v, RexValue lo, RexValue hi) {
+  if ((rex_unbox_num(v) < rex_unbox_num(lo))) {
+    return lo;
+  }
+  if ((rex_unbox_num(v) > rex_unbox_num(hi))) {
+    return hi;
+  }
+  return v;
+  return rex_nil();
+}
+
+static RexValue rex_user_rects_overlap(RexValue ax, RexValue ay, RexValue aw, RexValue ah, RexValue bx, RexValue by, RexValue bw, RexValue bh) {
+  return rex_bool(((((rex_unbox_num(ax) < (rex_unbox_num(bx) + rex_unbox_num(bw))) && ((rex_unbox_num(ax) + rex_unbox_num(aw)) > rex_unbox_num(bx))) && (rex_unbox_num(ay) < (rex_unbox_num(by) + rex_unbox_num(bh)))) && ((rex_unbox_num(ay) + rex_unbox_num(ah)) > rex_unbox_num(by))));
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  rex_random_seed(rex_now_ms());
+  RexValue title_1 = rex_strval_1;
+  RexValue bg_1 = rex_strval_2;
+  RexValue fg_1 = rex_strval_3;
+  RexValue msg_start_1 = rex_strval_4;
+  RexValue msg_restart_1 = rex_strval_5;
+  RexValue msg_over_1 = rex_strval_6;
+  int64_t win_w_1 = rex_wrap_i32(600);
+  int64_t win_h_1 = rex_wrap_i32(150);
+  RexValue sheet_1 = rex_ui_image_load(rex_strval_7);
+  RexValue sound_jump_1 = rex_strval_8;
+  RexValue sound_score_1 = rex_strval_9;
+  RexValue sound_hit_1 = rex_strval_10;
+  double sheet_scale_1 = 2.0;
+  double trex_x_1 = 1678.0;
+  double trex_y_1 = 2.0;
+  double cactus_small_x_1 = 446.0;
+  double cactus_small_y_1 = 2.0;
+  double cactus_large_x_1 = 652.0;
+  double cactus_large_y_1 = 2.0;
+  double ptero_x_1 = 260.0;
+  double ptero_y_1 = 2.0;
+  double restart_x_1 = 2.0;
+  double restart_y_1 = 2.0;
+  double horizon_x_1 = 2.0;
+  double horizon_y_src_1 = 104.0;
+  double cloud_x_1 = 166.0;
+  double cloud_y_1 = 2.0;
+  double moon_x_1 = 954.0;
+  double moon_y_1 = 2.0;
+  double star_x_1 = 1276.0;
+  double star_y_1 = 2.0;
+  double trex_w_1 = 44.0;
+  double trex_h_1 = 47.0;
+  double trex_duck_w_1 = 59.0;
+  double trex_duck_h_1 = trex_h_1;
+  double trex_src_w_1 = (trex_w_1 * sheet_scale_1);
+  double trex_src_h_1 = (trex_h_1 * sheet_scale_1);
+  double trex_duck_src_w_1 = (trex_duck_w_1 * sheet_scale_1);
+  double cactus_small_w_1 = 17.0;
+  double cactus_small_h_1 = 35.0;
+  double cactus_small_src_w_1 = (cactus_small_w_1 * sheet_scale_1);
+  double cactus_small_src_h_1 = (cactus_small_h_1 * sheet_scale_1);
+  double cactus_large_w_1 = 25.0;
+  double cactus_large_h_1 = 50.0;
+  double cactus_large_src_w_1 = (cactus_large_w_1 * sheet_scale_1);
+  double cactus_large_src_h_1 = (cactus_large_h_1 * sheet_scale_1);
+  double ptero_w_1 = 46.0;
+  double ptero_h_1 = 40.0;
+  double ptero_src_w_1 = (ptero_w_1 * sheet_scale_1);
+  double ptero_src_h_1 = (ptero_h_1 * sheet_scale_1);
+  double restart_w_1 = 36.0;
+  double restart_h_1 = 32.0;
+  double restart_src_w_1 = (restart_w_1 * sheet_scale_1);
+  double restart_src_h_1 = (restart_h_1 * sheet_scale_1);
+  double horizon_w_1 = 600.0;
+  double horizon_h_1 = 12.0;
+  double horizon_src_w_1 = (horizon_w_1 * sheet_scale_1);
+  double horizon_src_h_1 = (horizon_h_1 * sheet_scale_1);
+  double horizon_y_1 = 127.0;
+  double cloud_w_1 = 46.0;
+  double cloud_h_1 = 14.0;
+  double cloud_src_w_1 = (cloud_w_1 * sheet_scale_1);
+  double cloud_src_h_1 = (cloud_h_1 * sheet_scale_1);
+  double moon_w_1 = 20.0;
+  double moon_h_1 = 40.0;
+  double moon_src_w_1 = (moon_w_1 * sheet_scale_1);
+  double moon_src_h_1 = (moon_h_1 * sheet_scale_1);
+  double star_size_1 = 9.0;
+  double star_src_size_1 = (star_size_1 * sheet_scale_1);
+  double tick_ms_1 = 16.0;
+  double dino_x_1 = 50.0;
+  double gravity_1 = 0.6;
+  double jump_vy_1 = 11.0;
+  double base_speed_1 = 6.0;
+  double max_speed_1 = 13.0;
+  double speed_accel_1 = 0.001;
+  double gap_coeff_1 = 0.6;
+  double max_gap_coeff_1 = 1.5;
+  double score_step_px_1 = 40.0;
+  double cloud_speed_1 = 0.2;
+  double cloud_frequency_1 = 0.5;
+  double cloud_max_1 = 6.0;
+  double cloud_gap_min_1 = 100.0;
+  double cloud_gap_max_1 = 400.0;
+  double cloud_sky_min_1 = 71.0;
+  double cloud_sky_max_1 = 30.0;
+  int64_t night_interval_1 = rex_wrap_i32(500);
+  double moon_speed_1 = 0.25;
+  double star_speed_1 = 0.3;
+  double star_count_1 = 2.0;
+  double star_max_y_1 = 70.0;
+  double bottom_pad_1 = 10.0;
+  double ground_y_1 = (((double)win_h_1) - bottom_pad_1);
+  double track_y_1 = horizon_y_1;
+  double track_w_1 = horizon_w_1;
+  int64_t state_1 = rex_wrap_i32(0);
+  int64_t score_1 = rex_wrap_i32(0);
+  int64_t best_1 = rex_wrap_i32(0);
+  double speed_1 = base_speed_1;
+  double score_dist_1 = 0.0;
+  double dino_y_1 = 0.0;
+  double dino_vy_1 = 0.0;
+  double track_x_1 = 0.0;
+  double run_timer_1 = 0.0;
+  int64_t run_frame_1 = rex_wrap_i32(0);
+  double bird_timer_1 = 0.0;
+  int64_t bird_frame_1 = rex_wrap_i32(0);
+  RexValue obstacles_1 = rex_collections_vec_new();
+  RexValue clouds_1 = rex_collections_vec_new();
+  RexValue stars_1 = rex_collections_vec_new();
+  int night_active_1 = 0;
+  int64_t last_night_score_1 = rex_wrap_i32(0);
+  int titlebar_dark_1 = 0;
+  RexValue moon_phases_1 = rex_collections_vec_from_typed(REX_VEC_F64, 7, (RexValue[]){rex_num(140), rex_num(120), rex_num(100), rex_num(60), rex_num(40), rex_num(20), rex_num(0)});
+  int64_t moon_phase_1 = rex_wrap_i32(0);
+  double moon_x_pos_1 = ((double)rex_wrap_i32(rex_int_sub(win_w_1, 50)));
+  double moon_y_pos_1 = 30.0;
+  rex_collections_vec_push(rex_ref_mut(&clouds_1), rex_Cloud_new(rex_int(win_w_1), rex_random_int(rex_num(cloud_sky_max_1), rex_num(cloud_sky_min_1)), rex_random_int(rex_num(cloud_gap_min_1), rex_num(cloud_gap_max_1))));
+  double last_1 = rex_unbox_num(rex_now_ms());
+  double acc_1 = 0.0;
+  int jump_request_1 = 0;
+  while (rex_is_truthy(rex_ui_begin(rex_ref(&title_1), rex_int(win_w_1), rex_int(win_h_1)))) {
+    rex_ui_redraw();
+    double now_1 = rex_unbox_num(rex_now_ms());
+    double dt_1 = (now_1 - last_1);
+    if ((dt_1 < 0.0)) {
+      dt_1 = 0.0;
+    }
+    if ((dt_1 > 80.0)) {
+      dt_1 = 80.0;
+    }
+    last_1 = now_1;
+    acc_1 = (acc_1 + dt_1);
+    if (rex_is_truthy(rex_ui_key_space())) {
+      jump_request_1 = 1;
+    }
+    int duck_held_1 = rex_is_truthy(rex_ui_key_down());
+    while ((acc_1 >= tick_ms_1)) {
+      acc_1 = (acc_1 - tick_ms_1);
+      if ((state_1 == 0)) {
+        if (jump_request_1) {
+          state_1 = rex_wrap_i32(1);
+          score_1 = rex_wrap_i32(0);
+          score_dist_1 = 0.0;
+          dino_y_1 = 0.0;
+          dino_vy_1 = 0.0;
+          speed_1 = base_speed_1;
+          track_x_1 = 0.0;
+          run_timer_1 = 0.0;
+          run_frame_1 = rex_wrap_i32(0);
+          bird_timer_1 = 0.0;
+          bird_frame_1 = rex_wrap_i32(0);
+          rex_collections_vec_clear(rex_ref_mut(&obstacles_1));
+          rex_collections_vec_clear(rex_ref_mut(&clouds_1));
+          rex_collections_vec_clear(rex_ref_mut(&stars_1));
+          night_active_1 = 0;
+          last_night_score_1 = rex_wrap_i32(0);
+          moon_phase_1 = rex_wrap_i32(0);
+          moon_x_pos_1 = ((double)rex_wrap_i32(rex_int_sub(win_w_1, 50)));
+          rex_collections_vec_push(rex_ref_mut(&clouds_1), rex_Cloud_new(rex_int(win_w_1), rex_random_int(rex_num(cloud_sky_max_1), rex_num(cloud_sky_min_1)), rex_random_int(rex_num(cloud_gap_min_1), rex_num(cloud_gap_max_1))));
+          jump_request_1 = 0;
+        }
+      } else {
+        if ((state_1 == 2)) {
+          if (jump_request_1) {
+            state_1 = rex_wrap_i32(1);
+            score_1 = rex_wrap_i32(0);
+            score_dist_1 = 0.0;
+            dino_y_1 = 0.0;
+            dino_vy_1 = 0.0;
+            speed_1 = base_speed_1;
+            track_x_1 = 0.0;
+            run_timer_1 = 0.0;
+            run_frame_1 = rex_wrap_i32(0);
+            bird_timer_1 = 0.0;
+            bird_frame_1 = rex_wrap_i32(0);
+            rex_collections_vec_clear(rex_ref_mut(&obstacles_1));
+            rex_collections_vec_clear(rex_ref_mut(&clouds_1));
+            rex_collections_vec_clear(rex_ref_mut(&stars_1));
+            night_active_1 = 0;
+            last_night_score_1 = rex_wrap_i32(0);
+            moon_phase_1 = rex_wrap_i32(0);
+            moon_x_pos_1 = ((double)rex_wrap_i32(rex_int_sub(win_w_1, 50)));
+            rex_collections_vec_push(rex_ref_mut(&clouds_1), rex_Cloud_new(rex_int(win_w_1), rex_random_int(rex_num(cloud_sky_max_1), rex_num(cloud_sky_min_1)), rex_random_int(rex_num(cloud_gap_min_1), rex_num(cloud_gap_max_1))));
+            jump_request_1 = 0;
+          }
+        }
+        if ((state_1 == 1)) {
+          score_dist_1 = (score_dist_1 + speed_1);
+          while ((score_dist_1 >= score_step_px_1)) {
+            score_dist_1 = (score_dist_1 - score_step_px_1);
+            score_1 = rex_wrap_i32(rex_int_add(score_1, 1));
+            if ((rex_wrap_i32(rex_int_mod(score_1, 100)) == 0)) {
+              rex_ui_play_sound(rex_ref(&sound_score_1));
+            }
+          }
+          if ((speed_1 < max_speed_1)) {
+            speed_1 = (speed_1 + speed_accel_1);
+            if ((speed_1 > max_speed_1)) {
+              speed_1 = max_speed_1;
+            }
+          }
+          if ((((score_1 > 0) && (rex_wrap_i32(rex_int_mod(score_1, night_interval_1)) == 0)) && (score_1 != last_night_score_1))) {
+            last_night_score_1 = score_1;
+            night_active_1 = (!night_active_1);
+            if (night_active_1) {
+              moon_phase_1 = rex_wrap_i32(rex_int_add(moon_phase_1, 1));
+              if ((moon_phase_1 >= 7)) {
+                moon_phase_1 = rex_wrap_i32(0);
+              }
+              moon_x_pos_1 = ((double)rex_wrap_i32(rex_int_sub(win_w_1, 50)));
+              rex_collections_vec_clear(rex_ref_mut(&stars_1));
+              double seg_1 = (((double)win_w_1) / star_count_1);
+              double si_1 = 0.0;
+              while ((si_1 < star_count_1)) {
+                double x0_1 = (seg_1 * si_1);
+                double x1_1 = (seg_1 * (si_1 + 1.0));
+                double sx_1 = rex_unbox_num(rex_random_int(rex_num(x0_1), rex_num(x1_1)));
+                double sy_1 = rex_unbox_num(rex_random_int(rex_num(0), rex_num(star_max_y_1)));
+                double ssy_1 = (star_y_1 + (star_src_size_1 * si_1));
+                rex_collections_vec_push(rex_ref_mut(&stars_1), rex_Star_new(rex_num(sx_1), rex_num(sy_1), rex_num(ssy_1)));
+                si_1 = (si_1 + 1.0);
+              }
+            } else {
+              rex_collections_vec_clear(rex_ref_mut(&stars_1));
+            }
+          }
+          if (night_active_1) {
+            moon_x_pos_1 = (moon_x_pos_1 - moon_speed_1);
+            if ((moon_x_pos_1 < (-moon_w_1))) {
+              moon_x_pos_1 = ((double)win_w_1);
+            }
+            RexValue next_stars_1 = rex_collections_vec_new();
+            double sn_1 = rex_unbox_num(rex_collections_vec_len(rex_ref(&stars_1)));
+            double si_2 = 0.0;
+            while ((si_2 < sn_1)) {
+              RexValue s_1 = rex_collections_vec_get(rex_ref(&stars_1), rex_num(si_2));
+              double nx_1 = (((RexNative_Star*)rex_struct_data(s_1, &rex_layout_Star))->f_x - star_speed_1);
+              if ((nx_1 < (-star_size_1))) {
+                nx_1 = ((double)win_w_1);
+              }
+              rex_collections_vec_push(rex_ref_mut(&next_stars_1), rex_Star_new(rex_num(nx_1), rex_num(((RexNative_Star*)rex_struct_data(s_1, &rex_layout_Star))->f_y), rex_num(((RexNative_Star*)rex_struct_data(s_1, &rex_layout_Star))->f_src_y)));
+              si_2 = (si_2 + 1.0);
+            }
+            stars_1 = next_stars_1;
+          }
+          run_timer_1 = (run_timer_1 + tick_ms_1);
+          if ((run_timer_1 >= 80.0)) {
+            run_timer_1 = 0.0;
+            run_frame_1 = rex_wrap_i32(rex_int_sub(1, run_frame_1));
+          }
+          bird_timer_1 = (bird_timer_1 + tick_ms_1);
+          if ((bird_timer_1 >= 170.0)) {
+            bird_timer_1 = 0.0;
+            bird_frame_1 = rex_wrap_i32(rex_int_sub(1, bird_frame_1));
+          }
+          if ((jump_request_1 && (dino_y_1 <= 0.0))) {
+            dino_vy_1 = jump_vy_1;
+            rex_ui_play_sound(rex_ref(&sound_jump_1));
+            jump_request_1 = 0;
+          }
+          if ((duck_held_1 && (dino_y_1 > 0.0))) {
+            dino_vy_1 = (dino_vy_1 - (gravity_1 * 1.2));
+          }
+          dino_vy_1 = (dino_vy_1 - gravity_1);
+          dino_y_1 = (dino_y_1 + dino_vy_1);
+          if ((dino_y_1 < 0.0)) {
+            dino_y_1 = 0.0;
+            dino_vy_1 = 0.0;
+          }
+          track_x_1 = (track_x_1 - speed_1);
+          if ((track_x_1 <= (-track_w_1))) {
+            track_x_1 = (track_x_1 + track_w_1);
+          }
+          double cloud_dx_1 = (((cloud_speed_1 * speed_1) * tick_ms_1) / 1000.0);
+          double cloud_step_1 = cloud_dx_1;
+          if ((cloud_step_1 < 1.0)) {
+            cloud_step_1 = 1.0;
+          }
+          RexValue next_clouds_1 = rex_collections_vec_new();
+          double cn_1 = rex_unbox_num(rex_collections_vec_len(rex_ref(&clouds_1)));
+          double ci_1 = 0.0;
+          while ((ci_1 < cn_1)) {
+            RexValue c_1 = rex_collections_vec_get(rex_ref(&clouds_1), rex_num(ci_1));
+            double nx_2 = (((RexNative_Cloud*)rex_struct_data(c_1, &rex_layout_Cloud))->f_x - cloud_step_1);
+            if (((nx_2 + cloud_w_1) > 0.0)) {
+              rex_collections_vec_push(rex_ref_mut(&next_clouds_1), rex_Cloud_new(rex_num(nx_2), rex_num(((RexNative_Cloud*)rex_struct_data(c_1, &rex_layout_Cloud))->f_y), rex_num(((RexNative_Cloud*)rex_struct_data(c_1, &rex_layout_Cloud))->f_gap)));
+            }
+            ci_1 = (ci_1 + 1.0);
+          }
+          clouds_1 = next_clouds_1;
+          double cn2_1 = rex_unbox_num(rex_collections_vec_len(rex_ref(&clouds_1)));
+          if ((cn2_1 <= 0.0)) {
+            rex_collections_vec_push(rex_ref_mut(&clouds_1), rex_Cloud_new(rex_int(win_w_1), rex_random_int(rex_num(cloud_sky_max_1), rex_num(cloud_sky_min_1)), rex_random_int(rex_num(cloud_gap_min_1), rex_num(cloud_gap_max_1))));
+          } else {
+            if ((cn2_1 < cloud_max_1)) {
+              RexValue last_c_1 = rex_collections_vec_get(rex_ref(&clouds_1), rex_num((cn2_1 - 1.0)));
+              if ((((((double)win_w_1) - ((RexNative_Cloud*)rex_struct_data(last_c_1, &rex_layout_Cloud))->f_x) > ((RexNative_Cloud*)rex_struct_data(last_c_1, &rex_layout_Cloud))->f_gap) && (rex_unbox_num(rex_random_float()) < cloud_frequency_1))) {
+                rex_collections_vec_push(rex_ref_mut(&clouds_1), rex_Cloud_new(rex_int(win_w_1), rex_random_int(rex_num(cloud_sky_max_1), rex_num(cloud_sky_min_1)), rex_random_int(rex_num(cloud_gap_min_1), rex_num(cloud_gap_max_1))));
+              }
+            }
+          }
+          double on_1 = rex_unbox_num(rex_collections_vec_len(rex_ref(&obstacles_1)));
+          int should_spawn_1 = 0;
+          if ((on_1 <= 0.0)) {
+            should_spawn_1 = 1;
+          } else {
+            RexValue last_o_1 = rex_collections_vec_get(rex_ref(&obstacles_1), rex_num((on_1 - 1.0)));
+            if ((((((RexNative_Obstacle*)rex_struct_data(last_o_1, &rex_layout_Obstacle))->f_x + ((RexNative_Obstacle*)rex_struct_data(last_o_1, &rex_layout_Obstacle))->f_w) + ((RexNative_Obstacle*)rex_struct_data(last_o_1, &rex_layout_Obstacle))->f_gap) < ((double)win_w_1))) {
+              should_spawn_1 = 1;
+            }
+          }
+          if (should_spawn_1) {
+            int64_t kind_1 = rex_wrap_i32(0);
+            if (((speed_1 >= 8.5) && (rex_unbox_num(rex_random_int(rex_num(0), rex_num(9))) >= 7.0))) {
+              kind_1 = rex_wrap_i32(2);
+            } else {
+              kind_1 = rex_wrap_i32(rex_unbox_int(rex_random_int(rex_num(0), rex_num(1))));
+            }
+            double ow_1 = 0.0;
+            double oh_1 = 0.0;
+            double oy_1 = 0.0;
+            double base_min_gap_1 = 120.0;
+            int64_t size_1 = rex_wrap_i32(1);
+            if ((kind_1 == 0)) {
+              size_1 = rex_wrap_i32(rex_unbox_int(rex_random_int(rex_num(1), rex_num(3))));
+              if ((speed_1 < 4.0)) {
+                size_1 = rex_wrap_i32(1);
+              }
+              ow_1 = (cactus_small_w_1 * ((double)size_1));
+              oh_1 = cactus_small_h_1;
+              oy_1 = (ground_y_1 - oh_1);
+            } else {
+              if ((kind_1 == 1)) {
+                size_1 = rex_wrap_i32(rex_unbox_int(rex_random_int(rex_num(1), rex_num(3))));
+                if ((speed_1 < 7.0)) {
+                  size_1 = rex_wrap_i32(1);
+                }
+                ow_1 = (cactus_large_w_1 * ((double)size_1));
+                oh_1 = cactus_large_h_1;
+                oy_1 = (ground_y_1 - oh_1);
+              } else {
+                base_min_gap_1 = 150.0;
+                ow_1 = ptero_w_1;
+                oh_1 = ptero_h_1;
+                double lane_1 = rex_unbox_num(rex_random_int(rex_num(0), rex_num(2)));
+                if ((lane_1 == 0.0)) {
+                  oy_1 = 100.0;
+                } else {
+                  if ((lane_1 == 1.0)) {
+                    oy_1 = 75.0;
+                  } else {
+                    oy_1 = 50.0;
+                  }
+                }
+              }
+            }
+            double min_gap_1 = ((ow_1 * speed_1) + (base_min_gap_1 * gap_coeff_1));
+            double max_gap_1 = (min_gap_1 * max_gap_coeff_1);
+            double gap_1 = rex_unbox_num(rex_random_int(rex_num(min_gap_1), rex_num(max_gap_1)));
+            rex_collections_vec_push(rex_ref_mut(&obstacles_1), rex_Obstacle_new(rex_int(rex_wrap_i32(rex_int_add(win_w_1, 40))), rex_num(oy_1), rex_num(ow_1), rex_num(oh_1), rex_int(kind_1), rex_num(gap_1), rex_int(size_1)));
+          }
+          double dw_1 = trex_w_1;
+          double dh_1 = trex_h_1;
+          if ((dino_y_1 > 0.0)) {
+            dw_1 = trex_w_1;
+            dh_1 = trex_h_1;
+          } else {
+            if (duck_held_1) {
+              dw_1 = trex_duck_w_1;
+              dh_1 = trex_duck_h_1;
+            }
+          }
+          double dx_1 = dino_x_1;
+          double dy_1 = ((ground_y_1 - dh_1) - dino_y_1);
+          double d_l_1 = 7.0;
+          double d_r_1 = 7.0;
+          double d_t_1 = 5.0;
+          double d_b_1 = 5.0;
+          if ((duck_held_1 && (dino_y_1 <= 0.0))) {
+            d_l_1 = 4.0;
+            d_r_1 = 4.0;
+            d_t_1 = 2.0;
+            d_b_1 = 2.0;
+          } else {
+            if ((dino_y_1 > 0.0)) {
+              d_l_1 = 10.0;
+              d_r_1 = 10.0;
+              d_t_1 = 8.0;
+              d_b_1 = 6.0;
+            }
+          }
+          double d_hit_x_1 = (dx_1 + d_l_1);
+          double d_hit_y_1 = (dy_1 + d_t_1);
+          double d_hit_w_1 = rex_unbox_num(rex_user_clamp(rex_num(((dw_1 - d_l_1) - d_r_1)), rex_num(1), rex_num(dw_1)));
+          double d_hit_h_1 = rex_unbox_num(rex_user_clamp(rex_num(((dh_1 - d_t_1) - d_b_1)), rex_num(1), rex_num(dh_1)));
+          if ((duck_held_1 && (dino_y_1 <= 0.0))) {
+            double duck_hit_h_1 = 25.0;
+            d_hit_h_1 = rex_unbox_num(rex_user_clamp(rex_num(((duck_hit_h_1 - d_t_1) - d_b_1)), rex_num(1), rex_num(duck_hit_h_1)));
+            d_hit_y_1 = ((dy_1 + (dh_1 - duck_hit_h_1)) + d_t_1);
+          }
+          int hit_1 = 0;
+          RexValue next_1 = rex_collections_vec_new();
+          double i_1 = 0.0;
+          double n_1 = rex_unbox_num(rex_collections_vec_len(rex_ref(&obstacles_1)));
+          while ((i_1 < n_1)) {
+            RexValue o_1 = rex_collections_vec_get(rex_ref(&obstacles_1), rex_num(i_1));
+            double nx_3 = (((RexNative_Obstacle*)rex_struct_data(o_1, &rex_layout_Obstacle))->f_x - speed_1);
+            RexValue no_1 = rex_Obstacle_new(rex_num(nx_3), rex_num(((RexNative_Obstacle*)rex_struct_data(o_1, &rex_layout_Obstacle))->f_y), rex_num(((RexNative_Obstacle*)rex_struct_data(o_1, &rex_layout_Obstacle))->f_w), rex_num(((RexNative_Obstacle*)rex_struct_data(o_1, &rex_layout_Obstacle))->f_h), rex_int(((RexNative_Obstacle*)rex_struct_data(o_1, &rex_layout_Obstacle))->f_kind), rex_num(((RexNative_Obstacle*)rex_struct_data(o_1, &rex_layout_Obstacle))->f_gap), rex_int(((RexNative_Obstacle*)rex_struct_data(o_1, &rex_layout_Obstacle))->f_size));
+            if (((nx_3 + ((RexNative_Obstacle*)rex_struct_data(no_1, &rex_layout_Obstacle))->f_w) > (-50.0))) {
+              double o_l_1 = 2.0;
+              double o_r_1 = 2.0;
+              double o_t_1 = 6.0;
+              double o_b_1 = 2.0;
+              if ((((RexNative_Obstacle*)rex_struct_data(no_1, &rex_layout_Obstacle))->f_kind == 1)) {
+                o_l_1 = 3.0;
+                o_r_1 = 3.0;
+                o_t_1 = 10.0;
+              } else {
+                if ((((RexNative_Obstacle*)rex_struct_data(no_1, &rex_layout_Obstacle))->f_kind == 2)) {
+                  o_l_1 = 8.0;
+                  o_r_1 = 8.0;
+                  o_t_1 = 6.0;
+                  o_b_1 = 6.0;
+                }
+              }
+              double o_hit_x_1 = (((RexNative_Obstacle*)rex_struct_data(no_1, &rex_layout_Obstacle))->f_x + o_l_1);
+              double o_hit_y_1 = (((RexNative_Obstacle*)rex_struct_data(no_1, &rex_layout_Obstacle))->f_y + o_t_1);
+              double o_hit_w_1 = rex_unbox_num(rex_user_clamp(rex_num(((((RexNative_Obstacle*)rex_struct_data(no_1, &rex_layout_Obstacle))->f_w - o_l_1) - o_r_1)), rex_num(1), rex_num(((RexNative_Obstacle*)rex_struct_data(no_1, &rex_layout_Obstacle))->f_w)));
+              double o_hit_h_1 = rex_unbox_num(rex_user_clamp(rex_num(((((RexNative_Obstacle*)rex_struct_data(no_1, &rex_layout_Obstacle))->f_h - o_t_1) - o_b_1)), rex_num(1), rex_num(((RexNative_Obstacle*)rex_struct_data(no_1, &rex_layout_Obstacle))->f_h)));
+              if (rex_is_truthy(rex_user_rects_overlap(rex_num(d_hit_x_1), rex_num(d_hit_y_1), rex_num(d_hit_w_1), rex_num(d_hit_h_1), rex_num(o_hit_x_1), rex_num(o_hit_y_1), rex_num(o_hit_w_1), rex_num(o_hit_h_1)))) {
+                hit_1 = 1;
+              }
+              rex_collections_vec_push(rex_ref_mut(&next_1), no_1);
+            }
+            i_1 = (i_1 + 1.0);
+          }
+          obstacles_1 = next_1;
+          if (hit_1) {
+            rex_ui_play_sound(rex_ref(&sound_hit_1));
+            state_1 = rex_wrap_i32(2);
+            if ((score_1 > best_1)) {
+              best_1 = score_1;
+            }
+          }
+        }
+      }
+    }
+    rex_ui_invert(rex_bool(night_active_1));
+    int want_titlebar_dark_1 = night_active_1;
+    if ((want_titlebar_dark_1 != titlebar_dark_1)) {
+      titlebar_dark_1 = want_titlebar_dark_1;
+      rex_ui_titlebar_dark(rex_bool(titlebar_dark_1));
+    }
+    rex_ui_clear(rex_ref(&bg_1));
+    if (night_active_1) {
+      double si_3 = 0.0;
+      double sn_2 = rex_unbox_num(rex_collections_vec_len(rex_ref(&stars_1)));
+      while ((si_3 < sn_2)) {
+        RexValue s_2 = rex_collections_vec_get(rex_ref(&stars_1), rex_num(si_3));
+        rex_ui_image_region(rex_ref(&sheet_1), rex_num(star_x_1), rex_num(((RexNative_Star*)rex_struct_data(s_2, &rex_layout_Star))->f_src_y), rex_num(star_src_size_1), rex_num(star_src_size_1), rex_num(((RexNative_Star*)rex_struct_data(s_2, &rex_layout_Star))->f_x), rex_num(((RexNative_Star*)rex_struct_data(s_2, &rex_layout_Star))->f_y), rex_num(star_size_1), rex_num(star_size_1));
+        si_3 = (si_3 + 1.0);
+      }
+      double phase_offset_1 = rex_collections_vec_get_f64(moon_phases_1, moon_phase_1);
+      double moon_sw_1 = moon_src_w_1;
+      double moon_dw_1 = moon_w_1;
+      if ((moon_phase_1 == 3)) {
+        moon_sw_1 = (moon_src_w_1 * 2.0);
+        moon_dw_1 = (moon_w_1 * 2.0);
+      }
+      double moon_sx_1 = (moon_x_1 + (phase_offset_1 * sheet_scale_1));
+      rex_ui_image_region(rex_ref(&sheet_1), rex_num(moon_sx_1), rex_num(moon_y_1), rex_num(moon_sw_1), rex_num(moon_src_h_1), rex_num(moon_x_pos_1), rex_num(moon_y_pos_1), rex_num(moon_dw_1), rex_num(moon_h_1));
+    }
+    double ci_2 = 0.0;
+    double cn_2 = rex_unbox_num(rex_collections_vec_len(rex_ref(&clouds_1)));
+    while ((ci_2 < cn_2)) {
+      RexValue c_2 = rex_collections_vec_get(rex_ref(&clouds_1), rex_num(ci_2));
+      rex_ui_image_region(rex_ref(&sheet_1), rex_num(cloud_x_1), rex_num(cloud_y_1), rex_num(cloud_src_w_1), rex_num(cloud_src_h_1), rex_num(((RexNative_Cloud*)rex_struct_data(c_2, &rex_layout_Cloud))->f_x), rex_num(((RexNative_Cloud*)rex_struct_data(c_2, &rex_layout_Cloud))->f_y), rex_num(cloud_w_1), rex_num(cloud_h_1));
+      ci_2 = (ci_2 + 1.0);
+    }
+    rex_ui_image_region(rex_ref(&sheet_1), rex_num(horizon_x_1), rex_num(horizon_y_src_1), rex_num(horizon_src_w_1), rex_num(horizon_src_h_1), rex_num(track_x_1), rex_num(track_y_1), rex_num(horizon_w_1), rex_num(horizon_h_1));
+    rex_ui_image_region(rex_ref(&sheet_1), rex_num(horizon_x_1), rex_num(horizon_y_src_1), rex_num(horizon_src_w_1), rex_num(horizon_src_h_1), rex_num((track_x_1 + track_w_1)), rex_num(track_y_1), rex_num(horizon_w_1), rex_num(horizon_h_1));
+    double j_1 = 0.0;
+    double on_2 = rex_unbox_num(rex_collections_vec_len(rex_ref(&obstacles_1)));
+    while ((j_1 < on_2)) {
+      RexValue o_2 = rex_collections_vec_get(rex_ref(&obstacles_1), rex_num(j_1));
+      if ((((RexNative_Obstacle*)rex_struct_data(o_2, &rex_layout_Obstacle))->f_kind == 0)) {
+        double size_2 = ((double)((RexNative_Obstacle*)rex_struct_data(o_2, &rex_layout_Obstacle))->f_size);
+        double sw_1 = (cactus_small_src_w_1 * size_2);
+        double sh_1 = cactus_small_src_h_1;
+        double sx_2 = (cactus_small_x_1 + ((cactus_small_src_w_1 * size_2) * (0.5 * (size_2 - 1.0))));
+        rex_ui_image_region(rex_ref(&sheet_1), rex_num(sx_2), rex_num(cactus_small_y_1), rex_num(sw_1), rex_num(sh_1), rex_num(((RexNative_Obstacle*)rex_struct_data(o_2, &rex_layout_Obstacle))->f_x), rex_num(((RexNative_Obstacle*)rex_struct_data(o_2, &rex_layout_Obstacle))->f_y), rex_num((cactus_small_w_1 * size_2)), rex_num(cactus_small_h_1));
+      } else {
+        if ((((RexNative_Obstacle*)rex_struct_data(o_2, &rex_layout_Obstacle))->f_kind == 1)) {
+          double size_3 = ((double)((RexNative_Obstacle*)rex_struct_data(o_2, &rex_layout_Obstacle))->f_size);
+          double sw_2 = (cactus_large_src_w_1 * size_3);
+          double sh_2 = cactus_large_src_h_1;
+          double sx_3 = (cactus_large_x_1 + ((cactus_large_src_w_1 * size_3) * (0.5 * (size_3 - 1.0))));
+          rex_ui_image_region(rex_ref(&sheet_1), rex_num(sx_3), rex_num(cactus_large_y_1), rex_num(sw_2), rex_num(sh_2), rex_num(((RexNative_Obstacle*)rex_struct_data(o_2, &rex_layout_Obstacle))->f_x), rex_num(((RexNative_Obstacle*)rex_struct_data(o_2, &rex_layout_Obstacle))->f_y), rex_num((cactus_large_w_1 * size_3)), rex_num(cactus_large_h_1));
+        } else {
+          double sx_4 = (ptero_x_1 + (ptero_src_w_1 * ((double)bird_frame_1)));
+          rex_ui_image_region(rex_ref(&sheet_1), rex_num(sx_4), rex_num(ptero_y_1), rex_num(ptero_src_w_1), rex_num(ptero_src_h_1), rex_num(((RexNative_Obstacle*)rex_struct_data(o_2, &rex_layout_Obstacle))->f_x), rex_num(((RexNative_Obstacle*)rex_struct_data(o_2, &rex_layout_Obstacle))->f_y), rex_num(ptero_w_1), rex_num(ptero_h_1));
+        }
+      }
+      j_1 = (j_1 + 1.0);
+    }
+    double sx_5 = (trex_x_1 + (88.0 * sheet_scale_1));
+    double sw_3 = trex_src_w_1;
+    double dw_2 = trex_w_1;
+    double dh_2 = trex_h_1;
+    if ((state_1 == 0)) {
+      sx_5 = (trex_x_1 + (44.0 * sheet_scale_1));
+    } else {
+      if ((state_1 == 2)) {
+        sx_5 = (trex_x_1 + (220.0 * sheet_scale_1));
+      } else {
+        if ((dino_y_1 > 0.0)) {
+          sx_5 = trex_x_1;
+        } else {
+          if (duck_held_1) {
+            sw_3 = trex_duck_src_w_1;
+            dw_2 = trex_duck_w_1;
+            if ((run_frame_1 == 0)) {
+              sx_5 = (trex_x_1 + (264.0 * sheet_scale_1));
+            } else {
+              sx_5 = (trex_x_1 + (323.0 * sheet_scale_1));
+            }
+          } else {
+            if ((run_frame_1 == 0)) {
+              sx_5 = (trex_x_1 + (88.0 * sheet_scale_1));
+            } else {
+              sx_5 = (trex_x_1 + (132.0 * sheet_scale_1));
+            }
+          }
+        }
+      }
+    }
+    rex_ui_image_region(rex_ref(&sheet_1), rex_num(sx_5), rex_num(trex_y_1), rex_num(sw_3), rex_num(trex_src_h_1), rex_num(dino_x_1), rex_num(((ground_y_1 - dh_2) - dino_y_1)), rex_num(dw_2), rex_num(dh_2));
+    rex_ui_text(rex_num(20), rex_num(16), rex_int(score_1), rex_ref(&fg_1));
+    rex_ui_text(rex_int(rex_wrap_i32(rex_int_sub(win_w_1, 120))), rex_num(16), rex_int(best_1), rex_ref(&fg_1));
+    if ((state_1 == 0)) {
+      rex_ui_text(rex_num(20), rex_num(40), rex_ref(&msg_start_1), rex_ref(&fg_1));
+    }
+    if ((state_1 == 2)) {
+      double rs_x_1 = ((((double)win_w_1) - restart_w_1) / 2.0);
+      double rs_y_1 = (((((double)win_h_1) - restart_h_1) / 2.0) + 10.0);
+      rex_ui_text(rex_int(rex_wrap_i32(rex_int_div(rex_wrap_i32(rex_int_sub(win_w_1, 80)), 2))), rex_int(rex_wrap_i32(rex_int_sub(rex_wrap_i32(rex_int_div(win_h_1, 2)), 20))), rex_ref(&msg_over_1), rex_ref(&fg_1));
+      rex_ui_image_region(rex_ref(&sheet_1), rex_num(restart_x_1), rex_num(restart_y_1), rex_num(restart_src_w_1), rex_num(restart_src_h_1), rex_num(rs_x_1), rex_num(rs_y_1), rex_num(restart_w_1), rex_num(restart_h_1));
+      if (rex_is_truthy(rex_ui_mouse_pressed())) {
+        double mx_1 = rex_unbox_num(rex_ui_mouse_x());
+        double my_1 = rex_unbox_num(rex_ui_mouse_y());
+        if (((((mx_1 >= rs_x_1) && (mx_1 <= (rs_x_1 + restart_w_1))) && (my_1 >= rs_y_1)) && (my_1 <= (rs_y_1 + restart_h_1)))) {
+          jump_request_1 = 1;
+        }
+      }
+      rex_ui_text(rex_num(20), rex_num(40), rex_ref(&msg_restart_1), rex_ref(&fg_1));
+    }
+    rex_ui_end();
+  }
+  rex_drop(moon_phases_1);
+  rex_drop(sound_hit_1);
+  rex_drop(sound_score_1);
+  rex_drop(sound_jump_1);
+  rex_drop(msg_over_1);
+  rex_drop(msg_restart_1);
+  rex_drop(msg_start_1);
+  rex_drop(fg_1);
+  rex_drop(bg_1);
+  rex_drop(title_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
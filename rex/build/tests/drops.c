@@ -0,0 +1,206 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_label(RexValue i);
+static RexValue rex_user_squares(RexValue n);
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_1 = { { 5, 0, 0, REX_STR_STATIC }, "even-" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_2 = { { 4, 0, 0, REX_STR_STATIC }, "odd-" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[1]; } rex_strlit_3 = { { 0, 0, 0, REX_STR_STATIC }, "" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_4 = { { 4, 0, 0, REX_STR_STATIC }, "row " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_5 = { { 2, 0, 0, REX_STR_STATIC }, ": " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_6 = { { 7, 0, 0, REX_STR_STATIC }, "total: " };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_7 = { { 6, 0, 0, REX_STR_STATIC }, "last: " };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+
+
+static RexValue rex_user_label(RexValue i) {
+  if ((rex_wrap_i32(rex_int_mod(rex_wrap_i32(rex_unbox_int(i)), 2)) == 0)) {
+    RexValue __tmp1 = rex_format(i);
+    RexValue even_1 = rex_add(rex_strval_1, __tmp1);
+    rex_drop(__tmp1);
+    return even_1;
+  }
+  RexValue __tmp2 = rex_format(i);
+  RexValue odd_1 = rex_add(rex_strval_2, __tmp2);
+  rex_drop(__tmp2);
+  return odd_1;
+  return rex_nil();
+}
+
+static RexValue rex_user_squares(RexValue n) {
+  RexValue out_1 = rex_collections_vec_new_typed(REX_VEC_I64);
+  int64_t __start3 = 0;
+  int64_t __end3 = rex_wrap_i32(rex_unbox_int(n));
+  for (int64_t __idx3 = __start3; __idx3 < __end3; __idx3++) {
+    int64_t i_1 = __idx3;
+    rex_collections_vec_push_i64(rex_ref_mut(&out_1), rex_wrap_i32(rex_int_mul(i_1, i_1)));
+  }
+  return out_1;
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  RexValue last_1 = rex_strval_3;
+  double total_1 = 0.0;
+  int64_t __start4 = 0;
+  int64_t __end4 = 1000000;
+  for (int64_t __idx4 = __start4; __idx4 < __end4; __idx4++) {
+    double i_2 = ((double)__idx4);
+    RexValue name_1 = rex_user_label(rex_num(i_2));
+    RexValue __tmp5 = rex_format(rex_num(i_2));
+    RexValue __tmp6 = rex_add(rex_strval_4, __tmp5);
+    RexValue __tmp7 = rex_add(__tmp6, rex_strval_5);
+    RexValue row_1 = rex_add(__tmp7, name_1);
+    rex_drop(__tmp5);
+    rex_drop(__tmp6);
+    rex_drop(__tmp7);
+    RexValue sq_1 = rex_user_squares(rex_num(4));
+    total_1 = (total_1 + rex_unbox_num(rex_collections_vec_len(rex_ref(&sq_1))));
+    if ((fmod(i_2, 250000.0) == 0.0)) {
+      rex_println(row_1);
+    }
+    if ((i_2 >= 999998.0)) {
+      rex_drop(sq_1);
+      rex_drop(row_1);
+      rex_drop(name_1);
+      continue;
+    }
+    RexValue __tmp8 = rex_format(rex_num(i_2));
+    RexValue __tmp9 = rex_add(rex_strval_4, __tmp8);
+    rex_drop(last_1);
+    last_1 = __tmp9;
+    rex_drop(__tmp8);
+    rex_drop(sq_1);
+    rex_drop(row_1);
+    rex_drop(name_1);
+  }
+  RexValue __tmp10 = rex_format(rex_num(total_1));
+  RexValue __tmp11 = rex_add(rex_strval_6, __tmp10);
+  rex_println(__tmp11);
+  rex_drop(__tmp10);
+  rex_drop(__tmp11);
+  RexValue __tmp12 = rex_add(rex_strval_7, last_1);
+  rex_println(__tmp12);
+  rex_drop(__tmp12);
+  rex_drop(last_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
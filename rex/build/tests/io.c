@@ -0,0 +1,252 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[16]; } rex_strlit_1 = { { 15, 0, 0, REX_STR_STATIC }, "rex_io_demo.txt" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[17]; } rex_strlit_2 = { { 16, 0, 0, REX_STR_STATIC }, "rex_io_lines.txt" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_3 = { { 14, 0, 0, REX_STR_STATIC }, "hello from rex" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[11]; } rex_strlit_4 = { { 10, 0, 0, REX_STR_STATIC }, "write ok: " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[14]; } rex_strlit_5 = { { 13, 0, 0, REX_STR_STATIC }, "write error: " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_6 = { { 6, 0, 0, REX_STR_STATIC }, "read: " };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[13]; } rex_strlit_7 = { { 12, 0, 0, REX_STR_STATIC }, "read error: " };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[4]; } rex_strlit_8 = { { 3, 0, 0, REX_STR_STATIC }, "one" };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+static const struct { RexStrHeader h; char s[4]; } rex_strlit_9 = { { 3, 0, 0, REX_STR_STATIC }, "two" };
+static const RexValue rex_strval_9 = REX_STR_LITERAL(rex_strlit_9.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_10 = { { 5, 0, 0, REX_STR_STATIC }, "three" };
+static const RexValue rex_strval_10 = REX_STR_LITERAL(rex_strlit_10.s);
+static const struct { RexStrHeader h; char s[17]; } rex_strlit_11 = { { 16, 0, 0, REX_STR_STATIC }, "write lines ok: " };
+static const RexValue rex_strval_11 = REX_STR_LITERAL(rex_strlit_11.s);
+static const struct { RexStrHeader h; char s[20]; } rex_strlit_12 = { { 19, 0, 0, REX_STR_STATIC }, "write lines error: " };
+static const RexValue rex_strval_12 = REX_STR_LITERAL(rex_strlit_12.s);
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_13 = { { 6, 0, 0, REX_STR_STATIC }, "line: " };
+static const RexValue rex_strval_13 = REX_STR_LITERAL(rex_strlit_13.s);
+static const struct { RexStrHeader h; char s[19]; } rex_strlit_14 = { { 18, 0, 0, REX_STR_STATIC }, "read lines error: " };
+static const RexValue rex_strval_14 = REX_STR_LITERAL(rex_strlit_14.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_15 = { { 11, 0, 0, REX_STR_STATIC }, "remove ok: " };
+static const RexValue rex_strval_15 = REX_STR_LITERAL(rex_strlit_15.s);
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_16 = { { 14, 0, 0, REX_STR_STATIC }, "remove error: " };
+static const RexValue rex_strval_16 = REX_STR_LITERAL(rex_strlit_16.s);
+
+
+static RexValue rex_user_main() {
+  RexValue path_1 = rex_strval_1;
+  RexValue lines_path_1 = rex_strval_2;
+  RexValue data_1 = rex_strval_3;
+  {
+    RexValue __match1 = rex_io_write_file(rex_ref(&path_1), data_1);
+    if (rex_tag_is(__match1, "Ok")) {
+      RexValue done_1 = rex_tag_value(__match1);
+      rex_println(rex_add(rex_strval_4, rex_format(done_1)));
+    }
+    else if (rex_tag_is(__match1, "Err")) {
+      RexValue e_1 = rex_tag_value(__match1);
+      rex_println(rex_add(rex_strval_5, e_1));
+    }
+    else {
+      rex_panic("non-exhaustive match");
+    }
+  }
+  {
+    RexValue __match2 = rex_io_read_file(rex_ref(&path_1));
+    if (rex_tag_is(__match2, "Ok")) {
+      RexValue text_1 = rex_tag_value(__match2);
+      rex_println(rex_add(rex_strval_6, text_1));
+    }
+    else if (rex_tag_is(__match2, "Err")) {
+      RexValue e_2 = rex_tag_value(__match2);
+      rex_println(rex_add(rex_strval_7, e_2));
+    }
+    else {
+      rex_panic("non-exhaustive match");
+    }
+  }
+  RexValue lines_1 = rex_collections_vec_from(3, (RexValue[]){rex_strval_8, rex_strval_9, rex_strval_10});
+  {
+    RexValue __match3 = rex_io_write_lines(rex_ref(&lines_path_1), rex_ref(&lines_1));
+    if (rex_tag_is(__match3, "Ok")) {
+      RexValue done_2 = rex_tag_value(__match3);
+      rex_println(rex_add(rex_strval_11, rex_format(done_2)));
+    }
+    else if (rex_tag_is(__match3, "Err")) {
+      RexValue e_3 = rex_tag_value(__match3);
+      rex_println(rex_add(rex_strval_12, e_3));
+    }
+    else {
+      rex_panic("non-exhaustive match");
+    }
+  }
+  {
+    RexValue __match4 = rex_io_read_lines(rex_ref(&lines_path_1));
+    if (rex_tag_is(__match4, "Ok")) {
+      RexValue items_1 = rex_tag_value(__match4);
+      RexValue __iter1 = items_1;
+      RexVecView __view1 = rex_collections_vec_view(__iter1);
+      for (int64_t __idx1 = 0; __idx1 < __view1.count; __idx1++) {
+        rex_vec_view_check(&__view1);
+        RexValue line_1 = rex_vec_view_get(&__view1, __idx1);
+        RexValue __tmp2 = rex_add(rex_strval_13, line_1);
+        rex_println(__tmp2);
+        rex_drop(__tmp2);
+      }
+    }
+    else if (rex_tag_is(__match4, "Err")) {
+      RexValue e_4 = rex_tag_value(__match4);
+      rex_println(rex_add(rex_strval_14, e_4));
+    }
+    else {
+      rex_panic("non-exhaustive match");
+    }
+  }
+  {
+    RexValue __match5 = rex_fs_remove(rex_ref(&path_1));
+    if (rex_tag_is(__match5, "Ok")) {
+      RexValue done_3 = rex_tag_value(__match5);
+      rex_println(rex_add(rex_strval_15, rex_format(done_3)));
+    }
+    else if (rex_tag_is(__match5, "Err")) {
+      RexValue e_5 = rex_tag_value(__match5);
+      rex_println(rex_add(rex_strval_16, e_5));
+    }
+    else {
+      rex_panic("non-exhaustive match");
+    }
+  }
+  {
+    RexValue __match6 = rex_fs_remove(rex_ref(&lines_path_1));
+    if (rex_tag_is(__match6, "Ok")) {
+      RexValue done_4 = rex_tag_value(__match6);
+      rex_println(rex_add(rex_strval_15, rex_format(done_4)));
+    }
+    else if (rex_tag_is(__match6, "Err")) {
+      RexValue e_6 = rex_tag_value(__match6);
+      rex_println(rex_add(rex_strval_16, e_6));
+    }
+    else {
+      rex_panic("non-exhaustive match");
+    }
+  }
+  rex_drop(lines_1);
+  rex_drop(lines_path_1);
+  rex_drop(path_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
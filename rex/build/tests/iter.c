@@ -0,0 +1,263 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_over(RexValue x, RexValue limit);
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[11]; } rex_strlit_1 = { { 10, 0, 0, REX_STR_STATIC }, "  checked " };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_2 = { { 11, 0, 0, REX_STR_STATIC }, "evens x10: " };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_3 = { { 11, 0, 0, REX_STR_STATIC }, " ending at " };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[14]; } rex_strlit_4 = { { 13, 0, 0, REX_STR_STATIC }, "sum of odds: " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[37]; } rex_strlit_5 = { { 36, 0, 0, REX_STR_STATIC }, "any over 20, stops at the first hit:" };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_6 = { { 5, 0, 0, REX_STR_STATIC }, "  yes" };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_7 = { { 14, 0, 0, REX_STR_STATIC }, "skipped by &&:" };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_8 = { { 2, 0, 0, REX_STR_STATIC }, "  " };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_9 = { { 14, 0, 0, REX_STR_STATIC }, "skipped by ||:" };
+static const RexValue rex_strval_9 = REX_STR_LITERAL(rex_strlit_9.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_10 = { { 11, 0, 0, REX_STR_STATIC }, "  not empty" };
+static const RexValue rex_strval_10 = REX_STR_LITERAL(rex_strlit_10.s);
+
+
+static RexValue rex_user_over(RexValue x, RexValue limit) {
+  RexValue __tmp1 = rex_format(x);
+  RexValue __tmp2 = rex_add(rex_strval_1, __tmp1);
+  rex_println(__tmp2);
+  rex_drop(__tmp1);
+  rex_drop(__tmp2);
+  return rex_bool((rex_unbox_int(x) > rex_unbox_int(limit)));
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  RexValue values_1 = rex_collections_vec_from_typed(REX_VEC_F64, 6, (RexValue[]){rex_num(4), rex_num(8), rex_num(15), rex_num(16), rex_num(23), rex_num(42)});
+  RexValue __pipe3;
+  {
+    RexVecView __view3 = rex_collections_vec_view(rex_ref(&values_1));
+    __pipe3 = rex_collections_vec_new_typed(REX_VEC_F64);
+    for (int64_t __idx3 = 0; __idx3 < __view3.count; __idx3++) {
+      rex_vec_view_check(&__view3);
+      double x_1 = rex_vec_view_f64(&__view3, __idx3);
+      int __keep3_1 = (fmod(x_1, 2.0) == 0.0);
+      if (!__keep3_1) { continue; }
+      double x_2 = x_1;
+      double __item3_2 = (x_2 * 10.0);
+      rex_collections_vec_push_f64(__pipe3, __item3_2);
+    }
+  }
+  RexValue evens_1 = __pipe3;
+  RexValue __tmp4 = rex_format(rex_collections_vec_len(rex_ref(&evens_1)));
+  RexValue __tmp5 = rex_add(rex_strval_2, __tmp4);
+  RexValue __tmp6 = rex_add(__tmp5, rex_strval_3);
+  RexValue __tmp7 = rex_format(rex_collections_vec_last(rex_ref(&evens_1)));
+  RexValue __tmp8 = rex_add(__tmp6, __tmp7);
+  rex_println(__tmp8);
+  rex_drop(__tmp4);
+  rex_drop(__tmp5);
+  rex_drop(__tmp6);
+  rex_drop(__tmp7);
+  rex_drop(__tmp8);
+  RexValue __pipe9;
+  {
+    RexVecView __view9 = rex_collections_vec_view(rex_ref(&values_1));
+    double __acc9 = 0;
+    for (int64_t __idx9 = 0; __idx9 < __view9.count; __idx9++) {
+      rex_vec_view_check(&__view9);
+      double x_3 = rex_vec_view_f64(&__view9, __idx9);
+      int __keep9_1 = (fmod(x_3, 2.0) == 1.0);
+      if (!__keep9_1) { continue; }
+      __acc9 += x_3;
+    }
+    __pipe9 = rex_num(__acc9);
+  }
+  RexValue __tmp10 = rex_format(__pipe9);
+  RexValue __tmp11 = rex_add(rex_strval_4, __tmp10);
+  rex_println(__tmp11);
+  rex_drop(__tmp10);
+  rex_drop(__tmp11);
+  int empty_1 = (rex_unbox_num(rex_collections_vec_len(rex_ref(&values_1))) == 0.0);
+  rex_println(rex_strval_5);
+  int __logic12 = empty_1;
+  if (!__logic12) {
+    RexValue __pipe13;
+    {
+      RexVecView __view13 = rex_collections_vec_view(rex_ref(&values_1));
+      int __acc13 = 0;
+      for (int64_t __idx13 = 0; __idx13 < __view13.count; __idx13++) {
+        rex_vec_view_check(&__view13);
+        double x_4 = rex_vec_view_f64(&__view13, __idx13);
+        int __hit13 = rex_is_truthy(rex_user_over(rex_num(x_4), rex_num(20)));
+        if (__hit13) { __acc13 = 1; break; }
+      }
+      __pipe13 = rex_bool(__acc13);
+    }
+    __logic12 = rex_is_truthy(__pipe13);
+  }
+  if (__logic12) {
+    rex_println(rex_strval_6);
+  }
+  rex_println(rex_strval_7);
+  int __logic14 = empty_1;
+  if (__logic14) {
+    RexValue __pipe15;
+    {
+      RexVecView __view15 = rex_collections_vec_view(rex_ref(&values_1));
+      int __acc15 = 1;
+      for (int64_t __idx15 = 0; __idx15 < __view15.count; __idx15++) {
+        rex_vec_view_check(&__view15);
+        double x_5 = rex_vec_view_f64(&__view15, __idx15);
+        int __hit15 = rex_is_truthy(rex_user_over(rex_num(x_5), rex_num(0)));
+        if (!__hit15) { __acc15 = 0; break; }
+      }
+      __pipe15 = rex_bool(__acc15);
+    }
+    __logic14 = rex_is_truthy(__pipe15);
+  }
+  int all_positive_1 = __logic14;
+  RexValue __tmp16 = rex_format(rex_bool(all_positive_1));
+  RexValue __tmp17 = rex_add(rex_strval_8, __tmp16);
+  rex_println(__tmp17);
+  rex_drop(__tmp16);
+  rex_drop(__tmp17);
+  rex_println(rex_strval_9);
+  int __logic18 = (!empty_1);
+  if (!__logic18) {
+    RexValue __pipe19;
+    {
+      RexVecView __view19 = rex_collections_vec_view(rex_ref(&values_1));
+      int __acc19 = 0;
+      for (int64_t __idx19 = 0; __idx19 < __view19.count; __idx19++) {
+        rex_vec_view_check(&__view19);
+        double x_6 = rex_vec_view_f64(&__view19, __idx19);
+        int __hit19 = rex_is_truthy(rex_user_over(rex_num(x_6), rex_num(100)));
+        if (__hit19) { __acc19 = 1; break; }
+      }
+      __pipe19 = rex_bool(__acc19);
+    }
+    __logic18 = rex_is_truthy(__pipe19);
+  }
+  if (__logic18) {
+    rex_println(rex_strval_10);
+  }
+  rex_drop(evens_1);
+  rex_drop(values_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_1 = { { 4, 0, 0, REX_STR_STATIC }, "name" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[4]; } rex_strlit_2 = { { 3, 0, 0, REX_STR_STATIC }, "rex" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_3 = { { 6, 0, 0, REX_STR_STATIC }, "scores" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_4 = { { 6, 0, 0, REX_STR_STATIC }, "active" };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_5 = { { 14, 0, 0, REX_STR_STATIC }, "encode error: " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[64]; } rex_strlit_6 = { { 63, 0, 0, REX_STR_STATIC }, "{\"ok\":true,\"nums\":[10,20,30],\"emoji\":\"\\uD83D\\uDE00\",\"nil\":null}" };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_7 = { { 14, 0, 0, REX_STR_STATIC }, "decode error: " };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+
+
+static RexValue rex_user_main() {
+  RexValue scores_1 = rex_collections_vec_from_typed(REX_VEC_F64, 3, (RexValue[]){rex_num(1), rex_num(2), rex_num(3)});
+  RexValue obj_1 = rex_collections_map_new();
+  rex_collections_map_put(rex_ref_mut(&obj_1), rex_strval_1, rex_strval_2);
+  rex_collections_map_put(rex_ref_mut(&obj_1), rex_strval_3, scores_1);
+  rex_collections_map_put(rex_ref_mut(&obj_1), rex_strval_4, rex_bool(1));
+  {
+    RexValue __match1 = rex_json_encode_pretty(obj_1, rex_num(2));
+    if (rex_tag_is(__match1, "Ok")) {
+      RexValue text_1 = rex_tag_value(__match1);
+      rex_println(text_1);
+    }
+    else if (rex_tag_is(__match1, "Err")) {
+      RexValue e_1 = rex_tag_value(__match1);
+      rex_println(rex_add(rex_strval_5, e_1));
+    }
+    else {
+      rex_panic("non-exhaustive match");
+    }
+  }
+  RexValue raw_1 = rex_strval_6;
+  {
+    RexValue __match2 = rex_json_decode(rex_ref(&raw_1));
+    if (rex_tag_is(__match2, "Ok")) {
+      RexValue v_1 = rex_tag_value(__match2);
+      {
+        RexValue __match3 = rex_json_encode_pretty(v_1, rex_num(2));
+        if (rex_tag_is(__match3, "Ok")) {
+          RexValue text_2 = rex_tag_value(__match3);
+          rex_println(text_2);
+        }
+        else if (rex_tag_is(__match3, "Err")) {
+          RexValue e_2 = rex_tag_value(__match3);
+          rex_println(rex_add(rex_strval_5, e_2));
+        }
+        else {
+          rex_panic("non-exhaustive match");
+        }
+      }
+    }
+    else if (rex_tag_is(__match2, "Err")) {
+      RexValue e_3 = rex_tag_value(__match2);
+      rex_println(rex_add(rex_strval_7, e_3));
+    }
+    else {
+      rex_panic("non-exhaustive match");
+    }
+  }
+  rex_drop(raw_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
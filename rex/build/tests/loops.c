@@ -0,0 +1,177 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_1 = { { 4, 0, 0, REX_STR_STATIC }, "done" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_2 = { { 4, 0, 0, REX_STR_STATIC }, "oops" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+
+
+static RexValue rex_user_main() {
+  int64_t x_1 = rex_wrap_i32(0);
+  while ((x_1 < 3)) {
+    rex_println(rex_int(x_1));
+    x_1 = rex_wrap_i32(rex_int_add(x_1, 1));
+  }
+  int64_t __start1 = 0;
+  int64_t __end1 = 10;
+  for (int64_t __idx1 = __start1; __idx1 < __end1; __idx1++) {
+    double i_1 = ((double)__idx1);
+    if ((i_1 == 3.0)) {
+      continue;
+    }
+    if ((i_1 == 7.0)) {
+      break;
+    }
+    rex_println(rex_num(i_1));
+  }
+  int64_t __start2 = 0;
+  int64_t __step2 = 4;
+  int64_t __end2 = 10;
+  uint64_t __trips2 = rex_range_count(__start2, __end2, __step2);
+  for (uint64_t __k2 = 0; __k2 < __trips2; __k2++) {
+    int64_t __idx2 = (int64_t)((uint64_t)__start2 + __k2 * (uint64_t)__step2);
+    double i_2 = ((double)__idx2);
+    rex_println(rex_num(i_2));
+  }
+  int64_t __start3 = 3;
+  int64_t __step3 = rex_int_neg(1);
+  int64_t __end3 = 0;
+  uint64_t __trips3 = rex_range_count(__start3, __end3, __step3);
+  for (uint64_t __k3 = 0; __k3 < __trips3; __k3++) {
+    int64_t __idx3 = (int64_t)((uint64_t)__start3 + __k3 * (uint64_t)__step3);
+    double i_3 = ((double)__idx3);
+    rex_println(rex_num(i_3));
+  }
+  RexValue v_1 = rex_collections_vec_from_typed(REX_VEC_F64, 3, (RexValue[]){rex_num(10), rex_num(20), rex_num(30)});
+  RexValue part_1 = rex_collections_slice(v_1, rex_num(0), rex_num(2));
+  rex_println(rex_collections_vec_get_at(part_1, 1));
+  RexValue __iter4 = v_1;
+  RexVecView __view4 = rex_collections_vec_view(__iter4);
+  for (int64_t __idx4 = 0; __idx4 < __view4.count; __idx4++) {
+    rex_vec_view_check(&__view4);
+    double n_1 = rex_vec_view_f64(&__view4, __idx4);
+    rex_println(rex_num(n_1));
+  }
+  if ((x_1 == 3)) {
+    rex_println(rex_strval_1);
+  } else {
+    rex_println(rex_strval_2);
+  }
+  rex_drop(part_1);
+  rex_drop(v_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
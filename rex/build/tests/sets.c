@@ -0,0 +1,244 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_1 = { { 1, 0, 0, REX_STR_STATIC }, "," };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[9]; } rex_strlit_2 = { { 8, 0, 0, REX_STR_STATIC }, "unique: " };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_3 = { { 11, 0, 0, REX_STR_STATIC }, "intersect: " };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_4 = { { 7, 0, 0, REX_STR_STATIC }, "union: " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[13]; } rex_strlit_5 = { { 12, 0, 0, REX_STR_STATIC }, "difference: " };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_6 = { { 7, 0, 0, REX_STR_STATIC }, "has 6: " };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_7 = { { 5, 0, 0, REX_STR_STATIC }, "big: " };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[9]; } rex_strlit_8 = { { 8, 0, 0, REX_STR_STATIC }, "has 99: " };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+static const struct { RexStrHeader h; char s[10]; } rex_strlit_9 = { { 9, 0, 0, REX_STR_STATIC }, "has 100: " };
+static const RexValue rex_strval_9 = REX_STR_LITERAL(rex_strlit_9.s);
+static const struct { RexStrHeader h; char s[10]; } rex_strlit_10 = { { 9, 0, 0, REX_STR_STATIC }, "has 249: " };
+static const RexValue rex_strval_10 = REX_STR_LITERAL(rex_strlit_10.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_11 = { { 11, 0, 0, REX_STR_STATIC }, "big total: " };
+static const RexValue rex_strval_11 = REX_STR_LITERAL(rex_strlit_11.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_12 = { { 1, 0, 0, REX_STR_STATIC }, "b" };
+static const RexValue rex_strval_12 = REX_STR_LITERAL(rex_strlit_12.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_13 = { { 1, 0, 0, REX_STR_STATIC }, "a" };
+static const RexValue rex_strval_13 = REX_STR_LITERAL(rex_strlit_13.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_14 = { { 1, 0, 0, REX_STR_STATIC }, "c" };
+static const RexValue rex_strval_14 = REX_STR_LITERAL(rex_strlit_14.s);
+
+
+static RexValue rex_user_main() {
+  RexValue raw_1 = rex_collections_vec_from_typed(REX_VEC_F64, 11, (RexValue[]){rex_num(3), rex_num(1), rex_num(4), rex_num(1), rex_num(5), rex_num(9), rex_num(2), rex_num(6), rex_num(5), rex_num(3), rex_num(5)});
+  RexValue odds_1 = rex_collections_vec_from_typed(REX_VEC_F64, 6, (RexValue[]){rex_num(1), rex_num(3), rex_num(5), rex_num(7), rex_num(9), rex_num(11)});
+  RexValue sep_1 = rex_strval_1;
+  RexValue a_1 = rex_collections_set_from_vec(rex_ref(&raw_1));
+  RexValue b_1 = rex_collections_set_from_vec(rex_ref(&odds_1));
+  RexValue __tmp1 = rex_format(rex_collections_set_len(rex_ref(&a_1)));
+  RexValue __tmp2 = rex_add(rex_strval_2, __tmp1);
+  rex_println(__tmp2);
+  rex_drop(__tmp1);
+  rex_drop(__tmp2);
+  RexValue both_1 = rex_collections_set_intersect(rex_ref(&a_1), rex_ref(&b_1));
+  RexValue either_1 = rex_collections_set_union(rex_ref(&a_1), rex_ref(&b_1));
+  RexValue only_a_1 = rex_collections_set_difference(rex_ref(&a_1), rex_ref(&b_1));
+  RexValue __tmp3 = rex_format(rex_collections_set_len(rex_ref(&both_1)));
+  RexValue __tmp4 = rex_add(rex_strval_3, __tmp3);
+  rex_println(__tmp4);
+  rex_drop(__tmp3);
+  rex_drop(__tmp4);
+  RexValue __tmp5 = rex_format(rex_collections_set_len(rex_ref(&either_1)));
+  RexValue __tmp6 = rex_add(rex_strval_4, __tmp5);
+  rex_println(__tmp6);
+  rex_drop(__tmp5);
+  rex_drop(__tmp6);
+  RexValue __tmp7 = rex_format(rex_collections_set_len(rex_ref(&only_a_1)));
+  RexValue __tmp8 = rex_add(rex_strval_5, __tmp7);
+  rex_println(__tmp8);
+  rex_drop(__tmp7);
+  rex_drop(__tmp8);
+  RexValue __tmp9 = rex_format(rex_collections_set_has(rex_ref(&only_a_1), rex_num(6)));
+  RexValue __tmp10 = rex_add(rex_strval_6, __tmp9);
+  rex_println(__tmp10);
+  rex_drop(__tmp9);
+  rex_drop(__tmp10);
+  RexValue big_1 = rex_collections_set_new();
+  int64_t __start11 = 0;
+  int64_t __end11 = 1000;
+  for (int64_t __idx11 = __start11; __idx11 < __end11; __idx11++) {
+    double i_1 = ((double)__idx11);
+    rex_collections_set_add(rex_ref_mut(&big_1), rex_num(fmod(i_1, 250.0)));
+  }
+  int64_t __start12 = 0;
+  int64_t __end12 = 100;
+  for (int64_t __idx12 = __start12; __idx12 < __end12; __idx12++) {
+    double i_2 = ((double)__idx12);
+    rex_collections_set_remove(rex_ref_mut(&big_1), rex_num(i_2));
+  }
+  RexValue __tmp13 = rex_format(rex_collections_set_len(rex_ref(&big_1)));
+  RexValue __tmp14 = rex_add(rex_strval_7, __tmp13);
+  rex_println(__tmp14);
+  rex_drop(__tmp13);
+  rex_drop(__tmp14);
+  RexValue __tmp15 = rex_format(rex_collections_set_has(rex_ref(&big_1), rex_num(99)));
+  RexValue __tmp16 = rex_add(rex_strval_8, __tmp15);
+  rex_println(__tmp16);
+  rex_drop(__tmp15);
+  rex_drop(__tmp16);
+  RexValue __tmp17 = rex_format(rex_collections_set_has(rex_ref(&big_1), rex_num(100)));
+  RexValue __tmp18 = rex_add(rex_strval_9, __tmp17);
+  rex_println(__tmp18);
+  rex_drop(__tmp17);
+  rex_drop(__tmp18);
+  RexValue __tmp19 = rex_format(rex_collections_set_has(rex_ref(&big_1), rex_num(249)));
+  RexValue __tmp20 = rex_add(rex_strval_10, __tmp19);
+  rex_println(__tmp20);
+  rex_drop(__tmp19);
+  rex_drop(__tmp20);
+  double total_1 = 0.0;
+  RexValue __iter21 = rex_ref(&big_1);
+  RexVecView __view21 = rex_collections_set_view(__iter21);
+  for (int64_t __idx21 = 0; __idx21 < __view21.count; __idx21++) {
+    rex_vec_view_check(&__view21);
+    int64_t x_1 = rex_wrap_i32(rex_vec_view_i64(&__view21, __idx21));
+    total_1 = (total_1 + ((double)x_1));
+  }
+  RexValue __tmp22 = rex_format(rex_num(total_1));
+  RexValue __tmp23 = rex_add(rex_strval_11, __tmp22);
+  rex_println(__tmp23);
+  rex_drop(__tmp22);
+  rex_drop(__tmp23);
+  RexValue words_1 = rex_collections_vec_from(5, (RexValue[]){rex_strval_12, rex_strval_13, rex_strval_12, rex_strval_14, rex_strval_13});
+  RexValue unique_words_1 = rex_collections_set_from_vec(rex_ref(&words_1));
+  RexValue listed_1 = rex_collections_set_values(rex_ref(&unique_words_1));
+  rex_println(rex_collections_vec_join(rex_ref(&listed_1), rex_ref(&sep_1)));
+  rex_drop(listed_1);
+  rex_drop(unique_words_1);
+  rex_drop(words_1);
+  rex_drop(big_1);
+  rex_drop(only_a_1);
+  rex_drop(either_1);
+  rex_drop(both_1);
+  rex_drop(b_1);
+  rex_drop(a_1);
+  rex_drop(sep_1);
+  rex_drop(odds_1);
+  rex_drop(raw_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_total(RexValue xs);
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_1 = { { 7, 0, 0, REX_STR_STATIC }, "total: " };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[13]; } rex_strlit_2 = { { 12, 0, 0, REX_STR_STATIC }, "window len: " };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[12]; } rex_strlit_3 = { { 11, 0, 0, REX_STR_STATIC }, "window[0]: " };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[19]; } rex_strlit_4 = { { 18, 0, 0, REX_STR_STATIC }, "best window of 3: " };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_5 = { { 5, 0, 0, REX_STR_STATIC }, "alpha" };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_6 = { { 4, 0, 0, REX_STR_STATIC }, "beta" };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_7 = { { 5, 0, 0, REX_STR_STATIC }, "gamma" };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_8 = { { 5, 0, 0, REX_STR_STATIC }, "delta" };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+static const struct { RexStrHeader h; char s[3]; } rex_strlit_9 = { { 2, 0, 0, REX_STR_STATIC }, ", " };
+static const RexValue rex_strval_9 = REX_STR_LITERAL(rex_strlit_9.s);
+
+
+static RexValue rex_user_total(RexValue xs) {
+  double n_1 = rex_unbox_num(rex_collections_vec_len(xs));
+  if ((n_1 == 0.0)) {
+    return rex_num(0);
+  }
+  if ((n_1 == 1.0)) {
+    return rex_collections_vec_get_at(xs, 0);
+  }
+  double mid_1 = (n_1 / 2.0);
+  return rex_int(rex_int_add(rex_unbox_int(rex_user_total(rex_collections_vec_slice_view(&(RexVecSlice){ { 0 } }, xs, rex_num(0), rex_num(mid_1)))), rex_unbox_int(rex_user_total(rex_collections_vec_slice_view(&(RexVecSlice){ { 0 } }, xs, rex_num(mid_1), rex_num(n_1))))));
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  RexValue v_1 = rex_collections_vec_new_typed(REX_VEC_I64);
+  int64_t __start1 = 1;
+  int64_t __end1 = 11;
+  for (int64_t __idx1 = __start1; __idx1 < __end1; __idx1++) {
+    double i_1 = ((double)__idx1);
+    rex_collections_vec_push_f64(rex_ref_mut(&v_1), (i_1 * i_1));
+  }
+  RexValue __tmp2 = rex_format(rex_user_total(rex_ref(&v_1)));
+  RexValue __tmp3 = rex_add(rex_strval_1, __tmp2);
+  rex_println(__tmp3);
+  rex_drop(__tmp2);
+  rex_drop(__tmp3);
+  RexValue window_1 = rex_collections_vec_slice_view(&(RexVecSlice){ { 0 } }, v_1, rex_num(2), rex_num(5));
+  RexValue __tmp4 = rex_format(rex_collections_vec_len(window_1));
+  RexValue __tmp5 = rex_add(rex_strval_2, __tmp4);
+  rex_println(__tmp5);
+  rex_drop(__tmp4);
+  rex_drop(__tmp5);
+  RexValue __tmp6 = rex_format(rex_collections_vec_get_at(window_1, 0));
+  RexValue __tmp7 = rex_add(rex_strval_3, __tmp6);
+  rex_println(__tmp7);
+  rex_drop(__tmp6);
+  rex_drop(__tmp7);
+  RexValue __iter8 = window_1;
+  RexVecView __view8 = rex_collections_vec_view(__iter8);
+  for (int64_t __idx8 = 0; __idx8 < __view8.count; __idx8++) {
+    rex_vec_view_check(&__view8);
+    int64_t x_1 = rex_vec_view_i64(&__view8, __idx8);
+    rex_println(rex_int(x_1));
+  }
+  double best_1 = 0.0;
+  int64_t __start9 = 0;
+  int64_t __end9 = 8;
+  for (int64_t __idx9 = __start9; __idx9 < __end9; __idx9++) {
+    double i_2 = ((double)__idx9);
+    double sum_1 = 0.0;
+    RexValue __iter10 = rex_collections_vec_slice_view(&(RexVecSlice){ { 0 } }, v_1, rex_num(i_2), rex_num((i_2 + 3.0)));
+    RexVecView __view10 = rex_collections_vec_view(__iter10);
+    for (int64_t __idx10 = 0; __idx10 < __view10.count; __idx10++) {
+      rex_vec_view_check(&__view10);
+      int64_t x_2 = rex_vec_view_i64(&__view10, __idx10);
+      sum_1 = (sum_1 + ((double)x_2));
+    }
+    if ((sum_1 > best_1)) {
+      best_1 = sum_1;
+    }
+  }
+  RexValue __tmp11 = rex_format(rex_num(best_1));
+  RexValue __tmp12 = rex_add(rex_strval_4, __tmp11);
+  rex_println(__tmp12);
+  rex_drop(__tmp11);
+  rex_drop(__tmp12);
+  RexValue words_1 = rex_collections_vec_from(4, (RexValue[]){rex_strval_5, rex_strval_6, rex_strval_7, rex_strval_8});
+  RexValue sep_1 = rex_strval_9;
+  RexValue __tmp13 = rex_fmt_join(rex_collections_vec_slice_view(&(RexVecSlice){ { 0 } }, words_1, rex_num(1), rex_num(3)), rex_ref(&sep_1));
+  rex_println(__tmp13);
+  rex_drop(__tmp13);
+  RexValue tail_1 = rex_collections_vec_slice_view(&(RexVecSlice){ { 0 } }, words_1, rex_num(2), rex_nil());
+  rex_println(rex_collections_vec_get_at(tail_1, 1));
+  rex_drop(sep_1);
+  rex_drop(words_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
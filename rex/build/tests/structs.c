@@ -0,0 +1,144 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_Point_new(RexValue f_x, RexValue f_y);
+static RexValue rex_Point_len(RexValue self);
+static RexValue rex_user_main();
+static const char* rex_fields_Point[] = {"x", "y"};
+typedef struct RexNative_Point { double f_x; double f_y; } RexNative_Point;
+static const unsigned char rex_kinds_Point[] = {REX_FIELD_NUM, REX_FIELD_NUM};
+static const size_t rex_offsets_Point[] = {offsetof(RexNative_Point, f_x), offsetof(RexNative_Point, f_y)};
+static const RexStructLayout rex_layout_Point = {"Point", rex_fields_Point, rex_kinds_Point, rex_offsets_Point, 2, sizeof(RexNative_Point)};
+static RexValue rex_Point_new(RexValue f_x, RexValue f_y) {
+  RexNative_Point __rex_native = {rex_unbox_num(f_x), rex_unbox_num(f_y)};
+  return rex_struct_new_native(&rex_layout_Point, &__rex_native);
+}
+
+
+static RexValue rex_Point_len(RexValue self) {
+  return rex_sqrt(rex_num(((((RexNative_Point*)rex_struct_data(self, &rex_layout_Point))->f_x * ((RexNative_Point*)rex_struct_data(self, &rex_layout_Point))->f_x) + (((RexNative_Point*)rex_struct_data(self, &rex_layout_Point))->f_y * ((RexNative_Point*)rex_struct_data(self, &rex_layout_Point))->f_y))));
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  RexValue p_1 = rex_Point_new(rex_num(3), rex_num(4));
+  RexValue q_1 = rex_Point_new(rex_num(5), rex_num(12));
+  ((RexNative_Point*)rex_struct_data_mut(q_1, &rex_layout_Point))->f_x = 6.0;
+  rex_println(rex_Point_len(p_1));
+  rex_println(rex_Point_len(q_1));
+  rex_drop(q_1);
+  rex_drop(p_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
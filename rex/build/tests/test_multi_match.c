@@ -0,0 +1,190 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_axis(RexValue d);
+static RexValue rex_user_severity(RexValue s);
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[9]; } rex_strlit_1 = { { 8, 0, 0, REX_STR_STATIC }, "vertical" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[11]; } rex_strlit_2 = { { 10, 0, 0, REX_STR_STATIC }, "horizontal" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_3 = { { 4, 0, 0, REX_STR_STATIC }, "fine" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_4 = { { 7, 0, 0, REX_STR_STATIC }, "warning" };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[4]; } rex_strlit_5 = { { 3, 0, 0, REX_STR_STATIC }, "bad" };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[11]; } rex_strlit_6 = { { 10, 0, 0, REX_STR_STATIC }, "acceptable" };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_7 = { { 14, 0, 0, REX_STR_STATIC }, "not acceptable" };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+
+
+static RexValue rex_user_axis(RexValue d) {
+  {
+    RexValue __match1 = d;
+    if (rex_tag_is(__match1, "North") || rex_tag_is(__match1, "South")) {
+      rex_println(rex_strval_1);
+    }
+    else if (rex_tag_is(__match1, "East") || rex_tag_is(__match1, "West")) {
+      rex_println(rex_strval_2);
+    }
+    else {
+      rex_panic("non-exhaustive match");
+    }
+  }
+  return rex_nil();
+}
+
+static RexValue rex_user_severity(RexValue s) {
+  {
+    RexValue __match2 = s;
+    if (rex_tag_is(__match2, "Ok")) {
+      rex_println(rex_strval_3);
+    }
+    else if (rex_tag_is(__match2, "Warn")) {
+      rex_println(rex_strval_4);
+    }
+    else if (rex_tag_is(__match2, "Error") || rex_tag_is(__match2, "Fatal")) {
+      rex_println(rex_strval_5);
+    }
+    else {
+      rex_panic("non-exhaustive match");
+    }
+  }
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  rex_user_axis(rex_tag("North", rex_nil()));
+  rex_user_axis(rex_tag("East", rex_nil()));
+  rex_user_axis(rex_tag("South", rex_nil()));
+  rex_user_axis(rex_tag("West", rex_nil()));
+  rex_user_severity(rex_tag("Ok", rex_nil()));
+  rex_user_severity(rex_tag("Warn", rex_nil()));
+  rex_user_severity(rex_tag("Error", rex_nil()));
+  rex_user_severity(rex_tag("Fatal", rex_nil()));
+  RexValue x_1 = rex_tag("Warn", rex_nil());
+  {
+    RexValue __match3 = x_1;
+    if (rex_tag_is(__match3, "Ok") || rex_tag_is(__match3, "Warn")) {
+      rex_println(rex_strval_6);
+    }
+    else {
+      rex_println(rex_strval_7);
+    }
+  }
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_Outer_new(RexValue f_inner, RexValue f_label);
+static RexValue rex_Inner_new(RexValue f_value);
+static RexValue rex_Inner_get(RexValue self);
+static RexValue rex_user_main();
+static const char* rex_fields_Outer[] = {"inner", "label"};
+static RexValue rex_Outer_new(RexValue f_inner, RexValue f_label) {
+  RexValue __rex_values[] = {f_inner, f_label};
+  return rex_struct_new("Outer", rex_fields_Outer, __rex_values, 2);
+}
+
+static const char* rex_fields_Inner[] = {"value"};
+typedef struct RexNative_Inner { double f_value; } RexNative_Inner;
+static const unsigned char rex_kinds_Inner[] = {REX_FIELD_NUM};
+static const size_t rex_offsets_Inner[] = {offsetof(RexNative_Inner, f_value)};
+static const RexStructLayout rex_layout_Inner = {"Inner", rex_fields_Inner, rex_kinds_Inner, rex_offsets_Inner, 1, sizeof(RexNative_Inner)};
+static RexValue rex_Inner_new(RexValue f_value) {
+  RexNative_Inner __rex_native = {rex_unbox_num(f_value)};
+  return rex_struct_new_native(&rex_layout_Inner, &__rex_native);
+}
+
+static const struct { RexStrHeader h; char s[5]; } rex_strlit_1 = { { 4, 0, 0, REX_STR_STATIC }, "test" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_2 = { { 5, 0, 0, REX_STR_STATIC }, "hello" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+
+
+static RexValue rex_Inner_get(RexValue self) {
+  return rex_num(((RexNative_Inner*)rex_struct_data(self, &rex_layout_Inner))->f_value);
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  RexValue o_1 = rex_Outer_new(rex_Inner_new(rex_num(0)), rex_strval_1);
+  rex_struct_set_at(o_1, rex_fields_Outer, 1, rex_strval_2);
+  rex_println(rex_struct_get_at(o_1, rex_fields_Outer, 1));
+  ((RexNative_Inner*)rex_struct_data_mut(rex_struct_get_at(o_1, rex_fields_Outer, 0), &rex_layout_Inner))->f_value = 99.0;
+  rex_println(rex_Inner_get(rex_struct_get_at(o_1, rex_fields_Outer, 0)));
+  ((RexNative_Inner*)rex_struct_data_mut(rex_struct_get_at(o_1, rex_fields_Outer, 0), &rex_layout_Inner))->f_value = (((RexNative_Inner*)rex_struct_data(rex_struct_get_at(o_1, rex_fields_Outer, 0), &rex_layout_Inner))->f_value + 1.0);
+  RexValue __tmp1 = rex_format(rex_Inner_get(rex_struct_get_at(o_1, rex_fields_Outer, 0)));
+  rex_println(__tmp1);
+  rex_drop(__tmp1);
+  RexValue items_1 = rex_collections_vec_from(1, (RexValue[]){rex_Inner_new(rex_num(5))});
+  ((RexNative_Inner*)rex_struct_data_mut(rex_collections_vec_get_at(items_1, 0), &rex_layout_Inner))->f_value = (((RexNative_Inner*)rex_struct_data(rex_collections_vec_get_at(items_1, 0), &rex_layout_Inner))->f_value + 5.0);
+  RexValue __tmp2 = rex_format(rex_num(((RexNative_Inner*)rex_struct_data(rex_collections_vec_get_at(items_1, 0), &rex_layout_Inner))->f_value));
+  rex_println(__tmp2);
+  rex_drop(__tmp2);
+  rex_drop(items_1);
+  rex_drop(o_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_Leaf_new(RexValue f_value);
+static RexValue rex_Mid_new(RexValue f_leaf);
+static RexValue rex_Top_new(RexValue f_mid);
+static RexValue rex_user_main();
+static const char* rex_fields_Leaf[] = {"value"};
+typedef struct RexNative_Leaf { double f_value; } RexNative_Leaf;
+static const unsigned char rex_kinds_Leaf[] = {REX_FIELD_NUM};
+static const size_t rex_offsets_Leaf[] = {offsetof(RexNative_Leaf, f_value)};
+static const RexStructLayout rex_layout_Leaf = {"Leaf", rex_fields_Leaf, rex_kinds_Leaf, rex_offsets_Leaf, 1, sizeof(RexNative_Leaf)};
+static RexValue rex_Leaf_new(RexValue f_value) {
+  RexNative_Leaf __rex_native = {rex_unbox_num(f_value)};
+  return rex_struct_new_native(&rex_layout_Leaf, &__rex_native);
+}
+
+static const char* rex_fields_Mid[] = {"leaf"};
+static RexValue rex_Mid_new(RexValue f_leaf) {
+  RexValue __rex_values[] = {f_leaf};
+  return rex_struct_new("Mid", rex_fields_Mid, __rex_values, 1);
+}
+
+static const char* rex_fields_Top[] = {"mid"};
+static RexValue rex_Top_new(RexValue f_mid) {
+  RexValue __rex_values[] = {f_mid};
+  return rex_struct_new("Top", rex_fields_Top, __rex_values, 1);
+}
+
+
+static RexValue rex_user_main() {
+  RexValue t_1 = rex_Top_new(rex_Mid_new(rex_Leaf_new(rex_num(1))));
+  ((RexNative_Leaf*)rex_struct_data_mut(rex_struct_get_at(rex_struct_get_at(t_1, rex_fields_Top, 0), rex_fields_Mid, 0), &rex_layout_Leaf))->f_value = 5.0;
+  rex_println(rex_num(((RexNative_Leaf*)rex_struct_data(rex_struct_get_at(rex_struct_get_at(t_1, rex_fields_Top, 0), rex_fields_Mid, 0), &rex_layout_Leaf))->f_value));
+  ((RexNative_Leaf*)rex_struct_data_mut(rex_struct_get_at(rex_struct_get_at(t_1, rex_fields_Top, 0), rex_fields_Mid, 0), &rex_layout_Leaf))->f_value = (((RexNative_Leaf*)rex_struct_data(rex_struct_get_at(rex_struct_get_at(t_1, rex_fields_Top, 0), rex_fields_Mid, 0), &rex_layout_Leaf))->f_value + 2.0);
+  rex_println(rex_num(((RexNative_Leaf*)rex_struct_data(rex_struct_get_at(rex_struct_get_at(t_1, rex_fields_Top, 0), rex_fields_Mid, 0), &rex_layout_Leaf))->f_value));
+  RexValue items_1 = rex_collections_vec_from(2, (RexValue[]){rex_Top_new(rex_Mid_new(rex_Leaf_new(rex_num(3)))), rex_Top_new(rex_Mid_new(rex_Leaf_new(rex_num(8))))});
+  ((RexNative_Leaf*)rex_struct_data_mut(rex_struct_get_at(rex_struct_get_at(rex_collections_vec_get_at(items_1, 0), rex_fields_Top, 0), rex_fields_Mid, 0), &rex_layout_Leaf))->f_value = 11.0;
+  rex_println(rex_num(((RexNative_Leaf*)rex_struct_data(rex_struct_get_at(rex_struct_get_at(rex_collections_vec_get_at(items_1, 0), rex_fields_Top, 0), rex_fields_Mid, 0), &rex_layout_Leaf))->f_value));
+  ((RexNative_Leaf*)rex_struct_data_mut(rex_struct_get_at(rex_struct_get_at(rex_collections_vec_get_at(items_1, 1), rex_fields_Top, 0), rex_fields_Mid, 0), &rex_layout_Leaf))->f_value = (((RexNative_Leaf*)rex_struct_data(rex_struct_get_at(rex_struct_get_at(rex_collections_vec_get_at(items_1, 1), rex_fields_Top, 0), rex_fields_Mid, 0), &rex_layout_Leaf))->f_value + 4.0);
+  rex_println(rex_num(((RexNative_Leaf*)rex_struct_data(rex_struct_get_at(rex_struct_get_at(rex_collections_vec_get_at(items_1, 1), rex_fields_Top, 0), rex_fields_Mid, 0), &rex_layout_Leaf))->f_value));
+  RexValue nums_1 = rex_collections_vec_from_typed(REX_VEC_F64, 3, (RexValue[]){rex_num(1), rex_num(2), rex_num(3)});
+  rex_collections_vec_set_f64(nums_1, 1, 9.0);
+  rex_println(rex_collections_vec_get_at(nums_1, 1));
+  rex_collections_vec_set_f64(nums_1, 1, (rex_collections_vec_get_f64(nums_1, 1) + 5.0));
+  rex_println(rex_collections_vec_get_at(nums_1, 1));
+  rex_drop(nums_1);
+  rex_drop(items_1);
+  rex_drop(t_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
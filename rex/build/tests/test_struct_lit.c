@@ -0,0 +1,173 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_Vec2_new(RexValue f_x, RexValue f_y);
+static RexValue rex_Person_new(RexValue f_name, RexValue f_age);
+static RexValue rex_Vec2_len(RexValue self);
+static RexValue rex_user_greet(RexValue p);
+static RexValue rex_user_main();
+static const char* rex_fields_Vec2[] = {"x", "y"};
+typedef struct RexNative_Vec2 { double f_x; double f_y; } RexNative_Vec2;
+static const unsigned char rex_kinds_Vec2[] = {REX_FIELD_NUM, REX_FIELD_NUM};
+static const size_t rex_offsets_Vec2[] = {offsetof(RexNative_Vec2, f_x), offsetof(RexNative_Vec2, f_y)};
+static const RexStructLayout rex_layout_Vec2 = {"Vec2", rex_fields_Vec2, rex_kinds_Vec2, rex_offsets_Vec2, 2, sizeof(RexNative_Vec2)};
+static RexValue rex_Vec2_new(RexValue f_x, RexValue f_y) {
+  RexNative_Vec2 __rex_native = {rex_unbox_num(f_x), rex_unbox_num(f_y)};
+  return rex_struct_new_native(&rex_layout_Vec2, &__rex_native);
+}
+
+static const char* rex_fields_Person[] = {"name", "age"};
+static RexValue rex_Person_new(RexValue f_name, RexValue f_age) {
+  RexValue __rex_values[] = {f_name, f_age};
+  return rex_struct_new("Person", rex_fields_Person, __rex_values, 2);
+}
+
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_1 = { { 6, 0, 0, REX_STR_STATIC }, "hello " };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_2 = { { 5, 0, 0, REX_STR_STATIC }, "Alice" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+
+
+static RexValue rex_Vec2_len(RexValue self) {
+  return rex_sqrt(rex_num(((((RexNative_Vec2*)rex_struct_data(self, &rex_layout_Vec2))->f_x * ((RexNative_Vec2*)rex_struct_data(self, &rex_layout_Vec2))->f_x) + (((RexNative_Vec2*)rex_struct_data(self, &rex_layout_Vec2))->f_y * ((RexNative_Vec2*)rex_struct_data(self, &rex_layout_Vec2))->f_y))));
+  return rex_nil();
+}
+
+static RexValue rex_user_greet(RexValue p) {
+  RexValue __tmp1 = rex_add(rex_strval_1, rex_struct_get_at(p, rex_fields_Person, 0));
+  rex_println(__tmp1);
+  rex_drop(__tmp1);
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  RexValue p_1 = rex_Vec2_new(rex_num(3.0), rex_num(4.0));
+  RexValue __tmp2 = rex_format(rex_Vec2_len(p_1));
+  rex_println(__tmp2);
+  rex_drop(__tmp2);
+  rex_user_greet(rex_Person_new(rex_strval_2, rex_num(30)));
+  RexValue v_1 = rex_Vec2_new(rex_num(0.0), rex_num(1.0));
+  RexValue __tmp3 = rex_format(rex_num(((RexNative_Vec2*)rex_struct_data(v_1, &rex_layout_Vec2))->f_y));
+  rex_println(__tmp3);
+  rex_drop(__tmp3);
+  RexValue q_1 = rex_Vec2_new(rex_num(5.0), rex_num(12.0));
+  RexValue __tmp4 = rex_format(rex_Vec2_len(q_1));
+  rex_println(__tmp4);
+  rex_drop(__tmp4);
+  rex_drop(q_1);
+  rex_drop(v_1);
+  rex_drop(p_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
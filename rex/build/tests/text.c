@@ -0,0 +1,236 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[24]; } rex_strlit_1 = { { 23, 0, 0, REX_STR_STATIC }, "  Hello World Example  " };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_2 = { { 1, 0, 0, REX_STR_STATIC }, "0" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_3 = { { 1, 0, 0, REX_STR_STATIC }, "-" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_4 = { { 5, 0, 0, REX_STR_STATIC }, "Hello" };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_5 = { { 7, 0, 0, REX_STR_STATIC }, "Example" };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_6 = { { 5, 0, 0, REX_STR_STATIC }, "World" };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[4]; } rex_strlit_7 = { { 3, 0, 0, REX_STR_STATIC }, "Rex" };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_8 = { { 1, 0, 0, REX_STR_STATIC }, "=" };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_9 = { { 1, 0, 0, REX_STR_STATIC }, " " };
+static const RexValue rex_strval_9 = REX_STR_LITERAL(rex_strlit_9.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_10 = { { 1, 0, 0, REX_STR_STATIC }, "." };
+static const RexValue rex_strval_10 = REX_STR_LITERAL(rex_strlit_10.s);
+static const struct { RexStrHeader h; char s[18]; } rex_strlit_11 = { { 17, 0, 0, REX_STR_STATIC }, "alpha\nbeta\r\ngamma" };
+static const RexValue rex_strval_11 = REX_STR_LITERAL(rex_strlit_11.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_12 = { { 7, 0, 0, REX_STR_STATIC }, "   left" };
+static const RexValue rex_strval_12 = REX_STR_LITERAL(rex_strlit_12.s);
+static const struct { RexStrHeader h; char s[9]; } rex_strlit_13 = { { 8, 0, 0, REX_STR_STATIC }, "right   " };
+static const RexValue rex_strval_13 = REX_STR_LITERAL(rex_strlit_13.s);
+static const struct { RexStrHeader h; char s[1]; } rex_strlit_14 = { { 0, 0, 0, REX_STR_STATIC }, "" };
+static const RexValue rex_strval_14 = REX_STR_LITERAL(rex_strlit_14.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_15 = { { 1, 0, 0, REX_STR_STATIC }, ":" };
+static const RexValue rex_strval_15 = REX_STR_LITERAL(rex_strlit_15.s);
+
+
+static RexValue rex_user_main() {
+  RexValue title_1 = rex_strval_1;
+  int64_t priority_1 = rex_wrap_i32(42);
+  RexValue zero_1 = rex_strval_2;
+  RexValue dash_1 = rex_strval_3;
+  RexValue hello_1 = rex_strval_4;
+  RexValue example_1 = rex_strval_5;
+  RexValue world_1 = rex_strval_6;
+  RexValue rex_name_1 = rex_strval_7;
+  RexValue equals_1 = rex_strval_8;
+  RexValue space_1 = rex_strval_9;
+  RexValue dots_1 = rex_strval_10;
+  RexValue multi_1 = rex_strval_11;
+  RexValue padded_left_1 = rex_strval_12;
+  RexValue padded_right_1 = rex_strval_13;
+  RexValue empty_1 = rex_strval_14;
+  RexValue trimmed_1 = rex_text_trim(rex_ref(&title_1));
+  RexValue id_1 = rex_text_initials(rex_ref(&trimmed_1));
+  RexValue padded_1 = rex_fmt_pad_left(rex_int(priority_1), rex_num(4), rex_ref(&zero_1));
+  RexValue __tmp1 = rex_add(id_1, rex_strval_15);
+  RexValue raw_1 = rex_add(__tmp1, padded_1);
+  rex_drop(__tmp1);
+  RexValue lower_1 = rex_text_lower_ascii(rex_ref(&raw_1));
+  RexValue upper_1 = rex_text_upper_ascii(rex_ref(&raw_1));
+  RexValue words_1 = rex_text_split_words(rex_ref(&trimmed_1));
+  RexValue lines_1 = rex_text_lines(rex_ref(&multi_1));
+  rex_println(lower_1);
+  rex_println(upper_1);
+  rex_println(rex_text_starts_with(rex_ref(&trimmed_1), rex_ref(&hello_1)));
+  rex_println(rex_text_ends_with(rex_ref(&trimmed_1), rex_ref(&example_1)));
+  rex_println(rex_text_contains(rex_ref(&trimmed_1), rex_ref(&world_1)));
+  RexValue __tmp2 = rex_text_replace(rex_ref(&trimmed_1), rex_ref(&world_1), rex_ref(&rex_name_1));
+  rex_println(__tmp2);
+  rex_drop(__tmp2);
+  RexValue __tmp3 = rex_text_repeat(rex_ref(&equals_1), rex_num(5));
+  rex_println(__tmp3);
+  rex_drop(__tmp3);
+  rex_println(rex_collections_vec_join(rex_ref(&words_1), rex_ref(&dash_1)));
+  RexValue __tmp4 = rex_fmt_join(rex_ref(&words_1), rex_ref(&space_1));
+  rex_println(__tmp4);
+  rex_drop(__tmp4);
+  rex_println(rex_collections_vec_len(rex_ref(&lines_1)));
+  RexValue __tmp5 = rex_text_trim_start(rex_ref(&padded_left_1));
+  rex_println(__tmp5);
+  rex_drop(__tmp5);
+  RexValue __tmp6 = rex_text_trim_end(rex_ref(&padded_right_1));
+  rex_println(__tmp6);
+  rex_drop(__tmp6);
+  rex_println(rex_text_is_empty(rex_ref(&empty_1)));
+  rex_println(rex_text_len_bytes(rex_ref(&trimmed_1)));
+  rex_println(rex_text_index_of(rex_ref(&trimmed_1), rex_ref(&world_1)));
+  rex_println(rex_text_last_index_of(rex_ref(&trimmed_1), rex_ref(&world_1)));
+  RexValue __tmp7 = rex_fmt_fixed(rex_num(3.14159), rex_num(2));
+  rex_println(__tmp7);
+  rex_drop(__tmp7);
+  RexValue __tmp8 = rex_fmt_hex(rex_num(255));
+  rex_println(__tmp8);
+  rex_drop(__tmp8);
+  RexValue __tmp9 = rex_fmt_bin(rex_num(10));
+  rex_println(__tmp9);
+  rex_drop(__tmp9);
+  RexValue __tmp10 = rex_text_pad_right(rex_ref(&rex_name_1), rex_num(6), rex_ref(&dots_1));
+  rex_println(__tmp10);
+  rex_drop(__tmp10);
+  rex_drop(lines_1);
+  rex_drop(words_1);
+  rex_drop(upper_1);
+  rex_drop(lower_1);
+  rex_drop(raw_1);
+  rex_drop(padded_1);
+  rex_drop(id_1);
+  rex_drop(trimmed_1);
+  rex_drop(empty_1);
+  rex_drop(padded_right_1);
+  rex_drop(padded_left_1);
+  rex_drop(multi_1);
+  rex_drop(dots_1);
+  rex_drop(space_1);
+  rex_drop(equals_1);
+  rex_drop(rex_name_1);
+  rex_drop(world_1);
+  rex_drop(example_1);
+  rex_drop(hello_1);
+  rex_drop(dash_1);
+  rex_drop(zero_1);
+  rex_drop(title_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,423 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "rex_rt.h"
+
+typedef enum RexBondActionKind {
+  REX_BOND_ASSIGN = 0,
+  REX_BOND_MEMBER = 1,
+  REX_BOND_INDEX = 2,
+  REX_BOND_SNAPSHOT = 3
+} RexBondActionKind;
+
+typedef struct RexBondAction {
+  RexBondActionKind kind;
+  RexValue* slot;
+  RexValue object;
+  RexValue key;
+  const char* field;
+  RexValue old_value;
+} RexBondAction;
+
+static void __rex_bond_push(RexBondAction** actions, int* count, int* cap, RexBondAction action) {
+  if (!actions || !count || !cap) {
+    rex_panic("invalid bond state");
+  }
+  if (*count >= *cap) {
+    int next = (*cap == 0) ? 8 : (*cap * 2);
+    RexBondAction* resized = (RexBondAction*)realloc(*actions, (size_t)next * sizeof(RexBondAction));
+    if (!resized) {
+      rex_panic("bond out of memory");
+    }
+    *actions = resized;
+    *cap = next;
+  }
+  (*actions)[*count] = action;
+  *count = *count + 1;
+}
+
+static void __rex_bond_push_assign(RexBondAction** actions, int* count, int* cap, RexValue* slot, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_ASSIGN;
+  action.slot = slot;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_member(RexBondAction** actions, int* count, int* cap, RexValue object, const char* field, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_MEMBER;
+  action.object = object;
+  action.field = field;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_index(RexBondAction** actions, int* count, int* cap, RexValue object, RexValue key, RexValue old_value) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_INDEX;
+  action.object = object;
+  action.key = key;
+  action.old_value = old_value;
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {
+  RexBondAction action;
+  memset(&action, 0, sizeof(action));
+  action.kind = REX_BOND_SNAPSHOT;
+  action.object = object;
+  action.old_value = rex_collections_snapshot(object);
+  __rex_bond_push(actions, count, cap, action);
+}
+
+static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {
+  for (int i = count - 1; i >= 0; --i) {
+    RexBondAction* action = &actions[i];
+    if (action->kind == REX_BOND_ASSIGN) {
+      if (action->slot) {
+        *(action->slot) = action->old_value;
+      }
+    } else if (action->kind == REX_BOND_MEMBER) {
+      rex_struct_set(action->object, action->field, action->old_value);
+    } else if (action->kind == REX_BOND_INDEX) {
+      rex_collections_set(action->object, action->key, action->old_value);
+    } else if (action->kind == REX_BOND_SNAPSHOT) {
+      rex_collections_restore(action->object, action->old_value);
+      action->old_value = rex_nil();
+    }
+  }
+}
+
+static void __rex_bond_reset(RexBondAction** actions, int* count, int* cap) {
+  if (actions && *actions) {
+    for (int i = 0; i < *count; ++i) {
+      if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {
+        rex_drop((*actions)[i].old_value);
+      }
+    }
+    free(*actions);
+    *actions = NULL;
+  }
+  if (count) { *count = 0; }
+  if (cap) { *cap = 0; }
+}
+
+static RexValue rex_user_check_winner(RexValue board);
+static RexValue rex_user_board_full(RexValue board);
+static RexValue rex_user_minimax(RexValue board, RexValue player, RexValue depth);
+static RexValue rex_user_ai_pick(RexValue board);
+static RexValue rex_user_main();
+static const struct { RexStrHeader h; char s[7]; } rex_strlit_1 = { { 6, 0, 0, REX_STR_STATIC }, "Rex XO" };
+static const RexValue rex_strval_1 = REX_STR_LITERAL(rex_strlit_1.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_2 = { { 7, 0, 0, REX_STR_STATIC }, "#F5F1E6" };
+static const RexValue rex_strval_2 = REX_STR_LITERAL(rex_strlit_2.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_3 = { { 7, 0, 0, REX_STR_STATIC }, "#EFE4CF" };
+static const RexValue rex_strval_3 = REX_STR_LITERAL(rex_strlit_3.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_4 = { { 7, 0, 0, REX_STR_STATIC }, "#2A2A2A" };
+static const RexValue rex_strval_4 = REX_STR_LITERAL(rex_strlit_4.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_5 = { { 7, 0, 0, REX_STR_STATIC }, "#6B6B6B" };
+static const RexValue rex_strval_5 = REX_STR_LITERAL(rex_strlit_5.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_6 = { { 7, 0, 0, REX_STR_STATIC }, "#E7D6BF" };
+static const RexValue rex_strval_6 = REX_STR_LITERAL(rex_strlit_6.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_7 = { { 7, 0, 0, REX_STR_STATIC }, "#D9C4A7" };
+static const RexValue rex_strval_7 = REX_STR_LITERAL(rex_strlit_7.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_8 = { { 7, 0, 0, REX_STR_STATIC }, "#C9B091" };
+static const RexValue rex_strval_8 = REX_STR_LITERAL(rex_strlit_8.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_9 = { { 7, 0, 0, REX_STR_STATIC }, "#1F8A8A" };
+static const RexValue rex_strval_9 = REX_STR_LITERAL(rex_strlit_9.s);
+static const struct { RexStrHeader h; char s[8]; } rex_strlit_10 = { { 7, 0, 0, REX_STR_STATIC }, "#BEE4E4" };
+static const RexValue rex_strval_10 = REX_STR_LITERAL(rex_strlit_10.s);
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_11 = { { 14, 0, 0, REX_STR_STATIC }, "Press New Game" };
+static const RexValue rex_strval_11 = REX_STR_LITERAL(rex_strlit_11.s);
+static const struct { RexStrHeader h; char s[14]; } rex_strlit_12 = { { 13, 0, 0, REX_STR_STATIC }, "Your turn (X)" };
+static const RexValue rex_strval_12 = REX_STR_LITERAL(rex_strlit_12.s);
+static const struct { RexStrHeader h; char s[15]; } rex_strlit_13 = { { 14, 0, 0, REX_STR_STATIC }, "AI thinking..." };
+static const RexValue rex_strval_13 = REX_STR_LITERAL(rex_strlit_13.s);
+static const struct { RexStrHeader h; char s[9]; } rex_strlit_14 = { { 8, 0, 0, REX_STR_STATIC }, "You win!" };
+static const RexValue rex_strval_14 = REX_STR_LITERAL(rex_strlit_14.s);
+static const struct { RexStrHeader h; char s[9]; } rex_strlit_15 = { { 8, 0, 0, REX_STR_STATIC }, "AI wins!" };
+static const RexValue rex_strval_15 = REX_STR_LITERAL(rex_strlit_15.s);
+static const struct { RexStrHeader h; char s[6]; } rex_strlit_16 = { { 5, 0, 0, REX_STR_STATIC }, "Draw!" };
+static const RexValue rex_strval_16 = REX_STR_LITERAL(rex_strlit_16.s);
+static const struct { RexStrHeader h; char s[10]; } rex_strlit_17 = { { 9, 0, 0, REX_STR_STATIC }, "AI starts" };
+static const RexValue rex_strval_17 = REX_STR_LITERAL(rex_strlit_17.s);
+static const struct { RexStrHeader h; char s[9]; } rex_strlit_18 = { { 8, 0, 0, REX_STR_STATIC }, "New Game" };
+static const RexValue rex_strval_18 = REX_STR_LITERAL(rex_strlit_18.s);
+static const struct { RexStrHeader h; char s[1]; } rex_strlit_19 = { { 0, 0, 0, REX_STR_STATIC }, "" };
+static const RexValue rex_strval_19 = REX_STR_LITERAL(rex_strlit_19.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_20 = { { 1, 0, 0, REX_STR_STATIC }, "X" };
+static const RexValue rex_strval_20 = REX_STR_LITERAL(rex_strlit_20.s);
+static const struct { RexStrHeader h; char s[2]; } rex_strlit_21 = { { 1, 0, 0, REX_STR_STATIC }, "O" };
+static const RexValue rex_strval_21 = REX_STR_LITERAL(rex_strlit_21.s);
+
+
+static RexValue rex_user_check_winner(RexValue board) {
+  double a0_1 = rex_collections_vec_get_f64(board, 0);
+  double a1_1 = rex_collections_vec_get_f64(board, 1);
+  double a2_1 = rex_collections_vec_get_f64(board, 2);
+  double b0_1 = rex_collections_vec_get_f64(board, 3);
+  double b1_1 = rex_collections_vec_get_f64(board, 4);
+  double b2_1 = rex_collections_vec_get_f64(board, 5);
+  double c0_1 = rex_collections_vec_get_f64(board, 6);
+  double c1_1 = rex_collections_vec_get_f64(board, 7);
+  double c2_1 = rex_collections_vec_get_f64(board, 8);
+  if ((((a0_1 != 0.0) && (a0_1 == a1_1)) && (a1_1 == a2_1))) {
+    return rex_num(a0_1);
+  }
+  if ((((b0_1 != 0.0) && (b0_1 == b1_1)) && (b1_1 == b2_1))) {
+    return rex_num(b0_1);
+  }
+  if ((((c0_1 != 0.0) && (c0_1 == c1_1)) && (c1_1 == c2_1))) {
+    return rex_num(c0_1);
+  }
+  if ((((a0_1 != 0.0) && (a0_1 == b0_1)) && (b0_1 == c0_1))) {
+    return rex_num(a0_1);
+  }
+  if ((((a1_1 != 0.0) && (a1_1 == b1_1)) && (b1_1 == c1_1))) {
+    return rex_num(a1_1);
+  }
+  if ((((a2_1 != 0.0) && (a2_1 == b2_1)) && (b2_1 == c2_1))) {
+    return rex_num(a2_1);
+  }
+  if ((((a0_1 != 0.0) && (a0_1 == b1_1)) && (b1_1 == c2_1))) {
+    return rex_num(a0_1);
+  }
+  if ((((a2_1 != 0.0) && (a2_1 == b1_1)) && (b1_1 == c0_1))) {
+    return rex_num(a2_1);
+  }
+  return rex_num(0);
+  return rex_nil();
+}
+
+static RexValue rex_user_board_full(RexValue board) {
+  double i_1 = 0.0;
+  while ((i_1 < 9.0)) {
+    if ((rex_unbox_num(rex_collections_vec_get(board, rex_num(i_1))) == 0.0)) {
+      return rex_bool(0);
+    }
+    i_1 = (i_1 + 1.0);
+  }
+  return rex_bool(1);
+  return rex_nil();
+}
+
+static RexValue rex_user_minimax(RexValue board, RexValue player, RexValue depth) {
+  double winner_1 = rex_unbox_num(rex_user_check_winner(board));
+  if ((winner_1 == 2.0)) {
+    return rex_num((10.0 - rex_unbox_num(depth)));
+  }
+  if ((winner_1 == 1.0)) {
+    return rex_num((rex_unbox_num(depth) - 10.0));
+  }
+  if (rex_is_truthy(rex_user_board_full(board))) {
+    return rex_num(0);
+  }
+  if ((rex_unbox_num(player) == 2.0)) {
+    double best_1 = (-1000.0);
+    double i_2 = 0.0;
+    while ((i_2 < 9.0)) {
+      if ((rex_unbox_num(rex_collections_vec_get(board, rex_num(i_2))) == 0.0)) {
+        rex_collections_vec_set(board, rex_num(i_2), rex_num(2));
+        double score_1 = rex_unbox_num(rex_user_minimax(board, rex_num(1), rex_num((rex_unbox_num(depth) + 1.0))));
+        rex_collections_vec_set(board, rex_num(i_2), rex_num(0));
+        if ((score_1 > best_1)) {
+          best_1 = score_1;
+        }
+      }
+      i_2 = (i_2 + 1.0);
+    }
+    return rex_num(best_1);
+  }
+  double best_2 = 1000.0;
+  double i_3 = 0.0;
+  while ((i_3 < 9.0)) {
+    if ((rex_unbox_num(rex_collections_vec_get(board, rex_num(i_3))) == 0.0)) {
+      rex_collections_vec_set(board, rex_num(i_3), rex_num(1));
+      double score_2 = rex_unbox_num(rex_user_minimax(board, rex_num(2), rex_num((rex_unbox_num(depth) + 1.0))));
+      rex_collections_vec_set(board, rex_num(i_3), rex_num(0));
+      if ((score_2 < best_2)) {
+        best_2 = score_2;
+      }
+    }
+    i_3 = (i_3 + 1.0);
+  }
+  return rex_num(best_2);
+  return rex_nil();
+}
+
+static RexValue rex_user_ai_pick(RexValue board) {
+  double best_3 = (-1000.0);
+  double best_idx_1 = (-1.0);
+  double i_4 = 0.0;
+  while ((i_4 < 9.0)) {
+    if ((rex_unbox_num(rex_collections_vec_get(board, rex_num(i_4))) == 0.0)) {
+      rex_collections_vec_set(board, rex_num(i_4), rex_num(2));
+      double score_3 = rex_unbox_num(rex_user_minimax(board, rex_num(1), rex_num(0)));
+      rex_collections_vec_set(board, rex_num(i_4), rex_num(0));
+      if ((score_3 > best_3)) {
+        best_3 = score_3;
+        best_idx_1 = i_4;
+      }
+    }
+    i_4 = (i_4 + 1.0);
+  }
+  return rex_num(best_idx_1);
+  return rex_nil();
+}
+
+static RexValue rex_user_main() {
+  RexValue title_1 = rex_strval_1;
+  int64_t win_w_1 = rex_wrap_i32(360);
+  int64_t win_h_1 = rex_wrap_i32(480);
+  double cell_1 = 96.0;
+  double spacing_1 = 8.0;
+  double padding_1 = 16.0;
+  RexValue bg_1 = rex_strval_2;
+  RexValue panel_1 = rex_strval_3;
+  RexValue text_1 = rex_strval_4;
+  RexValue muted_1 = rex_strval_5;
+  RexValue button_1 = rex_strval_6;
+  RexValue button_hover_1 = rex_strval_7;
+  RexValue button_active_1 = rex_strval_8;
+  RexValue accent_1 = rex_strval_9;
+  RexValue select_1 = rex_strval_10;
+  RexValue board_1 = rex_collections_vec_from_typed(REX_VEC_F64, 9, (RexValue[]){rex_num(0), rex_num(0), rex_num(0), rex_num(0), rex_num(0), rex_num(0), rex_num(0), rex_num(0), rex_num(0)});
+  double state_1 = 0.0;
+  double winner_2 = 0.0;
+  double turn_1 = 1.0;
+  int ai_first_1 = 0;
+  while (rex_is_truthy(rex_ui_begin(rex_ref(&title_1), rex_int(win_w_1), rex_int(win_h_1)))) {
+    rex_ui_redraw();
+    rex_ui_theme_custom(rex_ref(&bg_1), rex_ref(&panel_1), rex_ref(&text_1), rex_ref(&muted_1), rex_ref(&button_1), rex_ref(&button_hover_1), rex_ref(&button_active_1), rex_ref(&accent_1), rex_ref(&select_1));
+    rex_ui_spacing(rex_num(spacing_1));
+    rex_ui_padding(rex_num(padding_1));
+    rex_ui_clear(rex_ref(&bg_1));
+    RexValue status_1 = rex_strval_11;
+    if ((state_1 == 1.0)) {
+      if ((turn_1 == 1.0)) {
+        RexValue __tmp1 = rex_strval_12;
+        rex_drop(status_1);
+        status_1 = __tmp1;
+      } else {
+        RexValue __tmp2 = rex_strval_13;
+        rex_drop(status_1);
+        status_1 = __tmp2;
+      }
+    } else {
+      if ((state_1 == 2.0)) {
+        if ((winner_2 == 1.0)) {
+          RexValue __tmp3 = rex_strval_14;
+          rex_drop(status_1);
+          status_1 = __tmp3;
+        } else {
+          if ((winner_2 == 2.0)) {
+            RexValue __tmp4 = rex_strval_15;
+            rex_drop(status_1);
+            status_1 = __tmp4;
+          } else {
+            RexValue __tmp5 = rex_strval_16;
+            rex_drop(status_1);
+            status_1 = __tmp5;
+          }
+        }
+      }
+    }
+    rex_ui_label(rex_ref(&title_1));
+    rex_ui_label(rex_ref(&status_1));
+    ai_first_1 = rex_is_truthy(rex_ui_checkbox(rex_strval_17, rex_bool(ai_first_1)));
+    if (rex_is_truthy(rex_ui_button(rex_strval_18))) {
+      board_1 = rex_collections_vec_from_typed(REX_VEC_F64, 9, (RexValue[]){rex_num(0), rex_num(0), rex_num(0), rex_num(0), rex_num(0), rex_num(0), rex_num(0), rex_num(0), rex_num(0)});
+      state_1 = 1.0;
+      winner_2 = 0.0;
+      if (ai_first_1) {
+        turn_1 = 2.0;
+      } else {
+        turn_1 = 1.0;
+      }
+    }
+    rex_ui_newline();
+    int allow_play_1 = ((state_1 == 1.0) && (turn_1 == 1.0));
+    rex_ui_enabled(rex_bool(allow_play_1));
+    rex_ui_layout_grid(rex_num(3), rex_num(cell_1), rex_num(cell_1));
+    double i_5 = 0.0;
+    int human_moved_1 = 0;
+    while ((i_5 < 9.0)) {
+      double cell_val_1 = rex_unbox_num(rex_collections_vec_get(rex_ref(&board_1), rex_num(i_5)));
+      RexValue label_1 = rex_strval_19;
+      if ((cell_val_1 == 1.0)) {
+        RexValue __tmp6 = rex_strval_20;
+        rex_drop(label_1);
+        label_1 = __tmp6;
+      } else {
+        if ((cell_val_1 == 2.0)) {
+          RexValue __tmp7 = rex_strval_21;
+          rex_drop(label_1);
+          label_1 = __tmp7;
+        }
+      }
+      if (((rex_is_truthy(rex_ui_button(rex_ref(&label_1))) && allow_play_1) && (cell_val_1 == 0.0))) {
+        rex_collections_vec_set(rex_ref_mut(&board_1), rex_num(i_5), rex_num(1));
+        human_moved_1 = 1;
+      }
+      i_5 = (i_5 + 1.0);
+      rex_drop(label_1);
+    }
+    rex_ui_enabled(rex_bool(1));
+    if (human_moved_1) {
+      double w_1 = rex_unbox_num(rex_user_check_winner(rex_ref(&board_1)));
+      if ((w_1 != 0.0)) {
+        winner_2 = w_1;
+        state_1 = 2.0;
+      } else {
+        if (rex_is_truthy(rex_user_board_full(rex_ref(&board_1)))) {
+          winner_2 = 3.0;
+          state_1 = 2.0;
+        } else {
+          turn_1 = 2.0;
+        }
+      }
+    }
+    if (((state_1 == 1.0) && (turn_1 == 2.0))) {
+      double mv_1 = rex_unbox_num(rex_user_ai_pick(rex_ref_mut(&board_1)));
+      if ((mv_1 >= 0.0)) {
+        rex_collections_vec_set(rex_ref_mut(&board_1), rex_num(mv_1), rex_num(2));
+      }
+      double w_2 = rex_unbox_num(rex_user_check_winner(rex_ref(&board_1)));
+      if ((w_2 != 0.0)) {
+        winner_2 = w_2;
+        state_1 = 2.0;
+      } else {
+        if (rex_is_truthy(rex_user_board_full(rex_ref(&board_1)))) {
+          winner_2 = 3.0;
+          state_1 = 2.0;
+        } else {
+          turn_1 = 1.0;
+        }
+      }
+    }
+    rex_ui_end();
+    rex_drop(status_1);
+  }
+  rex_drop(select_1);
+  rex_drop(accent_1);
+  rex_drop(button_active_1);
+  rex_drop(button_hover_1);
+  rex_drop(button_1);
+  rex_drop(muted_1);
+  rex_drop(text_1);
+  rex_drop(panel_1);
+  rex_drop(bg_1);
+  rex_drop(title_1);
+  return rex_nil();
+}
+
+int main(int argc, char** argv) {
+  rex_os_set_args(argc, argv);
+  rex_user_main();
+  return 0;
+}
\ No newline at end of file
@@ -31,6 +31,7 @@ local groups = {
     "ExprStmt",
     "WithinBlock",
     "DuringBlock",
+    "WithBlock",
     "DebugOwnership",
   },
   expression = {
@@ -51,6 +52,7 @@ local groups = {
     "Try",
     "Generic",
     "StructLit",
+    "Lambda",
   },
   pattern = {
     "TuplePattern",
@@ -19,7 +19,7 @@ local schema = {
   Return = { required = {}, optional = { "value" } },
   If = { required = { "cond", "then_block" }, optional = { "else_block" } },
   While = { required = { "cond", "body" } },
-  For = { required = { "name", "body" }, optional = { "range_start", "range_end", "iter" } },
+  For = { required = { "body" }, optional = { "name", "pattern", "range_start", "range_end", "range_step", "iter" } },
   Break = { required = {} },
   Continue = { required = {} },
   Match = { required = { "expr", "arms" } },
@@ -32,6 +32,7 @@ local schema = {
   ExprStmt = { required = { "expr" } },
   WithinBlock = { required = { "duration", "block" } },
   DuringBlock = { required = { "condition", "block" } },
+  WithBlock = { required = { "arena", "block" } },
   DebugOwnership = { required = { "rules" } },
 
   TuplePattern = { required = { "names" } },
@@ -54,6 +55,7 @@ local schema = {
   Try = { required = { "expr" } },
   Generic = { required = { "expr", "type_args" } },
   StructLit = { required = { "name", "fields" } },
+  Lambda = { required = { "params", "body" } },
 
   TemporalValue = { required = { "name", "value", "lifetime" } },
   OwnershipTrace = { required = { "variable", "event" } },
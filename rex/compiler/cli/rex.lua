@@ -1217,6 +1217,30 @@ local function normalize_build_mode(mode)
   error("Invalid build mode: " .. tostring(mode) .. " (expected 'release' or 'debug')")
 end
 
+local function normalize_value_repr(repr)
+  local r = repr
+  if not r or r == "" then
+    r = os.getenv("REX_VALUE_REPR") or "boxed"
+  end
+  r = tostring(r):lower()
+  if r == "boxed" or r == "nanbox" then
+    return r
+  end
+  error("Invalid value representation: " .. tostring(repr) .. " (expected 'boxed' or 'nanbox')")
+end
+
+-- Sum of every "<n>ms" reported, for benchmarks that time several phases.
+local function parse_total_ms(output)
+  local total = nil
+  for ms in (output or ""):gmatch("([%d%.]+)%s*ms") do
+    local n = tonumber(ms)
+    if n then
+      total = (total or 0) + n
+    end
+  end
+  return total
+end
+
 local function parse_elapsed_ms(output)
   if not output then
     return nil
@@ -1231,7 +1255,7 @@ local function parse_elapsed_ms(output)
   return tonumber(ms)
 end
 
-local BUILD_CACHE_VERSION = "2026-02-09-v1"
+local BUILD_CACHE_VERSION = "2026-10-17-v22"
 
 hash_data = function(data)
   local h = 5381
@@ -1315,7 +1339,7 @@ local function has_alsa()
   return false
 end
 
-local function compile_c(source, output, cc, mode)
+local function compile_c(source, output, cc, mode, value_repr)
   if not cc or cc == "" then
     error(missing_compiler_message(nil))
   end
@@ -1337,6 +1361,9 @@ local function compile_c(source, output, cc, mode)
   else
     cflags = cflags .. " -O3 -DNDEBUG"
   end
+  if normalize_value_repr(value_repr) == "nanbox" then
+    cflags = cflags .. " -DREX_NANBOX=1"
+  end
   local opt_flag = os.getenv("REX_OPT_FLAG")
   if opt_flag and opt_flag ~= "" then
     local lowered = opt_flag:lower()
@@ -1511,9 +1538,9 @@ local function usage()
   print("  rex remove <name>")
   print("  rex install")
   print("  rex deps")
-  print("  rex build [input] [--out path] [--c-out path] [--no-entry] [--no-native] [--cc compiler] [--mode release|debug]")
-  print("  rex run [input] [--cc compiler] [--mode release|debug]")
-  print("  rex bench [input] [--runs n] [--cc compiler] [--mode release|debug]")
+  print("  rex build [input] [--out path] [--c-out path] [--no-entry] [--no-native] [--cc compiler] [--mode release|debug] [--value-repr boxed|nanbox]")
+  print("  rex run [input] [--cc compiler] [--mode release|debug] [--value-repr boxed|nanbox]")
+  print("  rex bench [input] [--suite] [--runs n] [--cc compiler] [--mode release|debug] [--value-repr boxed|nanbox|both]")
   print("  rex test (builds examples to C)")
   print("  rex fmt [input]")
   print("  rex lint [input]")
@@ -1547,6 +1574,7 @@ elseif cmd == "build" then
   local native = true
   local cc = detect_default_cc()
   local mode = normalize_build_mode(nil)
+  local value_repr = nil
   local i = option_start_index(args[2])
   while i <= #args do
     local a = args[i]
@@ -1580,6 +1608,12 @@ elseif cmd == "build" then
       end
       mode = normalize_build_mode(args[i + 1])
       i = i + 1
+    elseif a == "--value-repr" then
+      if not args[i + 1] then
+        error("--value-repr requires a value")
+      end
+      value_repr = args[i + 1]
+      i = i + 1
     end
     i = i + 1
   end
@@ -1591,7 +1625,7 @@ elseif cmd == "build" then
   end
   local build_info = build(input, c_out, emit_entry)
   if native then
-    local native_info = compile_c(c_out, out, cc, mode)
+    local native_info = compile_c(c_out, out, cc, mode, value_repr)
     if native_info.cached then
       print("Native (cached) " .. out)
     else
@@ -1614,6 +1648,7 @@ elseif cmd == "run" then
   local c_out_set = false
   local cc = detect_default_cc()
   local mode = normalize_build_mode(nil)
+  local value_repr = nil
   local i = option_start_index(args[2])
   while i <= #args do
     local a = args[i]
@@ -1643,6 +1678,12 @@ elseif cmd == "run" then
       end
       mode = normalize_build_mode(args[i + 1])
       i = i + 1
+    elseif a == "--value-repr" then
+      if not args[i + 1] then
+        error("--value-repr requires a value")
+      end
+      value_repr = args[i + 1]
+      i = i + 1
     end
     i = i + 1
   end
@@ -1650,7 +1691,7 @@ elseif cmd == "run" then
     out = default_exe_path(c_out)
   end
   build(input, c_out, true)
-  compile_c(c_out, out, cc, mode)
+  compile_c(c_out, out, cc, mode, value_repr)
   if not run_exec(out) then
     error("Run failed")
   end
@@ -1659,6 +1700,8 @@ elseif cmd == "bench" then
   local runs = 5
   local cc = detect_default_cc()
   local mode = normalize_build_mode(nil)
+  local value_repr = nil
+  local suite = false
   local i = 3
   if input:sub(1, 2) == "--" then
     input = "examples/benchmark.rex"
@@ -1672,6 +1715,8 @@ elseif cmd == "bench" then
       end
       runs = tonumber(args[i + 1]) or 0
       i = i + 1
+    elseif a == "--suite" then
+      suite = true
     elseif a == "--cc" then
       if not args[i + 1] then
         error("--cc requires a value")
@@ -1684,55 +1729,99 @@ elseif cmd == "bench" then
       end
       mode = normalize_build_mode(args[i + 1])
       i = i + 1
+    elseif a == "--value-repr" then
+      if not args[i + 1] then
+        error("--value-repr requires a value")
+      end
+      value_repr = args[i + 1]
+      i = i + 1
     end
     i = i + 1
   end
   if runs < 1 then
     error("--runs must be >= 1")
   end
-  local bench_base = path_stem(input)
-  local bench_id = unique_suffix()
-  local bench_dir = join_path(resolve_build_root(), "bench")
-  local c_out = join_path(bench_dir, bench_base .. "_" .. bench_id .. ".c")
-  local out = default_exe_path(join_path(bench_dir, bench_base .. "_" .. bench_id))
-  build(input, c_out, true)
-  compile_c(c_out, out, cc, mode)
-  local run_path = cmd_path(out)
-  local count = 0
-  local sum = 0.0
-  local min_ms = nil
-  local max_ms = nil
-  for r = 1, runs do
-    local p = io.popen('"' .. run_path .. '"')
-    if not p then
-      error("Failed to run benchmark executable")
+  local function run_bench(file, repr)
+    local bench_base = path_stem(file)
+    local bench_id = unique_suffix() .. "_" .. repr
+    local bench_dir = join_path(resolve_build_root(), "bench")
+    local c_out = join_path(bench_dir, bench_base .. "_" .. bench_id .. ".c")
+    local out = default_exe_path(join_path(bench_dir, bench_base .. "_" .. bench_id))
+    build(file, c_out, true)
+    compile_c(c_out, out, cc, mode, repr)
+    local run_path = cmd_path(out)
+    local count = 0
+    local sum = 0.0
+    local min_ms = nil
+    local max_ms = nil
+    for r = 1, runs do
+      local p = io.popen('"' .. run_path .. '"')
+      if not p then
+        error("Failed to run benchmark executable")
+      end
+      local output = p:read("*a") or ""
+      local ok = p:close()
+      if ok == false then
+        error("Benchmark run failed")
+      end
+      local elapsed = parse_elapsed_ms(output) or parse_total_ms(output)
+      if elapsed then
+        count = count + 1
+        sum = sum + elapsed
+        if not min_ms or elapsed < min_ms then
+          min_ms = elapsed
+        end
+        if not max_ms or elapsed > max_ms then
+          max_ms = elapsed
+        end
+        print(string.format("run#%d elapsed_ms=%.6f", r, elapsed))
+      else
+        print("run#" .. r .. " elapsed_ms=NA")
+      end
     end
-    local output = p:read("*a") or ""
-    local ok = p:close()
-    if ok == false then
-      error("Benchmark run failed")
+    if count > 0 then
+      print(string.format("avg_ms=%.6f", sum / count))
+      print(string.format("min_ms=%.6f", min_ms))
+      print(string.format("max_ms=%.6f", max_ms))
+      return sum / count
     end
-    local elapsed = parse_elapsed_ms(output)
-    if elapsed then
-      count = count + 1
-      sum = sum + elapsed
-      if not min_ms or elapsed < min_ms then
-        min_ms = elapsed
-      end
-      if not max_ms or elapsed > max_ms then
-        max_ms = elapsed
+    print("No elapsed values parsed from output.")
+    return nil
+  end
+  local inputs = { input }
+  if suite then
+    inputs = {}
+    for _, file in ipairs(list_example_files()) do
+      if path_stem(file):match("^bench") then
+        table.insert(inputs, file)
       end
-      print(string.format("run#%d elapsed_ms=%.6f", r, elapsed))
-    else
-      print("run#" .. r .. " elapsed_ms=NA")
     end
   end
-  if count > 0 then
-    print(string.format("avg_ms=%.6f", sum / count))
-    print(string.format("min_ms=%.6f", min_ms))
-    print(string.format("max_ms=%.6f", max_ms))
-  else
-    print("No elapsed values parsed from output.")
+  local reprs = { "boxed", "nanbox" }
+  if value_repr ~= "both" then
+    reprs = { normalize_value_repr(value_repr) }
+  end
+  local rows = {}
+  for _, file in ipairs(inputs) do
+    local row = { file = file }
+    for _, repr in ipairs(reprs) do
+      if #inputs > 1 or #reprs > 1 then
+        print("== " .. file .. " [" .. repr .. "]")
+      end
+      row[repr] = run_bench(file, repr)
+    end
+    table.insert(rows, row)
+  end
+  if #reprs > 1 then
+    print("")
+    print(string.format("%-32s %12s %12s %8s", "benchmark", "boxed_ms", "nanbox_ms", "ratio"))
+    for _, row in ipairs(rows) do
+      local ratio = (row.boxed and row.nanbox and row.boxed > 0) and string.format("%.2f", row.nanbox / row.boxed) or "NA"
+      print(string.format("%-32s %12s %12s %8s", path_stem(row.file),
+        row.boxed and string.format("%.3f", row.boxed) or "NA",
+        row.nanbox and string.format("%.3f", row.nanbox) or "NA",
+        ratio))
+    end
   end
 elseif cmd == "test" then
   local files = list_example_files()
@@ -22,6 +22,16 @@ local function c_string(text)
   return "\"" .. s .. "\""
 end
 
+local function string_literal(ctx, text)
+  local name = ctx.string_literals[text]
+  if not name then
+    name = "rex_strval_" .. (#ctx.string_literal_order + 1)
+    ctx.string_literals[text] = name
+    table.insert(ctx.string_literal_order, text)
+  end
+  return name
+end
+
 local function type_base(type_str)
   if not type_str then
     return nil
@@ -91,8 +101,12 @@ function Codegen.generate(ast, opts)
     bond_id = 0,
     spawn_helpers = {},
     spawn_used = false,
+    string_literals = {},
+    string_literal_order = {},
     scopes = { {} },
     defer_stack = { {} },
+    loop_stack = {},
+    temp_drops = nil,
     bonds = {},
     active_bond_stack = {},
     active_bond = nil,
@@ -189,8 +203,10 @@ function Codegen.generate(ast, opts)
         box = "rex_box",
         unbox = "rex_unbox",
         drop = "rex_drop",
+        arena_new = "rex_mem_arena_new",
+        arena_reset = "rex_mem_arena_reset",
       },
-      math = { sqrt = "rex_sqrt", abs = "rex_abs", eval = "rex_math_eval" },
+      math = { sqrt = "rex_sqrt", abs = "rex_abs", trunc = "rex_math_trunc", eval = "rex_math_eval" },
       collections = {
         vec_new = "rex_collections_vec_new",
         vec_push = "rex_collections_vec_push",
@@ -201,7 +217,10 @@ function Codegen.generate(ast, opts)
         vec_pop = "rex_collections_vec_pop",
         vec_clear = "rex_collections_vec_clear",
         vec_sort = "rex_collections_vec_sort",
+        vec_sort_by_key = "rex_collections_vec_sort_by_key",
+        vec_par_sort = "rex_collections_vec_par_sort",
         vec_slice = "rex_collections_vec_slice",
+        vec_clone = "rex_collections_vec_clone",
         vec_from = "rex_collections_vec_from",
         vec_find = "rex_collections_vec_find",
         vec_any = "rex_collections_vec_any",
@@ -212,7 +231,15 @@ function Codegen.generate(ast, opts)
         vec_first = "rex_collections_vec_first",
         vec_last = "rex_collections_vec_last",
         vec_join = "rex_collections_vec_join",
+        vec_bytes = "rex_collections_vec_bytes",
+        vec_sum = "rex_collections_vec_sum",
+        vec_min = "rex_collections_vec_min",
+        vec_max = "rex_collections_vec_max",
+        vec_dot = "rex_collections_vec_dot",
+        vec_scale = "rex_collections_vec_scale",
+        vec_add = "rex_collections_vec_add",
         map_new = "rex_collections_map_new",
+        map_clone = "rex_collections_map_clone",
         map_put = "rex_collections_map_put",
         map_get = "rex_collections_map_get",
         map_remove = "rex_collections_map_remove",
@@ -226,6 +253,11 @@ function Codegen.generate(ast, opts)
         set_has = "rex_collections_set_has",
         set_remove = "rex_collections_set_remove",
         set_len = "rex_collections_set_len",
+        set_from_vec = "rex_collections_set_from_vec",
+        set_union = "rex_collections_set_union",
+        set_intersect = "rex_collections_set_intersect",
+        set_difference = "rex_collections_set_difference",
+        set_values = "rex_collections_set_values",
       },
       os = {
         getenv = "rex_os_getenv",
@@ -477,38 +509,38 @@ function Codegen.generate(ast, opts)
   local function emit_binary_typed(op, left, right, left_type, right_type)
     if left_type == "num" and right_type == "num" then
       if op == "+" then
-        return "rex_num((" .. left .. ").as.num + (" .. right .. ").as.num)"
+        return "rex_num(rex_as_num(" .. left .. ") + rex_as_num(" .. right .. "))"
       elseif op == "-" then
-        return "rex_num((" .. left .. ").as.num - (" .. right .. ").as.num)"
+        return "rex_num(rex_as_num(" .. left .. ") - rex_as_num(" .. right .. "))"
       elseif op == "*" then
-        return "rex_num((" .. left .. ").as.num * (" .. right .. ").as.num)"
+        return "rex_num(rex_as_num(" .. left .. ") * rex_as_num(" .. right .. "))"
       elseif op == "/" then
-        return "rex_num((" .. left .. ").as.num / (" .. right .. ").as.num)"
+        return "rex_num(rex_as_num(" .. left .. ") / rex_as_num(" .. right .. "))"
       elseif op == "%" then
-        return "rex_num(fmod((" .. left .. ").as.num, (" .. right .. ").as.num))"
+        return "rex_num(fmod(rex_as_num(" .. left .. "), rex_as_num(" .. right .. ")))"
       elseif op == "==" then
-        return "rex_bool((" .. left .. ").as.num == (" .. right .. ").as.num)"
+        return "rex_bool(rex_as_num(" .. left .. ") == rex_as_num(" .. right .. "))"
       elseif op == "!=" then
-        return "rex_bool((" .. left .. ").as.num != (" .. right .. ").as.num)"
+        return "rex_bool(rex_as_num(" .. left .. ") != rex_as_num(" .. right .. "))"
       elseif op == "<" then
-        return "rex_bool((" .. left .. ").as.num < (" .. right .. ").as.num)"
+        return "rex_bool(rex_as_num(" .. left .. ") < rex_as_num(" .. right .. "))"
       elseif op == "<=" then
-        return "rex_bool((" .. left .. ").as.num <= (" .. right .. ").as.num)"
+        return "rex_bool(rex_as_num(" .. left .. ") <= rex_as_num(" .. right .. "))"
       elseif op == ">" then
-        return "rex_bool((" .. left .. ").as.num > (" .. right .. ").as.num)"
+        return "rex_bool(rex_as_num(" .. left .. ") > rex_as_num(" .. right .. "))"
       elseif op == ">=" then
-        return "rex_bool((" .. left .. ").as.num >= (" .. right .. ").as.num)"
+        return "rex_bool(rex_as_num(" .. left .. ") >= rex_as_num(" .. right .. "))"
       end
     end
     if left_type == "bool" and right_type == "bool" then
       if op == "&&" then
-        return "rex_bool((" .. left .. ").as.boolean && (" .. right .. ").as.boolean)"
+        return "rex_bool(rex_as_bool(" .. left .. ") && rex_as_bool(" .. right .. "))"
       elseif op == "||" then
-        return "rex_bool((" .. left .. ").as.boolean || (" .. right .. ").as.boolean)"
+        return "rex_bool(rex_as_bool(" .. left .. ") || rex_as_bool(" .. right .. "))"
       elseif op == "==" then
-        return "rex_bool((" .. left .. ").as.boolean == (" .. right .. ").as.boolean)"
+        return "rex_bool(rex_as_bool(" .. left .. ") == rex_as_bool(" .. right .. "))"
       elseif op == "!=" then
-        return "rex_bool((" .. left .. ").as.boolean != (" .. right .. ").as.boolean)"
+        return "rex_bool(rex_as_bool(" .. left .. ") != rex_as_bool(" .. right .. "))"
       end
     end
     return emit_binary_fallback(op, left, right)
@@ -600,6 +632,89 @@ function Codegen.generate(ast, opts)
     return nil
   end
 
+  -- Fields of statically typed structs are read by position; the runtime
+  -- falls back to the name when handed a different struct.
+  local function struct_field_index(struct_name, property)
+    local def = struct_name and ctx.structs[struct_name]
+    if not def then
+      return nil
+    end
+    for i, field in ipairs(def.fields) do
+      if field.name == property then
+        return i - 1
+      end
+    end
+    return nil
+  end
+
+  local scalar_c_types = { num = "double", int = "int64_t", bool = "int" }
+
+  -- Integers of every width live in an int64_t; narrower widths are wrapped
+  -- back after each operation and u64 keeps its bits, reinterpreted only by
+  -- the unsigned division, comparison, conversion and boxing below.
+  local function wrap_int(code, width)
+    if not width or width == "u64" then
+      return code
+    end
+    return "rex_wrap_" .. width .. "(" .. code .. ")"
+  end
+
+  local function box_scalar(code, kind, width)
+    if kind == "int" then
+      if width == "u64" then
+        return "rex_uint((uint64_t)(" .. code .. "))"
+      end
+      return "rex_int(" .. code .. ")"
+    end
+    return (kind == "bool" and "rex_bool(" or "rex_num(") .. code .. ")"
+  end
+
+  -- Decimal integer literals are emitted exactly up to 2^64 - 1 (stripped of
+  -- leading zeros, which C would read as octal); nil when out of range.
+  local function int_literal(text)
+    local digits = text:gsub("^0+", "")
+    if digits == "" then
+      return "0"
+    elseif #digits <= 18 then
+      return digits
+    elseif #digits == 19 and digits <= "9223372036854775807" then
+      return "INT64_C(" .. digits .. ")"
+    elseif #digits < 20 or (#digits == 20 and digits <= "18446744073709551615") then
+      return "(int64_t)UINT64_C(" .. digits .. ")"
+    end
+    return nil
+  end
+
+  -- Native structs (see mark_native_struct) are accessed through their C
+  -- layout; the runtime boxes fields only for name-based access and json.
+  local function native_field(struct_name, index)
+    local def = ctx.structs[struct_name]
+    return def.native and def.fields[index + 1].native or nil
+  end
+
+  local function native_field_width(struct_name, index)
+    return ctx.structs[struct_name].fields[index + 1].int_width
+  end
+
+  -- Field names become C members and constructor parameters with an f_
+  -- prefix, so a field may be called data, count or a C keyword.
+  local function native_member(obj_expr, struct_name, property, mutable)
+    local data = mutable and "rex_struct_data_mut(" or "rex_struct_data("
+    return "((RexNative_" .. struct_name .. "*)" .. data .. obj_expr .. ", &rex_layout_" .. struct_name .. "))->f_" .. property
+  end
+
+  local function emit_struct_get(obj_expr, struct_name, property)
+    local index = struct_field_index(struct_name, property)
+    local native = index and native_field(struct_name, index)
+    if native then
+      return box_scalar(native_member(obj_expr, struct_name, property, false), native, native_field_width(struct_name, index))
+    end
+    if index then
+      return "rex_struct_get_at(" .. obj_expr .. ", rex_fields_" .. struct_name .. ", " .. index .. ")"
+    end
+    return "rex_struct_get(" .. obj_expr .. ", " .. c_string(property) .. ")"
+  end
+
   local function collect_spawn_captures(block)
     local used = {}
     local declared = {}
@@ -652,6 +767,11 @@ function Codegen.generate(ast, opts)
         collect_expr(expr.finish)
       elseif expr.kind == "Generic" then
         collect_expr(expr.expr)
+      elseif expr.kind == "Lambda" then
+        for _, name in ipairs(expr.params) do
+          mark_declared(name, {})
+        end
+        collect_expr(expr.body)
       elseif expr.kind == "StructLit" then
         for _, f in ipairs(expr.fields or {}) do
           collect_expr(f.value)
@@ -698,6 +818,9 @@ function Codegen.generate(ast, opts)
           if stmt.range_start then
             collect_expr(stmt.range_start)
             collect_expr(stmt.range_end)
+            if stmt.range_step then
+              collect_expr(stmt.range_step)
+            end
           else
             collect_expr(stmt.iter)
           end
@@ -705,7 +828,13 @@ function Codegen.generate(ast, opts)
           for k, v in pairs(local_declared) do
             inner_declared[k] = v
           end
-          mark_declared(stmt.name, inner_declared)
+          if stmt.pattern then
+            for _, name in ipairs(stmt.pattern.names) do
+              mark_declared(name, inner_declared)
+            end
+          else
+            mark_declared(stmt.name, inner_declared)
+          end
           collect_block(stmt.body, inner_declared)
         elseif stmt.kind == "Match" then
           collect_expr(stmt.expr)
@@ -723,6 +852,9 @@ function Codegen.generate(ast, opts)
           collect_block(stmt.block, local_declared)
         elseif stmt.kind == "Unsafe" then
           collect_block(stmt.block, local_declared)
+        elseif stmt.kind == "WithBlock" then
+          collect_expr(stmt.arena)
+          collect_block(stmt.block, local_declared)
         elseif stmt.kind == "Defer" then
           if stmt.block then
             collect_block(stmt.block, local_declared)
@@ -748,6 +880,15 @@ function Codegen.generate(ast, opts)
 
   local emit_all_defers
   local emit_expr
+  local emit_scalar
+
+  local function emit_ident(name)
+    local binding = scope_get_binding(ctx, name)
+    if binding and binding.unboxed then
+      return box_scalar(binding.c_name, binding.unboxed, binding.int_width)
+    end
+    return get_c_ident(ctx, name)
+  end
 
   local function can_emit_tail_return()
     local frame = ctx.block_tail_stack[#ctx.block_tail_stack]
@@ -784,18 +925,228 @@ function Codegen.generate(ast, opts)
     return nil
   end
 
+  -- Number, integer and bool expressions the checker typed are compiled to
+  -- raw C doubles/int64_ts/ints (emit_scalar) and boxed only where a RexValue
+  -- is needed. Integer arithmetic wraps and goes through the rex_int_* helpers,
+  -- then wrap_int narrows the result to the expression's width.
+  local arith_ops = { ["+"] = "add", ["-"] = "sub", ["*"] = "mul", ["/"] = "div", ["%"] = "mod" }
+  local compare_ops = { ["=="] = true, ["!="] = true, ["<"] = true, ["<="] = true, [">"] = true, [">="] = true }
+  local numeric_kinds = { num = true, int = true }
+
+  local function scalar_kind(expr)
+    local kind = expr.type_kind or infer_expr_type(expr)
+    if kind == "num" or kind == "int" or kind == "bool" then
+      return kind
+    end
+    return nil
+  end
+
+  local function int_operand(expr)
+    if scalar_kind(expr) == "int" then
+      return true
+    end
+    if expr.kind == "Unary" and expr.op == "-" then
+      expr = expr.expr
+    end
+    return expr.kind == "Number" and not tostring(expr.value):find("[%.eE]")
+  end
+
+  local function int_index(node, index)
+    return node.vec_index and int_operand(index)
+  end
+
+  local scalar_suffix = { num = "f64", int = "i64" }
+
+  local bond_mutators = {
+    vec_push = true,
+    vec_set = true,
+    vec_insert = true,
+    vec_pop = true,
+    vec_clear = true,
+    vec_sort = true,
+    vec_sort_by_key = true,
+    vec_par_sort = true,
+    vec_remove_at = true,
+    vec_reverse = true,
+    vec_scale = true,
+    vec_add = true,
+    map_put = true,
+    map_remove = true,
+  }
+
+  -- Inside a bond, the first collections call that writes through `&mut v`
+  -- (or a `&mut` parameter) records a copy-on-write snapshot of v so rollback can restore it. Only
+  -- containers declared before the bond are tracked; the per-variable flag is
+  -- declared next to the bond's action list.
+  local function emit_bond_snapshot(expr)
+    local bond = ctx.active_bond and ctx.bonds[ctx.active_bond]
+    if not bond or ctx.lines ~= bond.lines then
+      return
+    end
+    local callee = expr.callee.kind == "Generic" and expr.callee.expr or expr.callee
+    if callee.kind ~= "Member" or callee.object.kind ~= "Identifier" or ctx.imports[callee.object.name] ~= "collections" then
+      return
+    end
+    local target = expr.args[1]
+    if target and target.kind == "Borrow" and target.mutable then
+      target = target.expr
+    end
+    if not bond_mutators[callee.property] or not target or target.kind ~= "Identifier" then
+      return
+    end
+    local binding = scope_get_binding(ctx, target.name)
+    if not binding or not bond.outer[binding] or binding.unboxed then
+      return
+    end
+    local flag = bond.snapshots[binding.c_name]
+    if not flag then
+      ctx.tmp_id = ctx.tmp_id + 1
+      flag = "__bond_snap_" .. ctx.tmp_id
+      bond.snapshots[binding.c_name] = flag
+      bond.lines[bond.decl_line] = bond.lines[bond.decl_line] .. " int " .. flag .. " = 0;"
+    end
+    indent_line(
+      ctx,
+      "if (!" .. flag .. ") { " .. flag .. " = 1; __rex_bond_push_snapshot(&" .. bond.actions_var .. ", &" .. bond.count_var .. ", &"
+        .. bond.cap_var .. ", " .. binding.c_name .. "); }"
+    )
+  end
+
+  -- collections.vec_get/vec_set/vec_push with integer indices or number
+  -- elements call the unboxed runtime entry points; returns the C function
+  -- and the scalar kind of each argument passed raw.
+  local function vec_scalar_call(expr)
+    local callee = expr.callee.kind == "Generic" and expr.callee.expr or expr.callee
+    if callee.kind ~= "Member" or callee.object.kind ~= "Identifier" or ctx.imports[callee.object.name] ~= "collections" then
+      return nil
+    end
+    local prop = callee.property
+    local args = expr.args
+    if prop == "vec_push" then
+      local kind = args[2] and scalar_kind(args[2])
+      if scalar_suffix[kind] and not (kind == "int" and args[2].int_width == "u64") then
+        return "rex_collections_vec_push_" .. scalar_suffix[kind], { nil, kind }
+      end
+      return nil
+    end
+    if (prop ~= "vec_get" and prop ~= "vec_set") or not args[2] or not int_operand(args[2]) then
+      return nil
+    end
+    local kind = prop == "vec_set" and args[3] and scalar_kind(args[3])
+    if scalar_suffix[kind] and not (kind == "int" and args[3].int_width == "u64") then
+      return "rex_collections_vec_set_" .. scalar_suffix[kind], { nil, "int", kind }
+    end
+    return "rex_collections_" .. prop .. "_at", { nil, "int" }
+  end
+
+  -- width is the integer side's: the source of int -> num, the target of
+  -- num -> int.
+  local function convert_scalar(code, from, to, width)
+    if from == to then
+      return code
+    elseif from == "int" and to == "num" then
+      return (width == "u64" and "((double)(uint64_t)" or "((double)") .. code .. ")"
+    elseif from == "num" and to == "int" then
+      return wrap_int("rex_int_from_num(" .. code .. ")", width)
+    end
+    return code
+  end
+
+  local function native_field_kind(expr)
+    if expr.kind ~= "Member" or not expr.struct_name then
+      return nil
+    end
+    local index = struct_field_index(expr.struct_name, expr.property)
+    return index and native_field(expr.struct_name, index)
+  end
+
+  -- An int-kind value narrowed to the width of the slot it is stored in.
+  local function emit_int_store(expr, width)
+    local code = emit_scalar(expr, "int")
+    if expr.int_width ~= width then
+      code = wrap_int(code, width)
+    end
+    return code
+  end
+
+  local function scalar_direct(expr, kind)
+    if not kind then
+      return false
+    end
+    if expr.kind == "Binary" then
+      local lk = scalar_kind(expr.left)
+      local rk = scalar_kind(expr.right)
+      if arith_ops[expr.op] then
+        return numeric_kinds[kind] and numeric_kinds[lk] and numeric_kinds[rk] or false
+      end
+      if kind ~= "bool" then
+        return false
+      end
+      if compare_ops[expr.op] and numeric_kinds[lk] and numeric_kinds[rk] then
+        return true
+      end
+      local bool_op = expr.op == "==" or expr.op == "!=" or expr.op == "&&" or expr.op == "||"
+      return bool_op and lk == "bool" and rk == "bool"
+    elseif expr.kind == "Unary" then
+      if expr.op == "-" then
+        return numeric_kinds[kind] and numeric_kinds[scalar_kind(expr.expr)] or false
+      end
+      return expr.op == "!" and kind == "bool" and scalar_kind(expr.expr) == "bool"
+    elseif expr.kind == "Identifier" then
+      local binding = scope_get_binding(ctx, expr.name)
+      local unboxed = binding and binding.unboxed
+      return unboxed == kind or (numeric_kinds[kind] and numeric_kinds[unboxed]) or false
+    elseif expr.kind == "Number" then
+      return numeric_kinds[kind] or false
+    elseif expr.kind == "Bool" then
+      return kind == "bool"
+    end
+    local field = native_field_kind(expr)
+    return field == kind or (numeric_kinds[kind] and numeric_kinds[field]) or false
+  end
+
+  -- Beyond 2^53 a double would round an integer literal, so it is boxed as
+  -- an exact integer instead.
+  local function emit_number(text)
+    local exact = #text > 15 and not text:find(".", 1, true) and int_literal(text)
+    if exact then
+      return box_scalar(exact, "int", exact:find("UINT64_C", 1, true) and "u64" or nil)
+    end
+    return "rex_num(" .. text .. ")"
+  end
+
+  local function emit_vec_ctor(vec_kind, elements)
+    local kind = vec_kind and ("REX_VEC_" .. vec_kind:upper())
+    if #elements == 0 then
+      return kind and ("rex_collections_vec_new_typed(" .. kind .. ")") or "rex_collections_vec_new()"
+    end
+    local values = "(RexValue[]){" .. table.concat(elements, ", ") .. "}"
+    if kind then
+      return "rex_collections_vec_from_typed(" .. kind .. ", " .. #elements .. ", " .. values .. ")"
+    end
+    return "rex_collections_vec_from(" .. #elements .. ", " .. values .. ")"
+  end
+
   local function emit_expr_raw(expr)
+    if expr.kind == "Call" and expr.pipeline then
+      error("Iterator pipelines are not supported in defer expressions")
+    end
     if expr.kind == "Bool" then
       return expr.value and "rex_bool(1)" or "rex_bool(0)"
     elseif expr.kind == "Nil" then
       return "rex_nil()"
     elseif expr.kind == "Number" then
-      return "rex_num(" .. expr.value .. ")"
+      return emit_number(expr.value)
     elseif expr.kind == "String" then
-      return "rex_str(" .. c_string(expr.value) .. ")"
+      return string_literal(ctx, expr.value)
     elseif expr.kind == "Identifier" then
-      return get_c_ident(ctx, expr.name)
+      return emit_ident(expr.name)
     elseif expr.kind == "Borrow" then
+      if expr.expr.kind == "Slice" then
+        local slice = expr.expr
+        local finish = slice.finish and emit_expr_raw(slice.finish) or "rex_nil()"
+        return "rex_collections_vec_slice_view(&(RexVecSlice){ { 0 } }, " .. emit_expr_raw(slice.object) .. ", " .. emit_expr_raw(slice.start) .. ", " .. finish .. ")"
+      end
       if expr.expr.kind ~= "Identifier" then
         error("borrow expects identifier")
       end
@@ -818,14 +1169,11 @@ function Codegen.generate(ast, opts)
     elseif expr.kind == "Deref" then
       return "rex_deref(" .. emit_expr_raw(expr.expr) .. ")"
     elseif expr.kind == "Array" then
-      if #expr.elements == 0 then
-        return "rex_collections_vec_new()"
-      end
       local elements = {}
       for _, el in ipairs(expr.elements) do
         table.insert(elements, emit_expr_raw(el))
       end
-      return "rex_collections_vec_from(" .. #elements .. ", (RexValue[]){" .. table.concat(elements, ", ") .. "})"
+      return emit_vec_ctor(expr.vec_kind, elements)
     elseif expr.kind == "Call" then
       local args = {}
       for _, arg in ipairs(expr.args) do
@@ -867,11 +1215,8 @@ function Codegen.generate(ast, opts)
         if obj.kind == "Identifier" then
           local module = ctx.imports[obj.name]
           if module then
-            if module == "collections" and prop == "vec_from" then
-              if #args == 0 then
-                return "rex_collections_vec_new()"
-              end
-              return "rex_collections_vec_from(" .. #args .. ", (RexValue[]){" .. table.concat(args, ", ") .. "})"
+            if module == "collections" and (prop == "vec_from" or (prop == "vec_new" and expr.vec_kind)) then
+              return emit_vec_ctor(expr.vec_kind, args)
             end
             local map = ctx.module_builtins[module]
             if map and map[prop] then
@@ -1000,7 +1345,7 @@ function Codegen.generate(ast, opts)
         end
         return "rex_tag(" .. c_string(expr.property) .. ", rex_nil())"
       end
-      return "rex_struct_get(" .. emit_expr_raw(expr.object) .. ", " .. c_string(expr.property) .. ")"
+      return emit_struct_get(emit_expr_raw(expr.object), expr.struct_name, expr.property)
     elseif expr.kind == "Index" then
       return "rex_collections_get(" .. emit_expr_raw(expr.object) .. ", " .. emit_expr_raw(expr.index) .. ")"
     elseif expr.kind == "Slice" then
@@ -1034,6 +1379,33 @@ function Codegen.generate(ast, opts)
     error("Unhandled expression kind: " .. tostring(expr.kind))
   end
 
+  -- Temporaries the checker proved are only read by their consumer are
+  -- spilled to a local and dropped once the enclosing statement finishes.
+  local function emit_operand(expr)
+    local code = emit_expr(expr)
+    if not ctx.temp_drops or not expr.owned_temp then
+      return code
+    end
+    ctx.tmp_id = ctx.tmp_id + 1
+    local tmp = "__tmp" .. ctx.tmp_id
+    indent_line(ctx, "RexValue " .. tmp .. " = " .. code .. ";")
+    table.insert(ctx.temp_drops, tmp)
+    return tmp
+  end
+
+  local function begin_temps()
+    local saved = ctx.temp_drops
+    ctx.temp_drops = {}
+    return saved
+  end
+
+  local function end_temps(saved)
+    for _, tmp in ipairs(ctx.temp_drops or {}) do
+      indent_line(ctx, "rex_drop(" .. tmp .. ");")
+    end
+    ctx.temp_drops = saved
+  end
+
   local function emit_try(expr)
     local inner = emit_expr(expr.expr)
     ctx.tmp_id = ctx.tmp_id + 1
@@ -1053,20 +1425,259 @@ function Codegen.generate(ast, opts)
     return tmp
   end
 
+  -- Moves an element between its boxed (nil) and scalar representations.
+  local function pipeline_value(code, from, to, width)
+    if from == to then
+      return code
+    elseif not from then
+      return "rex_unbox_" .. to .. "(" .. code .. ")"
+    elseif not to then
+      return box_scalar(code, from, width)
+    end
+    return convert_scalar(code, from, to, width)
+  end
+
+  -- iter(src).filter(..).map(..).take(n).collect() runs as a single loop over
+  -- the source: closures are inlined with their parameter bound to the
+  -- current element, take/skip keep counters, and the terminal accumulates
+  -- into one result. Like ?, the loop is emitted ahead of the statement that
+  -- uses it and the expression itself is just the result variable.
+  local function emit_pipeline(expr)
+    local plan = expr.pipeline
+    ctx.tmp_id = ctx.tmp_id + 1
+    local id = ctx.tmp_id
+    local result = "__pipe" .. id
+    local view_var = "__view" .. id
+    local idx_var = "__idx" .. id
+    local done_var = "__done" .. id
+    local terminal = plan.terminal
+    local acc_kind = terminal == "sum" and (plan.elem_kind == "int" and "int" or "num") or nil
+    local acc_types = { sum = scalar_c_types[acc_kind], count = "int64_t", any = "int", all = "int" }
+
+    local source = emit_expr(plan.source)
+    local view_fn = plan.source_kind == "set" and "rex_collections_set_view" or "rex_collections_vec_view"
+    indent_line(ctx, "RexValue " .. result .. ";")
+    indent_line(ctx, "{")
+    ctx.indent = ctx.indent + 1
+    indent_line(ctx, "RexVecView " .. view_var .. " = " .. view_fn .. "(" .. source .. ");")
+    local has_take = false
+    for i, stage in ipairs(plan.stages) do
+      if stage.count then
+        local counter = "__" .. stage.op .. id .. "_" .. i
+        indent_line(ctx, "int64_t " .. counter .. " = " .. emit_scalar(stage.count, "int") .. ";")
+        stage.counter = counter
+        has_take = has_take or stage.op == "take"
+      end
+    end
+    if has_take then
+      indent_line(ctx, "int " .. done_var .. " = 0;")
+      for _, stage in ipairs(plan.stages) do
+        if stage.op == "take" then
+          indent_line(ctx, "if (" .. stage.counter .. " <= 0) { " .. done_var .. " = 1; }")
+        end
+      end
+    end
+    local acc = "__acc" .. id
+    if terminal == "collect" then
+      local kind = expr.vec_kind and ("REX_VEC_" .. expr.vec_kind:upper())
+      indent_line(ctx, result .. " = " .. (kind and ("rex_collections_vec_new_typed(" .. kind .. ")") or "rex_collections_vec_new()") .. ";")
+    else
+      indent_line(ctx, acc_types[terminal] .. " " .. acc .. " = " .. (terminal == "all" and "1" or "0") .. ";")
+    end
+    local cond = idx_var .. " < " .. view_var .. ".count"
+    if has_take then
+      cond = "!" .. done_var .. " && " .. cond
+    end
+    indent_line(ctx, "for (int64_t " .. idx_var .. " = 0; " .. cond .. "; " .. idx_var .. "++) {")
+    ctx.indent = ctx.indent + 1
+    indent_line(ctx, "rex_vec_view_check(&" .. view_var .. ");")
+    table.insert(ctx.current_bindings, {})
+
+    -- The current element is read lazily in whatever representation its
+    -- consumer wants, so skipped or counted elements are never unboxed.
+    local function read_source(kind)
+      local item = "rex_vec_view_get(&" .. view_var .. ", " .. idx_var .. ")"
+      if kind == "bool" then
+        return "rex_unbox_bool(" .. item .. ")"
+      elseif kind then
+        return "rex_vec_view_" .. scalar_suffix[kind] .. "(&" .. view_var .. ", " .. idx_var .. ")"
+      end
+      return item
+    end
+    local read = read_source
+    local function bind_param(fn)
+      local name = fn.params[1]
+      local var = get_c_name(ctx, name)
+      local value = read(fn.unboxed)
+      if fn.unboxed == "int" then
+        value = wrap_int(value, fn.int_width)
+      end
+      indent_line(ctx, (fn.unboxed and scalar_c_types[fn.unboxed] or "RexValue") .. " " .. var .. " = " .. value .. ";")
+      scope_set_binding(ctx, name, var, fn.unboxed or "unknown")
+      scope_get_binding(ctx, name).unboxed = fn.unboxed
+      scope_get_binding(ctx, name).int_width = fn.int_width
+      read = function(want)
+        return pipeline_value(var, fn.unboxed, want, fn.int_width)
+      end
+    end
+    local function emit_test(fn, var)
+      bind_param(fn)
+      local saved = begin_temps()
+      local code
+      if scalar_kind(fn.body) == "bool" then
+        code = emit_scalar(fn.body, "bool")
+      else
+        code = "rex_is_truthy(" .. emit_expr(fn.body) .. ")"
+      end
+      indent_line(ctx, "int " .. var .. " = " .. code .. ";")
+      end_temps(saved)
+    end
+
+    for i, stage in ipairs(plan.stages) do
+      if stage.op == "filter" then
+        local keep = "__keep" .. id .. "_" .. i
+        emit_test(stage.fn, keep)
+        indent_line(ctx, "if (!" .. keep .. ") { continue; }")
+      elseif stage.op == "map" then
+        bind_param(stage.fn)
+        local out = "__item" .. id .. "_" .. i
+        local kind = scalar_kind(stage.fn.body)
+        local saved = begin_temps()
+        if kind then
+          indent_line(ctx, scalar_c_types[kind] .. " " .. out .. " = " .. emit_scalar(stage.fn.body, kind) .. ";")
+        else
+          indent_line(ctx, "RexValue " .. out .. " = " .. emit_expr(stage.fn.body) .. ";")
+        end
+        end_temps(saved)
+        read = function(want)
+          return pipeline_value(out, kind, want, stage.fn.body.int_width)
+        end
+      elseif stage.op == "skip" then
+        indent_line(ctx, "if (" .. stage.counter .. " > 0) { " .. stage.counter .. "--; continue; }")
+      elseif stage.op == "take" then
+        indent_line(ctx, "if (--" .. stage.counter .. " <= 0) { " .. done_var .. " = 1; }")
+      end
+    end
+
+    if terminal == "collect" then
+      if expr.vec_kind == "f64" or expr.vec_kind == "i64" or expr.vec_kind == "u64" then
+        local kind = expr.vec_kind == "f64" and "num" or "int"
+        indent_line(ctx, "rex_collections_vec_push_" .. scalar_suffix[kind] .. "(" .. result .. ", " .. read(kind) .. ");")
+      else
+        indent_line(ctx, "rex_collections_vec_push(" .. result .. ", " .. read(nil) .. ");")
+      end
+    elseif terminal == "sum" and acc_kind == "int" then
+      indent_line(ctx, acc .. " = rex_int_add(" .. acc .. ", " .. read(acc_kind) .. ");")
+    elseif terminal == "sum" then
+      indent_line(ctx, acc .. " += " .. read(acc_kind) .. ";")
+    elseif terminal == "count" then
+      indent_line(ctx, acc .. "++;")
+    else
+      local hit = "__hit" .. id
+      emit_test(plan.terminal_fn, hit)
+      if terminal == "any" then
+        indent_line(ctx, "if (" .. hit .. ") { " .. acc .. " = 1; break; }")
+      else
+        indent_line(ctx, "if (!" .. hit .. ") { " .. acc .. " = 0; break; }")
+      end
+    end
+
+    table.remove(ctx.current_bindings)
+    ctx.indent = ctx.indent - 1
+    indent_line(ctx, "}")
+    if terminal == "sum" then
+      local width = acc_kind == "int" and plan.elem_width or nil
+      indent_line(ctx, result .. " = " .. box_scalar(wrap_int(acc, width), acc_kind, width) .. ";")
+    elseif terminal == "count" then
+      indent_line(ctx, result .. " = " .. box_scalar(acc, "int") .. ";")
+    elseif terminal ~= "collect" then
+      indent_line(ctx, result .. " = " .. box_scalar(acc, "bool") .. ";")
+    end
+    ctx.indent = ctx.indent - 1
+    indent_line(ctx, "}")
+    return result
+  end
+
+  -- True when emitting expr writes statements ahead of it (? or a pipeline).
+  -- Closure bodies are inlined inside their pipeline's own loop.
+  local function emits_prelude(expr)
+    if type(expr) ~= "table" or expr.kind == "Lambda" then
+      return false
+    end
+    if expr.kind == "Try" or (expr.kind == "Call" and expr.pipeline) then
+      return true
+    end
+    for _, key in ipairs({ "left", "right", "expr", "object", "index", "start", "finish", "callee" }) do
+      if emits_prelude(expr[key]) then
+        return true
+      end
+    end
+    for _, list in ipairs({ expr.args or {}, expr.elements or {} }) do
+      for _, item in ipairs(list) do
+        if emits_prelude(item) then
+          return true
+        end
+      end
+    end
+    for _, field in ipairs(expr.fields or {}) do
+      if emits_prelude(field.value) then
+        return true
+      end
+    end
+    return false
+  end
+
+  -- `a && b` / `a || b` whose right side emits statements first becomes an
+  -- if-chain, so those statements (and any closure side effects in them)
+  -- only run when the left side does not already decide the result.
+  local function emit_logic(expr)
+    local function cond(operand)
+      if scalar_kind(operand) == "bool" then
+        return emit_scalar(operand, "bool")
+      end
+      return "rex_is_truthy(" .. emit_expr(operand) .. ")"
+    end
+    local saved_temps = ctx.temp_drops
+    ctx.temp_drops = nil
+    ctx.tmp_id = ctx.tmp_id + 1
+    local var = "__logic" .. ctx.tmp_id
+    indent_line(ctx, "int " .. var .. " = " .. cond(expr.left) .. ";")
+    indent_line(ctx, "if (" .. (expr.op == "||" and "!" or "") .. var .. ") {")
+    ctx.indent = ctx.indent + 1
+    indent_line(ctx, var .. " = " .. cond(expr.right) .. ";")
+    ctx.indent = ctx.indent - 1
+    indent_line(ctx, "}")
+    ctx.temp_drops = saved_temps
+    return var
+  end
+
+  local function short_circuits(expr)
+    return expr.kind == "Binary" and (expr.op == "&&" or expr.op == "||") and emits_prelude(expr.right)
+  end
+
   emit_expr = function(expr)
     if expr.kind == "Try" then
       return emit_try(expr)
+    elseif expr.kind == "Call" and expr.pipeline then
+      return emit_pipeline(expr)
+    elseif short_circuits(expr) then
+      return "rex_bool(" .. emit_logic(expr) .. ")"
     elseif expr.kind == "Bool" then
       return expr.value and "rex_bool(1)" or "rex_bool(0)"
     elseif expr.kind == "Nil" then
       return "rex_nil()"
     elseif expr.kind == "Number" then
-      return "rex_num(" .. expr.value .. ")"
+      return emit_number(expr.value)
     elseif expr.kind == "String" then
-      return "rex_str(" .. c_string(expr.value) .. ")"
+      return string_literal(ctx, expr.value)
     elseif expr.kind == "Identifier" then
-      return get_c_ident(ctx, expr.name)
+      return emit_ident(expr.name)
     elseif expr.kind == "Borrow" then
+      if expr.expr.kind == "Slice" then
+        local slice = expr.expr
+        local finish = slice.finish and emit_expr(slice.finish) or "rex_nil()"
+        return "rex_collections_vec_slice_view(&(RexVecSlice){ { 0 } }, " .. emit_expr(slice.object) .. ", " .. emit_expr(slice.start) .. ", " .. finish .. ")"
+      end
       if expr.expr.kind ~= "Identifier" then
         error("borrow expects identifier")
       end
@@ -1074,9 +1685,18 @@ function Codegen.generate(ast, opts)
         return "rex_ref_mut(&" .. get_c_ident(ctx, expr.expr.name) .. ")"
       end
       return "rex_ref(&" .. get_c_ident(ctx, expr.expr.name) .. ")"
+    elseif expr.kind == "Binary" and scalar_direct(expr, scalar_kind(expr)) then
+      return box_scalar(emit_scalar(expr, scalar_kind(expr)), scalar_kind(expr), expr.int_width)
+    elseif expr.kind == "Unary" and scalar_direct(expr, scalar_kind(expr)) then
+      return box_scalar(emit_scalar(expr, scalar_kind(expr)), scalar_kind(expr), expr.int_width)
     elseif expr.kind == "Binary" then
-      local left = emit_expr(expr.left)
-      local right = emit_expr(expr.right)
+      local saved_temps = ctx.temp_drops
+      if expr.op == "&&" or expr.op == "||" then
+        ctx.temp_drops = nil
+      end
+      local left = emit_operand(expr.left)
+      local right = emit_operand(expr.right)
+      ctx.temp_drops = saved_temps
       local left_type = infer_expr_type(expr.left)
       local right_type = infer_expr_type(expr.right)
       return emit_binary_typed(expr.op, left, right, left_type, right_type)
@@ -1089,18 +1709,21 @@ function Codegen.generate(ast, opts)
     elseif expr.kind == "Deref" then
       return "rex_deref(" .. emit_expr(expr.expr) .. ")"
     elseif expr.kind == "Array" then
-      if #expr.elements == 0 then
-        return "rex_collections_vec_new()"
-      end
       local elements = {}
       for _, el in ipairs(expr.elements) do
         table.insert(elements, emit_expr(el))
       end
-      return "rex_collections_vec_from(" .. #elements .. ", (RexValue[]){" .. table.concat(elements, ", ") .. "})"
+      return emit_vec_ctor(expr.vec_kind, elements)
     elseif expr.kind == "Call" then
+      emit_bond_snapshot(expr)
       local args = {}
-      for _, arg in ipairs(expr.args) do
-        table.insert(args, emit_expr(arg))
+      local scalar_fn, scalar_args = vec_scalar_call(expr)
+      for i, arg in ipairs(expr.args) do
+        if scalar_args and scalar_args[i] then
+          table.insert(args, emit_scalar(arg, scalar_args[i]))
+        else
+          table.insert(args, emit_operand(arg))
+        end
       end
       local callee = expr.callee
       if callee.kind == "Generic" then
@@ -1138,11 +1761,11 @@ function Codegen.generate(ast, opts)
         if obj.kind == "Identifier" then
           local module = ctx.imports[obj.name]
           if module then
-            if module == "collections" and prop == "vec_from" then
-              if #args == 0 then
-                return "rex_collections_vec_new()"
-              end
-              return "rex_collections_vec_from(" .. #args .. ", (RexValue[]){" .. table.concat(args, ", ") .. "})"
+            if module == "collections" and (prop == "vec_from" or (prop == "vec_new" and expr.vec_kind)) then
+              return emit_vec_ctor(expr.vec_kind, args)
+            end
+            if scalar_fn then
+              return scalar_fn .. "(" .. table.concat(args, ", ") .. ")"
             end
             local map = ctx.module_builtins[module]
             if map and map[prop] then
@@ -1271,8 +1894,11 @@ function Codegen.generate(ast, opts)
         end
         return "rex_tag(" .. c_string(expr.property) .. ", rex_nil())"
       end
-      return "rex_struct_get(" .. emit_expr(expr.object) .. ", " .. c_string(expr.property) .. ")"
+      return emit_struct_get(emit_expr(expr.object), expr.struct_name, expr.property)
     elseif expr.kind == "Index" then
+      if int_index(expr, expr.index) then
+        return "rex_collections_vec_get_at(" .. emit_expr(expr.object) .. ", " .. emit_scalar(expr.index, "int") .. ")"
+      end
       return "rex_collections_get(" .. emit_expr(expr.object) .. ", " .. emit_expr(expr.index) .. ")"
     elseif expr.kind == "Slice" then
       local finish = "rex_nil()"
@@ -1303,8 +1929,106 @@ function Codegen.generate(ast, opts)
     error("Unhandled expression kind: " .. tostring(expr.kind))
   end
 
+  emit_scalar = function(expr, kind)
+    if kind == "bool" and short_circuits(expr) then
+      return emit_logic(expr)
+    elseif expr.kind == "Number" then
+      local text = tostring(expr.value)
+      if kind == "int" and not text:find("[%.eE]") and int_literal(text) then
+        return int_literal(text)
+      end
+      if not text:find("[%.eE]") then
+        text = text .. ".0"
+      end
+      return convert_scalar(text, "num", kind)
+    elseif expr.kind == "Bool" then
+      return expr.value and "1" or "0"
+    elseif expr.kind == "Identifier" then
+      local binding = scope_get_binding(ctx, expr.name)
+      if binding and binding.unboxed and scalar_direct(expr, kind) then
+        return convert_scalar(binding.c_name, binding.unboxed, kind, binding.int_width)
+      end
+      if not (binding and binding.unboxed) and kind ~= "int" and infer_expr_type(expr) == kind then
+        return (kind == "bool" and "rex_as_bool(" or "rex_as_num(") .. get_c_ident(ctx, expr.name) .. ")"
+      end
+    elseif expr.kind == "Binary" and scalar_direct(expr, kind) then
+      local saved_temps = ctx.temp_drops
+      if expr.op == "&&" or expr.op == "||" then
+        ctx.temp_drops = nil
+      end
+      local lk = scalar_kind(expr.left)
+      local rk = scalar_kind(expr.right)
+      local operand_kind = lk
+      if numeric_kinds[lk] then
+        local any_int = lk == "int" or rk == "int"
+        operand_kind = (any_int and int_operand(expr.left) and int_operand(expr.right)) and "int" or "num"
+      end
+      local result_kind = operand_kind
+      if arith_ops[expr.op] then
+        -- The checker decides when mixed int/literal arithmetic stays integral.
+        result_kind = scalar_kind(expr) == "int" and "int" or "num"
+        operand_kind = result_kind
+      end
+      local left = emit_scalar(expr.left, operand_kind)
+      local right = emit_scalar(expr.right, operand_kind)
+      ctx.temp_drops = saved_temps
+      local unsigned = operand_kind == "int" and (expr.left.int_width == "u64" or expr.right.int_width == "u64")
+      local code
+      if arith_ops[expr.op] and operand_kind == "int" then
+        local helper = (unsigned and (expr.op == "/" or expr.op == "%")) and "rex_uint_" or "rex_int_"
+        code = wrap_int(helper .. arith_ops[expr.op] .. "(" .. left .. ", " .. right .. ")", expr.int_width)
+      elseif expr.op == "%" then
+        code = "fmod(" .. left .. ", " .. right .. ")"
+      elseif unsigned and compare_ops[expr.op] then
+        code = "((uint64_t)" .. left .. " " .. expr.op .. " (uint64_t)" .. right .. ")"
+      else
+        code = "(" .. left .. " " .. expr.op .. " " .. right .. ")"
+      end
+      if not arith_ops[expr.op] then
+        return code
+      end
+      return convert_scalar(code, result_kind, kind, expr.int_width)
+    elseif expr.kind == "Unary" and scalar_direct(expr, kind) then
+      if expr.op == "-" then
+        local int_inner = scalar_kind(expr.expr) == "int" or (kind == "int" and int_operand(expr.expr))
+        local inner_kind = int_inner and "int" or "num"
+        local inner = emit_scalar(expr.expr, inner_kind)
+        local code = inner_kind == "int" and wrap_int("rex_int_neg(" .. inner .. ")", expr.int_width) or ("(-" .. inner .. ")")
+        return convert_scalar(code, inner_kind, kind, expr.int_width)
+      end
+      return "(" .. expr.op .. emit_scalar(expr.expr, kind) .. ")"
+    elseif scalar_direct(expr, kind) and native_field_kind(expr) then
+      local field = native_field_kind(expr)
+      local width = native_field_width(expr.struct_name, struct_field_index(expr.struct_name, expr.property))
+      return convert_scalar(native_member(emit_expr(expr.object), expr.struct_name, expr.property, false), field, kind, width)
+    end
+    if kind == "bool" then
+      return "rex_is_truthy(" .. emit_expr(expr) .. ")"
+    end
+    -- Boxed values may hold any integer, so reads narrow to the static width.
+    local width = kind == "int" and expr.int_width or nil
+    local getter = "rex_collections_vec_get_" .. (kind == "int" and "i64" or "f64")
+    if expr.kind == "Index" and int_index(expr, expr.index) then
+      return wrap_int(getter .. "(" .. emit_expr(expr.object) .. ", " .. emit_scalar(expr.index, "int") .. ")", width)
+    elseif expr.kind == "Call" and vec_scalar_call(expr) == "rex_collections_vec_get_at" then
+      return wrap_int(getter .. "(" .. emit_operand(expr.args[1]) .. ", " .. emit_scalar(expr.args[2], "int") .. ")", width)
+    end
+    return wrap_int((kind == "int" and "rex_unbox_int(" or "rex_unbox_num(") .. emit_expr(expr) .. ")", width)
+  end
+
+  local function emit_cond(expr)
+    if scalar_kind(expr) == "bool" then
+      return emit_scalar(expr, "bool")
+    end
+    return "rex_is_truthy(" .. emit_expr(expr) .. ")"
+  end
+
   local function emit_defer(node)
-    if node.block then
+    if node.drop then
+      indent_line(ctx, "rex_drop(" .. node.drop .. ");")
+    elseif node.arena_leave then
+      indent_line(ctx, "rex_mem_arena_leave(" .. node.arena_leave .. ");")
+    elseif node.block then
       emit_block(node.block, true)
     else
       indent_line(ctx, emit_expr_raw(node.expr) .. ";")
@@ -1323,6 +2047,39 @@ function Codegen.generate(ast, opts)
     end
   end
 
+  local function emit_return(value)
+    local pending = false
+    for i = #ctx.defer_stack, 1, -1 do
+      if #ctx.defer_stack[i] > 0 then
+        pending = true
+        break
+      end
+    end
+    if not pending then
+      indent_line(ctx, "return " .. value .. ";")
+      return
+    end
+    ctx.tmp_id = ctx.tmp_id + 1
+    local tmp = "__ret" .. ctx.tmp_id
+    indent_line(ctx, "RexValue " .. tmp .. " = " .. value .. ";")
+    emit_all_defers()
+    indent_line(ctx, "return " .. tmp .. ";")
+  end
+
+  local function emit_loop_exit(keyword)
+    local depth = ctx.loop_stack[#ctx.loop_stack] or #ctx.defer_stack
+    for i = #ctx.defer_stack, depth, -1 do
+      emit_defer_list(ctx.defer_stack[i])
+    end
+    indent_line(ctx, keyword .. ";")
+  end
+
+  local function emit_loop_body(body, prelude)
+    table.insert(ctx.loop_stack, #ctx.defer_stack + 1)
+    emit_block(body, true, prelude)
+    table.remove(ctx.loop_stack)
+  end
+
   emit_block = function(block, new_scope, prelude, allow_tail_return)
     if new_scope then
       table.insert(ctx.scopes, {})
@@ -1353,7 +2110,10 @@ function Codegen.generate(ast, opts)
           error("Bond '" .. (active_bond.name or tostring(active_id)) .. "' left scope without commit/rollback")
         end
       end
-      emit_defer_list(ctx.defer_stack[#ctx.defer_stack])
+      local last = statements[#statements]
+      if not (last and (last.kind == "Return" or last.kind == "Break" or last.kind == "Continue")) then
+        emit_defer_list(ctx.defer_stack[#ctx.defer_stack])
+      end
       table.remove(ctx.defer_stack)
       table.remove(ctx.scopes)
       table.remove(ctx.current_bindings)
@@ -1368,8 +2128,12 @@ function Codegen.generate(ast, opts)
 
     local saved_lines = ctx.lines
     local saved_indent = ctx.indent
+    local saved_defers = ctx.defer_stack
+    local saved_loops = ctx.loop_stack
     ctx.lines = {}
     ctx.indent = 0
+    ctx.defer_stack = { {} }
+    ctx.loop_stack = {}
 
     if #captures > 0 then
       indent_line(ctx, "typedef struct " .. ctx_type .. " {")
@@ -1405,6 +2169,8 @@ function Codegen.generate(ast, opts)
     local helper_lines = ctx.lines
     ctx.lines = saved_lines
     ctx.indent = saved_indent
+    ctx.defer_stack = saved_defers
+    ctx.loop_stack = saved_loops
     table.insert(ctx.spawn_helpers, helper_lines)
     return fn_name, ctx_type
   end
@@ -1517,8 +2283,32 @@ function Codegen.generate(ast, opts)
   end
 
   local function emit_stmt(stmt)
-    if stmt.kind == "Let" then
-      local value = emit_expr(stmt.value)
+    if stmt.kind == "Let" and stmt.unboxed and stmt.pattern.kind == "IdentPattern" then
+      if ctx.current_bindings[#ctx.current_bindings][stmt.pattern.name] then
+        error("variable '" .. stmt.pattern.name .. "' already defined in this scope")
+      end
+      local saved_temps = begin_temps()
+      local c_name = get_c_name(ctx, stmt.pattern.name)
+      local c_type = scalar_c_types[stmt.unboxed] .. " "
+      local value
+      if stmt.unboxed == "int" then
+        value = emit_int_store(stmt.value, stmt.int_width)
+      else
+        value = emit_scalar(stmt.value, stmt.unboxed)
+      end
+      indent_line(ctx, c_type .. c_name .. " = " .. value .. ";")
+      scope_set_binding(ctx, stmt.pattern.name, c_name, stmt.unboxed)
+      scope_get_binding(ctx, stmt.pattern.name).unboxed = stmt.unboxed
+      scope_get_binding(ctx, stmt.pattern.name).int_width = stmt.int_width
+      end_temps(saved_temps)
+    elseif stmt.kind == "Let" then
+      local saved_temps = begin_temps()
+      local value
+      if stmt.boxed_int and stmt.pattern.kind == "IdentPattern" then
+        value = box_scalar(emit_int_store(stmt.value, stmt.int_width), "int", stmt.int_width)
+      else
+        value = emit_expr(stmt.value)
+      end
       if stmt.pattern.kind == "TuplePattern" then
         ctx.tmp_id = ctx.tmp_id + 1
         local tmp = "__tmp" .. ctx.tmp_id
@@ -1536,6 +2326,7 @@ function Codegen.generate(ast, opts)
           scope_set_binding(ctx, stmt.pattern.names[1], get_c_ident(ctx, stmt.pattern.names[1]), "sender")
           scope_set_binding(ctx, stmt.pattern.names[2], get_c_ident(ctx, stmt.pattern.names[2]), "receiver")
         end
+        end_temps(saved_temps)
       else
      
         if ctx.current_bindings[#ctx.current_bindings][stmt.pattern.name] then
@@ -1569,6 +2360,14 @@ function Codegen.generate(ast, opts)
           end
         end
         scope_set_binding(ctx, stmt.pattern.name, c_name, type_annotation)
+        if stmt.boxed_int then
+          scope_get_binding(ctx, stmt.pattern.name).boxed_int = stmt.int_width or "i64"
+        end
+        end_temps(saved_temps)
+        if stmt.drop_on_exit then
+          scope_get_binding(ctx, stmt.pattern.name).drop = true
+          table.insert(ctx.defer_stack[#ctx.defer_stack], { drop = c_name })
+        end
       end
     elseif stmt.kind == "Defer" then
       table.insert(ctx.defer_stack[#ctx.defer_stack], stmt)
@@ -1596,6 +2395,20 @@ function Codegen.generate(ast, opts)
         ctx.indent = ctx.indent - 1
         indent_line(ctx, "}")
       end
+    elseif stmt.kind == "WithBlock" then
+      -- The leave sits at the bottom of the block's defer list so every exit
+      -- path runs it after the block's own drops.
+      ctx.tmp_id = ctx.tmp_id + 1
+      local arena = "__arena" .. ctx.tmp_id
+      indent_line(ctx, "{")
+      ctx.indent = ctx.indent + 1
+      indent_line(ctx, "RexValue " .. arena .. " = " .. emit_expr(stmt.arena) .. ";")
+      indent_line(ctx, "rex_mem_arena_enter(" .. arena .. ");")
+      emit_block(stmt.block, true, function()
+        table.insert(ctx.defer_stack[#ctx.defer_stack], { arena_leave = arena })
+      end)
+      ctx.indent = ctx.indent - 1
+      indent_line(ctx, "}")
     elseif stmt.kind == "DebugOwnership" then
       
       indent_line(ctx, "rex_ownership_debug_enable(); // Enable ownership debug mode")
@@ -1623,6 +2436,13 @@ function Codegen.generate(ast, opts)
       indent_line(ctx, "RexBondAction* " .. actions_var .. " = NULL;")
       indent_line(ctx, "int " .. count_var .. " = 0;")
       indent_line(ctx, "int " .. cap_var .. " = 0;")
+      local decl_line = #ctx.lines
+      local outer = {}
+      for _, scope in ipairs(ctx.current_bindings) do
+        for _, binding in pairs(scope) do
+          outer[binding] = true
+        end
+      end
       local value = emit_expr(stmt.value)
       local c_name = get_c_name(ctx, stmt.name)
       indent_line(ctx, "RexValue " .. c_name .. " = " .. value .. ";")
@@ -1636,6 +2456,10 @@ function Codegen.generate(ast, opts)
         count_var = count_var,
         cap_var = cap_var,
         scope_depth = #ctx.current_bindings,
+        lines = ctx.lines,
+        decl_line = decl_line,
+        outer = outer,
+        snapshots = {},
       }
       table.insert(ctx.active_bond_stack, bid)
       ctx.active_bond = bid
@@ -1662,16 +2486,39 @@ function Codegen.generate(ast, opts)
         ctx.active_bond = ctx.active_bond_stack[#ctx.active_bond_stack]
       end
     elseif stmt.kind == "Return" then
-      emit_all_defers()
       if stmt.value then
-        indent_line(ctx, "return " .. emit_expr(stmt.value) .. ";")
+        local saved_temps = begin_temps()
+        local value = emit_expr(stmt.value)
+        if #ctx.temp_drops > 0 then
+          ctx.tmp_id = ctx.tmp_id + 1
+          local tmp = "__ret" .. ctx.tmp_id
+          indent_line(ctx, "RexValue " .. tmp .. " = " .. value .. ";")
+          value = tmp
+        end
+        end_temps(saved_temps)
+        emit_return(value)
       else
+        emit_all_defers()
         indent_line(ctx, "return rex_nil();")
       end
     elseif stmt.kind == "ExprStmt" then
+      local saved_temps = begin_temps()
       indent_line(ctx, emit_expr(stmt.expr) .. ";")
+      end_temps(saved_temps)
+    elseif stmt.kind == "Assign" and scope_get_binding(ctx, stmt.name) and scope_get_binding(ctx, stmt.name).unboxed then
+      local binding = scope_get_binding(ctx, stmt.name)
+      local saved_temps = begin_temps()
+      local value
+      if binding.unboxed == "int" then
+        value = emit_int_store(stmt.value, binding.int_width)
+      else
+        value = emit_scalar(stmt.value, binding.unboxed)
+      end
+      indent_line(ctx, binding.c_name .. " = " .. value .. ";")
+      end_temps(saved_temps)
     elseif stmt.kind == "Assign" then
       local target = get_c_ident(ctx, stmt.name)
+      local binding = scope_get_binding(ctx, stmt.name)
       if ctx.active_bond then
         local bond = ctx.bonds[ctx.active_bond]
         if bond then
@@ -1681,7 +2528,23 @@ function Codegen.generate(ast, opts)
           )
         end
       end
-      indent_line(ctx, target .. " = " .. emit_expr(stmt.value) .. ";")
+      local saved_temps = begin_temps()
+      local value
+      if binding and binding.boxed_int then
+        local width = binding.boxed_int ~= "i64" and binding.boxed_int or nil
+        value = box_scalar(emit_int_store(stmt.value, width), "int", width)
+      else
+        value = emit_expr(stmt.value)
+      end
+      if binding and binding.drop then
+        ctx.tmp_id = ctx.tmp_id + 1
+        local tmp = "__tmp" .. ctx.tmp_id
+        indent_line(ctx, "RexValue " .. tmp .. " = " .. value .. ";")
+        indent_line(ctx, "rex_drop(" .. target .. ");")
+        value = tmp
+      end
+      indent_line(ctx, target .. " = " .. value .. ";")
+      end_temps(saved_temps)
     elseif stmt.kind == "MemberAssign" then
       local obj_expr = emit_expr(stmt.object)
       local field_lit = c_string(stmt.property)
@@ -1695,7 +2558,24 @@ function Codegen.generate(ast, opts)
           )
         end
       end
-      indent_line(ctx, "rex_struct_set(" .. obj_expr .. ", " .. field_lit .. ", " .. emit_expr(stmt.value) .. ");")
+      local index = struct_field_index(stmt.struct_name, stmt.property)
+      local native = index and native_field(stmt.struct_name, index)
+      if native then
+        local value
+        if native == "int" then
+          value = emit_int_store(stmt.value, native_field_width(stmt.struct_name, index))
+        else
+          value = emit_scalar(stmt.value, native)
+        end
+        indent_line(ctx, native_member(obj_expr, stmt.struct_name, stmt.property, true) .. " = " .. value .. ";")
+      elseif index then
+        indent_line(
+          ctx,
+          "rex_struct_set_at(" .. obj_expr .. ", rex_fields_" .. stmt.struct_name .. ", " .. index .. ", " .. emit_expr(stmt.value) .. ");"
+        )
+      else
+        indent_line(ctx, "rex_struct_set(" .. obj_expr .. ", " .. field_lit .. ", " .. emit_expr(stmt.value) .. ");")
+      end
     elseif stmt.kind == "IndexAssign" then
       local obj_expr = emit_expr(stmt.object)
       if ctx.active_bond then
@@ -1713,6 +2593,14 @@ function Codegen.generate(ast, opts)
         else
           indent_line(ctx, "rex_collections_set(" .. obj_expr .. ", " .. emit_expr(stmt.index) .. ", " .. emit_expr(stmt.value) .. ");")
         end
+      elseif int_index(stmt, stmt.index) then
+        local kind = scalar_kind(stmt.value)
+        local index = emit_scalar(stmt.index, "int")
+        if scalar_suffix[kind] and not (kind == "int" and stmt.value.int_width == "u64") then
+          indent_line(ctx, "rex_collections_vec_set_" .. scalar_suffix[kind] .. "(" .. obj_expr .. ", " .. index .. ", " .. emit_scalar(stmt.value, kind) .. ");")
+        else
+          indent_line(ctx, "rex_collections_vec_set_at(" .. obj_expr .. ", " .. index .. ", " .. emit_expr(stmt.value) .. ");")
+        end
       else
         indent_line(ctx, "rex_collections_set(" .. obj_expr .. ", " .. emit_expr(stmt.index) .. ", " .. emit_expr(stmt.value) .. ");")
       end
@@ -1743,7 +2631,7 @@ function Codegen.generate(ast, opts)
         indent_line(ctx, "}")
       end
     elseif stmt.kind == "If" then
-      indent_line(ctx, "if (rex_is_truthy(" .. emit_expr(stmt.cond) .. ")) {")
+      indent_line(ctx, "if (" .. emit_cond(stmt.cond) .. ") {")
       ctx.indent = ctx.indent + 1
       emit_block(stmt.then_block, true)
       ctx.indent = ctx.indent - 1
@@ -1761,55 +2649,169 @@ function Codegen.generate(ast, opts)
       local id = ctx.tmp_id
      
       table.insert(ctx.current_bindings, {})
-      local loop_var = get_c_name(ctx, stmt.name)
+      local loop_var = stmt.name and get_c_name(ctx, stmt.name)
+      local vars = {}
+      for i, name in ipairs(stmt.pattern and stmt.pattern.names or {}) do
+        vars[i] = get_c_name(ctx, name)
+      end
       table.remove(ctx.current_bindings)
       
-      if stmt.range_start then
+      if stmt.pattern then
+        -- (key, value) loops index the map's entry array directly.
+        local names = stmt.pattern.names
+        local iter_var = "__iter" .. id
+        local view_var = "__view" .. id
+        local idx_var = "__idx" .. id
+        indent_line(ctx, "RexValue " .. iter_var .. " = " .. emit_expr(stmt.iter) .. ";")
+        indent_line(ctx, "RexMapView " .. view_var .. " = rex_collections_map_view(" .. iter_var .. ");")
+        indent_line(ctx, "for (int64_t " .. idx_var .. " = 0; " .. idx_var .. " < " .. view_var .. ".count; " .. idx_var .. "++) {")
+        ctx.indent = ctx.indent + 1
+        indent_line(ctx, "rex_map_view_check(&" .. view_var .. ");")
+        indent_line(ctx, "if (rex_map_view_removed(&" .. view_var .. ", " .. idx_var .. ")) {")
+        ctx.indent = ctx.indent + 1
+        indent_line(ctx, "continue;")
+        ctx.indent = ctx.indent - 1
+        indent_line(ctx, "}")
+        local getters = { "rex_map_view_key", "rex_map_view_value" }
+        for i, var in ipairs(vars) do
+          local unboxed = stmt.bindings and stmt.bindings[i] and stmt.bindings[i].unboxed
+          local item = (getters[i] or getters[2]) .. "(&" .. view_var .. ", " .. idx_var .. ")"
+          if unboxed then
+            item = "rex_unbox_" .. unboxed .. "(" .. item .. ")"
+            if unboxed == "int" then
+              item = wrap_int(item, stmt.bindings[i].int_width)
+            end
+          end
+          indent_line(ctx, (unboxed and scalar_c_types[unboxed] or "RexValue") .. " " .. var .. " = " .. item .. ";")
+        end
+        emit_loop_body(stmt.body, function()
+          for i, name in ipairs(names) do
+            local unboxed = stmt.bindings and stmt.bindings[i] and stmt.bindings[i].unboxed
+            scope_set_binding(ctx, name, vars[i], unboxed or "unknown")
+            scope_get_binding(ctx, name).unboxed = unboxed
+            scope_get_binding(ctx, name).int_width = unboxed and stmt.bindings[i].int_width
+          end
+        end)
+        ctx.indent = ctx.indent - 1
+        indent_line(ctx, "}")
+      elseif stmt.range_start then
+        -- Integral ranges count with an int64_t; stepped ones iterate over a
+        -- precomputed trip count so reverse and overflowing ranges stay exact.
+        local counter = stmt.range_int and "int" or "num"
         local start_var = "__start" .. id
         local end_var = "__end" .. id
-        local start_num = "__start_num" .. id
-        local end_num = "__end_num" .. id
-        local idx_num = "__idx_num" .. id
-        indent_line(ctx, "RexValue " .. start_var .. " = " .. emit_expr(stmt.range_start) .. ";")
-        indent_line(ctx, "RexValue " .. end_var .. " = " .. emit_expr(stmt.range_end) .. ";")
-        indent_line(ctx, "if (" .. start_var .. ".tag != REX_NUM || " .. end_var .. ".tag != REX_NUM) { rex_panic(\"for range expects numbers\"); }")
-        indent_line(ctx, "double " .. start_num .. " = " .. start_var .. ".as.num;")
-        indent_line(ctx, "double " .. end_num .. " = " .. end_var .. ".as.num;")
-        indent_line(ctx, "for (double " .. idx_num .. " = " .. start_num .. "; " .. idx_num .. " < " .. end_num .. "; " .. idx_num .. " += 1.0) {")
-        ctx.indent = ctx.indent + 1
-        indent_line(ctx, "RexValue " .. loop_var .. " = rex_num(" .. idx_num .. ");")
-        emit_block(stmt.body, true, function()
-          scope_set_binding(ctx, stmt.name, loop_var, "num")
+        local step_var = "__step" .. id
+        local idx_var = "__idx" .. id
+        local function emit_bound(expr, var, kind)
+          if scalar_kind(expr) then
+            indent_line(ctx, scalar_c_types[kind] .. " " .. var .. " = " .. emit_scalar(expr, kind) .. ";")
+            return
+          end
+          indent_line(ctx, "RexValue " .. var .. "_val = " .. emit_expr(expr) .. ";")
+          indent_line(ctx, "if (rex_value_tag(" .. var .. "_val) != REX_NUM) { rex_panic(\"for range expects numbers\"); }")
+          indent_line(ctx, scalar_c_types[kind] .. " " .. var .. " = " .. convert_scalar("rex_as_num(" .. var .. "_val)", "num", kind) .. ";")
+        end
+        emit_bound(stmt.range_start, start_var, counter)
+        local step = stmt.range_step and step_var or (counter == "int" and "1" or "1.0")
+        if stmt.range_step then
+          emit_bound(stmt.range_step, step_var, counter)
+        end
+        if counter == "int" and not int_operand(stmt.range_end) then
+          emit_bound(stmt.range_end, end_var .. "_num", "num")
+          indent_line(ctx, "int64_t " .. end_var .. " = rex_range_end(" .. end_var .. "_num, " .. step .. ");")
+        else
+          emit_bound(stmt.range_end, end_var, counter)
+        end
+        if counter == "int" and stmt.range_step then
+          local trips = "__trips" .. id
+          local k = "__k" .. id
+          indent_line(ctx, "uint64_t " .. trips .. " = rex_range_count(" .. start_var .. ", " .. end_var .. ", " .. step .. ");")
+          indent_line(ctx, "for (uint64_t " .. k .. " = 0; " .. k .. " < " .. trips .. "; " .. k .. "++) {")
+          ctx.indent = ctx.indent + 1
+          indent_line(ctx, "int64_t " .. idx_var .. " = (int64_t)((uint64_t)" .. start_var .. " + " .. k .. " * (uint64_t)" .. step .. ");")
+        elseif counter == "int" then
+          indent_line(ctx, "for (int64_t " .. idx_var .. " = " .. start_var .. "; " .. idx_var .. " < " .. end_var .. "; " .. idx_var .. "++) {")
+          ctx.indent = ctx.indent + 1
+        else
+          local cond = idx_var .. " < " .. end_var
+          if stmt.range_step then
+            indent_line(ctx, "if (" .. step .. " == 0) { rex_panic(\"range step cannot be zero\"); }")
+            cond = step .. " > 0 ? " .. cond .. " : " .. idx_var .. " > " .. end_var
+          end
+          indent_line(ctx, "for (double " .. idx_var .. " = " .. start_var .. "; " .. cond .. "; " .. idx_var .. " += " .. step .. ") {")
+          ctx.indent = ctx.indent + 1
+        end
+        local var_kind = stmt.unboxed or "num"
+        if stmt.unboxed then
+          local value = convert_scalar(idx_var, counter, var_kind, stmt.int_width)
+          indent_line(ctx, scalar_c_types[var_kind] .. " " .. loop_var .. " = " .. value .. ";")
+        elseif stmt.boxed_int and counter == "int" then
+          indent_line(ctx, "RexValue " .. loop_var .. " = " .. box_scalar(idx_var, "int", stmt.int_width) .. ";")
+        else
+          indent_line(ctx, "RexValue " .. loop_var .. " = rex_num(" .. convert_scalar(idx_var, counter, "num") .. ");")
+        end
+        emit_loop_body(stmt.body, function()
+          scope_set_binding(ctx, stmt.name, loop_var, var_kind)
+          scope_get_binding(ctx, stmt.name).unboxed = stmt.unboxed
+          scope_get_binding(ctx, stmt.name).int_width = stmt.int_width
         end)
         ctx.indent = ctx.indent - 1
         indent_line(ctx, "}")
       else
         local iter_var = "__iter" .. id
-        local len_var = "__len" .. id
+        local view_var = "__view" .. id
         local idx_var = "__idx" .. id
         indent_line(ctx, "RexValue " .. iter_var .. " = " .. emit_expr(stmt.iter) .. ";")
-        indent_line(ctx, "RexValue " .. len_var .. " = rex_collections_vec_len(" .. iter_var .. ");")
-        indent_line(ctx, "for (RexValue " .. idx_var .. " = rex_num(0); rex_is_truthy(rex_lt(" .. idx_var .. ", " .. len_var .. ")); " .. idx_var .. " = rex_add(" .. idx_var .. ", rex_num(1))) {")
+        local view_fn = stmt.iter_kind == "set" and "rex_collections_set_view" or "rex_collections_vec_view"
+        indent_line(ctx, "RexVecView " .. view_var .. " = " .. view_fn .. "(" .. iter_var .. ");")
+        indent_line(ctx, "for (int64_t " .. idx_var .. " = 0; " .. idx_var .. " < " .. view_var .. ".count; " .. idx_var .. "++) {")
         ctx.indent = ctx.indent + 1
-        indent_line(ctx, "RexValue " .. loop_var .. " = rex_collections_vec_get(" .. iter_var .. ", " .. idx_var .. ");")
-        emit_block(stmt.body, true, function()
-          scope_set_binding(ctx, stmt.name, loop_var, "unknown")
+        indent_line(ctx, "rex_vec_view_check(&" .. view_var .. ");")
+        local item = "rex_vec_view_get(&" .. view_var .. ", " .. idx_var .. ")"
+        if stmt.unboxed == "bool" then
+          item = "rex_unbox_bool(" .. item .. ")"
+        elseif stmt.unboxed then
+          item = "rex_vec_view_" .. scalar_suffix[stmt.unboxed] .. "(&" .. view_var .. ", " .. idx_var .. ")"
+          if stmt.unboxed == "int" then
+            item = wrap_int(item, stmt.int_width)
+          end
+        end
+        indent_line(ctx, (stmt.unboxed and scalar_c_types[stmt.unboxed] or "RexValue") .. " " .. loop_var .. " = " .. item .. ";")
+        emit_loop_body(stmt.body, function()
+          scope_set_binding(ctx, stmt.name, loop_var, stmt.unboxed or "unknown")
+          scope_get_binding(ctx, stmt.name).unboxed = stmt.unboxed
+          scope_get_binding(ctx, stmt.name).int_width = stmt.int_width
         end)
         ctx.indent = ctx.indent - 1
         indent_line(ctx, "}")
       end
     elseif stmt.kind == "While" then
-      indent_line(ctx, "while (rex_is_truthy(" .. emit_expr(stmt.cond) .. ")) {")
+      -- A condition that emits statements first (? or an iterator pipeline)
+      -- has to rerun them on every pass, so it moves inside the loop.
+      local mark = #ctx.lines
       ctx.indent = ctx.indent + 1
-      emit_block(stmt.body, true)
+      local cond = emit_cond(stmt.cond)
+      ctx.indent = ctx.indent - 1
+      local pre = {}
+      while #ctx.lines > mark do
+        table.insert(pre, 1, table.remove(ctx.lines))
+      end
+      if #pre == 0 then
+        indent_line(ctx, "while (" .. cond .. ") {")
+        ctx.indent = ctx.indent + 1
+      else
+        indent_line(ctx, "while (1) {")
+        insert_lines(ctx.lines, #ctx.lines + 1, pre)
+        ctx.indent = ctx.indent + 1
+        indent_line(ctx, "if (!(" .. cond .. ")) { break; }")
+      end
+      emit_loop_body(stmt.body)
       ctx.indent = ctx.indent - 1
       indent_line(ctx, "}")
     elseif stmt.kind == "Break" then
-      emit_defer_list(ctx.defer_stack[#ctx.defer_stack])
-      indent_line(ctx, "break;")
+      emit_loop_exit("break")
     elseif stmt.kind == "Continue" then
-      emit_defer_list(ctx.defer_stack[#ctx.defer_stack])
-      indent_line(ctx, "continue;")
+      emit_loop_exit("continue")
     elseif stmt.kind == "Match" then
       ctx.match_id = ctx.match_id + 1
       local tmp = "__match" .. ctx.match_id
@@ -1847,6 +2849,8 @@ function Codegen.generate(ast, opts)
         if arm.body and arm.body.statements and #arm.body.statements > 0 then
           local last_stmt = arm.body.statements[#arm.body.statements]
           if last_stmt.kind == "ExprStmt" then
+            local arm_returned = false
+            table.insert(ctx.defer_stack, {})
             for j = 1, #arm.body.statements - 1 do
               ctx.emit_stmt(arm.body.statements[j])
             end
@@ -1872,11 +2876,16 @@ function Codegen.generate(ast, opts)
               indent_line(ctx, emit_expr(last_stmt.expr) .. ";")
             else
               if can_emit_tail_return() then
-                indent_line(ctx, "return " .. emit_expr(last_stmt.expr) .. ";")
+                emit_return(emit_expr(last_stmt.expr))
+                arm_returned = true
               else
                 indent_line(ctx, emit_expr(last_stmt.expr) .. ";")
               end
             end
+            local arm_defers = table.remove(ctx.defer_stack)
+            if not arm_returned then
+              emit_defer_list(arm_defers)
+            end
           else
             emit_block(arm.body, true)
           end
@@ -1914,7 +2923,8 @@ function Codegen.generate(ast, opts)
   ctx.indent = ctx.indent + 1
   indent_line(ctx, "REX_BOND_ASSIGN = 0,")
   indent_line(ctx, "REX_BOND_MEMBER = 1,")
-  indent_line(ctx, "REX_BOND_INDEX = 2")
+  indent_line(ctx, "REX_BOND_INDEX = 2,")
+  indent_line(ctx, "REX_BOND_SNAPSHOT = 3")
   ctx.indent = ctx.indent - 1
   indent_line(ctx, "} RexBondActionKind;")
   indent_line(ctx, "")
@@ -1989,6 +2999,17 @@ function Codegen.generate(ast, opts)
   ctx.indent = ctx.indent - 1
   indent_line(ctx, "}")
   indent_line(ctx, "")
+  indent_line(ctx, "static void __rex_bond_push_snapshot(RexBondAction** actions, int* count, int* cap, RexValue object) {")
+  ctx.indent = ctx.indent + 1
+  indent_line(ctx, "RexBondAction action;")
+  indent_line(ctx, "memset(&action, 0, sizeof(action));")
+  indent_line(ctx, "action.kind = REX_BOND_SNAPSHOT;")
+  indent_line(ctx, "action.object = object;")
+  indent_line(ctx, "action.old_value = rex_collections_snapshot(object);")
+  indent_line(ctx, "__rex_bond_push(actions, count, cap, action);")
+  ctx.indent = ctx.indent - 1
+  indent_line(ctx, "}")
+  indent_line(ctx, "")
   indent_line(ctx, "static void __rex_bond_apply_rollback(RexBondAction* actions, int count) {")
   ctx.indent = ctx.indent + 1
   indent_line(ctx, "for (int i = count - 1; i >= 0; --i) {")
@@ -2010,6 +3031,11 @@ function Codegen.generate(ast, opts)
   ctx.indent = ctx.indent + 1
   indent_line(ctx, "rex_collections_set(action->object, action->key, action->old_value);")
   ctx.indent = ctx.indent - 1
+  indent_line(ctx, "} else if (action->kind == REX_BOND_SNAPSHOT) {")
+  ctx.indent = ctx.indent + 1
+  indent_line(ctx, "rex_collections_restore(action->object, action->old_value);")
+  indent_line(ctx, "action->old_value = rex_nil();")
+  ctx.indent = ctx.indent - 1
   indent_line(ctx, "}")
   ctx.indent = ctx.indent - 1
   indent_line(ctx, "}")
@@ -2020,6 +3046,15 @@ function Codegen.generate(ast, opts)
   ctx.indent = ctx.indent + 1
   indent_line(ctx, "if (actions && *actions) {")
   ctx.indent = ctx.indent + 1
+  indent_line(ctx, "for (int i = 0; i < *count; ++i) {")
+  ctx.indent = ctx.indent + 1
+  indent_line(ctx, "if ((*actions)[i].kind == REX_BOND_SNAPSHOT) {")
+  ctx.indent = ctx.indent + 1
+  indent_line(ctx, "rex_drop((*actions)[i].old_value);")
+  ctx.indent = ctx.indent - 1
+  indent_line(ctx, "}")
+  ctx.indent = ctx.indent - 1
+  indent_line(ctx, "}")
   indent_line(ctx, "free(*actions);")
   indent_line(ctx, "*actions = NULL;")
   ctx.indent = ctx.indent - 1
@@ -2034,7 +3069,7 @@ function Codegen.generate(ast, opts)
     local ctor = ctx.struct_ctors[struct_name]
     local params = {}
     for _, field in ipairs(def.fields) do
-      table.insert(params, "RexValue " .. field.name)
+      table.insert(params, "RexValue f_" .. field.name)
     end
     indent_line(ctx, "static RexValue " .. ctor .. "(" .. table.concat(params, ", ") .. ");")
   end
@@ -2087,31 +3122,60 @@ function Codegen.generate(ast, opts)
     indent_line(ctx, "static RexValue rex_init(void);")
   end
 
-  local spawn_helper_index = #ctx.lines + 1
-  indent_line(ctx, "")
-
   for struct_name, def in pairs(ctx.structs) do
     local field_names = {}
     for _, field in ipairs(def.fields) do
       table.insert(field_names, c_string(field.name))
     end
     indent_line(ctx, "static const char* rex_fields_" .. struct_name .. "[] = {" .. table.concat(field_names, ", ") .. "};")
+    if def.native then
+      local native_type = "RexNative_" .. struct_name
+      local members = {}
+      local kinds = {}
+      local offsets = {}
+      for _, field in ipairs(def.fields) do
+        table.insert(members, scalar_c_types[field.native] .. " f_" .. field.name .. ";")
+        table.insert(kinds, field.int_width == "u64" and "REX_FIELD_U64" or ("REX_FIELD_" .. field.native:upper()))
+        table.insert(offsets, "offsetof(" .. native_type .. ", f_" .. field.name .. ")")
+      end
+      indent_line(ctx, "typedef struct " .. native_type .. " { " .. table.concat(members, " ") .. " } " .. native_type .. ";")
+      indent_line(ctx, "static const unsigned char rex_kinds_" .. struct_name .. "[] = {" .. table.concat(kinds, ", ") .. "};")
+      indent_line(ctx, "static const size_t rex_offsets_" .. struct_name .. "[] = {" .. table.concat(offsets, ", ") .. "};")
+      indent_line(
+        ctx,
+        "static const RexStructLayout rex_layout_" .. struct_name .. " = {" .. c_string(struct_name) .. ", rex_fields_" .. struct_name
+          .. ", rex_kinds_" .. struct_name .. ", rex_offsets_" .. struct_name .. ", " .. #def.fields .. ", sizeof(" .. native_type .. ")};"
+      )
+    end
     local ctor = ctx.struct_ctors[struct_name]
     local params = {}
     local values = {}
     for _, field in ipairs(def.fields) do
-      table.insert(params, "RexValue " .. field.name)
-      table.insert(values, field.name)
+      table.insert(params, "RexValue f_" .. field.name)
+      if field.native then
+        local value = "rex_unbox_" .. field.native .. "(f_" .. field.name .. ")"
+        table.insert(values, field.native == "int" and wrap_int(value, field.int_width) or value)
+      else
+        table.insert(values, "f_" .. field.name)
+      end
     end
     indent_line(ctx, "static RexValue " .. ctor .. "(" .. table.concat(params, ", ") .. ") {")
     ctx.indent = ctx.indent + 1
-    indent_line(ctx, "RexValue values[] = {" .. table.concat(values, ", ") .. "};")
-    indent_line(ctx, "return rex_struct_new(" .. c_string(struct_name) .. ", rex_fields_" .. struct_name .. ", values, " .. #def.fields .. ");")
+    if def.native then
+      indent_line(ctx, "RexNative_" .. struct_name .. " __rex_native = {" .. table.concat(values, ", ") .. "};")
+      indent_line(ctx, "return rex_struct_new_native(&rex_layout_" .. struct_name .. ", &__rex_native);")
+    else
+      indent_line(ctx, "RexValue __rex_values[] = {" .. table.concat(values, ", ") .. "};")
+      indent_line(ctx, "return rex_struct_new(" .. c_string(struct_name) .. ", rex_fields_" .. struct_name .. ", __rex_values, " .. #def.fields .. ");")
+    end
     ctx.indent = ctx.indent - 1
     indent_line(ctx, "}")
     indent_line(ctx, "")
   end
 
+  local spawn_helper_index = #ctx.lines + 1
+  indent_line(ctx, "")
+
   for _, item in ipairs(ast.items) do
     if item.kind == "Impl" then
       for _, method in ipairs(item.methods) do
@@ -2229,6 +3293,17 @@ function Codegen.generate(ast, opts)
     insert_lines(ctx.lines, spawn_helper_index, insert)
   end
 
+  if #ctx.string_literal_order > 0 then
+    local insert = {}
+    for i, text in ipairs(ctx.string_literal_order) do
+      local storage = "rex_strlit_" .. i
+      table.insert(insert, "static const struct { RexStrHeader h; char s[" .. (#text + 1) .. "]; } " .. storage .. " = { { " .. #text .. ", 0, 0, REX_STR_STATIC }, " .. c_string(text) .. " };")
+      table.insert(insert, "static const RexValue " .. ctx.string_literals[text] .. " = REX_STR_LITERAL(" .. storage .. ".s);")
+    end
+    table.insert(insert, "")
+    insert_lines(ctx.lines, spawn_helper_index, insert)
+  end
+
   return table.concat(ctx.lines, "\n")
 end
 
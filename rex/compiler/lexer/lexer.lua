@@ -37,6 +37,7 @@ local keywords = {
   ["rollback"] = true,
   ["within"] = true,
   ["during"] = true,
+  ["with"] = true,
   ["temporal"] = true,
   ["debug"] = true,
   ["ownership"] = true,
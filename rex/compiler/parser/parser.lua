@@ -381,6 +381,9 @@ function Parser:parse_statement()
   if self:match_keyword("during") then
     return self:parse_during()
   end
+  if self:match_keyword("with") then
+    return self:parse_with()
+  end
   if self:match_keyword("debug") then
     if self:match_keyword("ownership") then
       return self:parse_debug_ownership()
@@ -668,16 +671,30 @@ function Parser:parse_bond()
 end
 
 function Parser:parse_for()
-  local name = self:expect_kind("ident").value
+  local name = nil
+  local pattern = nil
+  if self:current().value == "(" then
+    pattern = self:parse_pattern()
+  else
+    name = self:expect_kind("ident").value
+  end
   self:expect_keyword("in")
   local start = self:parse_expression()
+  if pattern and self:current().value == ".." then
+    self:error("Range loops expect a single loop variable")
+  end
   if self:match("..") then
     local finish = self:parse_expression()
+    local step = nil
+    if self:current().kind == "ident" and self:current().value == "step" then
+      self:advance()
+      step = self:parse_expression()
+    end
     local body = self:parse_block()
-    return ast.node("For", { name = name, range_start = start, range_end = finish, body = body })
+    return ast.node("For", { name = name, range_start = start, range_end = finish, range_step = step, body = body })
   end
   local body = self:parse_block()
-  return ast.node("For", { name = name, iter = start, body = body })
+  return ast.node("For", { name = name, pattern = pattern, iter = start, body = body })
 end
 
 function Parser:parse_if()
@@ -916,6 +933,17 @@ function Parser:parse_primary()
     self:advance()
     return ast.node("Identifier", { name = tok.value })
   end
+  if self:match("|") then
+    local params = {}
+    if not self:match("|") then
+      repeat
+        table.insert(params, self:expect_kind("ident").value)
+      until not self:match(",")
+      self:expect("|")
+    end
+    local body = self:parse_expression()
+    return ast.node("Lambda", { params = params, body = body })
+  end
   if self:match("(") then
     local expr = self:parse_expression()
     self:expect(")")
@@ -942,6 +970,15 @@ function Parser:parse_during()
   })
 end
 
+function Parser:parse_with()
+  local arena = self:parse_expression()
+  local block = self:parse_block()
+  return ast.node("WithBlock", {
+    arena = arena,
+    block = block
+  })
+end
+
 function Parser:parse_debug_ownership()
   if self:match("{") then
     local rules = {}
@@ -23,6 +23,55 @@ local function type_num()
   return type_new("num")
 end
 
+-- A number known to be a float: an f64/f32 annotation, a literal with a
+-- fraction, or arithmetic on either. Plain num (counts, lengths, untyped
+-- locals such as `mut sum = 0`) may still hold an integer.
+local function type_float()
+  return type_new("num", { float = true })
+end
+
+-- Integers keep their declared width (i8 .. u64); every width is held in
+-- an int64_t and narrowed back after each operation.
+local function type_int(width)
+  width = width or "i64"
+  return type_new("num", { int = true, width = width, byte = width == "u8" or nil })
+end
+
+-- Vec<T> of numbers is stored contiguously at runtime (RexVecKind).
+local function typed_vec_kind(elem)
+  if not elem or elem.kind ~= "num" then
+    return nil
+  end
+  if elem.byte then
+    return "u8"
+  end
+  if elem.width == "u64" then
+    return "u64"
+  end
+  return elem.int and "i64" or "f64"
+end
+
+-- The width codegen must narrow to or treat as unsigned; nil for i64.
+local function int_width(t)
+  if t and t.kind == "num" and t.int and t.width and t.width ~= "i64" then
+    return t.width
+  end
+  return nil
+end
+
+local function scalar_type_kind(t)
+  if not t then
+    return nil
+  end
+  if t.kind == "num" then
+    return t.int and "int" or "num"
+  end
+  if t.kind == "bool" then
+    return "bool"
+  end
+  return nil
+end
+
 local function type_bool()
   return type_new("bool")
 end
@@ -75,6 +124,10 @@ local function type_receiver(item)
   return type_new("receiver", { item = item })
 end
 
+local function type_arena()
+  return type_new("arena")
+end
+
 local function type_struct(name, fields, args)
   return type_new("struct", { name = name, fields = fields, args = args })
 end
@@ -205,6 +258,8 @@ local function type_to_string(t)
     return "Sender<" .. type_to_string(t.item) .. ">"
   elseif t.kind == "receiver" then
     return "Receiver<" .. type_to_string(t.item) .. ">"
+  elseif t.kind == "arena" then
+    return "Arena"
   elseif t.kind == "struct" then
     if t.args and #t.args > 0 then
       local parts = {}
@@ -380,6 +435,9 @@ local function type_merge(ctx, a, b, where)
     return a
   end
   if type_equal(a, b) then
+    if a.kind == "num" and (a.int ~= b.int or a.width ~= b.width) then
+      return (a.int and b.int) and type_int() or type_num()
+    end
     return a
   end
   report(ctx, (where or "value") .. " types mismatch: " .. type_to_string(a) .. " vs " .. type_to_string(b))
@@ -559,6 +617,18 @@ local numeric_names = {
   usize = true,
 }
 
+local float_names = {
+  f32 = true,
+  f64 = true,
+  float = true,
+}
+
+local int_aliases = {
+  int = "i64",
+  isize = "i64",
+  usize = "u64",
+}
+
 build_struct_type = function(ctx, name, args, outer_params)
   local def = ctx.structs[name]
   if not def then
@@ -690,7 +760,7 @@ resolve_type = function(ctx, t, type_params, depth)
       return resolve_type(ctx, ctx.aliases[name], type_params, depth + 1)
     end
     if numeric_names[name] then
-      return type_num()
+      return float_names[name] and type_float() or type_int(int_aliases[name] or name)
     end
     if name == "bool" then
       return type_bool()
@@ -710,6 +780,9 @@ resolve_type = function(ctx, t, type_params, depth)
     if name == "unknown" then
       return type_unknown()
     end
+    if name == "Arena" then
+      return type_arena()
+    end
     if name == "Result" then
       if not t.args or #t.args == 0 then
         report(ctx, "Result expects type arguments")
@@ -874,10 +947,13 @@ local modules = {
     box = builtins.box,
     unbox = builtins.unbox,
     drop = builtins.drop,
+    arena_new = sig({}, type_arena()),
+    arena_reset = sig({ type_ref(type_arena(), true) }, type_void()),
   },
   math = {
     sqrt = sig({ type_num() }, type_num()),
     abs = sig({ type_num() }, type_num()),
+    trunc = sig({ type_num() }, type_int()),
     eval = sig({ type_ref(type_str(), false) }, type_result(type_num(), type_str())),
   },
   collections = {
@@ -888,10 +964,13 @@ local modules = {
     vec_len = sig({ type_ref(type_vec(type_var("T")), false) }, type_num(), { "T" }),
     vec_insert = sig({ type_ref(type_vec(type_var("T")), true), type_num(), type_var("T") }, type_void(), { "T" }),
     vec_slice = sig({ type_ref(type_vec(type_var("T")), false), type_num(), type_num() }, type_vec(type_var("T")), { "T" }),
+    vec_clone = sig({ type_ref(type_vec(type_var("T")), false) }, type_vec(type_var("T")), { "T" }),
     vec_from = sig({}, type_vec(type_var("T")), { "T" }),
     vec_pop = sig({ type_ref(type_vec(type_var("T")), true) }, type_var("T"), { "T" }),
     vec_clear = sig({ type_ref(type_vec(type_var("T")), true) }, type_void(), { "T" }),
     vec_sort = sig({ type_ref(type_vec(type_var("T")), true) }, type_void(), { "T" }),
+    vec_sort_by_key = sig({ type_ref(type_vec(type_var("T")), true), type_str() }, type_void(), { "T" }),
+    vec_par_sort = sig({ type_ref(type_vec(type_var("T")), true) }, type_void(), { "T" }),
     vec_find = sig({ type_ref(type_vec(type_var("T")), false), type_var("T") }, type_num(), { "T" }),
     vec_any = sig({ type_ref(type_vec(type_var("T")), false), type_var("T") }, type_bool(), { "T" }),
     vec_all = sig({ type_ref(type_vec(type_var("T")), false), type_var("T") }, type_bool(), { "T" }),
@@ -901,7 +980,15 @@ local modules = {
     vec_first = sig({ type_ref(type_vec(type_var("T")), false) }, type_var("T"), { "T" }),
     vec_last = sig({ type_ref(type_vec(type_var("T")), false) }, type_var("T"), { "T" }),
     vec_join = sig({ type_ref(type_vec(type_str()), false), type_ref(type_str(), false) }, type_str()),
+    vec_bytes = sig({ type_ref(type_vec(type_var("T")), false) }, type_num(), { "T" }),
+    vec_sum = sig({ type_ref(type_vec(type_var("T")), false) }, type_var("T"), { "T" }),
+    vec_min = sig({ type_ref(type_vec(type_var("T")), false) }, type_var("T"), { "T" }),
+    vec_max = sig({ type_ref(type_vec(type_var("T")), false) }, type_var("T"), { "T" }),
+    vec_dot = sig({ type_ref(type_vec(type_var("T")), false), type_ref(type_vec(type_var("T")), false) }, type_var("T"), { "T" }),
+    vec_scale = sig({ type_ref(type_vec(type_var("T")), true), type_num() }, type_void(), { "T" }),
+    vec_add = sig({ type_ref(type_vec(type_var("T")), true), type_ref(type_vec(type_var("T")), false) }, type_void(), { "T" }),
     map_new = sig({}, type_map(type_var("K"), type_var("V")), { "K", "V" }),
+    map_clone = sig({ type_ref(type_map(type_var("K"), type_var("V")), false) }, type_map(type_var("K"), type_var("V")), { "K", "V" }),
     map_put = sig({ type_ref(type_map(type_var("K"), type_var("V")), true), type_var("K"), type_var("V") }, type_void(), { "K", "V" }),
     map_get = sig({ type_ref(type_map(type_var("K"), type_var("V")), false), type_var("K") }, type_var("V"), { "K", "V" }),
     map_remove = sig({ type_ref(type_map(type_var("K"), type_var("V")), true), type_var("K") }, type_bool(), { "K", "V" }),
@@ -915,6 +1002,11 @@ local modules = {
     set_has = sig({ type_ref(type_set(type_var("T")), false), type_var("T") }, type_bool(), { "T" }),
     set_remove = sig({ type_ref(type_set(type_var("T")), true), type_var("T") }, type_bool(), { "T" }),
     set_len = sig({ type_ref(type_set(type_var("T")), false) }, type_num(), { "T" }),
+    set_from_vec = sig({ type_ref(type_vec(type_var("T")), false) }, type_set(type_var("T")), { "T" }),
+    set_union = sig({ type_ref(type_set(type_var("T")), false), type_ref(type_set(type_var("T")), false) }, type_set(type_var("T")), { "T" }),
+    set_intersect = sig({ type_ref(type_set(type_var("T")), false), type_ref(type_set(type_var("T")), false) }, type_set(type_var("T")), { "T" }),
+    set_difference = sig({ type_ref(type_set(type_var("T")), false), type_ref(type_set(type_var("T")), false) }, type_set(type_var("T")), { "T" }),
+    set_values = sig({ type_ref(type_set(type_var("T")), false) }, type_vec(type_var("T")), { "T" }),
   },
   os = {
     getenv = sig({ type_ref(type_str(), false) }, type_any()),
@@ -1118,16 +1210,69 @@ local function find_root_name(node)
   return nil
 end
 
+local function own_escape(ctx, id)
+  local var = id and ctx.ownership.vars[id]
+  if var and var.drop then
+    var.drop.escapes = var.drop.escapes + 1
+  end
+end
+
+-- A scalar local stays boxed once something needs its RexValue slot: a
+-- borrow, a spawn capture or a bond rollback entry.
+local function own_box(ctx, id)
+  local var = id and ctx.ownership.vars[id]
+  if var and var.scalar then
+    var.scalar.boxed = true
+  end
+end
+
 local function own_resolve(ctx, name)
   for i = #ctx.ownership.scopes, 1, -1 do
     local id = ctx.ownership.scopes[i][name]
     if id then
+      if ctx.ownership.in_spawn then
+        local var = ctx.ownership.vars[id]
+        if var and var.view_depth and i <= ctx.ownership.spawn_depth then
+          report(ctx, "Slice view cannot be captured by spawn; copy it with vec_slice")
+        end
+        own_escape(ctx, id)
+        own_escape(ctx, var and var.ref_target)
+        own_box(ctx, id)
+      end
       return id
     end
   end
   return nil
 end
 
+-- A `&v[a..b]` view points at a header in the scope that created it and at
+-- v's storage, so it may be lent to a call but never stored anywhere that
+-- can outlive that scope.
+local function own_is_view(ctx, expr)
+  if not expr then
+    return false
+  end
+  if expr.kind == "Borrow" then
+    return expr.expr ~= nil and expr.expr.kind == "Slice"
+  end
+  if expr.kind ~= "Identifier" then
+    return false
+  end
+  for i = #ctx.ownership.scopes, 1, -1 do
+    local id = ctx.ownership.scopes[i][expr.name]
+    if id then
+      return ctx.ownership.vars[id].view_depth ~= nil
+    end
+  end
+  return false
+end
+
+local function own_reject_view_store(ctx, expr)
+  if own_is_view(ctx, expr) then
+    report(ctx, "Slice view cannot be stored; copy it with vec_slice")
+  end
+end
+
 local function own_add_borrow(ctx, id, is_mut)
   local var = ctx.ownership.vars[id]
   if not var then
@@ -1183,6 +1328,8 @@ local function own_bind(ctx, name, info, opts)
     borrow_imm = 0,
     borrow_mut = 0,
     scope_depth = scope_depth,
+    drop = opts and opts.drop or nil,
+    scalar = opts and opts.scalar or nil,
   }
   ctx.ownership.scopes[#ctx.ownership.scopes][name] = id
   if ref_target then
@@ -1237,12 +1384,16 @@ local function own_mark_moved(ctx, id, where)
   var.moved = true
 end
 
-local function own_use_value(ctx, name, where)
+local function own_use_value(ctx, name, where, mode)
   local id = own_resolve(ctx, name)
   if not id then
     return
   end
   local var = ctx.ownership.vars[id]
+  if mode ~= "sink" then
+    own_escape(ctx, id)
+    own_escape(ctx, var.ref_target)
+  end
   if var.moved then
     report_moved_value(ctx, where or name, name)
     return
@@ -1267,6 +1418,7 @@ local function own_can_borrow(ctx, id, is_mut, where)
   if not var then
     return false
   end
+  own_box(ctx, id)
   if var.moved then
     report_moved_value(ctx, where or var.name, var.name)
     return false
@@ -1334,6 +1486,9 @@ local function own_clone(state)
       borrow_imm = var.borrow_imm,
       borrow_mut = var.borrow_mut,
       scope_depth = var.scope_depth,
+      view_depth = var.view_depth,
+      drop = var.drop,
+      scalar = var.scalar,
     }
   end
   local scopes = {}
@@ -1363,6 +1518,9 @@ local function own_clone(state)
     temp_borrows = temp_borrows,
     defer_stack = defer_stack,
     defer_use = {},
+    in_spawn = state.in_spawn,
+    spawn_depth = state.spawn_depth,
+    in_arena = state.in_arena,
   }
 end
 
@@ -1388,6 +1546,144 @@ local function own_apply_defer_uses(base, uses)
   end
 end
 
+-- Module functions that always return a newly allocated value the caller owns.
+local fresh_module_calls = {
+  collections = {
+    vec_new = true,
+    vec_from = true,
+    vec_slice = true,
+    vec_clone = true,
+    map_new = true,
+    map_clone = true,
+    map_keys = true,
+    map_values = true,
+    map_items = true,
+    set_new = true,
+    set_from_vec = true,
+    set_union = true,
+    set_intersect = true,
+    set_difference = true,
+    set_values = true,
+  },
+  fmt = { format = true, pad_left = true, pad_right = true, join = true, fixed = true, hex = true, bin = true },
+  text = {
+    initials = true,
+    lower_ascii = true,
+    upper_ascii = true,
+    pad_left = true,
+    pad_right = true,
+    trim = true,
+    trim_start = true,
+    trim_end = true,
+    split_words = true,
+    replace = true,
+    ["repeat"] = true,
+    lines = true,
+  },
+  json = { encode = true, encode_pretty = true },
+  mem = { arena_new = true },
+}
+
+-- Modules whose arguments are only read, never retained.
+local sink_modules = { fmt = true, text = true }
+
+-- A fresh expression yields a value nothing else refers to. Calls to user
+-- functions are fresh only once every return path of the callee is, which
+-- is settled after all bodies are checked (see own_resolve_drops).
+local function own_expr_is_fresh(expr)
+  if not expr then
+    return false
+  end
+  local kind = expr.kind
+  if kind == "String" or kind == "Number" or kind == "Bool" or kind == "Nil" then
+    return true
+  end
+  if kind == "Binary" or kind == "Unary" or kind == "Array" or kind == "StructLit" or kind == "Slice" then
+    return true
+  end
+  return kind == "Call" and (expr.fresh == true or expr.fresh_fn ~= nil)
+end
+
+local function own_drop_record(ctx, stmt, var_type)
+  local rec = {
+    stmt = stmt,
+    fresh = true,
+    fns = {},
+    escapes = ctx.ownership.in_spawn and 1 or 0,
+    returns = 0,
+    copy = type_is_copy(var_type),
+  }
+  stmt.drop_on_exit = false
+  table.insert(ctx.drop_records, rec)
+  return rec
+end
+
+-- Number and bool locals are emitted as raw C doubles/ints unless boxed.
+local function own_scalar_record(ctx, stmt, var_type)
+  local kind = scalar_type_kind(var_type)
+  if not kind then
+    return nil
+  end
+  local rec = { stmt = stmt, kind = kind, boxed = false }
+  stmt.unboxed = nil
+  stmt.int_width = int_width(var_type)
+  table.insert(ctx.scalar_records, rec)
+  return rec
+end
+
+local function own_note_fresh(rec, expr)
+  if not own_expr_is_fresh(expr) then
+    rec.fresh = false
+  elseif expr.fresh_fn then
+    table.insert(rec.fns, expr.fresh_fn)
+  end
+end
+
+local function own_resolve_drops(ctx)
+  local fn_fresh = {}
+  local function record_fresh(rec)
+    if not rec.fresh or rec.escapes ~= rec.returns then
+      return false
+    end
+    for _, name in ipairs(rec.fns) do
+      if not fn_fresh[name] then
+        return false
+      end
+    end
+    return true
+  end
+  local changed = true
+  while changed do
+    changed = false
+    for name, rec in pairs(ctx.fn_returns) do
+      if not fn_fresh[name] and record_fresh(rec) then
+        local ok = true
+        for _, var_rec in ipairs(rec.vars) do
+          if not record_fresh(var_rec) then
+            ok = false
+            break
+          end
+        end
+        if ok then
+          fn_fresh[name] = true
+          changed = true
+        end
+      end
+    end
+  end
+  for _, rec in ipairs(ctx.drop_records) do
+    rec.stmt.drop_on_exit = rec.escapes == 0 and not rec.copy and record_fresh(rec)
+  end
+  for _, rec in ipairs(ctx.scalar_records) do
+    rec.stmt.unboxed = not rec.boxed and rec.kind or nil
+    -- Boxed integer locals are still boxed as exact integers.
+    rec.stmt.boxed_int = rec.boxed and rec.kind == "int" or nil
+  end
+  for _, expr in ipairs(ctx.pending_temps) do
+    expr.owned_temp = fn_fresh[expr.fresh_fn] == true
+  end
+end
+
 report = function(ctx, msg, opts)
   local prefix = ctx.current_func or "<top>"
   if type(opts) ~= "table" then
@@ -1481,6 +1777,40 @@ local function expect_value(ctx, t, where)
   return t
 end
 
+local function int_literal(expr)
+  if expr.kind == "Unary" and expr.op == "-" then
+    return int_literal(expr.expr)
+  end
+  return expr.kind == "Number" and not expr.value:find(".", 1, true)
+end
+
+-- A float never converts implicitly to an integer type (3.7 would become 3);
+-- integer literals, integer-typed values and plain num values do.
+local function float_to_int(to, from)
+  return to and to.kind == "num" and to.int and from and from.float or false
+end
+
+local function report_float_to_int(ctx, where, to)
+  report(ctx, where .. " expects " .. to.width .. ", got a float; convert it with math.trunc")
+end
+
+-- Integer-typed operands keep integer arithmetic; untyped integer literals
+-- adopt the integer type of the other side. Two different widths meet at
+-- i64.
+local function numeric_result(expr, left, right)
+  local float = (left.float or right.float) and type_float() or type_num()
+  if not (left.int or right.int) then
+    return float
+  end
+  if (left.int or int_literal(expr.left)) and (right.int or int_literal(expr.right)) then
+    if not left.int or (right.int and left.width == right.width) then
+      return type_int(right.width)
+    end
+    return type_int(not right.int and left.width or nil)
+  end
+  return float
+end
+
 local function expect_numeric(ctx, t, where)
   if not t then
     return false
@@ -1520,6 +1850,7 @@ local function expect_bool(ctx, t, where)
 end
 
 local infer_expr
+local infer_expr_node
 local infer_call
 local infer_member
 local check_block
@@ -1639,10 +1970,17 @@ local function unify_type(ctx, expected, actual, param_map, where)
   return expected
 end
 
-local function infer_arg_type(ctx, expected, arg, where)
+local function infer_arg_type(ctx, expected, arg, where, mode)
   if expected and expected.kind == "ref" and arg.kind == "Identifier" then
     local info = scope_get(ctx, arg.name)
+    if ctx.ownership.in_spawn then
+      own_resolve(ctx, arg.name)
+    end
     if info and info.type and info.type.kind == "ref" then
+      if not mode then
+        local id = own_resolve(ctx, arg.name)
+        own_escape(ctx, id and ctx.ownership.vars[id].ref_target)
+      end
       return info.type
     end
     report_missing_borrow(ctx, where, expected)
@@ -1651,10 +1989,11 @@ local function infer_arg_type(ctx, expected, arg, where)
     end
     return type_unknown()
   end
+  ctx.ownership.use_mode = mode
   return expect_value(ctx, infer_expr(ctx, arg), where)
 end
 
-local function apply_signature(ctx, sig, args, type_args)
+local function apply_signature(ctx, sig, args, type_args, mode)
   local param_map = {}
   local generics = sig.generics or {}
   local prev_bounds = ctx.generic_bounds
@@ -1678,8 +2017,14 @@ local function apply_signature(ctx, sig, args, type_args)
   local limit = math.min(#args, #sig.params)
   for i = 1, limit do
     local expected = resolve_type(ctx, sig.params[i], param_map)
-    local actual = infer_arg_type(ctx, expected, args[i], "argument " .. i)
+    if mode ~= "sink" and sig.params[i] and sig.params[i].kind ~= "ref" then
+      own_reject_view_store(ctx, args[i])
+    end
+    local actual = infer_arg_type(ctx, expected, args[i], "argument " .. i, mode)
     unify_type(ctx, expected, actual, param_map, "argument " .. i)
+    if float_to_int(expected, actual) then
+      report_float_to_int(ctx, "Argument " .. i, expected)
+    end
   end
   if #generics > 0 then
     for _, name in ipairs(generics) do
@@ -1714,6 +2059,7 @@ local function infer_result_literal(ctx, expr, expected, where)
     return expected
   end
   local payload_expected = name == "Ok" and expected.ok or expected.err
+  own_reject_view_store(ctx, expr.args[1])
   local actual = expect_value(ctx, infer_expr(ctx, expr.args[1]), (where or name) .. " payload")
   if payload_expected and payload_expected.kind ~= "unknown" and not type_assignable(payload_expected, actual) then
     report(ctx, name .. " payload expects " .. type_to_string(payload_expected) .. ", got " .. type_to_string(actual))
@@ -1721,12 +2067,72 @@ local function infer_result_literal(ctx, expr, expected, where)
   return type_result(expected.ok or type_unknown(), expected.err or type_unknown())
 end
 
+-- `&v[a..b]` borrows v through a view of the range instead of copying it.
+local function infer_slice_view(ctx, expr)
+  local slice = expr.expr
+  if expr.mutable then
+    report(ctx, "Slice views are read-only")
+  end
+  local obj = type_unknown()
+  if slice.object.kind ~= "Identifier" then
+    report(ctx, "Slice view expects identifier")
+  else
+    local info = scope_get(ctx, slice.object.name)
+    if not info then
+      report(ctx, "Unknown identifier: " .. slice.object.name)
+    else
+      local id = own_resolve(ctx, slice.object.name)
+      if id then
+        own_borrow_temp(ctx, id, false)
+      end
+      obj = unwrap_ref(info.type)
+    end
+  end
+  local slice_start = expect_value(ctx, infer_expr(ctx, slice.start), "slice start")
+  expect_numeric(ctx, slice_start, "Slice start")
+  if slice.finish then
+    local slice_end = expect_value(ctx, infer_expr(ctx, slice.finish), "slice end")
+    expect_numeric(ctx, slice_end, "Slice end")
+  end
+  if obj.kind == "vec" then
+    return type_ref(type_vec(obj.elem), false)
+  elseif obj.kind == "unknown" or obj.kind == "any" then
+    return type_ref(type_unknown(), false)
+  elseif obj.kind == "str" then
+    report(ctx, "Slice view expects vector; string slices s[a..b] already share bytes")
+    return type_ref(type_unknown(), false)
+  end
+  report(ctx, "Slice view expects vector")
+  return type_ref(type_unknown(), false)
+end
+
+-- use_mode describes how the parent consumes this expression: "sink" when the
+-- value is only read (operators, print, fmt/text), "builtin" when it is an
+-- argument to a runtime builtin, nil when it may be retained.
 infer_expr = function(ctx, expr)
+  local mode = ctx.ownership.use_mode
+  ctx.ownership.use_mode = nil
+  local t = infer_expr_node(ctx, expr, mode)
+  if expr and t then
+    expr.type_kind = scalar_type_kind(t) or t.kind
+    expr.int_width = int_width(t)
+  end
+  if mode == "sink" and expr and expr.kind ~= "String" and own_expr_is_fresh(expr) and not type_is_copy(t) then
+    if expr.fresh_fn then
+      table.insert(ctx.pending_temps, expr)
+    else
+      expr.owned_temp = true
+    end
+  end
+  return t
+end
+
+infer_expr_node = function(ctx, expr, use_mode)
   if not expr then
     return type_void()
   end
   if expr.kind == "Number" then
-    return type_num()
+    return expr.value:find(".", 1, true) and type_float() or type_num()
   elseif expr.kind == "String" then
     return type_str()
   elseif expr.kind == "Bool" then
@@ -1744,7 +2150,7 @@ infer_expr = function(ctx, expr)
     local info = scope_get(ctx, expr.name)
     
     if info then
-      own_use_value(ctx, expr.name, expr.name)
+      own_use_value(ctx, expr.name, expr.name, use_mode)
       return info.type
     end
     local sig = ctx.functions[expr.name] or ctx.builtins[expr.name]
@@ -1756,15 +2162,19 @@ infer_expr = function(ctx, expr)
   elseif expr.kind == "Array" then
     local elem = nil
     for _, e in ipairs(expr.elements or {}) do
+      own_reject_view_store(ctx, e)
       local t = expect_value(ctx, infer_expr(ctx, e), "array element")
       elem = elem and type_merge(ctx, elem, t, "array element") or t
     end
     if not elem then
       elem = type_unknown()
     end
+    expr.vec_kind = typed_vec_kind(elem)
     return type_vec(elem)
   elseif expr.kind == "Binary" then
+    ctx.ownership.use_mode = "sink"
     local left = expect_value(ctx, infer_expr(ctx, expr.left), "left operand")
+    ctx.ownership.use_mode = "sink"
     local right = expect_value(ctx, infer_expr(ctx, expr.right), "right operand")
     local op = expr.op
     if op == "+" then
@@ -1784,14 +2194,14 @@ infer_expr = function(ctx, expr)
         return type_str()
       end
       if left.kind == "num" and right.kind == "num" then
-        return type_num()
+        return numeric_result(expr, left, right)
       end
       report(ctx, "Operator + expects numbers or strings")
       return type_unknown()
     elseif op == "-" or op == "*" or op == "/" or op == "%" then
       expect_numeric(ctx, left, "Left operand")
       expect_numeric(ctx, right, "Right operand")
-      return type_num()
+      return numeric_result(expr, left, right)
     elseif op == "<" or op == "<=" or op == ">" or op == ">=" then
       expect_numeric(ctx, left, "Left operand")
       expect_numeric(ctx, right, "Right operand")
@@ -1805,10 +2215,11 @@ infer_expr = function(ctx, expr)
     end
     return type_unknown()
   elseif expr.kind == "Unary" then
+    ctx.ownership.use_mode = "sink"
     local inner = expect_value(ctx, infer_expr(ctx, expr.expr), "unary operand")
     if expr.op == "-" then
       expect_numeric(ctx, inner, "Unary - operand")
-      return type_num()
+      return inner.int and type_int(inner.width) or (inner.float and type_float() or type_num())
     elseif expr.op == "!" then
       expect_bool(ctx, inner, "Unary ! operand")
       return type_bool()
@@ -1822,6 +2233,10 @@ infer_expr = function(ctx, expr)
         local id = own_resolve(ctx, expr.expr.name)
         if id then
           own_borrow_temp(ctx, id, false)
+          -- A copied-out referent now has a second holder.
+          if use_mode ~= "sink" then
+            own_escape(ctx, ctx.ownership.vars[id].ref_target)
+          end
         end
         inner = info.type
       end
@@ -1839,6 +2254,9 @@ infer_expr = function(ctx, expr)
     return type_unknown()
   elseif expr.kind == "Borrow" then
     local target = expr.expr
+    if target and target.kind == "Slice" then
+      return infer_slice_view(ctx, expr)
+    end
     if not target or target.kind ~= "Identifier" then
       report(ctx, "Borrow expects identifier")
       return type_ref(type_unknown(), expr.mutable)
@@ -1851,6 +2269,11 @@ infer_expr = function(ctx, expr)
     local id = own_resolve(ctx, target.name)
     if id then
       own_borrow_temp(ctx, id, expr.mutable)
+      -- A user function may copy *s out of a shared borrow too, so only
+      -- operator, print and builtin uses leave the target droppable.
+      if not use_mode then
+        own_escape(ctx, id)
+      end
     end
     return type_ref(info.type, expr.mutable)
   elseif expr.kind == "Try" then
@@ -1882,9 +2305,11 @@ infer_expr = function(ctx, expr)
     if not obj then
       obj = expect_value(ctx, infer_expr(ctx, expr.object), "index object")
     end
+    obj = unwrap_ref(obj)
     local idx = expect_value(ctx, infer_expr(ctx, expr.index), "index")
     if obj.kind == "vec" then
       expect_numeric(ctx, idx, "Vector index")
+      expr.vec_index = true
       return obj.elem
     elseif obj.kind == "map" then
       if not type_assignable(obj.key, idx) then
@@ -1914,6 +2339,7 @@ infer_expr = function(ctx, expr)
     if not obj then
       obj = expect_value(ctx, infer_expr(ctx, expr.object), "slice object")
     end
+    obj = unwrap_ref(obj)
     local slice_start = expect_value(ctx, infer_expr(ctx, expr.start), "slice start")
     expect_numeric(ctx, slice_start, "Slice start")
     if expr.finish then
@@ -1953,10 +2379,13 @@ infer_expr = function(ctx, expr)
       else
         seen[f.name] = true
         local field_type = struct_type.fields and struct_type.fields[f.name]
+        own_reject_view_store(ctx, f.value)
         if field_type then
           local value_type = expect_value(ctx, infer_expr(ctx, f.value), "field value")
           if not type_assignable(field_type, value_type) then
             report(ctx, "Field '" .. f.name .. "' expects " .. type_to_string(field_type) .. ", got " .. type_to_string(value_type))
+          elseif float_to_int(field_type, value_type) then
+            report_float_to_int(ctx, "Field '" .. f.name .. "'", field_type)
           end
         else
           infer_expr(ctx, f.value)
@@ -1969,20 +2398,167 @@ infer_expr = function(ctx, expr)
       end
     end
     return struct_type
+  elseif expr.kind == "Lambda" then
+    report(ctx, "Closures are only supported as iterator pipeline arguments")
+    return type_unknown()
   end
   report(ctx, "Unknown expression kind: " .. tostring(expr.kind))
   return type_unknown()
 end
+
+local PIPELINE_ADAPTERS = { filter = true, map = true, take = true, skip = true }
+local PIPELINE_TERMINALS = { collect = true, sum = true, count = true, any = true, all = true }
+
+-- Splits iter(src).filter(..).map(..).sum() into the iter(...) call and its
+-- stages, outermost last; nil when the chain is not rooted at iter(...).
+local function pipeline_parts(ctx, expr)
+  local stages = {}
+  local node = expr
+  while node.kind == "Call" and node.callee.kind == "Member" do
+    table.insert(stages, 1, { op = node.callee.property, args = node.args or {} })
+    node = node.callee.object
+  end
+  if node.kind ~= "Call" or node.callee.kind ~= "Identifier" or node.callee.name ~= "iter" then
+    return nil
+  end
+  if ctx.functions.iter or scope_get(ctx, "iter") then
+    return nil
+  end
+  return node, stages
+end
+
+-- Each closure is checked inline with its parameter bound to the current
+-- element type; codegen fuses the whole chain into one loop (see
+-- emit_pipeline), so no closure or intermediate vector exists at runtime.
+local function infer_pipeline(ctx, expr, root, stages)
+  local terminal = stages[#stages]
+  if not terminal or not PIPELINE_TERMINALS[terminal.op] then
+    report(ctx, "iter(...) must end in collect, sum, count, any or all")
+    return type_unknown()
+  end
+  local args = root.args or {}
+  if #args ~= 1 then
+    report(ctx, "iter expects one vector or set")
+    return type_unknown()
+  end
+  ctx.ownership.use_mode = "sink"
+  local source_type = unwrap_ref(expect_value(ctx, infer_expr(ctx, args[1]), "iter source"))
+  own_release_temp(ctx)
+  local elem = type_unknown()
+  local source_kind = "vec"
+  if source_type.kind == "vec" or source_type.kind == "set" then
+    elem = source_type.elem
+    source_kind = source_type.kind
+  elseif source_type.kind ~= "unknown" and source_type.kind ~= "any" then
+    report(ctx, "iter expects vector or set, got " .. type_to_string(source_type))
+  end
+
+  local function check_closure(stage)
+    local fn = stage.args[1]
+    if #stage.args ~= 1 or fn.kind ~= "Lambda" or #fn.params ~= 1 then
+      report(ctx, stage.op .. " expects a closure |x| ...")
+      for _, arg in ipairs(stage.args) do
+        if arg.kind ~= "Lambda" then
+          infer_expr(ctx, arg)
+        end
+      end
+      return nil, type_unknown()
+    end
+    scope_push(ctx)
+    own_scope_push(ctx)
+    local info = { type = elem, mutable = false }
+    scope_set(ctx, fn.params[1], info)
+    own_bind(ctx, fn.params[1], info, { scalar = own_scalar_record(ctx, fn, elem) })
+    local result = expect_value(ctx, infer_expr(ctx, fn.body), stage.op .. " result")
+    own_release_temp(ctx)
+    own_scope_pop(ctx)
+    scope_pop(ctx)
+    return fn, result
+  end
+
+  local plan = { source = args[1], source_kind = source_kind, stages = {} }
+  for i = 1, #stages - 1 do
+    local stage = stages[i]
+    local entry = { op = stage.op }
+    if not PIPELINE_ADAPTERS[stage.op] then
+      report(ctx, "Unknown iterator adapter: " .. stage.op)
+    elseif stage.op == "take" or stage.op == "skip" then
+      if #stage.args ~= 1 then
+        report(ctx, stage.op .. " expects a count")
+      else
+        entry.count = stage.args[1]
+        expect_numeric(ctx, expect_value(ctx, infer_expr(ctx, entry.count), stage.op .. " count"), stage.op .. " count")
+        own_release_temp(ctx)
+      end
+    else
+      local fn, result = check_closure(stage)
+      entry.fn = fn
+      if stage.op == "filter" then
+        expect_bool(ctx, result, "filter closure")
+      else
+        elem = result
+      end
+    end
+    table.insert(plan.stages, entry)
+  end
+
+  plan.terminal = terminal.op
+  local known = elem.kind ~= "unknown" and elem.kind ~= "any"
+  local result = nil
+  if terminal.op == "any" or terminal.op == "all" then
+    local fn, cond = check_closure(terminal)
+    plan.terminal_fn = fn
+    expect_bool(ctx, cond, terminal.op .. " closure")
+    result = type_bool()
+  elseif #terminal.args > 0 then
+    report(ctx, terminal.op .. " takes no arguments")
+  end
+  if terminal.op == "collect" then
+    result = type_vec(elem)
+    expr.vec_kind = typed_vec_kind(elem)
+    expr.fresh = true
+  elseif terminal.op == "count" then
+    result = type_int()
+  elseif terminal.op == "sum" then
+    if known then
+      expect_numeric(ctx, elem, "sum element")
+    end
+    result = elem.kind == "num" and elem.int and type_int(elem.width) or type_num()
+  end
+  plan.elem_kind = scalar_type_kind(elem)
+  plan.elem_width = int_width(elem)
+  expr.pipeline = plan
+  return result
+end
+
 infer_call = function(ctx, expr)
   local callee = expr.callee
   local args = expr.args or {}
   local type_args = resolve_type_args(ctx, expr.type_args)
 
+  expr.pipeline = nil
+  if callee.kind == "Member" or (callee.kind == "Identifier" and callee.name == "iter") then
+    local root, stages = pipeline_parts(ctx, expr)
+    if root then
+      return infer_pipeline(ctx, expr, root, stages)
+    end
+  end
+
   if callee.kind == "Identifier" then
-    local sig = ctx.functions[callee.name] or ctx.builtins[callee.name]
+    local sig = ctx.functions[callee.name]
     if sig then
+      expr.fresh_fn = callee.name
       return apply_signature(ctx, sig, args, type_args)
     end
+    sig = ctx.builtins[callee.name]
+    if sig then
+      local name = callee.name
+      if name == "format" then
+        expr.fresh = true
+      end
+      local sink = name == "println" or name == "print" or name == "format"
+      return apply_signature(ctx, sig, args, type_args, sink and "sink" or "builtin")
+    end
     report(ctx, "Unknown function: " .. callee.name)
     return type_unknown()
   elseif callee.kind == "Member" then
@@ -2006,6 +2582,7 @@ infer_call = function(ctx, expr)
             report(ctx, "Constructor argument " .. i .. " expects " .. type_to_string(expected) .. ", got " .. type_to_string(actual))
           end
         end
+        expr.fresh = true
         return struct_type
       elseif package_export_kind == "Enum" then
         local enum_type = build_enum_type(ctx, package_internal_name, type_args)
@@ -2044,11 +2621,24 @@ infer_call = function(ctx, expr)
           if type_args and type_args[1] then
             elem = type_args[1]
           end
+          expr.fresh = true
+          expr.vec_kind = typed_vec_kind(elem)
           return type_vec(elem or type_unknown())
         end
         local sig = ctx.modules[module] and ctx.modules[module][prop]
         if sig then
-          return apply_signature(ctx, sig, args, type_args)
+          if ctx.package_exports[module] then
+            return apply_signature(ctx, sig, args, type_args)
+          end
+          if fresh_module_calls[module] and fresh_module_calls[module][prop] then
+            expr.fresh = true
+          end
+          local sink = sink_modules[module] or (module == "io" and (prop == "println" or prop == "print"))
+          local result = apply_signature(ctx, sig, args, type_args, sink and "sink" or "builtin")
+          if module == "collections" and prop == "vec_new" and result.kind == "vec" then
+            expr.vec_kind = typed_vec_kind(result.elem)
+          end
+          return result
         end
         report(ctx, "Unknown module function: " .. module .. "." .. prop)
         return type_unknown()
@@ -2089,6 +2679,7 @@ infer_call = function(ctx, expr)
             report(ctx, "Constructor argument " .. i .. " expects " .. type_to_string(expected) .. ", got " .. type_to_string(actual))
           end
         end
+        expr.fresh = true
         return struct_type
       end
       obj_info = scope_get(ctx, obj.name)
@@ -2113,6 +2704,7 @@ infer_call = function(ctx, expr)
       if #args ~= 1 then
         report(ctx, "send expects 1 argument")
       end
+      own_reject_view_store(ctx, args[1])
       local actual = args[1] and expect_value(ctx, infer_expr(ctx, args[1]), "send argument") or type_unknown()
       local expected = sender_type.item or type_unknown()
       if not type_assignable(expected, actual) then
@@ -2168,6 +2760,9 @@ infer_call = function(ctx, expr)
             if self_actual.kind ~= "ref" then
               if obj_id then
                 own_borrow_temp(ctx, obj_id, self_expected.mutable)
+                if self_expected.mutable then
+                  own_escape(ctx, obj_id)
+                end
               end
             end
             self_actual = type_ref(base, self_expected.mutable)
@@ -2267,6 +2862,7 @@ infer_member = function(ctx, expr)
   if field_owner.kind == "struct" then
     local field = field_owner.fields and field_owner.fields[prop]
     if field then
+      expr.struct_name = field_owner.name
       return field
     end
     report(ctx, "Unknown field: " .. prop .. " on " .. type_to_string(field_owner))
@@ -2407,6 +3003,18 @@ local function check_statement(ctx, stmt)
     local explicit = stmt.type and resolve_type(ctx, parse_type_string(stmt.type), nil) or nil
     if stmt.pattern.kind == "IdentPattern" and stmt.value and stmt.value.kind == "Borrow" then
       local target = stmt.value.expr
+      if target and target.kind == "Slice" then
+        local ref_type = expect_value(ctx, infer_expr(ctx, stmt.value), "let value")
+        if explicit and not type_assignable(explicit, ref_type) then
+          report(ctx, "Let expects " .. type_to_string(explicit) .. ", got " .. type_to_string(ref_type))
+        end
+        local info = { type = explicit or ref_type, mutable = stmt.mutable }
+        scope_set(ctx, stmt.pattern.name, info)
+        local target_id = target.object.kind == "Identifier" and own_resolve(ctx, target.object.name) or nil
+        local id = own_bind(ctx, stmt.pattern.name, info, { ref_target = target_id })
+        ctx.ownership.vars[id].view_depth = #ctx.ownership.scopes
+        return
+      end
       if not target or target.kind ~= "Identifier" then
         report(ctx, "Borrow expects identifier")
         local info = { type = type_ref(type_unknown(), stmt.value.mutable), mutable = stmt.mutable }
@@ -2434,6 +3042,9 @@ local function check_statement(ctx, stmt)
       if target_id and own_can_borrow(ctx, target_id, stmt.value.mutable) then
         ref_target = target_id
       end
+      if stmt.value.mutable then
+        own_escape(ctx, target_id)
+      end
       own_bind(ctx, stmt.pattern.name, info, { ref_target = ref_target, ref_mut = stmt.value.mutable })
       return
     end
@@ -2477,6 +3088,8 @@ local function check_statement(ctx, stmt)
     else
       if explicit and not type_assignable(explicit, value_type) then
         report(ctx, "Let expects " .. type_to_string(explicit) .. ", got " .. type_to_string(value_type))
+      elseif float_to_int(explicit, value_type) then
+        report_float_to_int(ctx, "Let", explicit)
       end
       local final_type = explicit or value_type
       
@@ -2503,7 +3116,14 @@ local function check_statement(ctx, stmt)
           }
         end
       end
-      own_bind(ctx, stmt.pattern.name, info, opts)
+      if not opts then
+        opts = { drop = own_drop_record(ctx, stmt, final_type), scalar = own_scalar_record(ctx, stmt, final_type) }
+        own_note_fresh(opts.drop, stmt.value)
+      end
+      local id = own_bind(ctx, stmt.pattern.name, info, opts)
+      if opts.transfer then
+        ctx.ownership.vars[id].view_depth = ctx.ownership.vars[transfer_from].view_depth
+      end
     end
   elseif stmt.kind == "Bond" then
    
@@ -2587,6 +3207,9 @@ local function check_statement(ctx, stmt)
     
     local id = own_resolve(ctx, stmt.name)
     local var = id and ctx.ownership.vars[id] or nil
+    if ctx.active_bond then
+      own_box(ctx, id)
+    end
     if var and var.moved and not info.mutable then
       report_moved_value(ctx, stmt.name, stmt.name)
     end
@@ -2597,7 +3220,13 @@ local function check_statement(ctx, stmt)
     local ref_target = nil
     local ref_mut = false
     local transfer_from = nil
-    if stmt.value and stmt.value.kind == "Borrow" then
+    local view_depth = nil
+    if stmt.value and stmt.value.kind == "Borrow" and stmt.value.expr and stmt.value.expr.kind == "Slice" then
+      local target = stmt.value.expr.object
+      value_type = expect_value(ctx, infer_expr(ctx, stmt.value), "assignment value")
+      ref_target = target.kind == "Identifier" and own_resolve(ctx, target.name) or nil
+      view_depth = #ctx.ownership.scopes
+    elseif stmt.value and stmt.value.kind == "Borrow" then
       local target = stmt.value.expr
       if not target or target.kind ~= "Identifier" then
         report(ctx, "Borrow expects identifier")
@@ -2614,6 +3243,9 @@ local function check_statement(ctx, stmt)
             ref_target = target_id
             ref_mut = stmt.value.mutable
           end
+          if stmt.value.mutable then
+            own_escape(ctx, target_id)
+          end
         end
       end
     elseif stmt.value and stmt.value.kind == "Identifier" then
@@ -2625,6 +3257,7 @@ local function check_statement(ctx, stmt)
         if src_var and src_var.moved then
           report_moved_value(ctx, stmt.value.name, stmt.value.name)
         end
+        view_depth = src_var and src_var.view_depth
       end
     end
     if not value_type then
@@ -2633,9 +3266,14 @@ local function check_statement(ctx, stmt)
     local assign_ok = type_assignable(info.type, value_type)
     if not assign_ok then
       report(ctx, "Assignment expects " .. type_to_string(info.type) .. ", got " .. type_to_string(value_type))
+    elseif float_to_int(info.type, value_type) then
+      report_float_to_int(ctx, "Assignment", info.type)
     end
     if assign_ok and info.type.kind == "ref" and value_type and value_type.kind == "ref" then
       local dest_depth = var and var.scope_depth or #ctx.ownership.scopes
+      if view_depth and view_depth > dest_depth then
+        report(ctx, "Slice view outlives its scope")
+      end
       if ref_target then
         own_check_lifetime(ctx, ref_target, dest_depth, "Borrow")
       elseif transfer_from then
@@ -2648,12 +3286,19 @@ local function check_statement(ctx, stmt)
     if var and info.mutable then
       var.moved = false
     end
+    if var and var.drop then
+      own_note_fresh(var.drop, stmt.value)
+      if ctx.active_bond or ctx.ownership.in_arena then
+        var.drop.escapes = var.drop.escapes + 1
+      end
+    end
     if var and info.type.kind == "ref" and value_type and value_type.kind == "ref" and assign_ok then
       if var.ref_target then
         own_remove_borrow(ctx, var.ref_target, var.ref_mut)
       end
       var.ref_target = nil
       var.ref_mut = false
+      var.view_depth = view_depth
       if transfer_from then
         local src = ctx.ownership.vars[transfer_from]
         if src and src.ref_target then
@@ -2712,9 +3357,13 @@ local function check_statement(ctx, stmt)
       if not field_type then
         report(ctx, "Unknown field: " .. stmt.property .. " on " .. obj_type.name)
       else
+        stmt.struct_name = obj_type.name
+        own_reject_view_store(ctx, stmt.value)
         local value_type = expect_value(ctx, infer_expr(ctx, stmt.value), "field value")
         if not type_assignable(field_type, value_type) then
           report(ctx, "Field " .. stmt.property .. " expects " .. type_to_string(field_type) .. ", got " .. type_to_string(value_type))
+        elseif float_to_int(field_type, value_type) then
+          report_float_to_int(ctx, "Field " .. stmt.property, field_type)
         end
       end
     elseif obj_type.kind ~= "unknown" and obj_type.kind ~= "any" then
@@ -2760,11 +3409,15 @@ local function check_statement(ctx, stmt)
       obj_type = infer_expr(ctx, stmt.object)
     end
     local index_type = expect_value(ctx, infer_expr(ctx, stmt.index), "index")
+    own_reject_view_store(ctx, stmt.value)
     local value_type = expect_value(ctx, infer_expr(ctx, stmt.value), "index value")
     if obj_type.kind == "vec" then
       expect_numeric(ctx, index_type, "Vector index")
+      stmt.vec_index = true
       if not type_assignable(obj_type.elem, value_type) then
         report(ctx, "Vector element expects " .. type_to_string(obj_type.elem) .. ", got " .. type_to_string(value_type))
+      elseif float_to_int(obj_type.elem, value_type) then
+        report_float_to_int(ctx, "Vector element", obj_type.elem)
       end
     elseif obj_type.kind == "map" then
       if not type_assignable(obj_type.key, index_type) then
@@ -2772,6 +3425,8 @@ local function check_statement(ctx, stmt)
       end
       if not type_assignable(obj_type.value, value_type) then
         report(ctx, "Map value expects " .. type_to_string(obj_type.value) .. ", got " .. type_to_string(value_type))
+      elseif float_to_int(obj_type.value, value_type) then
+        report_float_to_int(ctx, "Map value", obj_type.value)
       end
     elseif obj_type.kind ~= "unknown" and obj_type.kind ~= "any" then
       report(ctx, "Index assignment expects vector or map")
@@ -2804,6 +3459,7 @@ local function check_statement(ctx, stmt)
         report_moved_value(ctx, stmt.name, stmt.name)
       end
     end
+    own_reject_view_store(ctx, stmt.value)
     local value_type = expect_value(ctx, infer_expr(ctx, stmt.value), "deref value")
     if (info.type.kind == "ptr" or info.type.kind == "ref") and not type_assignable(info.type.to, value_type) then
       report(ctx, "Pointer expects " .. type_to_string(info.type.to) .. ", got " .. type_to_string(value_type))
@@ -2825,10 +3481,31 @@ local function check_statement(ctx, stmt)
       if not value_type then
         value_type = expect_value(ctx, infer_expr(ctx, stmt.value), "return value")
       end
+      local returned = stmt.value.kind == "Identifier" and own_resolve(ctx, stmt.value.name)
+      if (stmt.value.kind == "Borrow" and stmt.value.expr.kind == "Slice")
+        or (returned and ctx.ownership.vars[returned].view_depth) then
+        report(ctx, "Cannot return a slice view; copy it with vec_slice")
+      end
+      local fn_rec = ctx.fn_return_rec
+      if fn_rec then
+        if ctx.ownership.in_arena then
+          fn_rec.fresh = false
+        end
+        local id = stmt.value.kind == "Identifier" and own_resolve(ctx, stmt.value.name)
+        local var = id and ctx.ownership.vars[id]
+        if var and var.drop then
+          var.drop.returns = var.drop.returns + 1
+          table.insert(fn_rec.vars, var.drop)
+        else
+          own_note_fresh(fn_rec, stmt.value)
+        end
+      end
       if ctx.return_type and ctx.return_type.kind == "void" then
         report(ctx, "Return value in void function")
       elseif ctx.return_type and not type_assignable(ctx.return_type, value_type) then
         report(ctx, "Return expects " .. type_to_string(ctx.return_type) .. ", got " .. type_to_string(value_type))
+      elseif float_to_int(ctx.return_type, value_type) then
+        report_float_to_int(ctx, "Return", ctx.return_type)
       end
     else
       if ctx.return_type and ctx.return_type.kind ~= "void" then
@@ -2861,23 +3538,75 @@ local function check_statement(ctx, stmt)
       local end_type = expect_value(ctx, infer_expr(ctx, stmt.range_end), "range end")
       expect_numeric(ctx, start_type, "Range start")
       expect_numeric(ctx, end_type, "Range end")
+      local step_type = nil
+      if stmt.range_step then
+        step_type = expect_value(ctx, infer_expr(ctx, stmt.range_step), "range step")
+        expect_numeric(ctx, step_type, "Range step")
+        local step = stmt.range_step
+        if step.kind == "Unary" and step.op == "-" then
+          step = step.expr
+        end
+        if step.kind == "Number" and tonumber(step.value) == 0 then
+          report(ctx, "Range step cannot be zero")
+        end
+      end
       own_release_temp(ctx)
-      local info = { type = type_num(), mutable = true }
+      -- Integral start and step get an int64_t counter; the loop variable is
+      -- an integer only when the bounds are integer-typed, as in arithmetic.
+      local function integral(expr, t)
+        return not expr or (t and t.int) or int_literal(expr)
+      end
+      stmt.range_int = integral(stmt.range_start, start_type) and integral(stmt.range_step, step_type) or nil
+      local var_type = type_num()
+      if stmt.range_int and (start_type and start_type.int or end_type and end_type.int) and integral(stmt.range_end, end_type) then
+        var_type = type_int(start_type and start_type.int and start_type.width or end_type.width)
+      end
+      local info = { type = var_type, mutable = true }
       scope_set(ctx, stmt.name, info)
-      own_bind(ctx, stmt.name, info)
+      own_bind(ctx, stmt.name, info, { scalar = own_scalar_record(ctx, stmt, info.type) })
     else
-      local iter_type = expect_value(ctx, infer_expr(ctx, stmt.iter), "iterable")
+      ctx.ownership.use_mode = "sink"
+      local iter_type = unwrap_ref(expect_value(ctx, infer_expr(ctx, stmt.iter), "iterable"))
       own_release_temp(ctx)
-      if iter_type.kind == "vec" then
+      stmt.iter_kind = nil
+      if stmt.pattern then
+        -- (key, value) loops walk the map's entry array; each name gets its
+        -- own scalar record so numeric keys and values can stay unboxed.
+        local names = stmt.pattern.names
+        local types = { type_unknown(), type_unknown() }
+        if iter_type.kind == "map" then
+          stmt.iter_kind = "map"
+          types = { iter_type.key, iter_type.value }
+        elseif iter_type.kind ~= "unknown" and iter_type.kind ~= "any" then
+          report(ctx, "for-in with (key, value) expects map, got " .. type_to_string(iter_type))
+        end
+        if #names ~= 2 then
+          report(ctx, "for-in over a map expects (key, value)")
+        end
+        stmt.bindings = {}
+        for i, name in ipairs(names) do
+          local binding = {}
+          stmt.bindings[i] = binding
+          local info = { type = types[i] or type_unknown(), mutable = true }
+          scope_set(ctx, name, info)
+          own_bind(ctx, name, info, { scalar = stmt.iter_kind and own_scalar_record(ctx, binding, info.type) or nil })
+        end
+      elseif iter_type.kind == "vec" or iter_type.kind == "set" then
+        stmt.iter_kind = iter_type.kind
         local info = { type = iter_type.elem, mutable = true }
         scope_set(ctx, stmt.name, info)
+        own_bind(ctx, stmt.name, info, { scalar = own_scalar_record(ctx, stmt, info.type) })
+      elseif iter_type.kind == "map" then
+        report(ctx, "for-in over a map expects (key, value)")
+        local info = { type = type_unknown(), mutable = true }
+        scope_set(ctx, stmt.name, info)
         own_bind(ctx, stmt.name, info)
       elseif iter_type.kind == "unknown" or iter_type.kind == "any" then
         local info = { type = type_unknown(), mutable = true }
         scope_set(ctx, stmt.name, info)
         own_bind(ctx, stmt.name, info)
       else
-        report(ctx, "for-in expects vector")
+        report(ctx, "for-in expects vector, map or set")
         local info = { type = type_unknown(), mutable = true }
         scope_set(ctx, stmt.name, info)
         own_bind(ctx, stmt.name, info)
@@ -2889,9 +3618,38 @@ local function check_statement(ctx, stmt)
   elseif stmt.kind == "Match" then
     check_match(ctx, stmt)
   elseif stmt.kind == "Spawn" then
+    local prev_spawn = ctx.ownership.in_spawn
+    local prev_depth = ctx.ownership.spawn_depth
+    ctx.ownership.in_spawn = true
+    ctx.ownership.spawn_depth = #ctx.ownership.scopes
     check_block(ctx, stmt.block, true)
+    ctx.ownership.in_spawn = prev_spawn
+    ctx.ownership.spawn_depth = prev_depth
   elseif stmt.kind == "Unsafe" then
     check_block(ctx, stmt.block, true)
+  elseif stmt.kind == "WithBlock" then
+    local arena_type = nil
+    if stmt.arena.kind == "Identifier" then
+      local info = scope_get(ctx, stmt.arena.name)
+      if not info then
+        report(ctx, "Unknown identifier: " .. stmt.arena.name)
+        return
+      end
+      local id = own_resolve(ctx, stmt.arena.name)
+      if id then
+        own_can_borrow(ctx, id, false, stmt.arena.name)
+      end
+      arena_type = unwrap_ref(info.type)
+    else
+      arena_type = unwrap_ref(infer_expr(ctx, stmt.arena))
+    end
+    if arena_type and arena_type.kind ~= "arena" and arena_type.kind ~= "any" and arena_type.kind ~= "unknown" then
+      report(ctx, "with expects Arena, got " .. type_to_string(arena_type))
+    end
+    local prev_arena = ctx.ownership.in_arena
+    ctx.ownership.in_arena = true
+    check_block(ctx, stmt.block, true)
+    ctx.ownership.in_arena = prev_arena
   elseif stmt.kind == "WithinBlock" then
   
     if not ctx.temporal then
@@ -3023,7 +3781,18 @@ local function check_function(ctx, fn, self_type, generic_names, generic_bounds)
     scope_set(ctx, p.name, info)
     own_bind(ctx, p.name, info)
   end
+  local prev_fn_rec = ctx.fn_return_rec
+  ctx.fn_return_rec = nil
+  if not self_type and fn.name and fn.return_type then
+    ctx.fn_return_rec = { fresh = true, fns = {}, vars = {}, escapes = 0, returns = 0 }
+  end
   check_block(ctx, fn.body, false)
+  local statements = fn.body and fn.body.statements or {}
+  local last = statements[#statements]
+  if ctx.fn_return_rec and not (last and last.kind == "Match") then
+    ctx.fn_returns[fn.name] = ctx.fn_return_rec
+  end
+  ctx.fn_return_rec = prev_fn_rec
   ctx.current_func = prev_func
   ctx.return_type = prev_ret
   ctx.generic_bounds = prev_bounds
@@ -3112,6 +3881,31 @@ local function build_self_type(ctx, item)
   end
   return nil
 end
+-- Structs whose fields are all numbers or bools get a plain C layout in the
+-- backend; field.native records how each field is stored.
+local function mark_native_struct(ctx, item)
+  local def = ctx.structs[item.name]
+  if not def or #def.params > 0 or #def.field_list == 0 then
+    return
+  end
+  local kinds = {}
+  local widths = {}
+  for i, field in ipairs(def.field_list) do
+    local t = resolve_type(ctx, field.type, nil)
+    local kind = scalar_type_kind(t)
+    if not kind then
+      return
+    end
+    kinds[i] = kind
+    widths[i] = int_width(t)
+  end
+  for i, field in ipairs(item.fields) do
+    field.native = kinds[i]
+    field.int_width = widths[i]
+  end
+  item.native = true
+end
+
 local function map_import(item)
   local alias = item.alias or item.path[#item.path]
   local module = alias
@@ -3207,6 +4001,10 @@ function Typechecker.check(ast, opts)
     builtins = builtins,
     modules = clone_modules_table(modules),
     package_exports = {},
+    drop_records = {},
+    scalar_records = {},
+    pending_temps = {},
+    fn_returns = {},
     current_func = "<top>",
     return_type = type_void(),
   }
@@ -3375,7 +4173,9 @@ function Typechecker.check(ast, opts)
         local generic_bounds = merge_generic_bounds(impl_bounds, method_bounds)
         check_function(ctx, method, self_type, generics, generic_bounds)
       end
-    elseif item.kind == "Struct" or item.kind == "Enum" or item.kind == "Use" or item.kind == "TypeAlias" then
+    elseif item.kind == "Struct" then
+      mark_native_struct(ctx, item)
+    elseif item.kind == "Enum" or item.kind == "Use" or item.kind == "TypeAlias" then
      
     else
       check_statement(ctx, item)
@@ -3386,6 +4186,7 @@ function Typechecker.check(ast, opts)
   if #ctx.errors > 0 then
     error(table.concat(ctx.errors, "\n"))
   end
+  own_resolve_drops(ctx)
   return true
 end
 
@@ -9,6 +9,11 @@
 #include <string.h>
 #include <sys/stat.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define REX_SIMD_X86 1
+#endif
+
 #ifdef _WIN32
 #include <winsock2.h>
 #include <ws2tcpip.h>
@@ -33,13 +38,14 @@ typedef struct stat rex_stat_t;
 typedef struct RexStruct {
   const char* name;
   const char** fields;
-  RexValue* values;
+  const RexStructLayout* layout;
   int count;
+  RexValue values[];
 } RexStruct;
 
 typedef struct RexTuple {
   int count;
-  RexValue* items;
+  RexValue items[];
 } RexTuple;
 
 typedef struct RexResult {
@@ -69,27 +75,59 @@ typedef struct RexReceiver {
   RexChannel* channel;
 } RexReceiver;
 
+/* Boxed vectors keep RexValues in items; typed vectors (see RexVecKind)
+   keep raw doubles/int64s/bytes in data and box on load. */
 typedef struct RexVec {
   RexValue* items;
+  void* data;
   int count;
   int capacity;
+  int kind;
+  int view;
+  int* shared;
 } RexVec;
 
+typedef char rex_vec_slice_layout_check[(sizeof(RexVec) <= sizeof(RexVecSlice)) ? 1 : -1];
+
+typedef struct RexHashSlot {
+  uint32_t hash;
+  int32_t index;
+} RexHashSlot;
+
+typedef struct RexHashIndex {
+  RexHashSlot* slots;
+  int capacity;
+} RexHashIndex;
+
 typedef struct RexMapEntry {
   RexValue key;
   RexValue value;
+  uint32_t hash;
+  uint32_t removed;
 } RexMapEntry;
 
+/* items holds `used` entries in insertion order; map_remove marks its entry
+   removed and drops it from the index, and the array is compacted once
+   removed entries outnumber the `count` live ones. */
+// mods changes whenever entries are added, removed or moved, so a for-in
+// view can tell a remove+put pair apart from an untouched map.
 typedef struct RexMap {
   RexMapEntry* items;
   int count;
+  int used;
   int capacity;
+  unsigned mods;
+  RexHashIndex index;
+  int* shared;
 } RexMap;
 
 typedef struct RexSet {
   RexValue* items;
+  uint32_t* hashes;
   int count;
   int capacity;
+  unsigned mods;
+  RexHashIndex index;
 } RexSet;
 
 typedef struct RexSpawnTask {
@@ -119,8 +157,34 @@ static pthread_mutex_t rex_thread_lock = PTHREAD_MUTEX_INITIALIZER;
 
 static RexValue rex_resolve(RexValue v);
 static RexValue rex_resolve_mut(RexValue v);
+static void vec_unshare(RexVec* v);
+static void map_unshare(RexMap* m);
+static RexValue vec_load(const RexVec* v, int index);
+static void vec_swap(RexVec* v, int i, int j);
 
-static void* rex_xmalloc(size_t size) {
+#ifdef _WIN32
+#define REX_THREAD_LOCAL __declspec(thread)
+#else
+#define REX_THREAD_LOCAL __thread
+#endif
+
+// Every runtime allocation carries a RexBlock header recording where it came
+// from, so rex_xfree can route it back: to the system, to a thread's
+// size-class freelist, or nowhere for arena memory.
+
+#define REX_BLOCK_SYSTEM 0u
+#define REX_BLOCK_ARENA 1u
+#define REX_BLOCK_POOL 2u
+
+typedef struct RexBlock {
+  size_t size;
+  uint32_t kind;
+  uint32_t reserved[(16 - sizeof(size_t) - sizeof(uint32_t)) / sizeof(uint32_t)];
+} RexBlock;
+
+typedef char rex_block_layout_check[(sizeof(RexBlock) == 16) ? 1 : -1];
+
+static void* rex_sys_malloc(size_t size) {
   void* p = malloc(size);
   if (!p) {
     fprintf(stderr, "Rex runtime: out of memory\n");
@@ -129,31 +193,534 @@ static void* rex_xmalloc(size_t size) {
   return p;
 }
 
+static size_t rex_align16(size_t size) {
+  return (size + 15u) & ~(size_t)15u;
+}
+
+#define REX_POOL_CLASSES 8
+#define REX_POOL_MAX 256
+#define REX_POOL_SLAB (64 * 1024)
+#define REX_POOL_CACHE_MAX 4096
+
+static const size_t rex_pool_sizes[REX_POOL_CLASSES] = { 16, 32, 48, 64, 96, 128, 192, 256 };
+
+typedef struct RexPoolCache {
+  RexBlock* free[REX_POOL_CLASSES];
+  int count[REX_POOL_CLASSES];
+  char* bump;
+  char* bump_end;
+  int registered;
+} RexPoolCache;
+
+static REX_THREAD_LOCAL RexPoolCache rex_pool_cache;
+static RexBlock* rex_pool_depot[REX_POOL_CLASSES];
+static int rex_pool_depot_count[REX_POOL_CLASSES];
+static int rex_pool_mode = -1;
+#ifdef _WIN32
+static CRITICAL_SECTION rex_pool_lock;
+static int rex_pool_lock_init = 0;
+#else
+static pthread_mutex_t rex_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t rex_pool_key;
+static pthread_once_t rex_pool_key_once = PTHREAD_ONCE_INIT;
+#endif
+
+static void rex_pool_lock_enter(void) {
+#ifdef _WIN32
+  if (!rex_pool_lock_init) {
+    InitializeCriticalSection(&rex_pool_lock);
+    rex_pool_lock_init = 1;
+  }
+  EnterCriticalSection(&rex_pool_lock);
+#else
+  pthread_mutex_lock(&rex_pool_lock);
+#endif
+}
+
+static void rex_pool_lock_leave(void) {
+#ifdef _WIN32
+  LeaveCriticalSection(&rex_pool_lock);
+#else
+  pthread_mutex_unlock(&rex_pool_lock);
+#endif
+}
+
+static RexBlock* rex_pool_next(RexBlock* b) {
+  return *(RexBlock**)(b + 1);
+}
+
+static void rex_pool_set_next(RexBlock* b, RexBlock* next) {
+  *(RexBlock**)(b + 1) = next;
+}
+
+static void rex_pool_flush(RexPoolCache* cache, int cls) {
+  RexBlock* head = cache->free[cls];
+  if (!head) {
+    return;
+  }
+  RexBlock* tail = head;
+  while (rex_pool_next(tail)) {
+    tail = rex_pool_next(tail);
+  }
+  rex_pool_lock_enter();
+  rex_pool_set_next(tail, rex_pool_depot[cls]);
+  rex_pool_depot[cls] = head;
+  __atomic_store_n(&rex_pool_depot_count[cls], rex_pool_depot_count[cls] + cache->count[cls], __ATOMIC_RELAXED);
+  rex_pool_lock_leave();
+  cache->free[cls] = NULL;
+  cache->count[cls] = 0;
+}
+
+// Hands a finishing thread's cached blocks back to the depot: from the
+// pthread key destructor on POSIX, and from rex_thread_entry on Windows.
+static void rex_pool_thread_exit(void* arg) {
+  RexPoolCache* cache = (RexPoolCache*)arg;
+  for (int i = 0; i < REX_POOL_CLASSES; i++) {
+    rex_pool_flush(cache, i);
+  }
+}
+
+#ifndef _WIN32
+static void rex_pool_key_init(void) {
+  pthread_key_create(&rex_pool_key, rex_pool_thread_exit);
+}
+#endif
+
+static int rex_pool_class(size_t size) {
+  for (int i = 0; i < REX_POOL_CLASSES; i++) {
+    if (size <= rex_pool_sizes[i]) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// Registers the thread-exit flush the first time a thread touches its
+// cache, so blocks a thread only recycled or freed are not stranded.
+static RexPoolCache* rex_pool_cache_get(void) {
+  RexPoolCache* cache = &rex_pool_cache;
+  if (!cache->registered) {
+#ifndef _WIN32
+    pthread_once(&rex_pool_key_once, rex_pool_key_init);
+    pthread_setspecific(rex_pool_key, cache);
+#endif
+    cache->registered = 1;
+  }
+  return cache;
+}
+
+static RexBlock* rex_pool_alloc(int cls) {
+  RexPoolCache* cache = rex_pool_cache_get();
+  RexBlock* b = cache->free[cls];
+  if (b) {
+    cache->free[cls] = rex_pool_next(b);
+    cache->count[cls]--;
+    return b;
+  }
+  // Unlocked peek; the depot itself is only touched under the lock.
+  if (__atomic_load_n(&rex_pool_depot_count[cls], __ATOMIC_RELAXED) > 0) {
+    rex_pool_lock_enter();
+    b = rex_pool_depot[cls];
+    int count = rex_pool_depot_count[cls];
+    rex_pool_depot[cls] = NULL;
+    __atomic_store_n(&rex_pool_depot_count[cls], 0, __ATOMIC_RELAXED);
+    rex_pool_lock_leave();
+    if (b) {
+      cache->free[cls] = rex_pool_next(b);
+      cache->count[cls] = count - 1;
+      return b;
+    }
+  }
+  size_t span = sizeof(RexBlock) + rex_pool_sizes[cls];
+  if (!cache->bump || (size_t)(cache->bump_end - cache->bump) < span) {
+    cache->bump = (char*)rex_sys_malloc(REX_POOL_SLAB);
+    cache->bump_end = cache->bump + REX_POOL_SLAB;
+  }
+  b = (RexBlock*)cache->bump;
+  cache->bump += span;
+  b->kind = REX_BLOCK_POOL + (uint32_t)cls;
+  return b;
+}
+
+static void rex_pool_free(RexBlock* b) {
+  RexPoolCache* cache = rex_pool_cache_get();
+  int cls = (int)(b->kind - REX_BLOCK_POOL);
+  rex_pool_set_next(b, cache->free[cls]);
+  cache->free[cls] = b;
+  cache->count[cls]++;
+  if (cache->count[cls] > REX_POOL_CACHE_MAX) {
+    rex_pool_flush(cache, cls);
+  }
+}
+
+static int rex_pool_enabled(void) {
+  if (rex_pool_mode < 0) {
+    const char* mode = getenv("REX_ALLOC");
+    rex_pool_mode = (mode && strcmp(mode, "system") == 0) ? 0 : 1;
+  }
+  return rex_pool_mode;
+}
+
+// Allocations that must outlive any active arena (thread bookkeeping, images).
+static void* rex_xmalloc_raw(size_t size) {
+  RexBlock* b = NULL;
+  int cls = rex_pool_enabled() ? rex_pool_class(size) : -1;
+  if (cls >= 0) {
+    b = rex_pool_alloc(cls);
+  } else {
+    b = (RexBlock*)rex_sys_malloc(sizeof(RexBlock) + size);
+    b->kind = REX_BLOCK_SYSTEM;
+  }
+  b->size = size;
+  return b + 1;
+}
+
+// Inside `with arena { ... }` a thread's allocations are bumped out of the
+// arena; frees of arena memory are no-ops until arena_reset or drop.
+
+#define REX_ARENA_FIRST_CHUNK 4096
+#define REX_ARENA_MAX_CHUNK (1024 * 1024)
+#define REX_ARENA_MAX_DEPTH 32
+
+typedef struct RexArenaChunk {
+  struct RexArenaChunk* next;
+  size_t used;
+  size_t cap;
+  size_t reserved;
+} RexArenaChunk;
+
+typedef struct RexArena {
+  RexArenaChunk* chunks;
+  size_t next_cap;
+  int active;
+} RexArena;
+
+static REX_THREAD_LOCAL RexArena* rex_arena_stack[REX_ARENA_MAX_DEPTH];
+static REX_THREAD_LOCAL int rex_arena_depth = 0;
+
+static void* rex_arena_alloc(RexArena* a, size_t size) {
+  size_t need = sizeof(RexBlock) + rex_align16(size);
+  RexArenaChunk* c = a->chunks;
+  if (!c || c->cap - c->used < need) {
+    size_t cap = a->next_cap;
+    while (cap < need) {
+      cap *= 2;
+    }
+    RexArenaChunk* fresh = (RexArenaChunk*)rex_sys_malloc(sizeof(RexArenaChunk) + cap);
+    fresh->used = 0;
+    fresh->cap = cap;
+    if (c && cap > a->next_cap) {
+      // Oversized block: keep bumping from the current chunk afterwards.
+      fresh->next = c->next;
+      c->next = fresh;
+    } else {
+      fresh->next = c;
+      a->chunks = fresh;
+      if (a->next_cap < REX_ARENA_MAX_CHUNK) {
+        a->next_cap *= 2;
+      }
+    }
+    c = fresh;
+  }
+  RexBlock* b = (RexBlock*)((char*)(c + 1) + c->used);
+  b->size = size;
+  b->kind = REX_BLOCK_ARENA;
+  c->used += need;
+  return b + 1;
+}
+
+static void rex_arena_release(RexArena* a, int keep_one) {
+  RexArenaChunk* keep = NULL;
+  if (keep_one) {
+    for (RexArenaChunk* c = a->chunks; c; c = c->next) {
+      if (!keep || c->cap > keep->cap) {
+        keep = c;
+      }
+    }
+  }
+  RexArenaChunk* c = a->chunks;
+  while (c) {
+    RexArenaChunk* next = c->next;
+    if (c != keep) {
+      free(c);
+    }
+    c = next;
+  }
+  if (keep) {
+    keep->next = NULL;
+    keep->used = 0;
+  }
+  a->chunks = keep;
+}
+
+static void* rex_xmalloc(size_t size) {
+  if (rex_arena_depth > 0) {
+    return rex_arena_alloc(rex_arena_stack[rex_arena_depth - 1], size);
+  }
+  return rex_xmalloc_raw(size);
+}
+
+static void rex_xfree(void* p) {
+  if (!p) {
+    return;
+  }
+  RexBlock* b = ((RexBlock*)p) - 1;
+  if (b->kind == REX_BLOCK_SYSTEM) {
+    free(b);
+  } else if (b->kind >= REX_BLOCK_POOL) {
+    rex_pool_free(b);
+  }
+}
+
+static void* rex_xrealloc(void* p, size_t size) {
+  if (!p) {
+    return rex_xmalloc(size);
+  }
+  RexBlock* b = ((RexBlock*)p) - 1;
+  if (b->kind == REX_BLOCK_SYSTEM) {
+    b = (RexBlock*)realloc(b, sizeof(RexBlock) + size);
+    if (!b) {
+      fprintf(stderr, "Rex runtime: out of memory\n");
+      exit(1);
+    }
+    b->size = size;
+    return b + 1;
+  }
+  if (b->kind >= REX_BLOCK_POOL) {
+    if (size <= rex_pool_sizes[b->kind - REX_BLOCK_POOL]) {
+      b->size = size;
+      return p;
+    }
+    void* out = rex_xmalloc_raw(size);
+    memcpy(out, p, b->size);
+    rex_pool_free(b);
+    return out;
+  }
+  if (size <= b->size) {
+    return p;
+  }
+  RexArenaChunk* c = rex_arena_depth > 0 ? rex_arena_stack[rex_arena_depth - 1]->chunks : NULL;
+  if (c) {
+    size_t old_span = sizeof(RexBlock) + rex_align16(b->size);
+    size_t new_span = sizeof(RexBlock) + rex_align16(size);
+    if ((char*)b + old_span == (char*)(c + 1) + c->used && c->used - old_span + new_span <= c->cap) {
+      c->used = c->used - old_span + new_span;
+      b->size = size;
+      return p;
+    }
+  }
+  void* out = rex_xmalloc(size);
+  memcpy(out, p, b->size);
+  return out;
+}
+
+// Storage for a container that already exists follows the container's own
+// block: a map, vector, set or channel made outside an arena keeps growing on
+// the heap inside `with arena`, so arena_reset cannot pull it out from under
+// the container. Only fresh values go to the arena.
+static void* rex_xmalloc_for(const void* owner, size_t size) {
+  if (owner && (((const RexBlock*)owner) - 1)->kind != REX_BLOCK_ARENA) {
+    return rex_xmalloc_raw(size);
+  }
+  return rex_xmalloc(size);
+}
+
+static void* rex_xrealloc_for(const void* owner, void* p, size_t size) {
+  return p ? rex_xrealloc(p, size) : rex_xmalloc_for(owner, size);
+}
+
+void* rex_heap_alloc(size_t size) {
+  return rex_xmalloc_raw(size);
+}
+
 static char* rex_strdup(const char* s) {
   size_t len = strlen(s);
-  char* out = (char*)rex_xmalloc(len + 1);
+  char* out = (char*)rex_xmalloc_raw(len + 1);
   memcpy(out, s, len + 1);
   return out;
 }
 
+static char* rex_str_alloc(size_t len) {
+  if (len > 0xffffffffu) {
+    rex_panic("string too large");
+    len = 0;
+  }
+  RexStrHeader* h = (RexStrHeader*)rex_xmalloc(sizeof(RexStrHeader) + len + 1);
+  h->len = (uint32_t)len;
+  h->refs = 0;
+  h->hash = 0;
+  h->flags = 0;
+  char* out = (char*)(h + 1);
+  out[len] = '\0';
+  return out;
+}
+
+static RexStrHeader* rex_str_header(const char* s) {
+  return ((RexStrHeader*)s) - 1;
+}
+
+#if !REX_NANBOX
+typedef char rex_small_str_layout_check[(offsetof(RexValue, as) == offsetof(RexValue, small) + 3) ? 1 : -1];
+#else
+typedef char rex_nanbox_layout_check[(sizeof(RexValue) == 8 && sizeof(void*) <= 8) ? 1 : -1];
+#endif
+
+// A view shares a range of its parent's bytes instead of copying them. Its
+// header (flagged REX_STR_VIEW) ends a RexStrView; the parent's refs count
+// keeps the parent's storage alive until the last view is dropped. Short
+// ranges are copied, which is no more expensive than a view header.
+typedef struct RexStrView {
+  const char* data;
+  char* parent;
+  char* cstr;
+  RexStrHeader header;
+} RexStrView;
+
+#define REX_STR_VIEW_MIN 24
+
+static RexStrView* rex_str_view_of(RexStrHeader* h) {
+  return (RexStrView*)((char*)h - offsetof(RexStrView, header));
+}
+
+// Views are not NUL-terminated, so C-string consumers get a copy made on
+// first use and kept with the view.
+static const char* rex_str_view_cstr(RexStrView* view) {
+  char* cstr = __atomic_load_n(&view->cstr, __ATOMIC_ACQUIRE);
+  if (cstr) {
+    return cstr;
+  }
+  char* copy = (char*)rex_xmalloc_raw((size_t)view->header.len + 1);
+  memcpy(copy, view->data, view->header.len);
+  copy[view->header.len] = '\0';
+  if (__atomic_compare_exchange_n(&view->cstr, &cstr, copy, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    return copy;
+  }
+  rex_xfree(copy);
+  return cstr;
+}
+
+const char* rex_str_data(const RexValue* v) {
+#if !REX_NANBOX
+  if (v->small_len) {
+    return (const char*)v + offsetof(RexValue, small);
+  }
+#endif
+  const char* s = rex_as_str(*v);
+  if (!s) {
+    return "";
+  }
+  RexStrHeader* h = rex_str_header(s);
+  return (h->flags & REX_STR_VIEW) ? rex_str_view_cstr(rex_str_view_of(h)) : s;
+}
+
+// Like rex_str_data, but the bytes are only valid up to rex_str_size.
+static const char* rex_str_bytes(const RexValue* v) {
+#if !REX_NANBOX
+  if (v->small_len) {
+    return (const char*)v + offsetof(RexValue, small);
+  }
+#endif
+  const char* s = rex_as_str(*v);
+  if (!s) {
+    return "";
+  }
+  RexStrHeader* h = rex_str_header(s);
+  return (h->flags & REX_STR_VIEW) ? rex_str_view_of(h)->data : s;
+}
+
+size_t rex_str_size(const RexValue* v) {
+#if !REX_NANBOX
+  if (v->small_len) {
+    return (size_t)(v->small_len - 1);
+  }
+#endif
+  const char* s = rex_as_str(*v);
+  return s ? (size_t)rex_str_header(s)->len : 0;
+}
+
+static RexValue rex_str_wrap(char* s) {
+  return rex_value_make(REX_STR, s);
+}
+
+static void rex_str_release(RexStrHeader* h) {
+  if (h->flags & REX_STR_STATIC) {
+    return;
+  }
+  if (__atomic_load_n(&h->refs, __ATOMIC_ACQUIRE) != 0 && __atomic_fetch_sub(&h->refs, 1, __ATOMIC_ACQ_REL) != 0) {
+    return;
+  }
+  if (h->flags & REX_STR_VIEW) {
+    RexStrView* view = rex_str_view_of(h);
+    if (view->parent) {
+      rex_str_release(rex_str_header(view->parent));
+    }
+    rex_xfree(view->cstr);
+    rex_xfree(view);
+    return;
+  }
+  rex_xfree(h);
+}
+
+// [start, start + len) must lie inside parent's bytes. Views of views borrow
+// the underlying string directly.
+static RexValue rex_str_view(const RexValue* parent, const char* start, size_t len) {
+  const char* s = rex_str_is_small(parent) ? NULL : rex_as_str(*parent);
+  if (len < REX_STR_VIEW_MIN || !s) {
+    return rex_str_n(start, len);
+  }
+  RexStrHeader* h = rex_str_header(s);
+  if (h->flags & REX_STR_VIEW) {
+    s = rex_str_view_of(h)->parent;
+    h = s ? rex_str_header(s) : NULL;
+  }
+  if (h && (h->flags & REX_STR_STATIC)) {
+    s = NULL;
+  } else if (h) {
+    // arena_reset frees views and strings without releasing them, so a view
+    // never pins a parent across an arena boundary: an arena-made view would
+    // leave a heap parent's refs raised, and a heap view would outlive an
+    // arena parent. Such pieces are copied instead.
+    if (rex_arena_depth > 0 || (((RexBlock*)h) - 1)->kind == REX_BLOCK_ARENA) {
+      return rex_str_n(start, len);
+    }
+    __atomic_fetch_add(&h->refs, 1, __ATOMIC_RELAXED);
+  }
+  RexStrView* view = (RexStrView*)rex_xmalloc(sizeof(RexStrView));
+  view->data = start;
+  view->parent = (char*)s;
+  view->cstr = NULL;
+  view->header.len = (uint32_t)len;
+  view->header.refs = 0;
+  view->header.hash = 0;
+  view->header.flags = REX_STR_VIEW;
+  return rex_str_wrap((char*)(&view->header + 1));
+}
+
+// Small strings and numbers are rendered into a per-thread rotation of four
+// buffers, so a result is only valid until the fourth call after it. Callers
+// that only need the bytes of a string should use rex_str_bytes/rex_str_size.
 static const char* rex_to_cstr(RexValue v) {
   v = rex_resolve(v);
-  static char buffers[4][64];
-  static int index = 0;
+  static REX_THREAD_LOCAL char buffers[4][64];
+  static REX_THREAD_LOCAL int index = 0;
   char* buf = buffers[index];
   index = (index + 1) % 4;
 
-  if (v.tag == REX_STR) {
-    return v.as.str ? v.as.str : "";
+  if (rex_value_tag(v) == REX_STR) {
+    if (rex_str_is_small(&v)) {
+      memcpy(buf, rex_str_data(&v), rex_str_size(&v) + 1);
+      return buf;
+    }
+    return rex_str_data(&v);
   }
-  if (v.tag == REX_NUM) {
-    snprintf(buf, sizeof(buffers[0]), "%.14g", v.as.num);
+  if (rex_value_tag(v) == REX_NUM) {
+    rex_num_print(buf, sizeof(buffers[0]), v);
     return buf;
   }
-  if (v.tag == REX_BOOL) {
-    return v.as.boolean ? "true" : "false";
+  if (rex_value_tag(v) == REX_BOOL) {
+    return rex_as_bool(v) ? "true" : "false";
   }
-  if (v.tag == REX_NIL) {
+  if (rex_value_tag(v) == REX_NIL) {
     return "nil";
   }
   snprintf(buf, sizeof(buffers[0]), "<value>");
@@ -182,7 +749,7 @@ static void sb_reserve(RexStrBuilder* sb, int extra) {
     cap *= 2;
   }
   if (sb->data) {
-    sb->data = (char*)realloc(sb->data, (size_t)cap);
+    sb->data = (char*)rex_xrealloc(sb->data, (size_t)cap);
     if (!sb->data) {
       rex_panic("string realloc failed");
       return;
@@ -216,8 +783,26 @@ static void sb_append_char(RexStrBuilder* sb, char c) {
   sb->data[sb->len] = '\0';
 }
 
+static void sb_append_value(RexStrBuilder* sb, RexValue v) {
+  v = rex_resolve(v);
+  if (rex_value_tag(v) == REX_STR) {
+    sb_append_bytes(sb, rex_str_bytes(&v), (int)rex_str_size(&v));
+    return;
+  }
+  sb_append_str(sb, rex_to_cstr(v));
+}
+
+static void rex_write_value(FILE* f, RexValue v) {
+  v = rex_resolve(v);
+  if (rex_value_tag(v) == REX_STR) {
+    fwrite(rex_str_bytes(&v), 1, rex_str_size(&v), f);
+    return;
+  }
+  fputs(rex_to_cstr(v), f);
+}
+
 static void sb_free(RexStrBuilder* sb) {
-  free(sb->data);
+  rex_xfree(sb->data);
   sb->data = NULL;
   sb->len = 0;
   sb->cap = 0;
@@ -268,7 +853,7 @@ static void rex_thread_add(
   pthread_t handle
 #endif
 ) {
-  RexThreadNode* node = (RexThreadNode*)rex_xmalloc(sizeof(RexThreadNode));
+  RexThreadNode* node = (RexThreadNode*)rex_xmalloc_raw(sizeof(RexThreadNode));
   node->handle = handle;
   node->next = NULL;
   rex_thread_lock_enter();
@@ -287,7 +872,8 @@ static unsigned __stdcall rex_thread_entry(void* arg) {
   if (task && task->fn) {
     task->fn(task->ctx);
   }
-  free(task);
+  rex_xfree(task);
+  rex_pool_thread_exit(&rex_pool_cache);
   return 0;
 }
 #else
@@ -296,7 +882,7 @@ static void* rex_thread_entry(void* arg) {
   if (task && task->fn) {
     task->fn(task->ctx);
   }
-  free(task);
+  rex_xfree(task);
   return NULL;
 }
 #endif
@@ -334,173 +920,316 @@ void rex_panic(const char* msg) {
   exit(1);
 }
 
-RexValue rex_nil(void) {
-  RexValue v;
-  v.tag = REX_NIL;
-  v.as.ptr = NULL;
-  return v;
-}
-
-RexValue rex_num(double n) {
-  RexValue v;
-  v.tag = REX_NUM;
-  v.as.num = n;
-  return v;
-}
-
-RexValue rex_bool(int b) {
-  RexValue v;
-  v.tag = REX_BOOL;
-  v.as.boolean = b ? 1 : 0;
-  return v;
+RexValue rex_str(const char* s) {
+  if (!s) {
+    s = "";
+  }
+  return rex_str_n(s, strlen(s));
 }
 
-RexValue rex_str(const char* s) {
-  RexValue v;
-  v.tag = REX_STR;
-  v.as.str = rex_strdup(s ? s : "");
-  return v;
+RexValue rex_str_n(const char* s, size_t len) {
+#if REX_NANBOX
+  if (len == 0) {
+    return rex_value_make(REX_STR, NULL);
+  }
+#else
+  if (len <= REX_SMALL_STR_MAX) {
+    RexValue v;
+    memset(&v, 0, sizeof(v));
+    v.tag = REX_STR;
+    v.small_len = (uint8_t)(len + 1);
+    char* out = (char*)&v + offsetof(RexValue, small);
+    if (len > 0) {
+      memcpy(out, s, len);
+    }
+    out[len] = '\0';
+    return v;
+  }
+#endif
+  char* out = rex_str_alloc(len);
+  memcpy(out, s, len);
+  return rex_str_wrap(out);
 }
 
 RexValue rex_ptr(void* p) {
-  RexValue v;
-  v.tag = REX_PTR;
-  v.as.ptr = p;
-  return v;
+  return rex_value_make(REX_PTR, p);
 }
 
 RexValue rex_ref(RexValue* v) {
-  RexValue out;
-  out.tag = REX_REF;
-  out.as.ptr = v;
-  return out;
+  return rex_value_make(REX_REF, v);
 }
 
 RexValue rex_ref_mut(RexValue* v) {
-  RexValue out;
-  out.tag = REX_REF_MUT;
-  out.as.ptr = v;
-  return out;
+  return rex_value_make(REX_REF_MUT, v);
 }
 
 static RexValue rex_resolve(RexValue v) {
-  while (v.tag == REX_REF || v.tag == REX_REF_MUT) {
-    if (!v.as.ptr) {
+  while (rex_value_tag(v) == REX_REF || rex_value_tag(v) == REX_REF_MUT) {
+    if (!rex_as_ptr(v)) {
       return rex_nil();
     }
-    v = *(RexValue*)v.as.ptr;
+    v = *(RexValue*)rex_as_ptr(v);
   }
   return v;
 }
 
 static RexValue rex_resolve_mut(RexValue v) {
   int saw_imm = 0;
-  while (v.tag == REX_REF || v.tag == REX_REF_MUT) {
-    if (v.tag == REX_REF) {
+  while (rex_value_tag(v) == REX_REF || rex_value_tag(v) == REX_REF_MUT) {
+    if (rex_value_tag(v) == REX_REF) {
       saw_imm = 1;
     }
-    if (!v.as.ptr) {
+    if (!rex_as_ptr(v)) {
       return rex_nil();
     }
-    v = *(RexValue*)v.as.ptr;
+    v = *(RexValue*)rex_as_ptr(v);
   }
   if (saw_imm) {
     rex_panic("mutable borrow required");
     return rex_nil();
   }
+  if (rex_value_tag(v) == REX_VEC && rex_as_ptr(v)) {
+    RexVec* vec = (RexVec*)rex_as_ptr(v);
+    if (vec->view) {
+      rex_panic("cannot modify a slice view");
+      return rex_nil();
+    }
+    if (vec->shared) {
+      vec_unshare(vec);
+    }
+  } else if (rex_value_tag(v) == REX_MAP && rex_as_ptr(v) && ((RexMap*)rex_as_ptr(v))->shared) {
+    map_unshare((RexMap*)rex_as_ptr(v));
+  }
   return v;
 }
 
+/* Vectors and maps cloned with vec_clone/map_clone share their storage
+   until one of the handles is written through (rex_resolve_mut above).
+   *shared counts the other handles, as RexStrHeader.refs does for strings,
+   so 0 means the caller is the last one and owns the storage outright. */
+static int* rex_shared_retain(const void* owner, int** slot) {
+  int* shared = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+  if (!shared) {
+    int* fresh = (int*)rex_xmalloc_for(owner, sizeof(int));
+    *fresh = 0;
+    if (__atomic_compare_exchange_n(slot, &shared, fresh, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      shared = fresh;
+    } else {
+      rex_xfree(fresh);
+    }
+  }
+  __atomic_fetch_add(shared, 1, __ATOMIC_RELAXED);
+  return shared;
+}
+
+// Drops one handle's claim; returns 1 when the caller was the last handle
+// and must free the storage itself.
+static int rex_shared_release(int* shared) {
+  if (__atomic_load_n(shared, __ATOMIC_ACQUIRE) != 0 && __atomic_fetch_sub(shared, 1, __ATOMIC_ACQ_REL) != 0) {
+    return 0;
+  }
+  rex_xfree(shared);
+  return 1;
+}
+
 void rex_drop(RexValue v) {
-  if (v.tag == REX_REF || v.tag == REX_REF_MUT) {
+  if (rex_value_tag(v) == REX_REF || rex_value_tag(v) == REX_REF_MUT) {
     return;
   }
-  if (v.tag == REX_STR) {
-    free((void*)v.as.str);
+  if (rex_value_tag(v) == REX_STR) {
+    if (!rex_str_is_small(&v) && rex_as_str(v)) {
+      rex_str_release(rex_str_header(rex_as_str(v)));
+    }
+    return;
+  }
+  if (rex_value_tag(v) == REX_PTR) {
+    rex_xfree(rex_as_ptr(v));
     return;
   }
-  if (v.tag == REX_PTR) {
-    free(v.as.ptr);
+  if (rex_value_tag(v) == REX_STRUCT && rex_as_ptr(v)) {
+    rex_xfree(rex_as_ptr(v));
     return;
   }
-  if (v.tag == REX_STRUCT && v.as.ptr) {
-    RexStruct* s = (RexStruct*)v.as.ptr;
-    free(s->values);
-    free(s);
+  if (rex_value_tag(v) == REX_TUPLE && rex_as_ptr(v)) {
+    rex_xfree(rex_as_ptr(v));
     return;
   }
-  if (v.tag == REX_TUPLE && v.as.ptr) {
-    RexTuple* t = (RexTuple*)v.as.ptr;
-    free(t->items);
-    free(t);
+  if (rex_value_tag(v) == REX_RESULT && rex_as_ptr(v)) {
+    rex_xfree(rex_as_ptr(v));
     return;
   }
-  if (v.tag == REX_RESULT && v.as.ptr) {
-    free(v.as.ptr);
+  if (rex_value_tag(v) == REX_VEC && rex_as_ptr(v)) {
+    RexVec* vec = (RexVec*)rex_as_ptr(v);
+    if (vec->view) {
+      return;
+    }
+    if (!vec->shared || rex_shared_release(vec->shared)) {
+      rex_xfree(vec->items);
+      rex_xfree(vec->data);
+    }
+    rex_xfree(vec);
     return;
   }
-  if (v.tag == REX_VEC && v.as.ptr) {
-    RexVec* vec = (RexVec*)v.as.ptr;
-    free(vec->items);
-    free(vec);
+  if (rex_value_tag(v) == REX_MAP && rex_as_ptr(v)) {
+    RexMap* map = (RexMap*)rex_as_ptr(v);
+    if (!map->shared || rex_shared_release(map->shared)) {
+      rex_xfree(map->items);
+      rex_xfree(map->index.slots);
+    }
+    rex_xfree(map);
     return;
   }
-  if (v.tag == REX_MAP && v.as.ptr) {
-    RexMap* map = (RexMap*)v.as.ptr;
-    free(map->items);
-    free(map);
+  if (rex_value_tag(v) == REX_SET && rex_as_ptr(v)) {
+    RexSet* set = (RexSet*)rex_as_ptr(v);
+    rex_xfree(set->items);
+    rex_xfree(set->hashes);
+    rex_xfree(set->index.slots);
+    rex_xfree(set);
     return;
   }
-  if (v.tag == REX_SET && v.as.ptr) {
-    RexSet* set = (RexSet*)v.as.ptr;
-    free(set->items);
-    free(set);
+  if (rex_value_tag(v) == REX_ARENA && rex_as_ptr(v)) {
+    RexArena* a = (RexArena*)rex_as_ptr(v);
+    if (a->active > 0) {
+      rex_panic("arena dropped inside its own with block");
+      return;
+    }
+    rex_arena_release(a, 0);
+    free(a);
     return;
   }
 }
 
 int rex_is_truthy(RexValue v) {
   v = rex_resolve(v);
-  if (v.tag == REX_NIL) {
+  if (rex_value_tag(v) == REX_NIL) {
     return 0;
   }
-  if (v.tag == REX_BOOL) {
-    return v.as.boolean != 0;
+  if (rex_value_tag(v) == REX_BOOL) {
+    return rex_as_bool(v) != 0;
   }
-  if (v.tag == REX_NUM) {
-    return v.as.num != 0.0;
+  if (rex_value_tag(v) == REX_NUM) {
+    return rex_as_num(v) != 0.0;
   }
-  if (v.tag == REX_STR) {
-    return v.as.str && v.as.str[0] != '\0';
+  if (rex_value_tag(v) == REX_STR) {
+    return rex_str_size(&v) > 0;
   }
   return 1;
 }
 
+/* Two integers combine exactly, wrapping like the rex_int_* helpers, and
+   stay unsigned when either side is; anything else goes through doubles. */
+static int rex_num_both_int(RexValue a, RexValue b) {
+  return rex_num_repr(a) != REX_NUM_F64 && rex_num_repr(b) != REX_NUM_F64;
+}
+
+static int rex_num_either_uint(RexValue a, RexValue b) {
+  return rex_num_repr(a) == REX_NUM_U64 || rex_num_repr(b) == REX_NUM_U64;
+}
+
+static RexValue rex_int_result(RexValue a, RexValue b, int64_t n) {
+  return rex_num_either_uint(a, b) ? rex_uint((uint64_t)n) : rex_int(n);
+}
+
+// Orders two integers by value, whichever of them is unsigned.
+static int rex_int_cmp(RexValue a, RexValue b) {
+  int64_t x = rex_as_int(a);
+  int64_t y = rex_as_int(b);
+  int ua = rex_num_repr(a) == REX_NUM_U64;
+  int ub = rex_num_repr(b) == REX_NUM_U64;
+  if (ua && ub) {
+    return (uint64_t)x < (uint64_t)y ? -1 : (uint64_t)x > (uint64_t)y;
+  }
+  if (ua != ub && (x < 0 || y < 0)) {
+    return ua ? 1 : -1;
+  }
+  return x < y ? -1 : x > y;
+}
+
+// Whether an integer converts to a double and back without rounding.
+static int rex_int_is_exact_num(RexValue v) {
+  int64_t x = rex_as_int(v);
+  if (rex_num_repr(v) == REX_NUM_U64) {
+    double d = (double)(uint64_t)x;
+    return d < 18446744073709551616.0 && (uint64_t)d == (uint64_t)x;
+  }
+  double d = (double)x;
+  return d < 9223372036854775808.0 && (int64_t)d == x;
+}
+
+// Orders an integer against a whole double that it rounds to.
+static int rex_int_cmp_num(RexValue a, double d) {
+  int64_t x = rex_as_int(a);
+  if (rex_num_repr(a) == REX_NUM_U64 && x < 0) {
+    if (d >= 18446744073709551616.0) {
+      return -1;
+    }
+    return (uint64_t)x < (uint64_t)d ? -1 : (uint64_t)x > (uint64_t)d;
+  }
+  if (d >= 9223372036854775808.0) {
+    return -1;
+  }
+  if (d < -9223372036854775808.0) {
+    return 1;
+  }
+  return x < (int64_t)d ? -1 : x > (int64_t)d;
+}
+
+/* Three-way numeric compare by exact value; 2 means unordered (a NaN). */
+static int rex_num_cmp(RexValue a, RexValue b) {
+  if (rex_num_both_int(a, b)) {
+    return rex_int_cmp(a, b);
+  }
+  double x = rex_as_num(a);
+  double y = rex_as_num(b);
+  if (x != y) {
+    return x < y ? -1 : x > y ? 1 : 2;
+  }
+  if (rex_num_repr(a) != REX_NUM_F64) {
+    return rex_int_cmp_num(a, y);
+  }
+  if (rex_num_repr(b) != REX_NUM_F64) {
+    return -rex_int_cmp_num(b, x);
+  }
+  return 0;
+}
+
 RexValue rex_add(RexValue a, RexValue b) {
   a = rex_resolve(a);
   b = rex_resolve(b);
-  if (a.tag == REX_NUM && b.tag == REX_NUM) {
-    return rex_num(a.as.num + b.as.num);
+  if (rex_value_tag(a) == REX_NUM && rex_value_tag(b) == REX_NUM) {
+    if (rex_num_both_int(a, b)) {
+      return rex_int_result(a, b, rex_int_add(rex_as_int(a), rex_as_int(b)));
+    }
+    return rex_num(rex_as_num(a) + rex_as_num(b));
   }
   {
-    const char* sa = rex_to_cstr(a);
-    const char* sb = rex_to_cstr(b);
-    size_t len = strlen(sa) + strlen(sb);
-    char* out = (char*)rex_xmalloc(len + 1);
-    memcpy(out, sa, strlen(sa));
-    memcpy(out + strlen(sa), sb, strlen(sb) + 1);
-    RexValue v;
-    v.tag = REX_STR;
-    v.as.str = out;
-    return v;
+    const char* sa = rex_value_tag(a) == REX_STR ? rex_str_bytes(&a) : rex_to_cstr(a);
+    const char* sb = rex_value_tag(b) == REX_STR ? rex_str_bytes(&b) : rex_to_cstr(b);
+    size_t la = rex_value_tag(a) == REX_STR ? rex_str_size(&a) : strlen(sa);
+    size_t lb = rex_value_tag(b) == REX_STR ? rex_str_size(&b) : strlen(sb);
+#if !REX_NANBOX
+    if (la + lb <= REX_SMALL_STR_MAX) {
+      char small[REX_SMALL_STR_MAX];
+      memcpy(small, sa, la);
+      memcpy(small + la, sb, lb);
+      return rex_str_n(small, la + lb);
+    }
+#endif
+    char* out = rex_str_alloc(la + lb);
+    memcpy(out, sa, la);
+    memcpy(out + la, sb, lb);
+    return rex_str_wrap(out);
   }
 }
 
 RexValue rex_sub(RexValue a, RexValue b) {
   a = rex_resolve(a);
   b = rex_resolve(b);
-  if (a.tag == REX_NUM && b.tag == REX_NUM) {
-    return rex_num(a.as.num - b.as.num);
+  if (rex_value_tag(a) == REX_NUM && rex_value_tag(b) == REX_NUM) {
+    if (rex_num_both_int(a, b)) {
+      return rex_int_result(a, b, rex_int_sub(rex_as_int(a), rex_as_int(b)));
+    }
+    return rex_num(rex_as_num(a) - rex_as_num(b));
   }
   rex_panic("sub expects numbers");
   return rex_nil();
@@ -509,8 +1238,11 @@ RexValue rex_sub(RexValue a, RexValue b) {
 RexValue rex_mul(RexValue a, RexValue b) {
   a = rex_resolve(a);
   b = rex_resolve(b);
-  if (a.tag == REX_NUM && b.tag == REX_NUM) {
-    return rex_num(a.as.num * b.as.num);
+  if (rex_value_tag(a) == REX_NUM && rex_value_tag(b) == REX_NUM) {
+    if (rex_num_both_int(a, b)) {
+      return rex_int_result(a, b, rex_int_mul(rex_as_int(a), rex_as_int(b)));
+    }
+    return rex_num(rex_as_num(a) * rex_as_num(b));
   }
   rex_panic("mul expects numbers");
   return rex_nil();
@@ -519,8 +1251,13 @@ RexValue rex_mul(RexValue a, RexValue b) {
 RexValue rex_div(RexValue a, RexValue b) {
   a = rex_resolve(a);
   b = rex_resolve(b);
-  if (a.tag == REX_NUM && b.tag == REX_NUM) {
-    return rex_num(a.as.num / b.as.num);
+  if (rex_value_tag(a) == REX_NUM && rex_value_tag(b) == REX_NUM) {
+    if (rex_num_both_int(a, b)) {
+      int64_t x = rex_as_int(a);
+      int64_t y = rex_as_int(b);
+      return rex_int_result(a, b, rex_num_either_uint(a, b) ? rex_uint_div(x, y) : rex_int_div(x, y));
+    }
+    return rex_num(rex_as_num(a) / rex_as_num(b));
   }
   rex_panic("div expects numbers");
   return rex_nil();
@@ -529,8 +1266,13 @@ RexValue rex_div(RexValue a, RexValue b) {
 RexValue rex_mod(RexValue a, RexValue b) {
   a = rex_resolve(a);
   b = rex_resolve(b);
-  if (a.tag == REX_NUM && b.tag == REX_NUM) {
-    return rex_num(fmod(a.as.num, b.as.num));
+  if (rex_value_tag(a) == REX_NUM && rex_value_tag(b) == REX_NUM) {
+    if (rex_num_both_int(a, b)) {
+      int64_t x = rex_as_int(a);
+      int64_t y = rex_as_int(b);
+      return rex_int_result(a, b, rex_num_either_uint(a, b) ? rex_uint_mod(x, y) : rex_int_mod(x, y));
+    }
+    return rex_num(fmod(rex_as_num(a), rex_as_num(b)));
   }
   rex_panic("mod expects numbers");
   return rex_nil();
@@ -539,38 +1281,109 @@ RexValue rex_mod(RexValue a, RexValue b) {
 RexValue rex_eq(RexValue a, RexValue b) {
   a = rex_resolve(a);
   b = rex_resolve(b);
-  if (a.tag != b.tag) {
+  if (rex_value_tag(a) != rex_value_tag(b)) {
     return rex_bool(0);
   }
-  if (a.tag == REX_NUM) {
-    return rex_bool(a.as.num == b.as.num);
+  if (rex_value_tag(a) == REX_NUM) {
+    return rex_bool(rex_num_cmp(a, b) == 0);
   }
-  if (a.tag == REX_BOOL) {
-    return rex_bool(a.as.boolean == b.as.boolean);
+  if (rex_value_tag(a) == REX_BOOL) {
+    return rex_bool(rex_as_bool(a) == rex_as_bool(b));
   }
-  if (a.tag == REX_STR) {
-    return rex_bool(strcmp(a.as.str ? a.as.str : "", b.as.str ? b.as.str : "") == 0);
+  if (rex_value_tag(a) == REX_STR) {
+    size_t la = rex_str_size(&a);
+    if (la != rex_str_size(&b)) {
+      return rex_bool(0);
+    }
+    return rex_bool(la == 0 || memcmp(rex_str_bytes(&a), rex_str_bytes(&b), la) == 0);
   }
-  return rex_bool(a.as.ptr == b.as.ptr);
+  return rex_bool(rex_as_ptr(a) == rex_as_ptr(b));
 }
 
 static int rex_value_eq(RexValue a, RexValue b) {
   RexValue eq = rex_eq(a, b);
-  return eq.tag == REX_BOOL && eq.as.boolean != 0;
+  return rex_value_tag(eq) == REX_BOOL && rex_as_bool(eq) != 0;
+}
+
+static uint32_t rex_hash_mix(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return (uint32_t)x;
+}
+
+static uint32_t rex_hash_bytes(const char* s, size_t len) {
+  uint64_t h = 1469598103934665603ULL;
+  for (size_t i = 0; i < len; i++) {
+    h ^= (unsigned char)s[i];
+    h *= 1099511628211ULL;
+  }
+  uint32_t out = rex_hash_mix(h);
+  return out ? out : 1u;
+}
+
+static uint32_t rex_str_hash(const RexValue* v) {
+  if (rex_str_is_small(v) || !rex_as_str(*v)) {
+    return rex_hash_bytes(rex_str_bytes(v), rex_str_size(v));
+  }
+  // The cached hash is published on its own, with 0 meaning "not computed",
+  // so threads hashing a shared string race only on an atomic store of the
+  // same value and the header's flags never change after creation.
+  RexStrHeader* h = rex_str_header(rex_as_str(*v));
+  uint32_t hash = __atomic_load_n(&h->hash, __ATOMIC_RELAXED);
+  if (hash) {
+    return hash;
+  }
+  hash = rex_hash_bytes(rex_str_bytes(v), h->len);
+  if (!(h->flags & REX_STR_STATIC)) {
+    __atomic_store_n(&h->hash, hash, __ATOMIC_RELAXED);
+  }
+  return hash;
+}
+
+static uint32_t rex_value_hash(RexValue v) {
+  v = rex_resolve(v);
+  switch (rex_value_tag(v)) {
+    case REX_NIL:
+      return 0;
+    case REX_NUM: {
+      // Integers that a double holds exactly hash like that double, so
+      // equal keys hash alike whatever their representation.
+      if (rex_num_repr(v) != REX_NUM_F64 && !rex_int_is_exact_num(v)) {
+        return rex_hash_mix((uint64_t)rex_as_int(v) ^ 0x9e3779b97f4a7c15ULL);
+      }
+      double n = rex_as_num(v);
+      if (n == 0.0) {
+        n = 0.0;
+      }
+      uint64_t bits = 0;
+      memcpy(&bits, &n, sizeof(bits));
+      return rex_hash_mix(bits);
+    }
+    case REX_BOOL:
+      return rex_as_bool(v) ? 1u : 2u;
+    case REX_STR:
+      return rex_str_hash(&v);
+    default:
+      return rex_hash_mix((uint64_t)(uintptr_t)rex_as_ptr(v) ^ ((uint64_t)rex_value_tag(v) << 56));
+  }
 }
 
 RexValue rex_neq(RexValue a, RexValue b) {
   a = rex_resolve(a);
   b = rex_resolve(b);
   RexValue eq = rex_eq(a, b);
-  return rex_bool(!eq.as.boolean);
+  return rex_bool(!rex_as_bool(eq));
 }
 
 RexValue rex_lt(RexValue a, RexValue b) {
   a = rex_resolve(a);
   b = rex_resolve(b);
-  if (a.tag == REX_NUM && b.tag == REX_NUM) {
-    return rex_bool(a.as.num < b.as.num);
+  if (rex_value_tag(a) == REX_NUM && rex_value_tag(b) == REX_NUM) {
+    int c = rex_num_cmp(a, b);
+    return rex_bool(c == -1);
   }
   rex_panic("lt expects numbers");
   return rex_nil();
@@ -579,8 +1392,9 @@ RexValue rex_lt(RexValue a, RexValue b) {
 RexValue rex_lte(RexValue a, RexValue b) {
   a = rex_resolve(a);
   b = rex_resolve(b);
-  if (a.tag == REX_NUM && b.tag == REX_NUM) {
-    return rex_bool(a.as.num <= b.as.num);
+  if (rex_value_tag(a) == REX_NUM && rex_value_tag(b) == REX_NUM) {
+    int c = rex_num_cmp(a, b);
+    return rex_bool(c == -1 || c == 0);
   }
   rex_panic("lte expects numbers");
   return rex_nil();
@@ -589,8 +1403,9 @@ RexValue rex_lte(RexValue a, RexValue b) {
 RexValue rex_gt(RexValue a, RexValue b) {
   a = rex_resolve(a);
   b = rex_resolve(b);
-  if (a.tag == REX_NUM && b.tag == REX_NUM) {
-    return rex_bool(a.as.num > b.as.num);
+  if (rex_value_tag(a) == REX_NUM && rex_value_tag(b) == REX_NUM) {
+    int c = rex_num_cmp(a, b);
+    return rex_bool(c == 1);
   }
   rex_panic("gt expects numbers");
   return rex_nil();
@@ -599,8 +1414,9 @@ RexValue rex_gt(RexValue a, RexValue b) {
 RexValue rex_gte(RexValue a, RexValue b) {
   a = rex_resolve(a);
   b = rex_resolve(b);
-  if (a.tag == REX_NUM && b.tag == REX_NUM) {
-    return rex_bool(a.as.num >= b.as.num);
+  if (rex_value_tag(a) == REX_NUM && rex_value_tag(b) == REX_NUM) {
+    int c = rex_num_cmp(a, b);
+    return rex_bool(c == 1 || c == 0);
   }
   rex_panic("gte expects numbers");
   return rex_nil();
@@ -608,8 +1424,14 @@ RexValue rex_gte(RexValue a, RexValue b) {
 
 RexValue rex_neg(RexValue v) {
   v = rex_resolve(v);
-  if (v.tag == REX_NUM) {
-    return rex_num(-v.as.num);
+  if (rex_value_tag(v) == REX_NUM) {
+    if (rex_num_repr(v) == REX_NUM_I64) {
+      return rex_int(rex_int_neg(rex_as_int(v)));
+    }
+    if (rex_num_repr(v) == REX_NUM_U64) {
+      return rex_uint(0 - (uint64_t)rex_as_int(v));
+    }
+    return rex_num(-rex_as_num(v));
   }
   rex_panic("neg expects number");
   return rex_nil();
@@ -634,14 +1456,13 @@ RexValue rex_or(RexValue a, RexValue b) {
 
 void rex_println(RexValue v) {
   rex_console_init();
-  const char* s = rex_to_cstr(v);
-  printf("%s\n", s);
+  rex_write_value(stdout, v);
+  putchar('\n');
 }
 
 void rex_print(RexValue v) {
   rex_console_init();
-  const char* s = rex_to_cstr(v);
-  printf("%s", s);
+  rex_write_value(stdout, v);
 }
 
 RexValue rex_tag(const char* tag, RexValue v) {
@@ -649,28 +1470,25 @@ RexValue rex_tag(const char* tag, RexValue v) {
   RexResult* r = (RexResult*)rex_xmalloc(sizeof(RexResult));
   r->tag = tag;
   r->value = v;
-  RexValue out;
-  out.tag = REX_RESULT;
-  out.as.ptr = r;
-  return out;
+  return rex_value_make(REX_RESULT, r);
 }
 
 int rex_tag_is(RexValue v, const char* tag) {
   v = rex_resolve(v);
-  if (v.tag != REX_RESULT || !v.as.ptr) {
+  if (rex_value_tag(v) != REX_RESULT || !rex_as_ptr(v)) {
     return 0;
   }
-  RexResult* r = (RexResult*)v.as.ptr;
+  RexResult* r = (RexResult*)rex_as_ptr(v);
   return strcmp(r->tag, tag) == 0;
 }
 
 RexValue rex_tag_value(RexValue v) {
   v = rex_resolve(v);
-  if (v.tag != REX_RESULT || !v.as.ptr) {
+  if (rex_value_tag(v) != REX_RESULT || !rex_as_ptr(v)) {
     rex_panic("tag_value expects tagged value");
     return rex_nil();
   }
-  RexResult* r = (RexResult*)v.as.ptr;
+  RexResult* r = (RexResult*)rex_as_ptr(v);
   return r->value;
 }
 
@@ -700,7 +1518,7 @@ RexValue rex_result_is_err(RexValue value) {
 
 RexValue rex_result_unwrap_or(RexValue value, RexValue fallback) {
   value = rex_resolve(value);
-  if (value.tag != REX_RESULT || !value.as.ptr) {
+  if (rex_value_tag(value) != REX_RESULT || !rex_as_ptr(value)) {
     rex_panic("result.unwrap_or expects Result");
     return fallback;
   }
@@ -720,7 +1538,7 @@ RexValue rex_result_unwrap_or_else(RexValue value, RexValue fallback) {
 
 RexValue rex_result_ok_or(RexValue value, RexValue err) {
   value = rex_resolve(value);
-  if (value.tag == REX_NIL) {
+  if (rex_value_tag(value) == REX_NIL) {
     return rex_err(err);
   }
   return rex_ok(value);
@@ -729,11 +1547,11 @@ RexValue rex_result_ok_or(RexValue value, RexValue err) {
 RexValue rex_result_expect(RexValue value, RexValue message) {
   value = rex_resolve(value);
   message = rex_resolve(message);
-  if (value.tag != REX_RESULT || !value.as.ptr) {
+  if (rex_value_tag(value) != REX_RESULT || !rex_as_ptr(value)) {
     rex_panic("result.expect expects Result");
     return rex_nil();
   }
-  if (message.tag != REX_STR) {
+  if (rex_value_tag(message) != REX_STR) {
     rex_panic("result.expect expects string message");
     return rex_nil();
   }
@@ -743,9 +1561,9 @@ RexValue rex_result_expect(RexValue value, RexValue message) {
   if (rex_result_is(value, "Err")) {
     RexStrBuilder sb;
     sb_init(&sb);
-    sb_append_str(&sb, message.as.str ? message.as.str : "");
+    sb_append_str(&sb, rex_str_data(&message));
     sb_append_str(&sb, ": ");
-    sb_append_str(&sb, rex_to_cstr(rex_result_value(value)));
+    sb_append_value(&sb, rex_result_value(value));
     rex_panic(sb.data ? sb.data : "result.expect failed");
     sb_free(&sb);
     return rex_nil();
@@ -756,10 +1574,10 @@ RexValue rex_result_expect(RexValue value, RexValue message) {
 
 RexValue rex_try(RexValue v) {
   v = rex_resolve(v);
-  if (v.tag != REX_RESULT || !v.as.ptr) {
+  if (rex_value_tag(v) != REX_RESULT || !rex_as_ptr(v)) {
     return v;
   }
-  RexResult* r = (RexResult*)v.as.ptr;
+  RexResult* r = (RexResult*)rex_as_ptr(v);
   if (strcmp(r->tag, "Ok") == 0) {
     return r->value;
   }
@@ -772,88 +1590,291 @@ RexValue rex_try(RexValue v) {
 RexValue rex_alloc(void) {
   RexPtr* p = (RexPtr*)rex_xmalloc(sizeof(RexPtr));
   p->value = rex_nil();
-  RexValue v;
-  v.tag = REX_PTR;
-  v.as.ptr = p;
-  return v;
+  return rex_value_make(REX_PTR, p);
 }
 
 void rex_free(RexValue p) {
   p = rex_resolve(p);
-  if (p.tag == REX_PTR && p.as.ptr) {
-    free(p.as.ptr);
+  if (rex_value_tag(p) == REX_PTR && rex_as_ptr(p)) {
+    rex_xfree(rex_as_ptr(p));
   }
 }
 
 RexValue rex_box(RexValue v) {
   RexPtr* p = (RexPtr*)rex_xmalloc(sizeof(RexPtr));
   p->value = v;
-  RexValue out;
-  out.tag = REX_PTR;
-  out.as.ptr = p;
-  return out;
+  return rex_value_make(REX_PTR, p);
 }
 
 RexValue rex_unbox(RexValue p) {
   p = rex_resolve(p);
-  if (p.tag != REX_PTR || !p.as.ptr) {
+  if (rex_value_tag(p) != REX_PTR || !rex_as_ptr(p)) {
     rex_panic("unbox expects pointer");
     return rex_nil();
   }
-  RexPtr* ptr = (RexPtr*)p.as.ptr;
+  RexPtr* ptr = (RexPtr*)rex_as_ptr(p);
   return ptr->value;
 }
 
 RexValue rex_deref(RexValue p) {
-  if (p.tag == REX_REF || p.tag == REX_REF_MUT) {
+  if (rex_value_tag(p) == REX_REF || rex_value_tag(p) == REX_REF_MUT) {
     return rex_resolve(p);
   }
   return rex_unbox(p);
 }
 
 void rex_deref_assign(RexValue p, RexValue v) {
-  if (p.tag == REX_REF_MUT && p.as.ptr) {
-    *(RexValue*)p.as.ptr = v;
+  if (rex_value_tag(p) == REX_REF_MUT && rex_as_ptr(p)) {
+    *(RexValue*)rex_as_ptr(p) = v;
     return;
   }
-  if (p.tag == REX_REF) {
+  if (rex_value_tag(p) == REX_REF) {
     rex_panic("deref assign expects mutable reference");
     return;
   }
   p = rex_resolve(p);
-  if (p.tag != REX_PTR || !p.as.ptr) {
+  if (rex_value_tag(p) != REX_PTR || !rex_as_ptr(p)) {
     rex_panic("deref assign expects pointer");
     return;
   }
-  RexPtr* ptr = (RexPtr*)p.as.ptr;
+  RexPtr* ptr = (RexPtr*)rex_as_ptr(p);
   ptr->value = v;
 }
 
+RexValue rex_mem_arena_new(void) {
+  RexArena* a = (RexArena*)rex_sys_malloc(sizeof(RexArena));
+  a->chunks = NULL;
+  a->next_cap = REX_ARENA_FIRST_CHUNK;
+  a->active = 0;
+  return rex_value_make(REX_ARENA, a);
+}
+
+static RexArena* rex_arena_from(RexValue v, const char* what) {
+  v = rex_resolve(v);
+  if (rex_value_tag(v) != REX_ARENA || !rex_as_ptr(v)) {
+    rex_panic(what);
+    return NULL;
+  }
+  return (RexArena*)rex_as_ptr(v);
+}
+
+void rex_mem_arena_enter(RexValue arena) {
+  RexArena* a = rex_arena_from(arena, "with expects arena");
+  if (!a) {
+    return;
+  }
+  if (rex_arena_depth >= REX_ARENA_MAX_DEPTH) {
+    rex_panic("arena nesting too deep");
+    return;
+  }
+  rex_arena_stack[rex_arena_depth++] = a;
+  a->active++;
+}
+
+void rex_mem_arena_leave(RexValue arena) {
+  RexArena* a = rex_arena_from(arena, "with expects arena");
+  if (!a || rex_arena_depth == 0 || rex_arena_stack[rex_arena_depth - 1] != a) {
+    rex_panic("arena scope mismatch");
+    return;
+  }
+  rex_arena_depth--;
+  a->active--;
+}
+
+RexValue rex_mem_arena_reset(RexValue arena) {
+  RexArena* a = rex_arena_from(arena, "arena_reset expects arena");
+  if (!a) {
+    return rex_nil();
+  }
+  if (a->active > 0) {
+    rex_panic("arena_reset inside its own with block");
+    return rex_nil();
+  }
+  rex_arena_release(a, 1);
+  return rex_nil();
+}
+
 RexValue rex_struct_new(const char* name, const char** fields, RexValue* values, int count) {
-  RexStruct* s = (RexStruct*)rex_xmalloc(sizeof(RexStruct));
+  RexStruct* s = (RexStruct*)rex_xmalloc(sizeof(RexStruct) + sizeof(RexValue) * (size_t)count);
   s->name = name;
   s->fields = fields;
+  s->layout = NULL;
   s->count = count;
-  s->values = (RexValue*)rex_xmalloc(sizeof(RexValue) * (size_t)count);
   for (int i = 0; i < count; i++) {
     s->values[i] = values[i];
   }
-  RexValue v;
-  v.tag = REX_STRUCT;
-  v.as.ptr = s;
-  return v;
+  return rex_value_make(REX_STRUCT, s);
+}
+
+RexValue rex_struct_new_native(const RexStructLayout* layout, const void* data) {
+  RexStruct* s = (RexStruct*)rex_xmalloc(sizeof(RexStruct) + layout->size);
+  s->name = layout->name;
+  s->fields = layout->fields;
+  s->layout = layout;
+  s->count = layout->count;
+  memcpy(s->values, data, layout->size);
+  return rex_value_make(REX_STRUCT, s);
+}
+
+static const char* rex_tag_name(RexTag tag) {
+  static const char* names[] = {
+    "nil", "number", "bool", "str", "pointer", "ref", "mutable ref", "struct",
+    "tuple", "result", "sender", "receiver", "vector", "map", "set", "arena"
+  };
+  return (unsigned)tag < sizeof(names) / sizeof(names[0]) ? names[tag] : "value";
+}
+
+// Shared by native struct fields, unboxed locals and typed vector reads.
+static void rex_unbox_panic(const char* expected, RexValue v) {
+  char msg[64];
+  snprintf(msg, sizeof(msg), "expected %s, got %s", expected, rex_tag_name(rex_value_tag(v)));
+  rex_panic(msg);
+}
+
+double rex_unbox_num_slow(RexValue v) {
+  v = rex_resolve(v);
+  if (rex_value_tag(v) != REX_NUM) {
+    rex_unbox_panic("number", v);
+    return 0;
+  }
+  return rex_as_num(v);
+}
+
+int64_t rex_unbox_int_slow(RexValue v) {
+  v = rex_resolve(v);
+  if (rex_value_tag(v) != REX_NUM) {
+    rex_unbox_panic("number", v);
+    return 0;
+  }
+  if (rex_num_repr(v) != REX_NUM_F64) {
+    return rex_as_int(v);
+  }
+  return rex_int_from_num(rex_as_num(v));
+}
+
+int64_t rex_int_from_num_wide(double n) {
+  if (n != n || n == INFINITY || n == -INFINITY) {
+    return 0;
+  }
+  double m = fmod(trunc(n), 18446744073709551616.0);
+  if (m < 0) {
+    m += 18446744073709551616.0;
+  }
+  return m >= 18446744073709551616.0 ? 0 : (int64_t)(uint64_t)m;
+}
+
+#if REX_NANBOX
+RexValue rex_int_too_wide(int64_t n, int repr) {
+  char msg[128];
+  if (repr == REX_NUM_U64) {
+    snprintf(msg, sizeof(msg), "integer %llu does not fit a NaN-boxed value; build with --value-repr boxed",
+             (unsigned long long)n);
+  } else {
+    snprintf(msg, sizeof(msg), "integer %lld does not fit a NaN-boxed value; build with --value-repr boxed", (long long)n);
+  }
+  rex_panic(msg);
+  return rex_nil();
+}
+#endif
+
+int rex_num_print(char* buf, size_t size, RexValue v) {
+  switch (rex_num_repr(v)) {
+    case REX_NUM_I64:
+      return snprintf(buf, size, "%lld", (long long)rex_as_int(v));
+    case REX_NUM_U64:
+      return snprintf(buf, size, "%llu", (unsigned long long)rex_as_int(v));
+    default:
+      return snprintf(buf, size, "%.14g", rex_as_num(v));
+  }
+}
+
+int rex_unbox_bool_slow(RexValue v) {
+  v = rex_resolve(v);
+  if (rex_value_tag(v) != REX_BOOL) {
+    rex_unbox_panic("bool", v);
+    return 0;
+  }
+  return rex_as_bool(v);
+}
+
+int64_t rex_range_end(double end, int64_t step) {
+  if (end != end) {
+    return step > 0 ? INT64_MIN : INT64_MAX;
+  }
+  return rex_int_from_num(step > 0 ? ceil(end) : floor(end));
+}
+
+uint64_t rex_range_count(int64_t start, int64_t end, int64_t step) {
+  if (step > 0) {
+    return start < end ? ((uint64_t)end - (uint64_t)start - 1) / (uint64_t)step + 1 : 0;
+  }
+  if (step < 0) {
+    return start > end ? ((uint64_t)start - (uint64_t)end - 1) / (0 - (uint64_t)step) + 1 : 0;
+  }
+  rex_panic("range step cannot be zero");
+  return 0;
+}
+
+static RexValue rex_struct_load(RexStruct* s, int index) {
+  if (!s->layout) {
+    return s->values[index];
+  }
+  const char* slot = (const char*)s->values + s->layout->offsets[index];
+  if (s->layout->kinds[index] == REX_FIELD_BOOL) {
+    return rex_bool(*(const int*)slot);
+  }
+  if (s->layout->kinds[index] == REX_FIELD_INT) {
+    return rex_int(*(const int64_t*)slot);
+  }
+  if (s->layout->kinds[index] == REX_FIELD_U64) {
+    return rex_uint(*(const uint64_t*)slot);
+  }
+  return rex_num(*(const double*)slot);
+}
+
+static void rex_struct_store(RexStruct* s, int index, RexValue value) {
+  if (!s->layout) {
+    s->values[index] = value;
+    return;
+  }
+  char* slot = (char*)s->values + s->layout->offsets[index];
+  if (s->layout->kinds[index] == REX_FIELD_BOOL) {
+    *(int*)slot = rex_unbox_bool(value);
+  } else if (s->layout->kinds[index] == REX_FIELD_INT || s->layout->kinds[index] == REX_FIELD_U64) {
+    *(int64_t*)slot = rex_unbox_int(value);
+  } else {
+    *(double*)slot = rex_unbox_num(value);
+  }
+}
+
+void* rex_struct_data(RexValue obj, const RexStructLayout* layout) {
+  obj = rex_resolve(obj);
+  if (rex_value_tag(obj) != REX_STRUCT || !rex_as_ptr(obj) || ((RexStruct*)rex_as_ptr(obj))->layout != layout) {
+    rex_panic("struct_get expects struct");
+    return NULL;
+  }
+  return ((RexStruct*)rex_as_ptr(obj))->values;
+}
+
+void* rex_struct_data_mut(RexValue obj, const RexStructLayout* layout) {
+  obj = rex_resolve_mut(obj);
+  if (rex_value_tag(obj) != REX_STRUCT || !rex_as_ptr(obj) || ((RexStruct*)rex_as_ptr(obj))->layout != layout) {
+    rex_panic("struct_set expects struct");
+    return NULL;
+  }
+  return ((RexStruct*)rex_as_ptr(obj))->values;
 }
 
 RexValue rex_struct_get(RexValue obj, const char* field) {
   obj = rex_resolve(obj);
-  if (obj.tag != REX_STRUCT || !obj.as.ptr) {
+  if (rex_value_tag(obj) != REX_STRUCT || !rex_as_ptr(obj)) {
     rex_panic("struct_get expects struct");
     return rex_nil();
   }
-  RexStruct* s = (RexStruct*)obj.as.ptr;
+  RexStruct* s = (RexStruct*)rex_as_ptr(obj);
   for (int i = 0; i < s->count; i++) {
     if (strcmp(s->fields[i], field) == 0) {
-      return s->values[i];
+      return rex_struct_load(s, i);
     }
   }
   return rex_nil();
@@ -861,39 +1882,62 @@ RexValue rex_struct_get(RexValue obj, const char* field) {
 
 void rex_struct_set(RexValue obj, const char* field, RexValue value) {
   obj = rex_resolve_mut(obj);
-  if (obj.tag != REX_STRUCT || !obj.as.ptr) {
+  if (rex_value_tag(obj) != REX_STRUCT || !rex_as_ptr(obj)) {
     rex_panic("struct_set expects struct");
     return;
   }
-  RexStruct* s = (RexStruct*)obj.as.ptr;
+  RexStruct* s = (RexStruct*)rex_as_ptr(obj);
   for (int i = 0; i < s->count; i++) {
     if (strcmp(s->fields[i], field) == 0) {
-      s->values[i] = value;
+      rex_struct_store(s, i, value);
       return;
     }
   }
 }
 
+RexValue rex_struct_get_at(RexValue obj, const char** fields, int index) {
+  obj = rex_resolve(obj);
+  if (rex_value_tag(obj) != REX_STRUCT || !rex_as_ptr(obj)) {
+    rex_panic("struct_get expects struct");
+    return rex_nil();
+  }
+  RexStruct* s = (RexStruct*)rex_as_ptr(obj);
+  if (s->fields == fields) {
+    return rex_struct_load(s, index);
+  }
+  return rex_struct_get(obj, fields[index]);
+}
+
+void rex_struct_set_at(RexValue obj, const char** fields, int index, RexValue value) {
+  obj = rex_resolve_mut(obj);
+  if (rex_value_tag(obj) != REX_STRUCT || !rex_as_ptr(obj)) {
+    rex_panic("struct_set expects struct");
+    return;
+  }
+  RexStruct* s = (RexStruct*)rex_as_ptr(obj);
+  if (s->fields == fields) {
+    rex_struct_store(s, index, value);
+    return;
+  }
+  rex_struct_set(obj, fields[index], value);
+}
+
 RexValue rex_tuple_new(int count, RexValue* values) {
-  RexTuple* t = (RexTuple*)rex_xmalloc(sizeof(RexTuple));
+  RexTuple* t = (RexTuple*)rex_xmalloc(sizeof(RexTuple) + sizeof(RexValue) * (size_t)count);
   t->count = count;
-  t->items = (RexValue*)rex_xmalloc(sizeof(RexValue) * (size_t)count);
   for (int i = 0; i < count; i++) {
     t->items[i] = values[i];
   }
-  RexValue v;
-  v.tag = REX_TUPLE;
-  v.as.ptr = t;
-  return v;
+  return rex_value_make(REX_TUPLE, t);
 }
 
 RexValue rex_tuple_get(RexValue tuple, int index) {
   tuple = rex_resolve(tuple);
-  if (tuple.tag != REX_TUPLE || !tuple.as.ptr) {
+  if (rex_value_tag(tuple) != REX_TUPLE || !rex_as_ptr(tuple)) {
     rex_panic("tuple_get expects tuple");
     return rex_nil();
   }
-  RexTuple* t = (RexTuple*)tuple.as.ptr;
+  RexTuple* t = (RexTuple*)rex_as_ptr(tuple);
   if (index < 0 || index >= t->count) {
     rex_panic("tuple index out of range");
     return rex_nil();
@@ -901,13 +1945,13 @@ RexValue rex_tuple_get(RexValue tuple, int index) {
   return t->items[index];
 }
 
-static void queue_push(RexQueue* q, RexValue v) {
+static void queue_push(const void* owner, RexQueue* q, RexValue v) {
   if (q->capacity == 0) {
     q->capacity = 4;
-    q->items = (RexValue*)rex_xmalloc(sizeof(RexValue) * (size_t)q->capacity);
+    q->items = (RexValue*)rex_xmalloc_for(owner, sizeof(RexValue) * (size_t)q->capacity);
   } else if (q->count >= q->capacity) {
     q->capacity *= 2;
-    q->items = (RexValue*)realloc(q->items, sizeof(RexValue) * (size_t)q->capacity);
+    q->items = (RexValue*)rex_xrealloc(q->items, sizeof(RexValue) * (size_t)q->capacity);
     if (!q->items) {
       rex_panic("queue realloc failed");
     }
@@ -939,10 +1983,8 @@ RexValue rex_channel(void) {
   r->channel = c;
   RexValue sender;
   RexValue receiver;
-  sender.tag = REX_SENDER;
-  sender.as.ptr = s;
-  receiver.tag = REX_RECEIVER;
-  receiver.as.ptr = r;
+  sender = rex_value_make(REX_SENDER, s);
+  receiver = rex_value_make(REX_RECEIVER, r);
   RexValue values[2];
   values[0] = sender;
   values[1] = receiver;
@@ -951,21 +1993,21 @@ RexValue rex_channel(void) {
 
 void rex_sender_send(RexValue sender, RexValue value) {
   sender = rex_resolve(sender);
-  if (sender.tag != REX_SENDER || !sender.as.ptr) {
+  if (rex_value_tag(sender) != REX_SENDER || !rex_as_ptr(sender)) {
     rex_panic("send expects sender");
     return;
   }
-  RexSender* s = (RexSender*)sender.as.ptr;
-  queue_push(&s->channel->queue, value);
+  RexSender* s = (RexSender*)rex_as_ptr(sender);
+  queue_push(s->channel, &s->channel->queue, value);
 }
 
 RexValue rex_receiver_recv(RexValue receiver) {
   receiver = rex_resolve(receiver);
-  if (receiver.tag != REX_RECEIVER || !receiver.as.ptr) {
+  if (rex_value_tag(receiver) != REX_RECEIVER || !rex_as_ptr(receiver)) {
     rex_panic("recv expects receiver");
     return rex_nil();
   }
-  RexReceiver* r = (RexReceiver*)receiver.as.ptr;
+  RexReceiver* r = (RexReceiver*)rex_as_ptr(receiver);
   return queue_pop(&r->channel->queue);
 }
 
@@ -974,13 +2016,13 @@ RexValue rex_spawn(RexSpawnFn fn, void* ctx) {
     rex_panic("spawn expects function");
     return rex_nil();
   }
-  RexSpawnTask* task = (RexSpawnTask*)rex_xmalloc(sizeof(RexSpawnTask));
+  RexSpawnTask* task = (RexSpawnTask*)rex_xmalloc_raw(sizeof(RexSpawnTask));
   task->fn = fn;
   task->ctx = ctx;
 #ifdef _WIN32
   uintptr_t handle = _beginthreadex(NULL, 0, rex_thread_entry, task, 0, NULL);
   if (handle == 0) {
-    free(task);
+    rex_xfree(task);
     rex_panic("spawn failed");
     return rex_nil();
   }
@@ -988,7 +2030,7 @@ RexValue rex_spawn(RexSpawnFn fn, void* ctx) {
 #else
   pthread_t thread;
   if (pthread_create(&thread, NULL, rex_thread_entry, task) != 0) {
-    free(task);
+    rex_xfree(task);
     rex_panic("spawn failed");
     return rex_nil();
   }
@@ -1011,19 +2053,220 @@ RexValue rex_wait_all(void) {
 #else
     pthread_join(node->handle, NULL);
 #endif
-    free(node);
+    rex_xfree(node);
     node = next;
   }
   return rex_nil();
 }
 
+// Fork-join for runtime-internal data parallelism: index 0 runs on the
+// calling thread, the others on a pool of helper threads started on first
+// use and parked between calls, so a multi-phase job pays a wakeup per phase
+// rather than a thread create/join per index. Capped by REX_THREADS when set,
+// otherwise by the online CPU count.
+#define REX_PARALLEL_MAX 64
+
+typedef void (*RexParallelFn)(void* ctx, int index);
+
+typedef struct RexParallelPool {
+  int started;
+  int helpers;
+  RexParallelFn fn;
+  void* ctx;
+  int count;
+  int pending;
+  unsigned generation;
+#ifdef _WIN32
+  SRWLOCK lock;
+  CONDITION_VARIABLE work;
+  CONDITION_VARIABLE done;
+#else
+  pthread_mutex_t lock;
+  pthread_cond_t work;
+  pthread_cond_t done;
+#endif
+} RexParallelPool;
+
+#ifdef _WIN32
+static SRWLOCK rex_parallel_call_lock = SRWLOCK_INIT;
+static RexParallelPool rex_parallel_pool = {
+  0, 0, NULL, NULL, 0, 0, 0, SRWLOCK_INIT, CONDITION_VARIABLE_INIT, CONDITION_VARIABLE_INIT
+};
+#else
+static pthread_mutex_t rex_parallel_call_lock = PTHREAD_MUTEX_INITIALIZER;
+static RexParallelPool rex_parallel_pool = {
+  0, 0, NULL, NULL, 0, 0, 0, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER
+};
+#endif
+
+static void rex_parallel_pool_lock(void) {
+#ifdef _WIN32
+  AcquireSRWLockExclusive(&rex_parallel_pool.lock);
+#else
+  pthread_mutex_lock(&rex_parallel_pool.lock);
+#endif
+}
+
+static void rex_parallel_pool_unlock(void) {
+#ifdef _WIN32
+  ReleaseSRWLockExclusive(&rex_parallel_pool.lock);
+#else
+  pthread_mutex_unlock(&rex_parallel_pool.lock);
+#endif
+}
+
+static void rex_parallel_pool_wait(int done) {
+  RexParallelPool* pool = &rex_parallel_pool;
+#ifdef _WIN32
+  SleepConditionVariableSRW(done ? &pool->done : &pool->work, &pool->lock, INFINITE, 0);
+#else
+  pthread_cond_wait(done ? &pool->done : &pool->work, &pool->lock);
+#endif
+}
+
+static void rex_parallel_helper(int index) {
+  RexParallelPool* pool = &rex_parallel_pool;
+  unsigned seen = 0;
+  for (;;) {
+    rex_parallel_pool_lock();
+    while (pool->generation == seen) {
+      rex_parallel_pool_wait(0);
+    }
+    seen = pool->generation;
+    RexParallelFn fn = index < pool->count ? pool->fn : NULL;
+    void* ctx = pool->ctx;
+    rex_parallel_pool_unlock();
+    if (!fn) {
+      continue;
+    }
+    fn(ctx, index);
+    rex_parallel_pool_lock();
+    if (--pool->pending == 0) {
+#ifdef _WIN32
+      WakeConditionVariable(&pool->done);
+#else
+      pthread_cond_signal(&pool->done);
+#endif
+    }
+    rex_parallel_pool_unlock();
+  }
+}
+
+#ifdef _WIN32
+static unsigned __stdcall rex_parallel_entry(void* arg) {
+  rex_parallel_helper((int)(intptr_t)arg);
+  return 0;
+}
+#else
+static void* rex_parallel_entry(void* arg) {
+  rex_parallel_helper((int)(intptr_t)arg);
+  return NULL;
+}
+#endif
+
+static int rex_parallel_workers(void) {
+  // Threads racing on first use compute the same count; the atomics keep
+  // the publication well-defined.
+  static int workers = 0;
+  int n = __atomic_load_n(&workers, __ATOMIC_ACQUIRE);
+  if (n == 0) {
+    const char* env = getenv("REX_THREADS");
+    n = env ? atoi(env) : 0;
+    if (n <= 0) {
+#ifdef _WIN32
+      SYSTEM_INFO info;
+      GetSystemInfo(&info);
+      n = (int)info.dwNumberOfProcessors;
+#else
+      long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+      n = cpus > 0 ? (int)cpus : 1;
+#endif
+    }
+    n = n < 1 ? 1 : (n > REX_PARALLEL_MAX ? REX_PARALLEL_MAX : n);
+    __atomic_store_n(&workers, n, __ATOMIC_RELEASE);
+  }
+  return n;
+}
+
+// Helpers are started under the call lock; one that fails to start just
+// leaves its indexes to the caller.
+static void rex_parallel_pool_start(void) {
+  RexParallelPool* pool = &rex_parallel_pool;
+  int want = rex_parallel_workers() - 1;
+  pool->started = 1;
+  for (int i = 1; i <= want; i++) {
+#ifdef _WIN32
+    uintptr_t handle = _beginthreadex(NULL, 0, rex_parallel_entry, (void*)(intptr_t)i, 0, NULL);
+    if (handle == 0) {
+      break;
+    }
+    CloseHandle((HANDLE)handle);
+#else
+    pthread_t handle;
+    if (pthread_create(&handle, NULL, rex_parallel_entry, (void*)(intptr_t)i) != 0) {
+      break;
+    }
+    pthread_detach(handle);
+#endif
+    pool->helpers = i;
+  }
+}
+
+// Calls from different threads take turns; fn must not call back into
+// rex_parallel_for.
+static void rex_parallel_for(int count, RexParallelFn fn, void* ctx) {
+  RexParallelPool* pool = &rex_parallel_pool;
+  if (count > REX_PARALLEL_MAX) {
+    count = REX_PARALLEL_MAX;
+  }
+#ifdef _WIN32
+  AcquireSRWLockExclusive(&rex_parallel_call_lock);
+#else
+  pthread_mutex_lock(&rex_parallel_call_lock);
+#endif
+  if (!pool->started) {
+    rex_parallel_pool_start();
+  }
+  int helpers = count - 1 < pool->helpers ? count - 1 : pool->helpers;
+  if (helpers > 0) {
+    rex_parallel_pool_lock();
+    pool->fn = fn;
+    pool->ctx = ctx;
+    pool->count = helpers + 1;
+    pool->pending = helpers;
+    pool->generation++;
+#ifdef _WIN32
+    WakeAllConditionVariable(&pool->work);
+#else
+    pthread_cond_broadcast(&pool->work);
+#endif
+    rex_parallel_pool_unlock();
+  }
+  fn(ctx, 0);
+  for (int i = helpers + 1; i < count; i++) {
+    fn(ctx, i);
+  }
+  if (helpers > 0) {
+    rex_parallel_pool_lock();
+    while (pool->pending > 0) {
+      rex_parallel_pool_wait(1);
+    }
+    rex_parallel_pool_unlock();
+  }
+#ifdef _WIN32
+  ReleaseSRWLockExclusive(&rex_parallel_call_lock);
+#else
+  pthread_mutex_unlock(&rex_parallel_call_lock);
+#endif
+}
+
 RexValue rex_sleep(RexValue ms) {
   ms = rex_resolve(ms);
-  if (ms.tag != REX_NUM) {
+  if (rex_value_tag(ms) != REX_NUM) {
     rex_panic("sleep expects number");
     return rex_nil();
   }
-  int m = (int)ms.as.num;
+  int m = (int)rex_as_num(ms);
 #ifdef _WIN32
   Sleep((DWORD)m);
 #else
@@ -1034,11 +2277,11 @@ RexValue rex_sleep(RexValue ms) {
 
 RexValue rex_sleep_s(RexValue seconds) {
   seconds = rex_resolve(seconds);
-  if (seconds.tag != REX_NUM) {
+  if (rex_value_tag(seconds) != REX_NUM) {
     rex_panic("sleep_s expects number");
     return rex_nil();
   }
-  double ms = seconds.as.num * 1000.0;
+  double ms = rex_as_num(seconds) * 1000.0;
   return rex_sleep(rex_num(ms));
 }
 
@@ -1054,7 +2297,7 @@ RexValue rex_now_ms(void) {
 
 RexValue rex_now_s(void) {
   RexValue ms = rex_now_ms();
-  return rex_num(ms.as.num / 1000.0);
+  return rex_num(rex_as_num(ms) / 1000.0);
 }
 
 RexValue rex_now_ns(void) {
@@ -1062,7 +2305,7 @@ RexValue rex_now_ns(void) {
   LARGE_INTEGER freq;
   LARGE_INTEGER counter;
   if (!QueryPerformanceFrequency(&freq) || !QueryPerformanceCounter(&counter) || freq.QuadPart == 0) {
-    return rex_num(rex_now_ms().as.num * 1000000.0);
+    return rex_num(rex_as_num(rex_now_ms()) * 1000000.0);
   }
   double ns = (double)counter.QuadPart * 1000000000.0 / (double)freq.QuadPart;
   return rex_num(ns);
@@ -1075,28 +2318,39 @@ RexValue rex_now_ns(void) {
 
 RexValue rex_time_since(RexValue start) {
   start = rex_resolve(start);
-  if (start.tag != REX_NUM) {
+  if (rex_value_tag(start) != REX_NUM) {
     rex_panic("time.since expects number");
     return rex_num(0);
   }
   RexValue now = rex_now_ms();
-  return rex_num(now.as.num - start.as.num);
+  return rex_num(rex_as_num(now) - rex_as_num(start));
 }
 
 RexValue rex_format(RexValue v) {
   v = rex_resolve(v);
+  if (rex_value_tag(v) == REX_STR) {
+    return rex_str_n(rex_str_data(&v), rex_str_size(&v));
+  }
   return rex_str(rex_to_cstr(v));
 }
 
-static RexValue rex_make_str_range(const char* start, size_t len) {
-  char* out = (char*)rex_xmalloc(len + 1u);
-  if (len > 0) {
-    memcpy(out, start, len);
+static const char* rex_mem_find(const char* hay, size_t hay_len, const char* needle, size_t needle_len) {
+  if (needle_len == 0) {
+    return hay;
+  }
+  const char* end = hay + hay_len;
+  const char* p = hay;
+  while ((size_t)(end - p) >= needle_len) {
+    p = (const char*)memchr(p, needle[0], (size_t)(end - p) - needle_len + 1);
+    if (!p) {
+      return NULL;
+    }
+    if (memcmp(p, needle, needle_len) == 0) {
+      return p;
+    }
+    p++;
   }
-  out[len] = '\0';
-  RexValue value = rex_str(out);
-  free(out);
-  return value;
+  return NULL;
 }
 
 static RexValue rex_pad_string_impl(const char* src, int target, const char* fill, int pad_left) {
@@ -1131,24 +2385,24 @@ static RexValue rex_pad_string_impl(const char* src, int target, const char* fil
 
   out[out_len] = '\0';
   RexValue value = rex_str(out);
-  free(out);
+  rex_xfree(out);
   return value;
 }
 
 static RexValue rex_join_vec_impl(RexValue vec, RexValue sep, const char* name) {
   vec = rex_resolve(vec);
   sep = rex_resolve(sep);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
     rex_panic(name);
     return rex_str("");
   }
-  if (sep.tag != REX_STR) {
+  if (rex_value_tag(sep) != REX_STR) {
     rex_panic("join expects string separator");
     return rex_str("");
   }
 
-  RexVec* v = (RexVec*)vec.as.ptr;
-  const char* separator = sep.as.str ? sep.as.str : "";
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
+  const char* separator = rex_str_data(&sep);
   RexStrBuilder sb;
   sb_init(&sb);
 
@@ -1156,11 +2410,10 @@ static RexValue rex_join_vec_impl(RexValue vec, RexValue sep, const char* name)
     if (i > 0) {
       sb_append_str(&sb, separator);
     }
-    RexValue item = rex_resolve(v->items[i]);
-    sb_append_str(&sb, rex_to_cstr(item));
+    sb_append_value(&sb, vec_load(v, i));
   }
 
-  RexValue out = rex_str(sb.data ? sb.data : "");
+  RexValue out = rex_str_n(sb.data ? sb.data : "", (size_t)sb.len);
   sb_free(&sb);
   return out;
 }
@@ -1182,16 +2435,16 @@ RexValue rex_fmt_join(RexValue vec, RexValue sep) {
 RexValue rex_fmt_fixed(RexValue value, RexValue digits) {
   value = rex_resolve(value);
   digits = rex_resolve(digits);
-  if (value.tag != REX_NUM) {
+  if (rex_value_tag(value) != REX_NUM) {
     rex_panic("fmt.fixed expects numeric value");
     return rex_str("");
   }
-  if (digits.tag != REX_NUM) {
+  if (rex_value_tag(digits) != REX_NUM) {
     rex_panic("fmt.fixed expects numeric digits");
     return rex_str("");
   }
 
-  int places = (int)digits.as.num;
+  int places = (int)rex_as_num(digits);
   if (places < 0) {
     places = 0;
   }
@@ -1199,30 +2452,31 @@ RexValue rex_fmt_fixed(RexValue value, RexValue digits) {
     places = 32;
   }
 
-  int needed = snprintf(NULL, 0, "%.*f", places, value.as.num);
+  int needed = snprintf(NULL, 0, "%.*f", places, rex_as_num(value));
   if (needed < 0) {
     rex_panic("fmt.fixed formatting failed");
     return rex_str("");
   }
 
   char* out = (char*)rex_xmalloc((size_t)needed + 1u);
-  snprintf(out, (size_t)needed + 1u, "%.*f", places, value.as.num);
+  snprintf(out, (size_t)needed + 1u, "%.*f", places, rex_as_num(value));
   RexValue result = rex_str(out);
-  free(out);
+  rex_xfree(out);
   return result;
 }
 
 RexValue rex_fmt_hex(RexValue value) {
   value = rex_resolve(value);
-  if (value.tag != REX_NUM) {
+  if (rex_value_tag(value) != REX_NUM) {
     rex_panic("fmt.hex expects number");
     return rex_str("");
   }
 
-  long long raw = (long long)value.as.num;
-  unsigned long long mag = raw < 0 ? (unsigned long long)(-raw) : (unsigned long long)raw;
+  int64_t raw = rex_unbox_int(value);
+  int negative = raw < 0 && rex_num_repr(value) != REX_NUM_U64;
+  unsigned long long mag = negative ? 0ULL - (unsigned long long)raw : (unsigned long long)raw;
   char buf[64];
-  if (raw < 0) {
+  if (negative) {
     snprintf(buf, sizeof(buf), "-%llx", mag);
   } else {
     snprintf(buf, sizeof(buf), "%llx", mag);
@@ -1232,13 +2486,14 @@ RexValue rex_fmt_hex(RexValue value) {
 
 RexValue rex_fmt_bin(RexValue value) {
   value = rex_resolve(value);
-  if (value.tag != REX_NUM) {
+  if (rex_value_tag(value) != REX_NUM) {
     rex_panic("fmt.bin expects number");
     return rex_str("");
   }
 
-  long long raw = (long long)value.as.num;
-  unsigned long long mag = raw < 0 ? (unsigned long long)(-raw) : (unsigned long long)raw;
+  int64_t raw = rex_unbox_int(value);
+  int negative = raw < 0 && rex_num_repr(value) != REX_NUM_U64;
+  unsigned long long mag = negative ? 0ULL - (unsigned long long)raw : (unsigned long long)raw;
   char bits[65];
   int count = 0;
 
@@ -1253,44 +2508,53 @@ RexValue rex_fmt_bin(RexValue value) {
 
   RexStrBuilder sb;
   sb_init(&sb);
-  if (raw < 0) {
+  if (negative) {
     sb_append_char(&sb, '-');
   }
   while (count > 0) {
     sb_append_char(&sb, bits[--count]);
   }
 
-  RexValue out = rex_str(sb.data ? sb.data : "");
+  RexValue out = rex_str_n(sb.data ? sb.data : "", (size_t)sb.len);
   sb_free(&sb);
   return out;
 }
 
 RexValue rex_sqrt(RexValue v) {
   v = rex_resolve(v);
-  if (v.tag != REX_NUM) {
+  if (rex_value_tag(v) != REX_NUM) {
     rex_panic("sqrt expects number");
     return rex_nil();
   }
-  return rex_num(sqrt(v.as.num));
+  return rex_num(sqrt(rex_as_num(v)));
 }
 
 RexValue rex_abs(RexValue v) {
   v = rex_resolve(v);
-  if (v.tag != REX_NUM) {
+  if (rex_value_tag(v) != REX_NUM) {
     rex_panic("abs expects number");
     return rex_nil();
   }
-  return rex_num(fabs(v.as.num));
+  return rex_num(fabs(rex_as_num(v)));
+}
+
+RexValue rex_math_trunc(RexValue v) {
+  v = rex_resolve(v);
+  if (rex_value_tag(v) != REX_NUM) {
+    rex_panic("math.trunc expects number");
+    return rex_nil();
+  }
+  return rex_int(rex_unbox_int(v));
 }
 
 RexValue rex_math_eval(RexValue expr) {
   expr = rex_resolve(expr);
-  if (expr.tag != REX_STR) {
+  if (rex_value_tag(expr) != REX_STR) {
     rex_panic("math.eval expects string");
     return rex_err(rex_str("bad expression"));
   }
 
-  const char* s = expr.as.str ? expr.as.str : "";
+  const char* s = rex_str_data(&expr);
   while (*s && isspace((unsigned char)*s)) {
     s++;
   }
@@ -1351,12 +2615,12 @@ RexValue rex_math_eval(RexValue expr) {
 
 RexValue rex_text_initials(RexValue text) {
   text = rex_resolve(text);
-  if (text.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR) {
     rex_panic("text.initials expects string");
     return rex_str("");
   }
 
-  const char* s = text.as.str ? text.as.str : "";
+  const char* s = rex_str_data(&text);
   RexStrBuilder sb;
   sb_init(&sb);
   int take_next = 1;
@@ -1372,143 +2636,139 @@ RexValue rex_text_initials(RexValue text) {
     }
   }
 
-  RexValue outv = rex_str(sb.data ? sb.data : "");
+  RexValue outv = rex_str_n(sb.data ? sb.data : "", (size_t)sb.len);
   sb_free(&sb);
   return outv;
 }
 
 RexValue rex_text_lower_ascii(RexValue text) {
   text = rex_resolve(text);
-  if (text.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR) {
     rex_panic("text.lower_ascii expects string");
     return rex_str("");
   }
 
-  const char* s = text.as.str ? text.as.str : "";
-  size_t len = strlen(s);
-  char* out = (char*)rex_xmalloc(len + 1u);
+  const char* s = rex_str_bytes(&text);
+  size_t len = rex_str_size(&text);
+  char* out = rex_str_alloc(len);
   for (size_t i = 0; i < len; ++i) {
     out[i] = (char)tolower((unsigned char)s[i]);
   }
-  out[len] = '\0';
 
-  RexValue outv = rex_str(out);
-  free(out);
-  return outv;
+  return rex_str_wrap(out);
 }
 
 RexValue rex_text_pad_left(RexValue text, RexValue width, RexValue fill) {
   text = rex_resolve(text);
   width = rex_resolve(width);
   fill = rex_resolve(fill);
-  if (text.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR) {
     rex_panic("text.pad_left expects string text");
     return rex_str("");
   }
-  if (width.tag != REX_NUM) {
+  if (rex_value_tag(width) != REX_NUM) {
     rex_panic("text.pad_left expects numeric width");
     return rex_str("");
   }
-  if (fill.tag != REX_STR) {
+  if (rex_value_tag(fill) != REX_STR) {
     rex_panic("text.pad_left expects string fill");
     return rex_str("");
   }
 
-  return rex_pad_string_impl(text.as.str ? text.as.str : "", (int)width.as.num, fill.as.str ? fill.as.str : "", 1);
+  return rex_pad_string_impl(rex_str_data(&text), (int)rex_as_num(width), rex_str_data(&fill), 1);
 }
 
 RexValue rex_text_pad_right(RexValue text, RexValue width, RexValue fill) {
   text = rex_resolve(text);
   width = rex_resolve(width);
   fill = rex_resolve(fill);
-  if (text.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR) {
     rex_panic("text.pad_right expects string text");
     return rex_str("");
   }
-  if (width.tag != REX_NUM) {
+  if (rex_value_tag(width) != REX_NUM) {
     rex_panic("text.pad_right expects numeric width");
     return rex_str("");
   }
-  if (fill.tag != REX_STR) {
+  if (rex_value_tag(fill) != REX_STR) {
     rex_panic("text.pad_right expects string fill");
     return rex_str("");
   }
 
-  return rex_pad_string_impl(text.as.str ? text.as.str : "", (int)width.as.num, fill.as.str ? fill.as.str : "", 0);
+  return rex_pad_string_impl(rex_str_data(&text), (int)rex_as_num(width), rex_str_data(&fill), 0);
 }
 
 RexValue rex_text_trim(RexValue text) {
   text = rex_resolve(text);
-  if (text.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR) {
     rex_panic("text.trim expects string");
     return rex_str("");
   }
 
-  const char* src = text.as.str ? text.as.str : "";
-  const char* start = src;
-  while (*start && isspace((unsigned char)*start)) {
+  const char* start = rex_str_bytes(&text);
+  const char* finish = start + rex_str_size(&text);
+  while (start < finish && isspace((unsigned char)*start)) {
     ++start;
   }
-  const char* finish = src + strlen(src);
   while (finish > start && isspace((unsigned char)finish[-1])) {
     --finish;
   }
-  return rex_make_str_range(start, (size_t)(finish - start));
+  return rex_str_view(&text, start, (size_t)(finish - start));
 }
 
 RexValue rex_text_trim_start(RexValue text) {
   text = rex_resolve(text);
-  if (text.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR) {
     rex_panic("text.trim_start expects string");
     return rex_str("");
   }
 
-  const char* src = text.as.str ? text.as.str : "";
-  const char* start = src;
-  while (*start && isspace((unsigned char)*start)) {
+  const char* start = rex_str_bytes(&text);
+  const char* finish = start + rex_str_size(&text);
+  while (start < finish && isspace((unsigned char)*start)) {
     ++start;
   }
-  return rex_str(start);
+  return rex_str_view(&text, start, (size_t)(finish - start));
 }
 
 RexValue rex_text_trim_end(RexValue text) {
   text = rex_resolve(text);
-  if (text.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR) {
     rex_panic("text.trim_end expects string");
     return rex_str("");
   }
 
-  const char* src = text.as.str ? text.as.str : "";
-  const char* finish = src + strlen(src);
+  const char* src = rex_str_bytes(&text);
+  const char* finish = src + rex_str_size(&text);
   while (finish > src && isspace((unsigned char)finish[-1])) {
     --finish;
   }
-  return rex_make_str_range(src, (size_t)(finish - src));
+  return rex_str_view(&text, src, (size_t)(finish - src));
 }
 
 RexValue rex_text_split_words(RexValue text) {
   text = rex_resolve(text);
-  if (text.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR) {
     rex_panic("text.split_words expects string");
     return rex_nil();
   }
 
   RexValue out = rex_collections_vec_new();
-  const char* src = text.as.str ? text.as.str : "";
-  const char* p = src;
+  const char* p = rex_str_bytes(&text);
+  const char* end = p + rex_str_size(&text);
 
-  while (*p) {
-    while (*p && isspace((unsigned char)*p)) {
+  while (p < end) {
+    while (p < end && isspace((unsigned char)*p)) {
       ++p;
     }
-    if (!*p) {
+    if (p == end) {
       break;
     }
     const char* start = p;
-    while (*p && !isspace((unsigned char)*p)) {
+    while (p < end && !isspace((unsigned char)*p)) {
       ++p;
     }
-    rex_collections_vec_push(out, rex_make_str_range(start, (size_t)(p - start)));
+    rex_collections_vec_push(out, rex_str_view(&text, start, (size_t)(p - start)));
   }
 
   return out;
@@ -1517,15 +2777,15 @@ RexValue rex_text_split_words(RexValue text) {
 RexValue rex_text_starts_with(RexValue text, RexValue prefix) {
   text = rex_resolve(text);
   prefix = rex_resolve(prefix);
-  if (text.tag != REX_STR || prefix.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR || rex_value_tag(prefix) != REX_STR) {
     rex_panic("text.starts_with expects strings");
     return rex_bool(0);
   }
 
-  const char* src = text.as.str ? text.as.str : "";
-  const char* pre = prefix.as.str ? prefix.as.str : "";
-  size_t src_len = strlen(src);
-  size_t pre_len = strlen(pre);
+  const char* src = rex_str_bytes(&text);
+  const char* pre = rex_str_bytes(&prefix);
+  size_t src_len = rex_str_size(&text);
+  size_t pre_len = rex_str_size(&prefix);
   if (pre_len > src_len) {
     return rex_bool(0);
   }
@@ -1535,15 +2795,15 @@ RexValue rex_text_starts_with(RexValue text, RexValue prefix) {
 RexValue rex_text_ends_with(RexValue text, RexValue suffix) {
   text = rex_resolve(text);
   suffix = rex_resolve(suffix);
-  if (text.tag != REX_STR || suffix.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR || rex_value_tag(suffix) != REX_STR) {
     rex_panic("text.ends_with expects strings");
     return rex_bool(0);
   }
 
-  const char* src = text.as.str ? text.as.str : "";
-  const char* suf = suffix.as.str ? suffix.as.str : "";
-  size_t src_len = strlen(src);
-  size_t suf_len = strlen(suf);
+  const char* src = rex_str_bytes(&text);
+  const char* suf = rex_str_bytes(&suffix);
+  size_t src_len = rex_str_size(&text);
+  size_t suf_len = rex_str_size(&suffix);
   if (suf_len > src_len) {
     return rex_bool(0);
   }
@@ -1553,51 +2813,51 @@ RexValue rex_text_ends_with(RexValue text, RexValue suffix) {
 RexValue rex_text_contains(RexValue text, RexValue needle) {
   text = rex_resolve(text);
   needle = rex_resolve(needle);
-  if (text.tag != REX_STR || needle.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR || rex_value_tag(needle) != REX_STR) {
     rex_panic("text.contains expects strings");
     return rex_bool(0);
   }
 
-  const char* src = text.as.str ? text.as.str : "";
-  const char* find = needle.as.str ? needle.as.str : "";
-  if (find[0] == '\0') {
-    return rex_bool(1);
-  }
-  return rex_bool(strstr(src, find) != NULL);
+  const char* src = rex_str_bytes(&text);
+  const char* find = rex_str_bytes(&needle);
+  return rex_bool(rex_mem_find(src, rex_str_size(&text), find, rex_str_size(&needle)) != NULL);
 }
 
 RexValue rex_text_replace(RexValue text, RexValue from, RexValue to) {
   text = rex_resolve(text);
   from = rex_resolve(from);
   to = rex_resolve(to);
-  if (text.tag != REX_STR || from.tag != REX_STR || to.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR || rex_value_tag(from) != REX_STR || rex_value_tag(to) != REX_STR) {
     rex_panic("text.replace expects strings");
     return rex_str("");
   }
 
-  const char* src = text.as.str ? text.as.str : "";
-  const char* needle = from.as.str ? from.as.str : "";
-  const char* repl = to.as.str ? to.as.str : "";
-  size_t needle_len = strlen(needle);
+  const char* src = rex_str_bytes(&text);
+  const char* needle = rex_str_bytes(&from);
+  const char* repl = rex_str_bytes(&to);
+  size_t src_len = rex_str_size(&text);
+  size_t needle_len = rex_str_size(&from);
+  size_t repl_len = rex_str_size(&to);
   if (needle_len == 0) {
-    return rex_str(src);
+    return rex_str_n(src, src_len);
   }
 
   RexStrBuilder sb;
   sb_init(&sb);
   const char* p = src;
-  while (*p) {
-    const char* hit = strstr(p, needle);
+  const char* end = src + src_len;
+  while (p < end) {
+    const char* hit = rex_mem_find(p, (size_t)(end - p), needle, needle_len);
     if (!hit) {
-      sb_append_str(&sb, p);
+      sb_append_bytes(&sb, p, (int)(end - p));
       break;
     }
     sb_append_bytes(&sb, p, (int)(hit - p));
-    sb_append_str(&sb, repl);
+    sb_append_bytes(&sb, repl, (int)repl_len);
     p = hit + needle_len;
   }
 
-  RexValue out = rex_str(sb.data ? sb.data : "");
+  RexValue out = rex_str_n(sb.data ? sb.data : "", (size_t)sb.len);
   sb_free(&sb);
   return out;
 }
@@ -1605,57 +2865,59 @@ RexValue rex_text_replace(RexValue text, RexValue from, RexValue to) {
 RexValue rex_text_repeat(RexValue text, RexValue count) {
   text = rex_resolve(text);
   count = rex_resolve(count);
-  if (text.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR) {
     rex_panic("text.repeat expects string");
     return rex_str("");
   }
-  if (count.tag != REX_NUM) {
+  if (rex_value_tag(count) != REX_NUM) {
     rex_panic("text.repeat expects numeric count");
     return rex_str("");
   }
 
-  int times = (int)count.as.num;
+  int times = (int)rex_as_num(count);
   if (times <= 0) {
     return rex_str("");
   }
 
-  const char* src = text.as.str ? text.as.str : "";
+  const char* src = rex_str_data(&text);
   RexStrBuilder sb;
   sb_init(&sb);
   for (int i = 0; i < times; ++i) {
     sb_append_str(&sb, src);
   }
-  RexValue out = rex_str(sb.data ? sb.data : "");
+  RexValue out = rex_str_n(sb.data ? sb.data : "", (size_t)sb.len);
   sb_free(&sb);
   return out;
 }
 
 RexValue rex_text_lines(RexValue text) {
   text = rex_resolve(text);
-  if (text.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR) {
     rex_panic("text.lines expects string");
     return rex_nil();
   }
 
   RexValue out = rex_collections_vec_new();
-  const char* src = text.as.str ? text.as.str : "";
-  if (*src == '\0') {
+  const char* start = rex_str_bytes(&text);
+  const char* end = start + rex_str_size(&text);
+  if (start == end) {
     return out;
   }
 
-  const char* start = src;
-  for (const char* p = src; ; ++p) {
-    if (*p == '\n' || *p == '\0') {
-      size_t len = (size_t)(p - start);
-      if (len > 0 && start[len - 1] == '\r') {
-        --len;
-      }
-      rex_collections_vec_push(out, rex_make_str_range(start, len));
-      if (*p == '\0') {
-        break;
-      }
-      start = p + 1;
+  for (;;) {
+    const char* p = (const char*)memchr(start, '\n', (size_t)(end - start));
+    if (!p) {
+      p = end;
+    }
+    size_t len = (size_t)(p - start);
+    if (len > 0 && start[len - 1] == '\r') {
+      --len;
+    }
+    rex_collections_vec_push(out, rex_str_view(&text, start, len));
+    if (p == end) {
+      break;
     }
+    start = p + 1;
   }
 
   return out;
@@ -1663,58 +2925,50 @@ RexValue rex_text_lines(RexValue text) {
 
 RexValue rex_text_upper_ascii(RexValue text) {
   text = rex_resolve(text);
-  if (text.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR) {
     rex_panic("text.upper_ascii expects string");
     return rex_str("");
   }
 
-  const char* s = text.as.str ? text.as.str : "";
-  size_t len = strlen(s);
-  char* out = (char*)rex_xmalloc(len + 1u);
+  const char* s = rex_str_bytes(&text);
+  size_t len = rex_str_size(&text);
+  char* out = rex_str_alloc(len);
   for (size_t i = 0; i < len; ++i) {
     out[i] = (char)toupper((unsigned char)s[i]);
   }
-  out[len] = '\0';
 
-  RexValue outv = rex_str(out);
-  free(out);
-  return outv;
+  return rex_str_wrap(out);
 }
 
 RexValue rex_text_is_empty(RexValue text) {
   text = rex_resolve(text);
-  if (text.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR) {
     rex_panic("text.is_empty expects string");
     return rex_bool(0);
   }
-  const char* src = text.as.str ? text.as.str : "";
-  return rex_bool(src[0] == '\0');
+  return rex_bool(rex_str_size(&text) == 0);
 }
 
 RexValue rex_text_len_bytes(RexValue text) {
   text = rex_resolve(text);
-  if (text.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR) {
     rex_panic("text.len_bytes expects string");
     return rex_num(0);
   }
-  const char* src = text.as.str ? text.as.str : "";
-  return rex_num((double)strlen(src));
+  return rex_num((double)rex_str_size(&text));
 }
 
 RexValue rex_text_index_of(RexValue text, RexValue needle) {
   text = rex_resolve(text);
   needle = rex_resolve(needle);
-  if (text.tag != REX_STR || needle.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR || rex_value_tag(needle) != REX_STR) {
     rex_panic("text.index_of expects strings");
     return rex_num(-1);
   }
 
-  const char* src = text.as.str ? text.as.str : "";
-  const char* find = needle.as.str ? needle.as.str : "";
-  if (find[0] == '\0') {
-    return rex_num(0);
-  }
-  const char* hit = strstr(src, find);
+  const char* src = rex_str_bytes(&text);
+  const char* find = rex_str_bytes(&needle);
+  const char* hit = rex_mem_find(src, rex_str_size(&text), find, rex_str_size(&needle));
   if (!hit) {
     return rex_num(-1);
   }
@@ -1724,15 +2978,15 @@ RexValue rex_text_index_of(RexValue text, RexValue needle) {
 RexValue rex_text_last_index_of(RexValue text, RexValue needle) {
   text = rex_resolve(text);
   needle = rex_resolve(needle);
-  if (text.tag != REX_STR || needle.tag != REX_STR) {
+  if (rex_value_tag(text) != REX_STR || rex_value_tag(needle) != REX_STR) {
     rex_panic("text.last_index_of expects strings");
     return rex_num(-1);
   }
 
-  const char* src = text.as.str ? text.as.str : "";
-  const char* find = needle.as.str ? needle.as.str : "";
-  size_t src_len = strlen(src);
-  size_t needle_len = strlen(find);
+  const char* src = rex_str_bytes(&text);
+  const char* find = rex_str_bytes(&needle);
+  size_t src_len = rex_str_size(&text);
+  size_t needle_len = rex_str_size(&needle);
   if (needle_len == 0) {
     return rex_num((double)src_len);
   }
@@ -1750,11 +3004,11 @@ RexValue rex_text_last_index_of(RexValue text, RexValue needle) {
 
 RexValue rex_random_seed(RexValue seed) {
   seed = rex_resolve(seed);
-  if (seed.tag != REX_NUM) {
+  if (rex_value_tag(seed) != REX_NUM) {
     rex_panic("random.seed expects number");
     return rex_nil();
   }
-  uint64_t s = (uint64_t)seed.as.num;
+  uint64_t s = (uint64_t)rex_as_num(seed);
   rex_rand_seed_u64(s);
   return rex_nil();
 }
@@ -1762,12 +3016,12 @@ RexValue rex_random_seed(RexValue seed) {
 RexValue rex_random_int(RexValue min, RexValue max) {
   min = rex_resolve(min);
   max = rex_resolve(max);
-  if (min.tag != REX_NUM || max.tag != REX_NUM) {
+  if (rex_value_tag(min) != REX_NUM || rex_value_tag(max) != REX_NUM) {
     rex_panic("random.int expects numbers");
     return rex_num(0);
   }
-  int64_t lo = (int64_t)min.as.num;
-  int64_t hi = (int64_t)max.as.num;
+  int64_t lo = (int64_t)rex_as_num(min);
+  int64_t hi = (int64_t)rex_as_num(max);
   if (hi < lo) {
     int64_t tmp = lo;
     lo = hi;
@@ -1790,48 +3044,46 @@ RexValue rex_random_float(void) {
 
 RexValue rex_random_bool(RexValue probability) {
   probability = rex_resolve(probability);
-  if (probability.tag != REX_NUM) {
+  if (rex_value_tag(probability) != REX_NUM) {
     rex_panic("random.bool expects number");
     return rex_bool(0);
   }
-  double p = probability.as.num;
+  double p = rex_as_num(probability);
   if (p <= 0.0) {
     return rex_bool(0);
   }
   if (p >= 1.0) {
     return rex_bool(1);
   }
-  return rex_bool(rex_random_float().as.num < p);
+  return rex_bool(rex_as_num(rex_random_float()) < p);
 }
 
 RexValue rex_random_choice(RexValue vec) {
   vec = rex_resolve(vec);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
     rex_panic("random.choice expects vector");
     return rex_nil();
   }
-  RexVec* v = (RexVec*)vec.as.ptr;
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
   if (v->count <= 0) {
     return rex_nil();
   }
   uint64_t r = rex_rand_next();
   int idx = (int)(r % (uint64_t)v->count);
-  return v->items[idx];
+  return vec_load(v, idx);
 }
 
 RexValue rex_random_shuffle(RexValue vec) {
   vec = rex_resolve_mut(vec);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
     rex_panic("random.shuffle expects vector");
     return rex_nil();
   }
-  RexVec* v = (RexVec*)vec.as.ptr;
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
   for (int i = v->count - 1; i > 0; i--) {
     uint64_t r = rex_rand_next();
     int j = (int)(r % (uint64_t)(i + 1));
-    RexValue tmp = v->items[i];
-    v->items[i] = v->items[j];
-    v->items[j] = tmp;
+    vec_swap(v, i, j);
   }
   return vec;
 }
@@ -1839,28 +3091,28 @@ RexValue rex_random_shuffle(RexValue vec) {
 RexValue rex_random_range(RexValue min, RexValue max) {
   min = rex_resolve(min);
   max = rex_resolve(max);
-  if (min.tag != REX_NUM || max.tag != REX_NUM) {
+  if (rex_value_tag(min) != REX_NUM || rex_value_tag(max) != REX_NUM) {
     rex_panic("random.range expects numbers");
     return rex_num(0);
   }
-  double lo = min.as.num;
-  double hi = max.as.num;
+  double lo = rex_as_num(min);
+  double hi = rex_as_num(max);
   if (hi < lo) {
     double tmp = lo;
     lo = hi;
     hi = tmp;
   }
-  double r = rex_random_float().as.num;
+  double r = rex_as_num(rex_random_float());
   return rex_num(lo + (hi - lo) * r);
 }
 
 RexValue rex_io_read_file(RexValue path) {
   path = rex_resolve(path);
-  if (path.tag != REX_STR) {
+  if (rex_value_tag(path) != REX_STR) {
     rex_panic("read_file expects string path");
     return rex_err(rex_str("bad path"));
   }
-  FILE* f = fopen(path.as.str, "rb");
+  FILE* f = fopen(rex_str_data(&path), "rb");
   if (!f) {
     return rex_err(rex_str(strerror(errno)));
   }
@@ -1877,28 +3129,27 @@ RexValue rex_io_read_file(RexValue path) {
     fclose(f);
     return rex_err(rex_str("fseek failed"));
   }
-  char* buf = (char*)rex_xmalloc((size_t)size + 1);
+  char* buf = rex_str_alloc((size_t)size);
   size_t read = fread(buf, 1, (size_t)size, f);
   buf[read] = '\0';
+  rex_str_header(buf)->len = (uint32_t)read;
   fclose(f);
-  RexValue out = rex_ok(rex_str(buf));
-  free(buf);
-  return out;
+  return rex_ok(rex_str_wrap(buf));
 }
 
 RexValue rex_io_write_file(RexValue path, RexValue data) {
   path = rex_resolve(path);
   data = rex_resolve(data);
-  if (path.tag != REX_STR) {
+  if (rex_value_tag(path) != REX_STR) {
     rex_panic("write_file expects string path");
     return rex_err(rex_str("bad path"));
   }
-  const char* content = rex_to_cstr(data);
-  FILE* f = fopen(path.as.str, "wb");
+  const char* content = rex_value_tag(data) == REX_STR ? rex_str_bytes(&data) : rex_to_cstr(data);
+  FILE* f = fopen(rex_str_data(&path), "wb");
   if (!f) {
     return rex_err(rex_str(strerror(errno)));
   }
-  size_t len = strlen(content);
+  size_t len = rex_value_tag(data) == REX_STR ? rex_str_size(&data) : strlen(content);
   size_t written = fwrite(content, 1, len, f);
   fclose(f);
   if (written != len) {
@@ -1924,11 +3175,11 @@ RexValue rex_io_read_line(void) {
 
 RexValue rex_io_read_lines(RexValue path) {
   path = rex_resolve(path);
-  if (path.tag != REX_STR) {
+  if (rex_value_tag(path) != REX_STR) {
     rex_panic("read_lines expects string path");
     return rex_err(rex_str("bad path"));
   }
-  FILE* f = fopen(path.as.str, "rb");
+  FILE* f = fopen(rex_str_data(&path), "rb");
   if (!f) {
     return rex_err(rex_str(strerror(errno)));
   }
@@ -1941,7 +3192,7 @@ RexValue rex_io_read_lines(RexValue path) {
       continue;
     }
     if (ch == '\n') {
-      RexValue line = rex_str(sb.data ? sb.data : "");
+      RexValue line = rex_str_n(sb.data ? sb.data : "", (size_t)sb.len);
       rex_collections_vec_push(lines, line);
       sb.len = 0;
       if (sb.data) {
@@ -1952,7 +3203,7 @@ RexValue rex_io_read_lines(RexValue path) {
     sb_append_char(&sb, (char)ch);
   }
   if (sb.len > 0) {
-    RexValue line = rex_str(sb.data ? sb.data : "");
+    RexValue line = rex_str_n(sb.data ? sb.data : "", (size_t)sb.len);
     rex_collections_vec_push(lines, line);
   }
   fclose(f);
@@ -1963,22 +3214,23 @@ RexValue rex_io_read_lines(RexValue path) {
 RexValue rex_io_write_lines(RexValue path, RexValue lines) {
   path = rex_resolve(path);
   lines = rex_resolve(lines);
-  if (path.tag != REX_STR) {
+  if (rex_value_tag(path) != REX_STR) {
     rex_panic("write_lines expects string path");
     return rex_err(rex_str("bad path"));
   }
-  if (lines.tag != REX_VEC || !lines.as.ptr) {
+  if (rex_value_tag(lines) != REX_VEC || !rex_as_ptr(lines)) {
     rex_panic("write_lines expects vector");
     return rex_err(rex_str("bad lines"));
   }
-  FILE* f = fopen(path.as.str, "wb");
+  FILE* f = fopen(rex_str_data(&path), "wb");
   if (!f) {
     return rex_err(rex_str(strerror(errno)));
   }
-  RexVec* v = (RexVec*)lines.as.ptr;
+  RexVec* v = (RexVec*)rex_as_ptr(lines);
   for (int i = 0; i < v->count; i++) {
-    const char* text = rex_to_cstr(v->items[i]);
-    size_t len = strlen(text);
+    RexValue item = rex_resolve(vec_load(v, i));
+    const char* text = rex_value_tag(item) == REX_STR ? rex_str_bytes(&item) : rex_to_cstr(item);
+    size_t len = rex_value_tag(item) == REX_STR ? rex_str_size(&item) : strlen(text);
     if (len > 0 && fwrite(text, 1, len, f) != len) {
       fclose(f);
       return rex_err(rex_str("write failed"));
@@ -1994,23 +3246,23 @@ RexValue rex_io_write_lines(RexValue path, RexValue lines) {
 
 RexValue rex_fs_exists(RexValue path) {
   path = rex_resolve(path);
-  if (path.tag != REX_STR) {
+  if (rex_value_tag(path) != REX_STR) {
     rex_panic("fs_exists expects string path");
     return rex_bool(0);
   }
   rex_stat_t st;
-  int rc = rex_stat(path.as.str, &st);
+  int rc = rex_stat(rex_str_data(&path), &st);
   return rex_bool(rc == 0);
 }
 
 RexValue rex_fs_mkdir(RexValue path) {
   path = rex_resolve(path);
-  if (path.tag != REX_STR) {
+  if (rex_value_tag(path) != REX_STR) {
     rex_panic("fs_mkdir expects string path");
     return rex_err(rex_str("bad path"));
   }
   rex_stat_t st;
-  if (rex_stat(path.as.str, &st) == 0) {
+  if (rex_stat(rex_str_data(&path), &st) == 0) {
 #ifdef _WIN32
     if (st.st_mode & _S_IFDIR) {
       return rex_ok(rex_bool(1));
@@ -2023,9 +3275,9 @@ RexValue rex_fs_mkdir(RexValue path) {
     return rex_err(rex_str("path exists"));
   }
 #ifdef _WIN32
-  int rc = _mkdir(path.as.str);
+  int rc = _mkdir(rex_str_data(&path));
 #else
-  int rc = mkdir(path.as.str, 0755);
+  int rc = mkdir(rex_str_data(&path), 0755);
 #endif
   if (rc == 0 || errno == EEXIST) {
     return rex_ok(rex_bool(1));
@@ -2035,30 +3287,30 @@ RexValue rex_fs_mkdir(RexValue path) {
 
 RexValue rex_fs_remove(RexValue path) {
   path = rex_resolve(path);
-  if (path.tag != REX_STR) {
+  if (rex_value_tag(path) != REX_STR) {
     rex_panic("fs_remove expects string path");
     return rex_err(rex_str("bad path"));
   }
   rex_stat_t st;
-  if (rex_stat(path.as.str, &st) != 0) {
+  if (rex_stat(rex_str_data(&path), &st) != 0) {
     return rex_err(rex_str(strerror(errno)));
   }
 #ifdef _WIN32
   if (st.st_mode & _S_IFDIR) {
-    if (_rmdir(path.as.str) == 0) {
+    if (_rmdir(rex_str_data(&path)) == 0) {
       return rex_ok(rex_bool(1));
     }
     return rex_err(rex_str(strerror(errno)));
   }
 #else
   if (S_ISDIR(st.st_mode)) {
-    if (rmdir(path.as.str) == 0) {
+    if (rmdir(rex_str_data(&path)) == 0) {
       return rex_ok(rex_bool(1));
     }
     return rex_err(rex_str(strerror(errno)));
   }
 #endif
-  if (remove(path.as.str) == 0) {
+  if (remove(rex_str_data(&path)) == 0) {
     return rex_ok(rex_bool(1));
   }
   return rex_err(rex_str(strerror(errno)));
@@ -2066,12 +3318,12 @@ RexValue rex_fs_remove(RexValue path) {
 
 RexValue rex_fs_is_dir(RexValue path) {
   path = rex_resolve(path);
-  if (path.tag != REX_STR) {
+  if (rex_value_tag(path) != REX_STR) {
     rex_panic("fs_is_dir expects string path");
     return rex_bool(0);
   }
   rex_stat_t st;
-  if (rex_stat(path.as.str, &st) != 0) {
+  if (rex_stat(rex_str_data(&path), &st) != 0) {
     return rex_bool(0);
   }
 #ifdef _WIN32
@@ -2113,12 +3365,12 @@ static RexValue rex_fs_copy_file(const char* src, const char* dst) {
 RexValue rex_fs_copy(RexValue src, RexValue dst) {
   src = rex_resolve(src);
   dst = rex_resolve(dst);
-  if (src.tag != REX_STR || dst.tag != REX_STR) {
+  if (rex_value_tag(src) != REX_STR || rex_value_tag(dst) != REX_STR) {
     rex_panic("fs_copy expects string paths");
     return rex_err(rex_str("bad path"));
   }
   rex_stat_t st;
-  if (rex_stat(src.as.str, &st) != 0) {
+  if (rex_stat(rex_str_data(&src), &st) != 0) {
     return rex_err(rex_str(strerror(errno)));
   }
 #ifdef _WIN32
@@ -2130,31 +3382,31 @@ RexValue rex_fs_copy(RexValue src, RexValue dst) {
     return rex_err(rex_str("copy supports files only"));
   }
 #endif
-  return rex_fs_copy_file(src.as.str, dst.as.str);
+  return rex_fs_copy_file(rex_str_data(&src), rex_str_data(&dst));
 }
 
 RexValue rex_fs_move(RexValue src, RexValue dst) {
   src = rex_resolve(src);
   dst = rex_resolve(dst);
-  if (src.tag != REX_STR || dst.tag != REX_STR) {
+  if (rex_value_tag(src) != REX_STR || rex_value_tag(dst) != REX_STR) {
     rex_panic("fs_move expects string paths");
     return rex_err(rex_str("bad path"));
   }
 #ifdef _WIN32
-  if (MoveFileExA(src.as.str, dst.as.str, MOVEFILE_REPLACE_EXISTING | MOVEFILE_COPY_ALLOWED) != 0) {
+  if (MoveFileExA(rex_str_data(&src), rex_str_data(&dst), MOVEFILE_REPLACE_EXISTING | MOVEFILE_COPY_ALLOWED) != 0) {
     return rex_ok(rex_bool(1));
   }
   return rex_err(rex_str("move failed"));
 #else
-  if (rename(src.as.str, dst.as.str) == 0) {
+  if (rename(rex_str_data(&src), rex_str_data(&dst)) == 0) {
     return rex_ok(rex_bool(1));
   }
   if (errno != EXDEV) {
     return rex_err(rex_str(strerror(errno)));
   }
-  RexValue copied = rex_fs_copy_file(src.as.str, dst.as.str);
-  if (copied.tag == REX_RESULT && rex_result_is(copied, "Ok")) {
-    if (remove(src.as.str) == 0) {
+  RexValue copied = rex_fs_copy_file(rex_str_data(&src), rex_str_data(&dst));
+  if (rex_value_tag(copied) == REX_RESULT && rex_result_is(copied, "Ok")) {
+    if (remove(rex_str_data(&src)) == 0) {
       return rex_ok(rex_bool(1));
     }
     return rex_err(rex_str(strerror(errno)));
@@ -2165,12 +3417,12 @@ RexValue rex_fs_move(RexValue src, RexValue dst) {
 
 RexValue rex_fs_read_dir(RexValue path) {
   path = rex_resolve(path);
-  if (path.tag != REX_STR) {
+  if (rex_value_tag(path) != REX_STR) {
     rex_panic("fs_read_dir expects string path");
     return rex_err(rex_str("bad path"));
   }
 #ifdef _WIN32
-  const char* base = path.as.str;
+  const char* base = rex_str_data(&path);
   size_t len = strlen(base);
   size_t extra = 3u;
   char* pattern = (char*)rex_xmalloc(len + extra);
@@ -2187,7 +3439,7 @@ RexValue rex_fs_read_dir(RexValue path) {
 
   WIN32_FIND_DATAA data;
   HANDLE h = FindFirstFileA(pattern, &data);
-  free(pattern);
+  rex_xfree(pattern);
   if (h == INVALID_HANDLE_VALUE) {
     return rex_err(rex_str("read_dir failed"));
   }
@@ -2202,7 +3454,7 @@ RexValue rex_fs_read_dir(RexValue path) {
   FindClose(h);
   return rex_ok(vec);
 #else
-  DIR* d = opendir(path.as.str);
+  DIR* d = opendir(rex_str_data(&path));
   if (!d) {
     return rex_err(rex_str(strerror(errno)));
   }
@@ -2222,11 +3474,11 @@ RexValue rex_fs_read_dir(RexValue path) {
 
 RexValue rex_os_getenv(RexValue key) {
   key = rex_resolve(key);
-  if (key.tag != REX_STR) {
+  if (rex_value_tag(key) != REX_STR) {
     rex_panic("getenv expects string key");
     return rex_nil();
   }
-  const char* val = getenv(key.as.str);
+  const char* val = getenv(rex_str_data(&key));
   if (!val) {
     return rex_nil();
   }
@@ -2288,7 +3540,7 @@ RexValue rex_os_home(void) {
     char* buf = (char*)rex_xmalloc(len);
     snprintf(buf, len, "%s%s", drive, path);
     RexValue out = rex_str(buf);
-    free(buf);
+    rex_xfree(buf);
     return out;
   }
   return rex_nil();
@@ -2354,19 +3606,19 @@ static RexValue rex_path_slice(const char* start, size_t len) {
   memcpy(buf, start, len);
   buf[len] = '\0';
   RexValue out = rex_str(buf);
-  free(buf);
+  rex_xfree(buf);
   return out;
 }
 
 RexValue rex_path_join(RexValue a, RexValue b) {
   a = rex_resolve(a);
   b = rex_resolve(b);
-  if (a.tag != REX_STR || b.tag != REX_STR) {
+  if (rex_value_tag(a) != REX_STR || rex_value_tag(b) != REX_STR) {
     rex_panic("path_join expects string paths");
     return rex_str("");
   }
-  const char* left = a.as.str;
-  const char* right = b.as.str;
+  const char* left = rex_str_data(&a);
+  const char* right = rex_str_data(&b);
   if (!left || !left[0]) {
     return rex_str(right ? right : "");
   }
@@ -2395,17 +3647,17 @@ RexValue rex_path_join(RexValue a, RexValue b) {
   pos += right_len;
   buf[pos] = '\0';
   RexValue out = rex_str(buf);
-  free(buf);
+  rex_xfree(buf);
   return out;
 }
 
 RexValue rex_path_basename(RexValue path) {
   path = rex_resolve(path);
-  if (path.tag != REX_STR) {
+  if (rex_value_tag(path) != REX_STR) {
     rex_panic("path_basename expects string path");
     return rex_str("");
   }
-  const char* p = path.as.str;
+  const char* p = rex_str_data(&path);
   size_t len = strlen(p);
   if (len == 0) {
     return rex_str("");
@@ -2426,11 +3678,11 @@ RexValue rex_path_basename(RexValue path) {
 
 RexValue rex_path_dirname(RexValue path) {
   path = rex_resolve(path);
-  if (path.tag != REX_STR) {
+  if (rex_value_tag(path) != REX_STR) {
     rex_panic("path_dirname expects string path");
     return rex_str(".");
   }
-  const char* p = path.as.str;
+  const char* p = rex_str_data(&path);
   size_t len = strlen(p);
   if (len == 0) {
     return rex_str(".");
@@ -2467,11 +3719,11 @@ RexValue rex_path_dirname(RexValue path) {
 
 RexValue rex_path_ext(RexValue path) {
   path = rex_resolve(path);
-  if (path.tag != REX_STR) {
+  if (rex_value_tag(path) != REX_STR) {
     rex_panic("path_ext expects string path");
     return rex_str("");
   }
-  const char* p = path.as.str;
+  const char* p = rex_str_data(&path);
   size_t len = strlen(p);
   size_t end = len;
   while (end > 0 && rex_path_is_sep(p[end - 1])) {
@@ -2497,11 +3749,11 @@ RexValue rex_path_ext(RexValue path) {
 
 RexValue rex_path_stem(RexValue path) {
   path = rex_resolve(path);
-  if (path.tag != REX_STR) {
+  if (rex_value_tag(path) != REX_STR) {
     rex_panic("path_stem expects string path");
     return rex_str("");
   }
-  const char* p = path.as.str;
+  const char* p = rex_str_data(&path);
   size_t len = strlen(p);
   size_t end = len;
   while (end > 0 && rex_path_is_sep(p[end - 1])) {
@@ -2527,29 +3779,29 @@ RexValue rex_path_stem(RexValue path) {
 
 RexValue rex_path_is_abs(RexValue path) {
   path = rex_resolve(path);
-  if (path.tag != REX_STR) {
+  if (rex_value_tag(path) != REX_STR) {
     rex_panic("path_is_abs expects string path");
     return rex_bool(0);
   }
-  return rex_bool(rex_path_is_abs_cstr(path.as.str));
+  return rex_bool(rex_path_is_abs_cstr(rex_str_data(&path)));
 }
 
 RexValue rex_audio_play(RexValue path) {
   path = rex_resolve(path);
-  if (path.tag != REX_STR || !path.as.str) {
+  if (rex_value_tag(path) != REX_STR ) {
     rex_panic("audio.play expects string path");
     return rex_bool(0);
   }
-  return rex_bool(rex_audio_platform_play(path.as.str) != 0);
+  return rex_bool(rex_audio_platform_play(rex_str_data(&path)) != 0);
 }
 
 RexValue rex_audio_play_loop(RexValue path) {
   path = rex_resolve(path);
-  if (path.tag != REX_STR || !path.as.str) {
+  if (rex_value_tag(path) != REX_STR ) {
     rex_panic("audio.play_loop expects string path");
     return rex_bool(0);
   }
-  return rex_bool(rex_audio_platform_play_ex(path.as.str, 1) != 0);
+  return rex_bool(rex_audio_platform_play_ex(rex_str_data(&path), 1) != 0);
 }
 
 RexValue rex_audio_stop(void) {
@@ -2559,20 +3811,20 @@ RexValue rex_audio_stop(void) {
 
 RexValue rex_audio_supports(RexValue ext) {
   ext = rex_resolve(ext);
-  if (ext.tag != REX_STR || !ext.as.str) {
+  if (rex_value_tag(ext) != REX_STR ) {
     rex_panic("audio.supports expects string extension");
     return rex_bool(0);
   }
-  return rex_bool(rex_audio_platform_supports(ext.as.str) != 0);
+  return rex_bool(rex_audio_platform_supports(rex_str_data(&ext)) != 0);
 }
 
 RexValue rex_audio_set_volume(RexValue value) {
   value = rex_resolve(value);
-  if (value.tag != REX_NUM) {
+  if (rex_value_tag(value) != REX_NUM) {
     rex_panic("audio.set_volume expects number");
     return rex_nil();
   }
-  rex_audio_platform_set_volume(value.as.num);
+  rex_audio_platform_set_volume(rex_as_num(value));
   return rex_nil();
 }
 
@@ -2585,8 +3837,8 @@ static int rex_log_level = REX_LOG_INFO;
 
 static int rex_log_parse_level(RexValue v) {
   v = rex_resolve(v);
-  if (v.tag == REX_NUM) {
-    int lvl = (int)v.as.num;
+  if (rex_value_tag(v) == REX_NUM) {
+    int lvl = (int)rex_as_num(v);
     if (lvl < REX_LOG_DEBUG) {
       lvl = REX_LOG_DEBUG;
     } else if (lvl > REX_LOG_ERROR) {
@@ -2594,8 +3846,8 @@ static int rex_log_parse_level(RexValue v) {
     }
     return lvl;
   }
-  if (v.tag == REX_STR && v.as.str) {
-    const char* s = v.as.str;
+  if (rex_value_tag(v) == REX_STR) {
+    const char* s = rex_str_data(&v);
     if (strcmp(s, "debug") == 0) return REX_LOG_DEBUG;
     if (strcmp(s, "info") == 0) return REX_LOG_INFO;
     if (strcmp(s, "warn") == 0) return REX_LOG_WARN;
@@ -2608,7 +3860,9 @@ static void rex_log_emit(int level, const char* label, RexValue value) {
   if (level < rex_log_level) {
     return;
   }
-  fprintf(stderr, "[%s] %s\n", label, rex_to_cstr(value));
+  fprintf(stderr, "[%s] ", label);
+  rex_write_value(stderr, value);
+  fputc('\n', stderr);
 }
 
 RexValue rex_log_debug(RexValue value) {
@@ -2640,104 +3894,355 @@ RexValue rex_log_get_level(void) {
   return rex_num(rex_log_level);
 }
 
+static size_t vec_elem_size(const RexVec* v) {
+  switch (v->kind) {
+    case REX_VEC_F64:
+      return sizeof(double);
+    case REX_VEC_I64:
+    case REX_VEC_U64:
+      return sizeof(int64_t);
+    case REX_VEC_U8:
+      return sizeof(uint8_t);
+    default:
+      return sizeof(RexValue);
+  }
+}
+
+static char* vec_bytes(RexVec* v) {
+  return v->kind == REX_VEC_VALUE ? (char*)v->items : (char*)v->data;
+}
+
+static void vec_reserve(RexVec* v, int capacity) {
+  if (capacity <= v->capacity) {
+    return;
+  }
+  size_t size = vec_elem_size(v) * (size_t)capacity;
+  if (v->kind == REX_VEC_VALUE) {
+    v->items = (RexValue*)rex_xrealloc_for(v, v->items, size);
+  } else {
+    v->data = rex_xrealloc_for(v, v->data, size);
+  }
+  if (!vec_bytes(v)) {
+    rex_panic("vector realloc failed");
+  }
+  v->capacity = capacity;
+}
+
 static void vec_grow(RexVec* v) {
   if (v->capacity == 0) {
-    v->capacity = 4;
-    v->items = (RexValue*)rex_xmalloc(sizeof(RexValue) * (size_t)v->capacity);
+    vec_reserve(v, 4);
   } else if (v->count >= v->capacity) {
-    v->capacity *= 2;
-    v->items = (RexValue*)realloc(v->items, sizeof(RexValue) * (size_t)v->capacity);
-    if (!v->items) {
-      rex_panic("vector realloc failed");
+    vec_reserve(v, v->capacity * 2);
+  }
+}
+
+static RexValue vec_load(const RexVec* v, int index) {
+  switch (v->kind) {
+    case REX_VEC_F64:
+      return rex_num(((const double*)v->data)[index]);
+    case REX_VEC_I64:
+      return rex_int(((const int64_t*)v->data)[index]);
+    case REX_VEC_U64:
+      return rex_uint(((const uint64_t*)v->data)[index]);
+    case REX_VEC_U8:
+      return rex_int(((const uint8_t*)v->data)[index]);
+    default:
+      return v->items[index];
+  }
+}
+
+static double vec_expect_num(RexValue value) {
+  value = rex_resolve(value);
+  if (rex_value_tag(value) != REX_NUM) {
+    rex_panic("typed vector expects number");
+    return 0;
+  }
+  return rex_as_num(value);
+}
+
+static int64_t vec_expect_int(RexValue value) {
+  value = rex_resolve(value);
+  if (rex_value_tag(value) != REX_NUM) {
+    rex_panic("typed vector expects number");
+    return 0;
+  }
+  return rex_unbox_int(value);
+}
+
+static void vec_store_f64(RexVec* v, int index, double value) {
+  switch (v->kind) {
+    case REX_VEC_F64:
+      ((double*)v->data)[index] = value;
+      break;
+    case REX_VEC_I64:
+    case REX_VEC_U64:
+      ((int64_t*)v->data)[index] = rex_int_from_num(value);
+      break;
+    case REX_VEC_U8:
+      ((uint8_t*)v->data)[index] = (uint8_t)rex_int_from_num(value);
+      break;
+    default:
+      v->items[index] = rex_num(value);
+      break;
+  }
+}
+
+static void vec_store_i64(RexVec* v, int index, int64_t value) {
+  switch (v->kind) {
+    case REX_VEC_F64:
+      ((double*)v->data)[index] = (double)value;
+      break;
+    case REX_VEC_I64:
+    case REX_VEC_U64:
+      ((int64_t*)v->data)[index] = value;
+      break;
+    case REX_VEC_U8:
+      ((uint8_t*)v->data)[index] = (uint8_t)value;
+      break;
+    default:
+      v->items[index] = rex_int(value);
+      break;
+  }
+}
+
+static void vec_store(RexVec* v, int index, RexValue value) {
+  if (v->kind == REX_VEC_VALUE) {
+    v->items[index] = value;
+  } else {
+    value = rex_resolve(value);
+    if (rex_value_tag(value) == REX_NUM && rex_num_repr(value) != REX_NUM_F64) {
+      vec_store_i64(v, index, rex_as_int(value));
+    } else {
+      vec_store_f64(v, index, vec_expect_num(value));
     }
   }
 }
 
-RexValue rex_collections_vec_new(void) {
+static void vec_swap(RexVec* v, int i, int j) {
+  size_t size = vec_elem_size(v);
+  char* base = vec_bytes(v);
+  char tmp[sizeof(RexValue)];
+  memcpy(tmp, base + (size_t)i * size, size);
+  memcpy(base + (size_t)i * size, base + (size_t)j * size, size);
+  memcpy(base + (size_t)j * size, tmp, size);
+}
+
+static RexVec* vec_alloc(int kind) {
   RexVec* v = (RexVec*)rex_xmalloc(sizeof(RexVec));
   v->items = NULL;
+  v->data = NULL;
   v->count = 0;
   v->capacity = 0;
-  RexValue out;
-  out.tag = REX_VEC;
-  out.as.ptr = v;
-  return out;
+  v->kind = kind;
+  v->view = 0;
+  v->shared = NULL;
+  return v;
+}
+
+// Gives v a private copy of storage it shares with clones; the last handle
+// just takes the storage over.
+static void vec_unshare(RexVec* v) {
+  int* shared = v->shared;
+  v->shared = NULL;
+  if (__atomic_load_n(shared, __ATOMIC_ACQUIRE) == 0) {
+    rex_xfree(shared);
+    return;
+  }
+  char* old = vec_bytes(v);
+  size_t size = vec_elem_size(v);
+  char* copy = (char*)rex_xmalloc_for(v, size * (size_t)v->capacity);
+  memcpy(copy, old, size * (size_t)v->count);
+  if (v->kind == REX_VEC_VALUE) {
+    v->items = (RexValue*)copy;
+  } else {
+    v->data = copy;
+  }
+  if (rex_shared_release(shared)) {
+    rex_xfree(old);
+  }
+}
+
+static RexValue vec_value(RexVec* v) {
+  return rex_value_make(REX_VEC, v);
+}
+
+static RexVec* vec_expect(RexValue vec, int mutable, const char* msg) {
+  vec = mutable ? rex_resolve_mut(vec) : rex_resolve(vec);
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
+    rex_panic(msg);
+    return NULL;
+  }
+  return (RexVec*)rex_as_ptr(vec);
+}
+
+static RexVec* vec_expect_index(RexValue vec, int64_t index, int mutable, const char* msg) {
+  RexVec* v = vec_expect(vec, mutable, msg);
+  if (v && (index < 0 || index >= v->count)) {
+    rex_panic("vec index out of range");
+    return NULL;
+  }
+  return v;
+}
+
+RexValue rex_collections_vec_new(void) {
+  return vec_value(vec_alloc(REX_VEC_VALUE));
+}
+
+RexValue rex_collections_vec_new_typed(int kind) {
+  return vec_value(vec_alloc(kind));
 }
 
 void rex_collections_vec_push(RexValue vec, RexValue value) {
   vec = rex_resolve_mut(vec);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
     rex_panic("vec_push expects vector");
     return;
   }
-  RexVec* v = (RexVec*)vec.as.ptr;
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
+  vec_grow(v);
+  vec_store(v, v->count, value);
+  v->count += 1;
+}
+
+void rex_collections_vec_push_f64(RexValue vec, double value) {
+  RexVec* v = vec_expect(vec, 1, "vec_push expects vector");
+  if (!v) {
+    return;
+  }
   vec_grow(v);
-  v->items[v->count++] = value;
+  vec_store_f64(v, v->count, value);
+  v->count += 1;
 }
 
-RexValue rex_collections_vec_get(RexValue vec, RexValue index) {
-  vec = rex_resolve(vec);
-  index = rex_resolve(index);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
-    rex_panic("vec_get expects vector");
+void rex_collections_vec_push_i64(RexValue vec, int64_t value) {
+  RexVec* v = vec_expect(vec, 1, "vec_push expects vector");
+  if (!v) {
+    return;
+  }
+  vec_grow(v);
+  vec_store_i64(v, v->count, value);
+  v->count += 1;
+}
+
+RexValue rex_collections_vec_get_at(RexValue vec, int64_t index) {
+  RexVec* v = vec_expect_index(vec, index, 0, "vec_get expects vector");
+  if (!v) {
     return rex_nil();
   }
-  if (index.tag != REX_NUM) {
+  return vec_load(v, (int)index);
+}
+
+static double vec_load_f64(const RexVec* v, int index) {
+  switch (v->kind) {
+    case REX_VEC_F64:
+      return ((const double*)v->data)[index];
+    case REX_VEC_I64:
+      return (double)((const int64_t*)v->data)[index];
+    case REX_VEC_U64:
+      return (double)((const uint64_t*)v->data)[index];
+    case REX_VEC_U8:
+      return (double)((const uint8_t*)v->data)[index];
+    default:
+      return vec_expect_num(v->items[index]);
+  }
+}
+
+double rex_collections_vec_get_f64(RexValue vec, int64_t index) {
+  RexVec* v = vec_expect_index(vec, index, 0, "vec_get expects vector");
+  if (!v) {
+    return 0;
+  }
+  return vec_load_f64(v, (int)index);
+}
+
+static int vec_is_int(const RexVec* v) {
+  return v->kind == REX_VEC_I64 || v->kind == REX_VEC_U64 || v->kind == REX_VEC_U8;
+}
+
+static int64_t vec_load_i64(const RexVec* v, int index) {
+  switch (v->kind) {
+    case REX_VEC_I64:
+    case REX_VEC_U64:
+      return ((const int64_t*)v->data)[index];
+    case REX_VEC_U8:
+      return ((const uint8_t*)v->data)[index];
+    case REX_VEC_F64:
+      return rex_int_from_num(((const double*)v->data)[index]);
+    default:
+      return vec_expect_int(v->items[index]);
+  }
+}
+
+int64_t rex_collections_vec_get_i64(RexValue vec, int64_t index) {
+  RexVec* v = vec_expect_index(vec, index, 0, "vec_get expects vector");
+  if (!v) {
+    return 0;
+  }
+  return vec_load_i64(v, (int)index);
+}
+
+RexValue rex_collections_vec_get(RexValue vec, RexValue index) {
+  index = rex_resolve(index);
+  if (rex_value_tag(index) != REX_NUM) {
     rex_panic("vec_get expects numeric index");
     return rex_nil();
   }
-  RexVec* v = (RexVec*)vec.as.ptr;
-  int idx = (int)index.as.num;
-  if (idx < 0 || idx >= v->count) {
-    rex_panic("vec index out of range");
-    return rex_nil();
+  return rex_collections_vec_get_at(vec, rex_unbox_int(index));
+}
+
+void rex_collections_vec_set_at(RexValue vec, int64_t index, RexValue value) {
+  RexVec* v = vec_expect_index(vec, index, 1, "vec_set expects vector");
+  if (v) {
+    vec_store(v, (int)index, value);
+  }
+}
+
+void rex_collections_vec_set_f64(RexValue vec, int64_t index, double value) {
+  RexVec* v = vec_expect_index(vec, index, 1, "vec_set expects vector");
+  if (v) {
+    vec_store_f64(v, (int)index, value);
+  }
+}
+
+void rex_collections_vec_set_i64(RexValue vec, int64_t index, int64_t value) {
+  RexVec* v = vec_expect_index(vec, index, 1, "vec_set expects vector");
+  if (v) {
+    vec_store_i64(v, (int)index, value);
   }
-  return v->items[idx];
 }
 
 void rex_collections_vec_set(RexValue vec, RexValue index, RexValue value) {
-  vec = rex_resolve_mut(vec);
   index = rex_resolve(index);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
-    rex_panic("vec_set expects vector");
-    return;
-  }
-  if (index.tag != REX_NUM) {
+  if (rex_value_tag(index) != REX_NUM) {
     rex_panic("vec_set expects numeric index");
     return;
   }
-  RexVec* v = (RexVec*)vec.as.ptr;
-  int idx = (int)index.as.num;
-  if (idx < 0 || idx >= v->count) {
-    rex_panic("vec index out of range");
-    return;
-  }
-  v->items[idx] = value;
+  rex_collections_vec_set_at(vec, rex_unbox_int(index), value);
 }
 
 RexValue rex_collections_vec_len(RexValue vec) {
   vec = rex_resolve(vec);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
     rex_panic("vec_len expects vector");
     return rex_nil();
   }
-  RexVec* v = (RexVec*)vec.as.ptr;
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
   return rex_num((double)v->count);
 }
 
 RexValue rex_collections_vec_insert(RexValue vec, RexValue index, RexValue value) {
   vec = rex_resolve_mut(vec);
   index = rex_resolve(index);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
     rex_panic("vec_insert expects vector");
     return rex_nil();
   }
-  if (index.tag != REX_NUM) {
+  if (rex_value_tag(index) != REX_NUM) {
     rex_panic("vec_insert expects numeric index");
     return rex_nil();
   }
-  RexVec* v = (RexVec*)vec.as.ptr;
-  int idx = (int)index.as.num;
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
+  int idx = (int)rex_as_num(index);
   if (idx < 0) {
     idx = 0;
   }
@@ -2746,34 +4251,36 @@ RexValue rex_collections_vec_insert(RexValue vec, RexValue index, RexValue value
   }
   vec_grow(v);
   if (idx < v->count) {
-    memmove(&v->items[idx + 1], &v->items[idx], sizeof(RexValue) * (size_t)(v->count - idx));
+    size_t size = vec_elem_size(v);
+    char* base = vec_bytes(v);
+    memmove(base + (size_t)(idx + 1) * size, base + (size_t)idx * size, size * (size_t)(v->count - idx));
   }
-  v->items[idx] = value;
+  vec_store(v, idx, value);
   v->count += 1;
   return rex_nil();
 }
 
 RexValue rex_collections_vec_pop(RexValue vec) {
   vec = rex_resolve_mut(vec);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
     rex_panic("vec_pop expects vector");
     return rex_nil();
   }
-  RexVec* v = (RexVec*)vec.as.ptr;
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
   if (v->count <= 0) {
     return rex_nil();
   }
   v->count -= 1;
-  return v->items[v->count];
+  return vec_load(v, v->count);
 }
 
 RexValue rex_collections_vec_clear(RexValue vec) {
   vec = rex_resolve_mut(vec);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
     rex_panic("vec_clear expects vector");
     return rex_nil();
   }
-  RexVec* v = (RexVec*)vec.as.ptr;
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
   v->count = 0;
   return rex_nil();
 }
@@ -2781,49 +4288,47 @@ RexValue rex_collections_vec_clear(RexValue vec) {
 static int rex_value_cmp(RexValue a, RexValue b) {
   a = rex_resolve(a);
   b = rex_resolve(b);
-  if (a.tag == REX_NIL && b.tag == REX_NIL) {
+  if (rex_value_tag(a) == REX_NIL && rex_value_tag(b) == REX_NIL) {
     return 0;
   }
-  if (a.tag == REX_NIL) {
+  if (rex_value_tag(a) == REX_NIL) {
     return -1;
   }
-  if (b.tag == REX_NIL) {
+  if (rex_value_tag(b) == REX_NIL) {
     return 1;
   }
-  if (a.tag == REX_NUM && b.tag == REX_NUM) {
-    if (a.as.num < b.as.num) {
-      return -1;
-    }
-    if (a.as.num > b.as.num) {
-      return 1;
-    }
-    return 0;
+  if (rex_value_tag(a) == REX_NUM && rex_value_tag(b) == REX_NUM) {
+    int c = rex_num_cmp(a, b);
+    return c == 2 ? 0 : c;
   }
-  if (a.tag == REX_STR && b.tag == REX_STR) {
-    const char* sa = a.as.str ? a.as.str : "";
-    const char* sb = b.as.str ? b.as.str : "";
-    int cmp = strcmp(sa, sb);
+  if (rex_value_tag(a) == REX_STR && rex_value_tag(b) == REX_STR) {
+    size_t la = rex_str_size(&a);
+    size_t lb = rex_str_size(&b);
+    int cmp = (la && lb) ? memcmp(rex_str_bytes(&a), rex_str_bytes(&b), la < lb ? la : lb) : 0;
     if (cmp < 0) {
       return -1;
     }
     if (cmp > 0) {
       return 1;
     }
+    if (la != lb) {
+      return la < lb ? -1 : 1;
+    }
     return 0;
   }
-  if (a.tag == REX_BOOL && b.tag == REX_BOOL) {
-    if (a.as.boolean == b.as.boolean) {
+  if (rex_value_tag(a) == REX_BOOL && rex_value_tag(b) == REX_BOOL) {
+    if (rex_as_bool(a) == rex_as_bool(b)) {
       return 0;
     }
-    return a.as.boolean ? 1 : -1;
+    return rex_as_bool(a) ? 1 : -1;
   }
-  if (a.tag != b.tag) {
-    return (int)a.tag - (int)b.tag;
+  if (rex_value_tag(a) != rex_value_tag(b)) {
+    return (int)rex_value_tag(a) - (int)rex_value_tag(b);
   }
-  if (a.as.ptr == b.as.ptr) {
+  if (rex_as_ptr(a) == rex_as_ptr(b)) {
     return 0;
   }
-  return (a.as.ptr < b.as.ptr) ? -1 : 1;
+  return (rex_as_ptr(a) < rex_as_ptr(b)) ? -1 : 1;
 }
 
 static int rex_value_cmp_qsort(const void* a, const void* b) {
@@ -2832,243 +4337,1349 @@ static int rex_value_cmp_qsort(const void* a, const void* b) {
   return rex_value_cmp(va, vb);
 }
 
-RexValue rex_collections_vec_sort(RexValue vec) {
-  vec = rex_resolve_mut(vec);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
-    rex_panic("vec_sort expects vector");
-    return rex_nil();
-  }
-  RexVec* v = (RexVec*)vec.as.ptr;
-  if (v->count > 1) {
-    qsort(v->items, (size_t)v->count, sizeof(RexValue), rex_value_cmp_qsort);
-  }
-  return vec;
+// Numbers sort as order-preserving 64-bit keys with an LSD radix sort;
+// strings use an introsort over cached 8-byte prefixes. Anything else (or a
+// mix of tags) falls back to qsort with rex_value_cmp.
+static uint64_t sort_key_f64(double d) {
+  uint64_t u;
+  memcpy(&u, &d, sizeof(u));
+  return (u & 0x8000000000000000ULL) ? ~u : (u | 0x8000000000000000ULL);
 }
 
-RexValue rex_collections_vec_slice(RexValue vec, RexValue start, RexValue finish) {
-  vec = rex_resolve(vec);
-  start = rex_resolve(start);
-  finish = rex_resolve(finish);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
-    rex_panic("vec_slice expects vector");
-    return rex_nil();
+static double sort_unkey_f64(uint64_t u) {
+  u = (u & 0x8000000000000000ULL) ? (u & ~0x8000000000000000ULL) : ~u;
+  double d;
+  memcpy(&d, &u, sizeof(d));
+  return d;
+}
+
+static uint64_t sort_key_i64(int64_t n) {
+  return (uint64_t)n ^ 0x8000000000000000ULL;
+}
+
+// Stable; idx (optional) is permuted along with the keys. Byte positions
+// shared by every key are skipped.
+static void sort_radix_u64(uint64_t* keys, uint32_t* idx, size_t n) {
+  if (n < 2) {
+    return;
   }
-  if (start.tag != REX_NUM) {
-    rex_panic("vec_slice expects numeric start");
-    return rex_nil();
+  if (n <= 32) {
+    for (size_t i = 1; i < n; i++) {
+      uint64_t k = keys[i];
+      uint32_t x = idx ? idx[i] : 0;
+      size_t j = i;
+      while (j > 0 && keys[j - 1] > k) {
+        keys[j] = keys[j - 1];
+        if (idx) {
+          idx[j] = idx[j - 1];
+        }
+        j--;
+      }
+      keys[j] = k;
+      if (idx) {
+        idx[j] = x;
+      }
+    }
+    return;
   }
-  RexVec* v = (RexVec*)vec.as.ptr;
-  int s = (int)start.as.num;
-  int e = v->count;
-  if (finish.tag != REX_NIL) {
-    if (finish.tag != REX_NUM) {
-      rex_panic("vec_slice expects numeric end");
-      return rex_nil();
+  size_t counts[8][256];
+  memset(counts, 0, sizeof(counts));
+  for (size_t i = 0; i < n; i++) {
+    uint64_t k = keys[i];
+    for (int b = 0; b < 8; b++) {
+      counts[b][(k >> (b * 8)) & 0xff]++;
     }
-    e = (int)finish.as.num;
   }
-  if (s < 0) {
-    s = 0;
+  uint64_t* key_tmp = (uint64_t*)rex_xmalloc_raw(n * sizeof(uint64_t));
+  uint32_t* idx_tmp = idx ? (uint32_t*)rex_xmalloc_raw(n * sizeof(uint32_t)) : NULL;
+  uint64_t* src = keys;
+  uint64_t* dst = key_tmp;
+  uint32_t* isrc = idx;
+  uint32_t* idst = idx_tmp;
+  for (int b = 0; b < 8; b++) {
+    size_t* c = counts[b];
+    int shift = b * 8;
+    if (c[(src[0] >> shift) & 0xff] == n) {
+      continue;
+    }
+    size_t sum = 0;
+    for (int d = 0; d < 256; d++) {
+      size_t t = c[d];
+      c[d] = sum;
+      sum += t;
+    }
+    for (size_t i = 0; i < n; i++) {
+      size_t at = c[(src[i] >> shift) & 0xff]++;
+      dst[at] = src[i];
+      if (isrc) {
+        idst[at] = isrc[i];
+      }
+    }
+    uint64_t* kt = src;
+    src = dst;
+    dst = kt;
+    uint32_t* it = isrc;
+    isrc = idst;
+    idst = it;
+  }
+  if (src != keys) {
+    memcpy(keys, src, n * sizeof(uint64_t));
+    if (idx) {
+      memcpy(idx, isrc, n * sizeof(uint32_t));
+    }
   }
-  if (s > v->count) {
-    s = v->count;
+  rex_xfree(key_tmp);
+  rex_xfree(idx_tmp);
+}
+
+static void sort_u8_counting(uint8_t* data, size_t n) {
+  size_t counts[256] = { 0 };
+  for (size_t i = 0; i < n; i++) {
+    counts[data[i]]++;
   }
-  if (e < s) {
-    e = s;
+  size_t at = 0;
+  for (int d = 0; d < 256; d++) {
+    memset(data + at, d, counts[d]);
+    at += counts[d];
   }
-  if (e > v->count) {
-    e = v->count;
+}
+
+typedef struct RexSortStr {
+  uint64_t prefix;
+  const char* data;
+  size_t len;
+  RexValue value;
+} RexSortStr;
+
+static inline int sort_str_less(const RexSortStr* a, const RexSortStr* b) {
+  if (a->prefix != b->prefix) {
+    return a->prefix < b->prefix;
   }
-  RexVec* out = (RexVec*)rex_xmalloc(sizeof(RexVec));
-  out->count = e - s;
-  out->capacity = out->count;
-  if (out->count == 0) {
-    out->items = NULL;
-  } else {
-    out->items = (RexValue*)rex_xmalloc(sizeof(RexValue) * (size_t)out->count);
-    for (int i = 0; i < out->count; i++) {
-      out->items[i] = v->items[s + i];
+  size_t n = a->len < b->len ? a->len : b->len;
+  if (n > 8) {
+    int cmp = memcmp(a->data + 8, b->data + 8, n - 8);
+    if (cmp != 0) {
+      return cmp < 0;
     }
   }
-  RexValue outv;
-  outv.tag = REX_VEC;
-  outv.as.ptr = out;
-  return outv;
+  return a->len < b->len;
 }
 
-RexValue rex_collections_vec_find(RexValue vec, RexValue value) {
-  vec = rex_resolve(vec);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
-    rex_panic("vec_find expects vector");
-    return rex_num(-1);
-  }
+static inline void sort_str_swap(RexSortStr* a, RexSortStr* b) {
+  RexSortStr t = *a;
+  *a = *b;
+  *b = t;
+}
 
-  RexVec* v = (RexVec*)vec.as.ptr;
-  for (int i = 0; i < v->count; ++i) {
-    if (rex_value_eq(v->items[i], value)) {
-      return rex_num((double)i);
+static void sort_str_insertion(RexSortStr* a, size_t n) {
+  for (size_t i = 1; i < n; i++) {
+    RexSortStr x = a[i];
+    size_t j = i;
+    while (j > 0 && sort_str_less(&x, &a[j - 1])) {
+      a[j] = a[j - 1];
+      j--;
     }
+    a[j] = x;
   }
-  return rex_num(-1);
 }
 
-RexValue rex_collections_vec_any(RexValue vec, RexValue value) {
-  vec = rex_resolve(vec);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
-    rex_panic("vec_any expects vector");
-    return rex_bool(0);
+static void sort_str_sift(RexSortStr* a, size_t root, size_t n) {
+  for (;;) {
+    size_t child = root * 2 + 1;
+    if (child >= n) {
+      return;
+    }
+    if (child + 1 < n && sort_str_less(&a[child], &a[child + 1])) {
+      child++;
+    }
+    if (!sort_str_less(&a[root], &a[child])) {
+      return;
+    }
+    sort_str_swap(&a[root], &a[child]);
+    root = child;
   }
+}
 
-  RexVec* v = (RexVec*)vec.as.ptr;
-  for (int i = 0; i < v->count; ++i) {
-    if (rex_value_eq(v->items[i], value)) {
-      return rex_bool(1);
-    }
+static void sort_str_heap(RexSortStr* a, size_t n) {
+  for (size_t i = n / 2; i-- > 0;) {
+    sort_str_sift(a, i, n);
+  }
+  for (size_t end = n; end-- > 1;) {
+    sort_str_swap(&a[0], &a[end]);
+    sort_str_sift(a, 0, end);
   }
-  return rex_bool(0);
 }
 
-RexValue rex_collections_vec_all(RexValue vec, RexValue value) {
-  vec = rex_resolve(vec);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
-    rex_panic("vec_all expects vector");
-    return rex_bool(0);
+static void sort_str_sort3(RexSortStr* a, size_t i, size_t j, size_t k) {
+  if (sort_str_less(&a[j], &a[i])) {
+    sort_str_swap(&a[i], &a[j]);
+  }
+  if (sort_str_less(&a[k], &a[j])) {
+    sort_str_swap(&a[j], &a[k]);
+    if (sort_str_less(&a[j], &a[i])) {
+      sort_str_swap(&a[i], &a[j]);
+    }
   }
+}
 
-  RexVec* v = (RexVec*)vec.as.ptr;
-  for (int i = 0; i < v->count; ++i) {
-    if (!rex_value_eq(v->items[i], value)) {
-      return rex_bool(0);
+// pdqsort-style: ninther pivot, heapsort once the depth budget runs out, and
+// runs equal to the previous pivot are split off in one linear pass.
+static void sort_str_intro(RexSortStr* a, size_t n, int depth, int leftmost) {
+  while (n > 24) {
+    if (depth-- <= 0) {
+      sort_str_heap(a, n);
+      return;
+    }
+    size_t mid = n / 2;
+    if (n > 128) {
+      sort_str_sort3(a, 0, mid, n - 1);
+      sort_str_sort3(a, 1, mid - 1, n - 2);
+      sort_str_sort3(a, 2, mid + 1, n - 3);
+      sort_str_sort3(a, mid - 1, mid, mid + 1);
+    } else {
+      sort_str_sort3(a, 0, mid, n - 1);
+    }
+    sort_str_swap(&a[0], &a[mid]);
+    RexSortStr p = a[0];
+    if (!leftmost && !sort_str_less(&a[-1], &p)) {
+      size_t first = 0;
+      size_t last = n;
+      do {
+        last--;
+      } while (sort_str_less(&p, &a[last]));
+      do {
+        first++;
+      } while (first < last && !sort_str_less(&p, &a[first]));
+      while (first < last) {
+        sort_str_swap(&a[first], &a[last]);
+        do {
+          last--;
+        } while (sort_str_less(&p, &a[last]));
+        do {
+          first++;
+        } while (!sort_str_less(&p, &a[first]));
+      }
+      a[0] = a[last];
+      a[last] = p;
+      a += last + 1;
+      n -= last + 1;
+      continue;
+    }
+    size_t first = 0;
+    size_t last = n;
+    do {
+      first++;
+    } while (first < n && sort_str_less(&a[first], &p));
+    do {
+      last--;
+    } while (last > 0 && !sort_str_less(&a[last], &p));
+    while (first < last) {
+      sort_str_swap(&a[first], &a[last]);
+      do {
+        first++;
+      } while (sort_str_less(&a[first], &p));
+      do {
+        last--;
+      } while (!sort_str_less(&a[last], &p));
+    }
+    size_t pivot = first - 1;
+    a[0] = a[pivot];
+    a[pivot] = p;
+    size_t left = pivot;
+    size_t right = n - pivot - 1;
+    if (left < right) {
+      sort_str_intro(a, left, depth, leftmost);
+      a += pivot + 1;
+      n = right;
+      leftmost = 0;
+    } else {
+      sort_str_intro(a + pivot + 1, right, depth, 0);
+      n = left;
     }
   }
-  return rex_bool(1);
+  sort_str_insertion(a, n);
 }
 
-RexValue rex_collections_vec_contains(RexValue vec, RexValue value) {
-  return rex_collections_vec_any(vec, value);
+static uint64_t sort_str_prefix(const char* data, size_t len) {
+  uint64_t prefix = 0;
+  for (size_t i = 0; i < 8; i++) {
+    prefix = (prefix << 8) | (i < len ? (unsigned char)data[i] : 0);
+  }
+  return prefix;
 }
 
-RexValue rex_collections_vec_remove_at(RexValue vec, RexValue index) {
-  vec = rex_resolve_mut(vec);
-  index = rex_resolve(index);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
-    rex_panic("vec_remove_at expects vector");
-    return rex_nil();
+// Parallel sample sort: oversampled splitters cut the input into one bucket
+// per worker, workers classify and scatter their own chunk, then each sorts
+// one bucket in place with the serial kernel above.
+#define REX_PAR_SORT_MIN 131072
+#define REX_PAR_SORT_GRAIN 32768
+#define REX_PAR_SORT_OVERSAMPLE 32
+
+typedef struct RexParSort {
+  uint64_t* keys;
+  RexSortStr* strs;
+  uint64_t* key_out;
+  RexSortStr* str_out;
+  size_t n;
+  int workers;
+  uint64_t key_split[REX_PARALLEL_MAX];
+  RexSortStr str_split[REX_PARALLEL_MAX];
+  uint8_t* bucket;
+  size_t* offsets;
+  size_t starts[REX_PARALLEL_MAX + 1];
+} RexParSort;
+
+static int sort_workers(size_t n, int parallel) {
+  if (!parallel && n < REX_PAR_SORT_MIN) {
+    return 1;
   }
-  if (index.tag != REX_NUM) {
-    rex_panic("vec_remove_at expects numeric index");
-    return rex_nil();
+  size_t by_size = n / REX_PAR_SORT_GRAIN;
+  int workers = rex_parallel_workers();
+  if ((size_t)workers > by_size) {
+    workers = (int)by_size;
   }
+  return workers < 1 ? 1 : workers;
+}
 
-  RexVec* v = (RexVec*)vec.as.ptr;
-  int idx = (int)index.as.num;
-  if (idx < 0 || idx >= v->count) {
-    rex_panic("vec_remove_at index out of range");
-    return rex_nil();
+static int par_sort_bucket(const RexParSort* ps, size_t i) {
+  int lo = 0;
+  int hi = ps->workers - 1;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    int below = ps->strs ? sort_str_less(&ps->strs[i], &ps->str_split[mid])
+                         : ps->keys[i] < ps->key_split[mid];
+    if (below) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
   }
+  return lo;
+}
 
-  RexValue removed = v->items[idx];
-  for (int i = idx + 1; i < v->count; ++i) {
-    v->items[i - 1] = v->items[i];
+static void par_sort_classify(void* ctx, int w) {
+  RexParSort* ps = (RexParSort*)ctx;
+  size_t* counts = ps->offsets + (size_t)w * (size_t)ps->workers;
+  size_t end = ps->n * (size_t)(w + 1) / (size_t)ps->workers;
+  for (size_t i = ps->n * (size_t)w / (size_t)ps->workers; i < end; i++) {
+    int b = par_sort_bucket(ps, i);
+    ps->bucket[i] = (uint8_t)b;
+    counts[b]++;
   }
+}
+
+static void par_sort_scatter(void* ctx, int w) {
+  RexParSort* ps = (RexParSort*)ctx;
+  size_t* at = ps->offsets + (size_t)w * (size_t)ps->workers;
+  size_t end = ps->n * (size_t)(w + 1) / (size_t)ps->workers;
+  for (size_t i = ps->n * (size_t)w / (size_t)ps->workers; i < end; i++) {
+    size_t to = at[ps->bucket[i]]++;
+    if (ps->strs) {
+      ps->str_out[to] = ps->strs[i];
+    } else {
+      ps->key_out[to] = ps->keys[i];
+    }
+  }
+}
+
+static void par_sort_bucket_sort(void* ctx, int b) {
+  RexParSort* ps = (RexParSort*)ctx;
+  size_t start = ps->starts[b];
+  size_t count = ps->starts[b + 1] - start;
+  if (ps->strs) {
+    int depth = 0;
+    for (size_t m = count; m > 1; m >>= 1) {
+      depth += 2;
+    }
+    sort_str_intro(ps->str_out + start, count, depth, 1);
+    memcpy(ps->strs + start, ps->str_out + start, count * sizeof(RexSortStr));
+  } else {
+    sort_radix_u64(ps->key_out + start, NULL, count);
+    memcpy(ps->keys + start, ps->key_out + start, count * sizeof(uint64_t));
+  }
+}
+
+// Exactly one of keys/strs is non-NULL; workers must be at least 2.
+static void sort_parallel(uint64_t* keys, RexSortStr* strs, size_t n, int workers) {
+  RexParSort* ps = (RexParSort*)rex_xmalloc_raw(sizeof(RexParSort));
+  memset(ps, 0, sizeof(*ps));
+  ps->keys = keys;
+  ps->strs = strs;
+  ps->n = n;
+  ps->workers = workers;
+
+  size_t samples = (size_t)workers * REX_PAR_SORT_OVERSAMPLE;
+  size_t stride = n / samples;
+  if (strs) {
+    RexSortStr* sample = (RexSortStr*)rex_xmalloc_raw(samples * sizeof(RexSortStr));
+    for (size_t i = 0; i < samples; i++) {
+      sample[i] = strs[i * stride + stride / 2];
+    }
+    sort_str_intro(sample, samples, 64, 1);
+    for (int j = 0; j + 1 < workers; j++) {
+      ps->str_split[j] = sample[(size_t)(j + 1) * REX_PAR_SORT_OVERSAMPLE];
+    }
+    rex_xfree(sample);
+    ps->str_out = (RexSortStr*)rex_xmalloc_raw(n * sizeof(RexSortStr));
+  } else {
+    uint64_t* sample = (uint64_t*)rex_xmalloc_raw(samples * sizeof(uint64_t));
+    for (size_t i = 0; i < samples; i++) {
+      sample[i] = keys[i * stride + stride / 2];
+    }
+    sort_radix_u64(sample, NULL, samples);
+    for (int j = 0; j + 1 < workers; j++) {
+      ps->key_split[j] = sample[(size_t)(j + 1) * REX_PAR_SORT_OVERSAMPLE];
+    }
+    rex_xfree(sample);
+    ps->key_out = (uint64_t*)rex_xmalloc_raw(n * sizeof(uint64_t));
+  }
+  ps->bucket = (uint8_t*)rex_xmalloc_raw(n);
+  size_t cells = (size_t)workers * (size_t)workers;
+  ps->offsets = (size_t*)rex_xmalloc_raw(cells * sizeof(size_t));
+  memset(ps->offsets, 0, cells * sizeof(size_t));
+
+  rex_parallel_for(workers, par_sort_classify, ps);
+  // offsets[w][b] turns from a count into where worker w starts writing
+  // bucket b.
+  size_t sum = 0;
+  for (int b = 0; b < workers; b++) {
+    ps->starts[b] = sum;
+    for (int w = 0; w < workers; w++) {
+      size_t* cell = &ps->offsets[(size_t)w * (size_t)workers + (size_t)b];
+      size_t count = *cell;
+      *cell = sum;
+      sum += count;
+    }
+  }
+  ps->starts[workers] = sum;
+  rex_parallel_for(workers, par_sort_scatter, ps);
+  rex_parallel_for(workers, par_sort_bucket_sort, ps);
+
+  rex_xfree(ps->offsets);
+  rex_xfree(ps->bucket);
+  rex_xfree(ps->key_out);
+  rex_xfree(ps->str_out);
+  rex_xfree(ps);
+}
+
+static void sort_keys(uint64_t* keys, size_t n, int workers) {
+  if (workers > 1) {
+    sort_parallel(keys, NULL, n, workers);
+  } else {
+    sort_radix_u64(keys, NULL, n);
+  }
+}
+
+static void sort_strings(RexValue* items, size_t n, int workers) {
+  RexSortStr* entries = (RexSortStr*)rex_xmalloc_raw(n * sizeof(RexSortStr));
+  for (size_t i = 0; i < n; i++) {
+    entries[i].data = rex_str_bytes(&items[i]);
+    entries[i].len = rex_str_size(&items[i]);
+    entries[i].prefix = sort_str_prefix(entries[i].data, entries[i].len);
+    entries[i].value = items[i];
+  }
+  if (workers > 1) {
+    sort_parallel(NULL, entries, n, workers);
+  } else {
+    int depth = 0;
+    for (size_t m = n; m > 1; m >>= 1) {
+      depth += 2;
+    }
+    sort_str_intro(entries, n, depth, 1);
+  }
+  for (size_t i = 0; i < n; i++) {
+    items[i] = entries[i].value;
+  }
+  rex_xfree(entries);
+}
+
+// Numbers of one representation sort as radix keys; a mix of integers and
+// doubles falls back to the exact comparison sort.
+static void sort_values(RexValue* items, size_t n, int workers) {
+  RexTag tag = rex_value_tag(items[0]);
+  int repr = tag == REX_NUM ? rex_num_repr(items[0]) : -1;
+  for (size_t i = 1; i < n; i++) {
+    if (rex_value_tag(items[i]) != tag) {
+      tag = REX_NIL;
+      break;
+    }
+    if (tag == REX_NUM && rex_num_repr(items[i]) != repr) {
+      repr = -1;
+    }
+  }
+  if (tag == REX_NUM && repr >= 0) {
+    uint64_t* keys = (uint64_t*)rex_xmalloc_raw(n * sizeof(uint64_t));
+    for (size_t i = 0; i < n; i++) {
+      if (repr == REX_NUM_F64) {
+        keys[i] = sort_key_f64(rex_as_num(items[i]));
+      } else {
+        keys[i] = repr == REX_NUM_I64 ? sort_key_i64(rex_as_int(items[i])) : (uint64_t)rex_as_int(items[i]);
+      }
+    }
+    sort_keys(keys, n, workers);
+    for (size_t i = 0; i < n; i++) {
+      if (repr == REX_NUM_F64) {
+        items[i] = rex_num(sort_unkey_f64(keys[i]));
+      } else if (repr == REX_NUM_I64) {
+        items[i] = rex_int((int64_t)(keys[i] ^ 0x8000000000000000ULL));
+      } else {
+        items[i] = rex_uint(keys[i]);
+      }
+    }
+    rex_xfree(keys);
+  } else if (tag == REX_STR) {
+    sort_strings(items, n, workers);
+  } else {
+    qsort(items, n, sizeof(RexValue), rex_value_cmp_qsort);
+  }
+}
+
+static void vec_sort_items(RexVec* v, int parallel) {
+  if (v->count < 2) {
+    return;
+  }
+  size_t n = (size_t)v->count;
+  int workers = sort_workers(n, parallel);
+  if (v->kind == REX_VEC_F64) {
+    // Rekeyed in place; the doubles go through memcpy so the buffer is only
+    // ever accessed as uint64_t here.
+    uint64_t* keys = (uint64_t*)v->data;
+    for (size_t i = 0; i < n; i++) {
+      double d;
+      memcpy(&d, &keys[i], sizeof(d));
+      keys[i] = sort_key_f64(d);
+    }
+    sort_keys(keys, n, workers);
+    for (size_t i = 0; i < n; i++) {
+      double d = sort_unkey_f64(keys[i]);
+      memcpy(&keys[i], &d, sizeof(d));
+    }
+  } else if (v->kind == REX_VEC_I64) {
+    uint64_t* keys = (uint64_t*)v->data;
+    for (size_t i = 0; i < n; i++) {
+      keys[i] = sort_key_i64((int64_t)keys[i]);
+    }
+    sort_keys(keys, n, workers);
+    for (size_t i = 0; i < n; i++) {
+      keys[i] = (uint64_t)(int64_t)(keys[i] ^ 0x8000000000000000ULL);
+    }
+  } else if (v->kind == REX_VEC_U64) {
+    sort_keys((uint64_t*)v->data, n, workers);
+  } else if (v->kind == REX_VEC_U8) {
+    sort_u8_counting((uint8_t*)v->data, n);
+  } else {
+    sort_values(v->items, n, workers);
+  }
+}
+
+RexValue rex_collections_vec_sort(RexValue vec) {
+  vec = rex_resolve_mut(vec);
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
+    rex_panic("vec_sort expects vector");
+    return rex_nil();
+  }
+  vec_sort_items((RexVec*)rex_as_ptr(vec), 0);
+  return vec;
+}
+
+RexValue rex_collections_vec_par_sort(RexValue vec) {
+  vec = rex_resolve_mut(vec);
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
+    rex_panic("vec_par_sort expects vector");
+    return rex_nil();
+  }
+  vec_sort_items((RexVec*)rex_as_ptr(vec), 1);
+  return vec;
+}
+
+static void sort_merge_keys(RexValue* keys, uint32_t* idx, uint32_t* tmp, size_t n) {
+  if (n < 2) {
+    return;
+  }
+  size_t half = n / 2;
+  sort_merge_keys(keys, idx, tmp, half);
+  sort_merge_keys(keys, idx + half, tmp, n - half);
+  if (rex_value_cmp(keys[idx[half - 1]], keys[idx[half]]) <= 0) {
+    return;
+  }
+  memcpy(tmp, idx, half * sizeof(uint32_t));
+  size_t i = 0;
+  size_t j = half;
+  size_t k = 0;
+  while (i < half && j < n) {
+    if (rex_value_cmp(keys[idx[j]], keys[tmp[i]]) < 0) {
+      idx[k++] = idx[j++];
+    } else {
+      idx[k++] = tmp[i++];
+    }
+  }
+  while (i < half) {
+    idx[k++] = tmp[i++];
+  }
+}
+
+RexValue rex_collections_vec_sort_by_key(RexValue vec, RexValue field) {
+  vec = rex_resolve_mut(vec);
+  field = rex_resolve(field);
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
+    rex_panic("vec_sort_by_key expects vector");
+    return rex_nil();
+  }
+  if (rex_value_tag(field) != REX_STR) {
+    rex_panic("vec_sort_by_key expects field name");
+    return rex_nil();
+  }
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
+  if (v->count < 2) {
+    return rex_nil();
+  }
+  if (v->kind != REX_VEC_VALUE) {
+    rex_panic("vec_sort_by_key expects vector of structs");
+    return rex_nil();
+  }
+  size_t n = (size_t)v->count;
+  const char* name = rex_str_data(&field);
+  RexValue* keys = (RexValue*)rex_xmalloc_raw(n * sizeof(RexValue));
+  const char** fields = NULL;
+  int index = -1;
+  int numeric = 1;
+  for (size_t i = 0; i < n; i++) {
+    RexValue item = rex_resolve(v->items[i]);
+    if (rex_value_tag(item) != REX_STRUCT || !rex_as_ptr(item)) {
+      rex_xfree(keys);
+      rex_panic("vec_sort_by_key expects vector of structs");
+      return rex_nil();
+    }
+    RexStruct* st = (RexStruct*)rex_as_ptr(item);
+    if (st->fields != fields) {
+      fields = st->fields;
+      index = -1;
+      for (int f = 0; f < st->count; f++) {
+        if (strcmp(st->fields[f], name) == 0) {
+          index = f;
+          break;
+        }
+      }
+      if (index < 0) {
+        rex_xfree(keys);
+        rex_panic("vec_sort_by_key: unknown field");
+        return rex_nil();
+      }
+    }
+    keys[i] = rex_resolve(rex_struct_load(st, index));
+    numeric = numeric && rex_value_tag(keys[i]) == REX_NUM && rex_num_repr(keys[i]) == rex_num_repr(keys[0]);
+  }
+  uint32_t* idx = (uint32_t*)rex_xmalloc_raw(n * sizeof(uint32_t));
+  for (size_t i = 0; i < n; i++) {
+    idx[i] = (uint32_t)i;
+  }
+  if (numeric) {
+    uint64_t* bits = (uint64_t*)rex_xmalloc_raw(n * sizeof(uint64_t));
+    int repr = rex_num_repr(keys[0]);
+    for (size_t i = 0; i < n; i++) {
+      if (repr == REX_NUM_F64) {
+        bits[i] = sort_key_f64(rex_as_num(keys[i]));
+      } else {
+        bits[i] = repr == REX_NUM_I64 ? sort_key_i64(rex_as_int(keys[i])) : (uint64_t)rex_as_int(keys[i]);
+      }
+    }
+    sort_radix_u64(bits, idx, n);
+    rex_xfree(bits);
+  } else {
+    uint32_t* tmp = (uint32_t*)rex_xmalloc_raw((n / 2 + 1) * sizeof(uint32_t));
+    sort_merge_keys(keys, idx, tmp, n);
+    rex_xfree(tmp);
+  }
+  RexValue* sorted = keys;
+  for (size_t i = 0; i < n; i++) {
+    sorted[i] = v->items[idx[i]];
+  }
+  memcpy(v->items, sorted, n * sizeof(RexValue));
+  rex_xfree(keys);
+  rex_xfree(idx);
+  return rex_nil();
+}
+
+static RexVec* vec_slice_bounds(RexValue vec, RexValue start, RexValue finish, int* out_start, int* out_end) {
+  vec = rex_resolve(vec);
+  start = rex_resolve(start);
+  finish = rex_resolve(finish);
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
+    rex_panic("vec_slice expects vector");
+    return NULL;
+  }
+  if (rex_value_tag(start) != REX_NUM) {
+    rex_panic("vec_slice expects numeric start");
+    return NULL;
+  }
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
+  int s = (int)rex_as_num(start);
+  int e = v->count;
+  if (rex_value_tag(finish) != REX_NIL) {
+    if (rex_value_tag(finish) != REX_NUM) {
+      rex_panic("vec_slice expects numeric end");
+      return NULL;
+    }
+    e = (int)rex_as_num(finish);
+  }
+  if (s < 0) {
+    s = 0;
+  }
+  if (s > v->count) {
+    s = v->count;
+  }
+  if (e < s) {
+    e = s;
+  }
+  if (e > v->count) {
+    e = v->count;
+  }
+  *out_start = s;
+  *out_end = e;
+  return v;
+}
+
+RexValue rex_collections_vec_slice(RexValue vec, RexValue start, RexValue finish) {
+  int s = 0;
+  int e = 0;
+  RexVec* v = vec_slice_bounds(vec, start, finish, &s, &e);
+  if (!v) {
+    return rex_nil();
+  }
+  RexVec* out = vec_alloc(v->kind);
+  if (e > s) {
+    size_t size = vec_elem_size(v);
+    vec_reserve(out, e - s);
+    memcpy(vec_bytes(out), vec_bytes(v) + (size_t)s * size, size * (size_t)(e - s));
+    out->count = e - s;
+  }
+  return vec_value(out);
+}
+
+// Views of views point straight at the root storage, so nesting stays O(1).
+RexValue rex_collections_vec_slice_view(RexVecSlice* slot, RexValue vec, RexValue start, RexValue finish) {
+  int s = 0;
+  int e = 0;
+  RexVec* v = vec_slice_bounds(vec, start, finish, &s, &e);
+  if (!v) {
+    return rex_nil();
+  }
+  RexVec* out = (RexVec*)slot;
+  char* base = vec_bytes(v);
+  if (base) {
+    base += (size_t)s * vec_elem_size(v);
+  }
+  out->items = v->kind == REX_VEC_VALUE ? (RexValue*)base : NULL;
+  out->data = v->kind == REX_VEC_VALUE ? NULL : base;
+  out->count = e - s;
+  out->capacity = e - s;
+  out->kind = v->kind;
+  out->view = 1;
+  out->shared = NULL;
+  return vec_value(out);
+}
+
+RexValue rex_collections_vec_clone(RexValue vec) {
+  RexVec* v = vec_expect(vec, 0, "vec_clone expects vector");
+  if (!v) {
+    return rex_nil();
+  }
+  if (v->view) {
+    return rex_collections_vec_slice(vec, rex_num(0), rex_nil());
+  }
+  RexVec* out = vec_alloc(v->kind);
+  if (v->capacity == 0) {
+    return vec_value(out);
+  }
+  out->shared = rex_shared_retain(v, &v->shared);
+  out->items = v->items;
+  out->data = v->data;
+  out->count = v->count;
+  out->capacity = v->capacity;
+  return vec_value(out);
+}
+
+RexValue rex_collections_vec_find(RexValue vec, RexValue value) {
+  vec = rex_resolve(vec);
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
+    rex_panic("vec_find expects vector");
+    return rex_num(-1);
+  }
+
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
+  for (int i = 0; i < v->count; ++i) {
+    if (rex_value_eq(vec_load(v, i), value)) {
+      return rex_num((double)i);
+    }
+  }
+  return rex_num(-1);
+}
+
+RexValue rex_collections_vec_any(RexValue vec, RexValue value) {
+  vec = rex_resolve(vec);
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
+    rex_panic("vec_any expects vector");
+    return rex_bool(0);
+  }
+
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
+  for (int i = 0; i < v->count; ++i) {
+    if (rex_value_eq(vec_load(v, i), value)) {
+      return rex_bool(1);
+    }
+  }
+  return rex_bool(0);
+}
+
+RexValue rex_collections_vec_all(RexValue vec, RexValue value) {
+  vec = rex_resolve(vec);
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
+    rex_panic("vec_all expects vector");
+    return rex_bool(0);
+  }
+
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
+  for (int i = 0; i < v->count; ++i) {
+    if (!rex_value_eq(vec_load(v, i), value)) {
+      return rex_bool(0);
+    }
+  }
+  return rex_bool(1);
+}
+
+RexValue rex_collections_vec_contains(RexValue vec, RexValue value) {
+  return rex_collections_vec_any(vec, value);
+}
+
+RexValue rex_collections_vec_remove_at(RexValue vec, RexValue index) {
+  vec = rex_resolve_mut(vec);
+  index = rex_resolve(index);
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
+    rex_panic("vec_remove_at expects vector");
+    return rex_nil();
+  }
+  if (rex_value_tag(index) != REX_NUM) {
+    rex_panic("vec_remove_at expects numeric index");
+    return rex_nil();
+  }
+
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
+  int idx = (int)rex_as_num(index);
+  if (idx < 0 || idx >= v->count) {
+    rex_panic("vec_remove_at index out of range");
+    return rex_nil();
+  }
+
+  RexValue removed = vec_load(v, idx);
+  size_t size = vec_elem_size(v);
+  char* base = vec_bytes(v);
+  memmove(base + (size_t)idx * size, base + (size_t)(idx + 1) * size, size * (size_t)(v->count - idx - 1));
   v->count -= 1;
   return removed;
 }
 
-RexValue rex_collections_vec_reverse(RexValue vec) {
-  vec = rex_resolve_mut(vec);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
-    rex_panic("vec_reverse expects vector");
-    return rex_nil();
+RexValue rex_collections_vec_reverse(RexValue vec) {
+  vec = rex_resolve_mut(vec);
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
+    rex_panic("vec_reverse expects vector");
+    return rex_nil();
+  }
+
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
+  for (int i = 0, j = v->count - 1; i < j; ++i, --j) {
+    vec_swap(v, i, j);
+  }
+  return vec;
+}
+
+RexValue rex_collections_vec_first(RexValue vec) {
+  vec = rex_resolve(vec);
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
+    rex_panic("vec_first expects vector");
+    return rex_nil();
+  }
+
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
+  if (v->count <= 0) {
+    return rex_nil();
+  }
+  return vec_load(v, 0);
+}
+
+RexValue rex_collections_vec_last(RexValue vec) {
+  vec = rex_resolve(vec);
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
+    rex_panic("vec_last expects vector");
+    return rex_nil();
+  }
+
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
+  if (v->count <= 0) {
+    return rex_nil();
+  }
+  return vec_load(v, v->count - 1);
+}
+
+RexValue rex_collections_vec_join(RexValue vec, RexValue sep) {
+  return rex_join_vec_impl(vec, sep, "vec_join expects vector");
+}
+
+/* Numeric kernels over Vec<f64>. Other vector kinds go through the scalar
+   element loops below. The x86 variants are picked once from the CPU's
+   feature bits; the others are the portable fallback. */
+typedef struct RexVecKernels {
+  double (*sum)(const double* a, size_t n);
+  double (*dot)(const double* a, const double* b, size_t n);
+  double (*min)(const double* a, size_t n);
+  double (*max)(const double* a, size_t n);
+  void (*scale)(double* a, size_t n, double k);
+  void (*add)(double* a, const double* b, size_t n);
+} RexVecKernels;
+
+static double kernel_sum_scalar(const double* a, size_t n) {
+  double total = 0;
+  for (size_t i = 0; i < n; i++) {
+    total += a[i];
+  }
+  return total;
+}
+
+static double kernel_dot_scalar(const double* a, const double* b, size_t n) {
+  double total = 0;
+  for (size_t i = 0; i < n; i++) {
+    total += a[i] * b[i];
+  }
+  return total;
+}
+
+static double kernel_min_scalar(const double* a, size_t n) {
+  double m = a[0];
+  for (size_t i = 1; i < n; i++) {
+    m = a[i] < m ? a[i] : m;
+  }
+  return m;
+}
+
+static double kernel_max_scalar(const double* a, size_t n) {
+  double m = a[0];
+  for (size_t i = 1; i < n; i++) {
+    m = a[i] > m ? a[i] : m;
+  }
+  return m;
+}
+
+static void kernel_scale_scalar(double* a, size_t n, double k) {
+  for (size_t i = 0; i < n; i++) {
+    a[i] *= k;
+  }
+}
+
+static void kernel_add_scalar(double* a, const double* b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    a[i] += b[i];
+  }
+}
+
+#ifdef REX_SIMD_X86
+__attribute__((target("sse2"))) static double kernel_sum_sse2(const double* a, size_t n) {
+  __m128d acc0 = _mm_setzero_pd();
+  __m128d acc1 = _mm_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    acc0 = _mm_add_pd(acc0, _mm_loadu_pd(a + i));
+    acc1 = _mm_add_pd(acc1, _mm_loadu_pd(a + i + 2));
+  }
+  double lanes[2];
+  _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+  double total = lanes[0] + lanes[1];
+  for (; i < n; i++) {
+    total += a[i];
+  }
+  return total;
+}
+
+__attribute__((target("sse2"))) static double kernel_dot_sse2(const double* a, const double* b, size_t n) {
+  __m128d acc0 = _mm_setzero_pd();
+  __m128d acc1 = _mm_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+  }
+  double lanes[2];
+  _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+  double total = lanes[0] + lanes[1];
+  for (; i < n; i++) {
+    total += a[i] * b[i];
+  }
+  return total;
+}
+
+// min/max keep the scalar kernels' NaN behaviour: every lane starts at a[0]
+// and MINPD/MAXPD return their second operand (the running value) when the
+// new element is NaN, so only a NaN in a[0] reaches the result.
+__attribute__((target("sse2"))) static double kernel_min_sse2(const double* a, size_t n) {
+  if (n < 3) {
+    return kernel_min_scalar(a, n);
+  }
+  __m128d m = _mm_set1_pd(a[0]);
+  size_t i = 1;
+  for (; i + 2 <= n; i += 2) {
+    m = _mm_min_pd(_mm_loadu_pd(a + i), m);
+  }
+  double lanes[2];
+  _mm_storeu_pd(lanes, m);
+  double out = kernel_min_scalar(lanes, 2);
+  for (; i < n; i++) {
+    out = a[i] < out ? a[i] : out;
+  }
+  return out;
+}
+
+__attribute__((target("sse2"))) static double kernel_max_sse2(const double* a, size_t n) {
+  if (n < 3) {
+    return kernel_max_scalar(a, n);
+  }
+  __m128d m = _mm_set1_pd(a[0]);
+  size_t i = 1;
+  for (; i + 2 <= n; i += 2) {
+    m = _mm_max_pd(_mm_loadu_pd(a + i), m);
+  }
+  double lanes[2];
+  _mm_storeu_pd(lanes, m);
+  double out = kernel_max_scalar(lanes, 2);
+  for (; i < n; i++) {
+    out = a[i] > out ? a[i] : out;
+  }
+  return out;
+}
+
+__attribute__((target("sse2"))) static void kernel_scale_sse2(double* a, size_t n, double k) {
+  __m128d f = _mm_set1_pd(k);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(a + i, _mm_mul_pd(_mm_loadu_pd(a + i), f));
+  }
+  for (; i < n; i++) {
+    a[i] *= k;
+  }
+}
+
+__attribute__((target("sse2"))) static void kernel_add_sse2(double* a, const double* b, size_t n) {
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(a + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+  }
+  for (; i < n; i++) {
+    a[i] += b[i];
+  }
+}
+
+__attribute__((target("avx2"))) static double kernel_hsum_avx(__m256d v) {
+  __m128d lo = _mm256_castpd256_pd128(v);
+  __m128d hi = _mm256_extractf128_pd(v, 1);
+  lo = _mm_add_pd(lo, hi);
+  double lanes[2];
+  _mm_storeu_pd(lanes, lo);
+  return lanes[0] + lanes[1];
+}
+
+__attribute__((target("avx2"))) static double kernel_sum_avx2(const double* a, size_t n) {
+  __m256d acc0 = _mm256_setzero_pd();
+  __m256d acc1 = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(a + i));
+    acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(a + i + 4));
+  }
+  double total = kernel_hsum_avx(_mm256_add_pd(acc0, acc1));
+  for (; i < n; i++) {
+    total += a[i];
+  }
+  return total;
+}
+
+__attribute__((target("avx2"))) static double kernel_dot_avx2(const double* a, const double* b, size_t n) {
+  __m256d acc0 = _mm256_setzero_pd();
+  __m256d acc1 = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+  }
+  double total = kernel_hsum_avx(_mm256_add_pd(acc0, acc1));
+  for (; i < n; i++) {
+    total += a[i] * b[i];
+  }
+  return total;
+}
+
+__attribute__((target("avx2"))) static double kernel_min_avx2(const double* a, size_t n) {
+  if (n < 5) {
+    return kernel_min_scalar(a, n);
+  }
+  __m256d m = _mm256_set1_pd(a[0]);
+  size_t i = 1;
+  for (; i + 4 <= n; i += 4) {
+    m = _mm256_min_pd(_mm256_loadu_pd(a + i), m);
+  }
+  double lanes[4];
+  _mm256_storeu_pd(lanes, m);
+  double out = kernel_min_scalar(lanes, 4);
+  for (; i < n; i++) {
+    out = a[i] < out ? a[i] : out;
+  }
+  return out;
+}
+
+__attribute__((target("avx2"))) static double kernel_max_avx2(const double* a, size_t n) {
+  if (n < 5) {
+    return kernel_max_scalar(a, n);
+  }
+  __m256d m = _mm256_set1_pd(a[0]);
+  size_t i = 1;
+  for (; i + 4 <= n; i += 4) {
+    m = _mm256_max_pd(_mm256_loadu_pd(a + i), m);
+  }
+  double lanes[4];
+  _mm256_storeu_pd(lanes, m);
+  double out = kernel_max_scalar(lanes, 4);
+  for (; i < n; i++) {
+    out = a[i] > out ? a[i] : out;
+  }
+  return out;
+}
+
+__attribute__((target("avx2"))) static void kernel_scale_avx2(double* a, size_t n, double k) {
+  __m256d f = _mm256_set1_pd(k);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(a + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), f));
+  }
+  for (; i < n; i++) {
+    a[i] *= k;
+  }
+}
+
+__attribute__((target("avx2"))) static void kernel_add_avx2(double* a, const double* b, size_t n) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(a + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+  }
+  for (; i < n; i++) {
+    a[i] += b[i];
+  }
+}
+#endif
+
+static const RexVecKernels* vec_kernels(void) {
+  static const RexVecKernels scalar = {
+    kernel_sum_scalar, kernel_dot_scalar, kernel_min_scalar, kernel_max_scalar, kernel_scale_scalar, kernel_add_scalar
+  };
+#ifdef REX_SIMD_X86
+  static const RexVecKernels sse2 = {
+    kernel_sum_sse2, kernel_dot_sse2, kernel_min_sse2, kernel_max_sse2, kernel_scale_sse2, kernel_add_sse2
+  };
+  static const RexVecKernels avx2 = {
+    kernel_sum_avx2, kernel_dot_avx2, kernel_min_avx2, kernel_max_avx2, kernel_scale_avx2, kernel_add_avx2
+  };
+  // Threads racing on first use all pick the same table; the atomics keep
+  // the publication well-defined.
+  static const RexVecKernels* chosen = NULL;
+  const RexVecKernels* pick = __atomic_load_n(&chosen, __ATOMIC_ACQUIRE);
+  if (!pick) {
+    const char* force = getenv("REX_SIMD");
+    __builtin_cpu_init();
+    if (force && strcmp(force, "scalar") == 0) {
+      pick = &scalar;
+    } else if ((!force || strcmp(force, "sse2") != 0) && __builtin_cpu_supports("avx2")) {
+      pick = &avx2;
+    } else if (__builtin_cpu_supports("sse2")) {
+      pick = &sse2;
+    } else {
+      pick = &scalar;
+    }
+    __atomic_store_n(&chosen, pick, __ATOMIC_RELEASE);
   }
+  return pick;
+#else
+  return &scalar;
+#endif
+}
 
-  RexVec* v = (RexVec*)vec.as.ptr;
-  for (int i = 0, j = v->count - 1; i < j; ++i, --j) {
-    RexValue tmp = v->items[i];
-    v->items[i] = v->items[j];
-    v->items[j] = tmp;
+static RexValue vec_reduce(RexValue vec, int op, const char* msg) {
+  RexVec* v = vec_expect(vec, 0, msg);
+  if (!v) {
+    return rex_nil();
   }
-  return vec;
+  if (op != 0 && v->count == 0) {
+    return rex_nil();
+  }
+  if (v->kind == REX_VEC_F64) {
+    const RexVecKernels* k = vec_kernels();
+    const double* a = (const double*)v->data;
+    size_t n = (size_t)v->count;
+    return rex_num(op == 0 ? (n ? k->sum(a, n) : 0) : (op < 0 ? k->min(a, n) : k->max(a, n)));
+  }
+  if (vec_is_int(v)) {
+    // Integer vectors reduce exactly; sums wrap like rex_int_add.
+    int unsig = v->kind == REX_VEC_U64;
+    int64_t out = op == 0 ? 0 : vec_load_i64(v, 0);
+    for (int i = op == 0 ? 0 : 1; i < v->count; i++) {
+      int64_t x = vec_load_i64(v, i);
+      if (op == 0) {
+        out = rex_int_add(out, x);
+      } else if (unsig ? (op < 0 ? (uint64_t)x < (uint64_t)out : (uint64_t)x > (uint64_t)out)
+                       : (op < 0 ? x < out : x > out)) {
+        out = x;
+      }
+    }
+    return unsig ? rex_uint((uint64_t)out) : rex_int(out);
+  }
+  double out = op == 0 ? 0 : vec_load_f64(v, 0);
+  for (int i = op == 0 ? 0 : 1; i < v->count; i++) {
+    double x = vec_load_f64(v, i);
+    if (op == 0) {
+      out += x;
+    } else if (op < 0 ? x < out : x > out) {
+      out = x;
+    }
+  }
+  return rex_num(out);
 }
 
-RexValue rex_collections_vec_first(RexValue vec) {
-  vec = rex_resolve(vec);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
-    rex_panic("vec_first expects vector");
+RexValue rex_collections_vec_sum(RexValue vec) {
+  return vec_reduce(vec, 0, "vec_sum expects vector");
+}
+
+RexValue rex_collections_vec_min(RexValue vec) {
+  return vec_reduce(vec, -1, "vec_min expects vector");
+}
+
+RexValue rex_collections_vec_max(RexValue vec) {
+  return vec_reduce(vec, 1, "vec_max expects vector");
+}
+
+RexValue rex_collections_vec_dot(RexValue a, RexValue b) {
+  RexVec* va = vec_expect(a, 0, "vec_dot expects vectors");
+  RexVec* vb = vec_expect(b, 0, "vec_dot expects vectors");
+  if (!va || !vb) {
     return rex_nil();
   }
-
-  RexVec* v = (RexVec*)vec.as.ptr;
-  if (v->count <= 0) {
+  if (va->count != vb->count) {
+    rex_panic("vec_dot expects vectors of equal length");
     return rex_nil();
   }
-  return v->items[0];
+  if (va->kind == REX_VEC_F64 && vb->kind == REX_VEC_F64) {
+    return rex_num(vec_kernels()->dot((const double*)va->data, (const double*)vb->data, (size_t)va->count));
+  }
+  if (vec_is_int(va) && vec_is_int(vb)) {
+    int64_t sum = 0;
+    for (int i = 0; i < va->count; i++) {
+      sum = rex_int_add(sum, rex_int_mul(vec_load_i64(va, i), vec_load_i64(vb, i)));
+    }
+    return va->kind == REX_VEC_U64 || vb->kind == REX_VEC_U64 ? rex_uint((uint64_t)sum) : rex_int(sum);
+  }
+  double total = 0;
+  for (int i = 0; i < va->count; i++) {
+    total += vec_load_f64(va, i) * vec_load_f64(vb, i);
+  }
+  return rex_num(total);
 }
 
-RexValue rex_collections_vec_last(RexValue vec) {
-  vec = rex_resolve(vec);
-  if (vec.tag != REX_VEC || !vec.as.ptr) {
-    rex_panic("vec_last expects vector");
+RexValue rex_collections_vec_scale(RexValue vec, RexValue factor) {
+  RexVec* v = vec_expect(vec, 1, "vec_scale expects vector");
+  if (!v) {
     return rex_nil();
   }
-
-  RexVec* v = (RexVec*)vec.as.ptr;
-  if (v->count <= 0) {
+  factor = rex_resolve(factor);
+  if (vec_is_int(v) && rex_value_tag(factor) == REX_NUM && rex_num_repr(factor) != REX_NUM_F64) {
+    int64_t f = rex_as_int(factor);
+    for (int i = 0; i < v->count; i++) {
+      vec_store_i64(v, i, rex_int_mul(vec_load_i64(v, i), f));
+    }
+    return rex_nil();
+  }
+  double k = vec_expect_num(factor);
+  if (v->kind == REX_VEC_F64) {
+    vec_kernels()->scale((double*)v->data, (size_t)v->count, k);
     return rex_nil();
   }
-  return v->items[v->count - 1];
+  for (int i = 0; i < v->count; i++) {
+    vec_store_f64(v, i, vec_load_f64(v, i) * k);
+  }
+  return rex_nil();
 }
 
-RexValue rex_collections_vec_join(RexValue vec, RexValue sep) {
-  return rex_join_vec_impl(vec, sep, "vec_join expects vector");
+RexValue rex_collections_vec_add(RexValue vec, RexValue other) {
+  RexVec* v = vec_expect(vec, 1, "vec_add expects vectors");
+  RexVec* o = vec_expect(other, 0, "vec_add expects vectors");
+  if (!v || !o) {
+    return rex_nil();
+  }
+  if (v->count != o->count) {
+    rex_panic("vec_add expects vectors of equal length");
+    return rex_nil();
+  }
+  if (v->kind == REX_VEC_F64 && o->kind == REX_VEC_F64) {
+    vec_kernels()->add((double*)v->data, (const double*)o->data, (size_t)v->count);
+    return rex_nil();
+  }
+  if (vec_is_int(v) && vec_is_int(o)) {
+    for (int i = 0; i < v->count; i++) {
+      vec_store_i64(v, i, rex_int_add(vec_load_i64(v, i), vec_load_i64(o, i)));
+    }
+    return rex_nil();
+  }
+  for (int i = 0; i < v->count; i++) {
+    vec_store_f64(v, i, vec_load_f64(v, i) + vec_load_f64(o, i));
+  }
+  return rex_nil();
 }
 
 static RexValue rex_string_get(RexValue str, RexValue index) {
   str = rex_resolve(str);
   index = rex_resolve(index);
-  if (str.tag != REX_STR) {
+  if (rex_value_tag(str) != REX_STR) {
     rex_panic("string index expects string");
     return rex_nil();
   }
-  if (index.tag != REX_NUM) {
+  if (rex_value_tag(index) != REX_NUM) {
     rex_panic("string index expects numeric index");
     return rex_nil();
   }
-  const char* s = str.as.str ? str.as.str : "";
-  int len = (int)strlen(s);
-  int idx = (int)index.as.num;
+  const char* s = rex_str_bytes(&str);
+  int len = (int)rex_str_size(&str);
+  int idx = (int)rex_as_num(index);
   if (idx < 0 || idx >= len) {
     rex_panic("string index out of range");
     return rex_nil();
   }
-  char out[2];
-  out[0] = s[idx];
-  out[1] = '\0';
-  return rex_str(out);
+  return rex_str_n(s + idx, 1);
 }
 
 static RexValue rex_string_slice(RexValue str, RexValue start, RexValue finish) {
   str = rex_resolve(str);
   start = rex_resolve(start);
   finish = rex_resolve(finish);
-  if (str.tag != REX_STR) {
+  if (rex_value_tag(str) != REX_STR) {
     rex_panic("string slice expects string");
     return rex_nil();
   }
-  if (start.tag != REX_NUM) {
+  if (rex_value_tag(start) != REX_NUM) {
     rex_panic("string slice expects numeric start");
     return rex_nil();
   }
-  const char* s = str.as.str ? str.as.str : "";
-  int len = (int)strlen(s);
-  int from = (int)start.as.num;
+  const char* s = rex_str_bytes(&str);
+  int len = (int)rex_str_size(&str);
+  int from = (int)rex_as_num(start);
   int to = len;
-  if (finish.tag != REX_NIL) {
-    if (finish.tag != REX_NUM) {
+  if (rex_value_tag(finish) != REX_NIL) {
+    if (rex_value_tag(finish) != REX_NUM) {
       rex_panic("string slice expects numeric end");
       return rex_nil();
     }
-    to = (int)finish.as.num;
+    to = (int)rex_as_num(finish);
   }
   if (from < 0) {
     from = 0;
@@ -3082,42 +5693,195 @@ static RexValue rex_string_slice(RexValue str, RexValue start, RexValue finish)
   if (to > len) {
     to = len;
   }
-  int out_len = to - from;
-  char* out = (char*)rex_xmalloc((size_t)out_len + 1u);
-  if (out_len > 0) {
-    memcpy(out, s + from, (size_t)out_len);
-  }
-  out[out_len] = '\0';
-  RexValue value = rex_str(out);
-  free(out);
-  return value;
+  return rex_str_view(&str, s + from, (size_t)(to - from));
 }
 
 RexValue rex_collections_vec_from(int count, RexValue* values) {
-  RexVec* v = (RexVec*)rex_xmalloc(sizeof(RexVec));
-  v->count = count;
-  v->capacity = count;
-  if (count == 0) {
-    v->items = NULL;
-  } else {
-    v->items = (RexValue*)rex_xmalloc(sizeof(RexValue) * (size_t)count);
+  return rex_collections_vec_from_typed(REX_VEC_VALUE, count, values);
+}
+
+RexValue rex_collections_vec_from_typed(int kind, int count, RexValue* values) {
+  RexVec* v = vec_alloc(kind);
+  if (count > 0) {
+    vec_reserve(v, count);
     for (int i = 0; i < count; i++) {
-      v->items[i] = values[i];
+      vec_store(v, i, values[i]);
     }
+    v->count = count;
   }
-  RexValue out;
-  out.tag = REX_VEC;
-  out.as.ptr = v;
-  return out;
+  return vec_value(v);
+}
+
+// Vectors shift or append elements only by changing count, so their views
+// watch a modification counter that never moves.
+static const unsigned rex_vec_no_mods = 0;
+
+RexVecView rex_collections_vec_view(RexValue vec) {
+  RexVecView view = { NULL, 0, REX_VEC_VALUE, NULL, NULL, 0, &rex_vec_no_mods };
+  RexVec* v = vec_expect(vec, 0, "for-in expects vector");
+  if (v) {
+    view.data = vec_bytes(v);
+    view.count = v->count;
+    view.kind = v->kind;
+    view.live_count = &v->count;
+    view.live_data = v->kind == REX_VEC_VALUE ? (const void* const*)&v->items : (const void* const*)&v->data;
+  }
+  return view;
+}
+
+RexVecView rex_collections_set_view(RexValue set) {
+  RexVecView view = { NULL, 0, REX_VEC_VALUE, NULL, NULL, 0, &rex_vec_no_mods };
+  set = rex_resolve(set);
+  if (rex_value_tag(set) != REX_SET || !rex_as_ptr(set)) {
+    rex_panic("for-in expects set");
+    return view;
+  }
+  RexSet* s = (RexSet*)rex_as_ptr(set);
+  view.data = s->items;
+  view.count = s->count;
+  view.live_count = &s->count;
+  view.live_data = (const void* const*)&s->items;
+  view.mods = s->mods;
+  view.live_mods = &s->mods;
+  return view;
+}
+
+RexMapView rex_collections_map_view(RexValue map) {
+  RexMapView view = { NULL, sizeof(RexMapEntry), offsetof(RexMapEntry, value), offsetof(RexMapEntry, removed), 0, 0, NULL, NULL };
+  map = rex_resolve(map);
+  if (rex_value_tag(map) != REX_MAP || !rex_as_ptr(map)) {
+    rex_panic("for-in expects map");
+    return view;
+  }
+  RexMap* m = (RexMap*)rex_as_ptr(map);
+  view.entries = (const char*)m->items;
+  view.count = m->used;
+  view.mods = m->mods;
+  view.live_mods = &m->mods;
+  view.live_entries = (const void* const*)&m->items;
+  return view;
+}
+
+RexValue rex_collections_vec_bytes(RexValue vec) {
+  RexVec* v = vec_expect(vec, 0, "vec_bytes expects vector");
+  if (!v) {
+    return rex_num(0);
+  }
+  return rex_num((double)(sizeof(RexVec) + vec_elem_size(v) * (size_t)v->capacity));
+}
+
+#define REX_HASH_INDEX_MIN 8
+
+static void hash_index_reset(const void* owner, RexHashIndex* idx, int capacity) {
+  rex_xfree(idx->slots);
+  idx->slots = (RexHashSlot*)rex_xmalloc_for(owner, sizeof(RexHashSlot) * (size_t)capacity);
+  idx->capacity = capacity;
+  for (int i = 0; i < capacity; i++) {
+    idx->slots[i].hash = 0;
+    idx->slots[i].index = -1;
+  }
+}
+
+static void hash_index_insert(RexHashIndex* idx, uint32_t hash, int32_t index) {
+  uint32_t mask = (uint32_t)idx->capacity - 1;
+  uint32_t pos = hash & mask;
+  while (idx->slots[pos].index >= 0) {
+    pos = (pos + 1) & mask;
+  }
+  idx->slots[pos].hash = hash;
+  idx->slots[pos].index = index;
+}
+
+static int hash_index_slot_of(RexHashIndex* idx, uint32_t hash, int32_t index) {
+  uint32_t mask = (uint32_t)idx->capacity - 1;
+  uint32_t pos = hash & mask;
+  while (idx->slots[pos].index >= 0) {
+    if (idx->slots[pos].index == index) {
+      return (int)pos;
+    }
+    pos = (pos + 1) & mask;
+  }
+  return -1;
+}
+
+static void hash_index_remove_at(RexHashIndex* idx, uint32_t pos) {
+  uint32_t mask = (uint32_t)idx->capacity - 1;
+  uint32_t hole = pos;
+  uint32_t next = (pos + 1) & mask;
+  while (idx->slots[next].index >= 0) {
+    uint32_t home = idx->slots[next].hash & mask;
+    if (((next - home) & mask) >= ((next - hole) & mask)) {
+      idx->slots[hole] = idx->slots[next];
+      hole = next;
+    }
+    next = (next + 1) & mask;
+  }
+  idx->slots[hole].index = -1;
+}
+
+static int hash_index_capacity_for(int count) {
+  int capacity = 16;
+  while (capacity < count * 2) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+static void map_index_rebuild(RexMap* m) {
+  if (m->count < REX_HASH_INDEX_MIN) {
+    rex_xfree(m->index.slots);
+    m->index.slots = NULL;
+    m->index.capacity = 0;
+    return;
+  }
+  hash_index_reset(m, &m->index, hash_index_capacity_for(m->count));
+  for (int i = 0; i < m->used; i++) {
+    if (!m->items[i].removed) {
+      hash_index_insert(&m->index, m->items[i].hash, i);
+    }
+  }
+}
+
+static void map_compact(RexMap* m) {
+  int out = 0;
+  for (int i = 0; i < m->used; i++) {
+    if (!m->items[i].removed) {
+      m->items[out++] = m->items[i];
+    }
+  }
+  m->used = out;
+  m->mods++;
+  map_index_rebuild(m);
+}
+
+static int map_find(RexMap* m, RexValue key, uint32_t hash) {
+  if (!m->index.slots) {
+    for (int i = 0; i < m->used; i++) {
+      if (m->items[i].hash == hash && !m->items[i].removed && rex_value_eq(m->items[i].key, key)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+  uint32_t mask = (uint32_t)m->index.capacity - 1;
+  uint32_t pos = hash & mask;
+  while (m->index.slots[pos].index >= 0) {
+    RexHashSlot slot = m->index.slots[pos];
+    if (slot.hash == hash && rex_value_eq(m->items[slot.index].key, key)) {
+      return slot.index;
+    }
+    pos = (pos + 1) & mask;
+  }
+  return -1;
 }
 
 static void map_grow(RexMap* m) {
   if (m->capacity == 0) {
     m->capacity = 4;
-    m->items = (RexMapEntry*)rex_xmalloc(sizeof(RexMapEntry) * (size_t)m->capacity);
-  } else if (m->count >= m->capacity) {
+    m->items = (RexMapEntry*)rex_xmalloc_for(m, sizeof(RexMapEntry) * (size_t)m->capacity);
+  } else if (m->used >= m->capacity) {
     m->capacity *= 2;
-    m->items = (RexMapEntry*)realloc(m->items, sizeof(RexMapEntry) * (size_t)m->capacity);
+    m->items = (RexMapEntry*)rex_xrealloc(m->items, sizeof(RexMapEntry) * (size_t)m->capacity);
     if (!m->items) {
       rex_panic("map realloc failed");
     }
@@ -3128,56 +5892,157 @@ RexValue rex_collections_map_new(void) {
   RexMap* m = (RexMap*)rex_xmalloc(sizeof(RexMap));
   m->items = NULL;
   m->count = 0;
+  m->used = 0;
   m->capacity = 0;
-  RexValue out;
-  out.tag = REX_MAP;
-  out.as.ptr = m;
+  m->mods = 0;
+  m->index.slots = NULL;
+  m->index.capacity = 0;
+  m->shared = NULL;
+  return rex_value_make(REX_MAP, m);
+}
+
+static void map_unshare(RexMap* m) {
+  int* shared = m->shared;
+  m->shared = NULL;
+  if (__atomic_load_n(shared, __ATOMIC_ACQUIRE) == 0) {
+    rex_xfree(shared);
+    return;
+  }
+  RexMapEntry* items = m->items;
+  RexHashSlot* slots = m->index.slots;
+  m->items = (RexMapEntry*)rex_xmalloc_for(m, sizeof(RexMapEntry) * (size_t)m->capacity);
+  memcpy(m->items, items, sizeof(RexMapEntry) * (size_t)m->used);
+  if (slots) {
+    m->index.slots = (RexHashSlot*)rex_xmalloc_for(m, sizeof(RexHashSlot) * (size_t)m->index.capacity);
+    memcpy(m->index.slots, slots, sizeof(RexHashSlot) * (size_t)m->index.capacity);
+  }
+  if (rex_shared_release(shared)) {
+    rex_xfree(items);
+    rex_xfree(slots);
+  }
+}
+
+RexValue rex_collections_map_clone(RexValue map) {
+  map = rex_resolve(map);
+  if (rex_value_tag(map) != REX_MAP || !rex_as_ptr(map)) {
+    rex_panic("map_clone expects map");
+    return rex_nil();
+  }
+  RexMap* m = (RexMap*)rex_as_ptr(map);
+  RexValue out = rex_collections_map_new();
+  if (m->capacity == 0) {
+    return out;
+  }
+  RexMap* c = (RexMap*)rex_as_ptr(out);
+  c->shared = rex_shared_retain(m, &m->shared);
+  c->items = m->items;
+  c->count = m->count;
+  c->used = m->used;
+  c->mods = 0;
+  c->capacity = m->capacity;
+  c->index = m->index;
   return out;
 }
 
+// Bond rollback support: snapshot takes an O(1) clone of a vector or map
+// before its first write inside a bond, and restore moves the snapshot's
+// storage back into the original handle, which other bond actions may
+// still refer to.
+RexValue rex_collections_snapshot(RexValue value) {
+  value = rex_resolve(value);
+  if (rex_value_tag(value) == REX_VEC) {
+    return rex_collections_vec_clone(value);
+  }
+  if (rex_value_tag(value) == REX_MAP) {
+    return rex_collections_map_clone(value);
+  }
+  return rex_nil();
+}
+
+void rex_collections_restore(RexValue target, RexValue snapshot) {
+  target = rex_resolve(target);
+  snapshot = rex_resolve(snapshot);
+  if (rex_value_tag(target) != rex_value_tag(snapshot) || !rex_as_ptr(target) || !rex_as_ptr(snapshot)) {
+    return;
+  }
+  if (rex_value_tag(target) == REX_VEC) {
+    RexVec* t = (RexVec*)rex_as_ptr(target);
+    RexVec* s = (RexVec*)rex_as_ptr(snapshot);
+    if (!t->shared || rex_shared_release(t->shared)) {
+      rex_xfree(t->items);
+      rex_xfree(t->data);
+    }
+    t->items = s->items;
+    t->data = s->data;
+    t->count = s->count;
+    t->capacity = s->capacity;
+    t->shared = s->shared;
+    rex_xfree(s);
+  } else if (rex_value_tag(target) == REX_MAP) {
+    RexMap* t = (RexMap*)rex_as_ptr(target);
+    RexMap* s = (RexMap*)rex_as_ptr(snapshot);
+    if (!t->shared || rex_shared_release(t->shared)) {
+      rex_xfree(t->items);
+      rex_xfree(t->index.slots);
+    }
+    unsigned mods = t->mods;
+    *t = *s;
+    t->mods = mods + 1;
+    rex_xfree(s);
+  }
+}
+
 void rex_collections_map_put(RexValue map, RexValue key, RexValue value) {
   map = rex_resolve_mut(map);
-  if (map.tag != REX_MAP || !map.as.ptr) {
+  if (rex_value_tag(map) != REX_MAP || !rex_as_ptr(map)) {
     rex_panic("map_put expects map");
     return;
   }
-  RexMap* m = (RexMap*)map.as.ptr;
-  for (int i = 0; i < m->count; i++) {
-    if (rex_value_eq(m->items[i].key, key)) {
-      m->items[i].value = value;
-      return;
-    }
+  RexMap* m = (RexMap*)rex_as_ptr(map);
+  uint32_t hash = rex_value_hash(key);
+  int found = map_find(m, key, hash);
+  if (found >= 0) {
+    m->items[found].value = value;
+    return;
   }
   map_grow(m);
-  m->items[m->count].key = key;
-  m->items[m->count].value = value;
+  m->items[m->used].key = key;
+  m->items[m->used].value = value;
+  m->items[m->used].hash = hash;
+  m->items[m->used].removed = 0;
+  m->used += 1;
   m->count += 1;
+  m->mods++;
+  if (m->index.slots && m->count * 2 <= m->index.capacity) {
+    hash_index_insert(&m->index, hash, m->used - 1);
+  } else if (m->count >= REX_HASH_INDEX_MIN) {
+    map_index_rebuild(m);
+  }
 }
 
 RexValue rex_collections_map_get(RexValue map, RexValue key) {
   map = rex_resolve(map);
-  if (map.tag != REX_MAP || !map.as.ptr) {
+  if (rex_value_tag(map) != REX_MAP || !rex_as_ptr(map)) {
     rex_panic("map_get expects map");
     return rex_nil();
   }
-  RexMap* m = (RexMap*)map.as.ptr;
-  for (int i = 0; i < m->count; i++) {
-    if (rex_value_eq(m->items[i].key, key)) {
-      return m->items[i].value;
-    }
+  RexMap* m = (RexMap*)rex_as_ptr(map);
+  int found = map_find(m, key, rex_value_hash(key));
+  if (found >= 0) {
+    return m->items[found].value;
   }
   return rex_nil();
 }
 
 RexValue rex_collections_get(RexValue object, RexValue index) {
   object = rex_resolve(object);
-  if (object.tag == REX_VEC) {
+  if (rex_value_tag(object) == REX_VEC) {
     return rex_collections_vec_get(object, index);
   }
-  if (object.tag == REX_MAP) {
+  if (rex_value_tag(object) == REX_MAP) {
     return rex_collections_map_get(object, index);
   }
-  if (object.tag == REX_STR) {
+  if (rex_value_tag(object) == REX_STR) {
     return rex_string_get(object, index);
   }
   rex_panic("index expects vector, map, or string");
@@ -3186,10 +6051,10 @@ RexValue rex_collections_get(RexValue object, RexValue index) {
 
 RexValue rex_collections_slice(RexValue object, RexValue start, RexValue finish) {
   object = rex_resolve(object);
-  if (object.tag == REX_VEC) {
+  if (rex_value_tag(object) == REX_VEC) {
     return rex_collections_vec_slice(object, start, finish);
   }
-  if (object.tag == REX_STR) {
+  if (rex_value_tag(object) == REX_STR) {
     return rex_string_slice(object, start, finish);
   }
   rex_panic("slice expects vector or string");
@@ -3198,11 +6063,11 @@ RexValue rex_collections_slice(RexValue object, RexValue start, RexValue finish)
 
 void rex_collections_set(RexValue object, RexValue index, RexValue value) {
   object = rex_resolve_mut(object);
-  if (object.tag == REX_VEC) {
+  if (rex_value_tag(object) == REX_VEC) {
     rex_collections_vec_set(object, index, value);
     return;
   }
-  if (object.tag == REX_MAP) {
+  if (rex_value_tag(object) == REX_MAP) {
     rex_collections_map_put(object, index, value);
     return;
   }
@@ -3211,77 +6076,87 @@ void rex_collections_set(RexValue object, RexValue index, RexValue value) {
 
 RexValue rex_collections_map_remove(RexValue map, RexValue key) {
   map = rex_resolve_mut(map);
-  if (map.tag != REX_MAP || !map.as.ptr) {
+  if (rex_value_tag(map) != REX_MAP || !rex_as_ptr(map)) {
     rex_panic("map_remove expects map");
     return rex_bool(0);
   }
-  RexMap* m = (RexMap*)map.as.ptr;
-  for (int i = 0; i < m->count; i++) {
-    if (rex_value_eq(m->items[i].key, key)) {
-      for (int j = i + 1; j < m->count; j++) {
-        m->items[j - 1] = m->items[j];
-      }
-      m->count -= 1;
-      return rex_bool(1);
-    }
+  RexMap* m = (RexMap*)rex_as_ptr(map);
+  uint32_t hash = rex_value_hash(key);
+  int found = map_find(m, key, hash);
+  if (found < 0) {
+    return rex_bool(0);
   }
-  return rex_bool(0);
+  if (m->index.slots) {
+    hash_index_remove_at(&m->index, (uint32_t)hash_index_slot_of(&m->index, hash, found));
+  }
+  m->items[found].removed = 1;
+  m->count -= 1;
+  m->mods++;
+  while (m->used > 0 && m->items[m->used - 1].removed) {
+    m->used -= 1;
+  }
+  if (m->used - m->count > m->count) {
+    map_compact(m);
+  }
+  return rex_bool(1);
 }
 
 RexValue rex_collections_map_has(RexValue map, RexValue key) {
   map = rex_resolve(map);
-  if (map.tag != REX_MAP || !map.as.ptr) {
+  if (rex_value_tag(map) != REX_MAP || !rex_as_ptr(map)) {
     rex_panic("map_has expects map");
     return rex_bool(0);
   }
-  RexMap* m = (RexMap*)map.as.ptr;
-  for (int i = 0; i < m->count; i++) {
-    if (rex_value_eq(m->items[i].key, key)) {
-      return rex_bool(1);
-    }
-  }
-  return rex_bool(0);
+  RexMap* m = (RexMap*)rex_as_ptr(map);
+  return rex_bool(map_find(m, key, rex_value_hash(key)) >= 0);
 }
 
 RexValue rex_collections_map_keys(RexValue map) {
   map = rex_resolve(map);
-  if (map.tag != REX_MAP || !map.as.ptr) {
+  if (rex_value_tag(map) != REX_MAP || !rex_as_ptr(map)) {
     rex_panic("map_keys expects map");
     return rex_nil();
   }
-  RexMap* m = (RexMap*)map.as.ptr;
+  RexMap* m = (RexMap*)rex_as_ptr(map);
   RexValue keys = rex_collections_vec_new();
-  for (int i = 0; i < m->count; i++) {
-    rex_collections_vec_push(keys, m->items[i].key);
+  for (int i = 0; i < m->used; i++) {
+    if (!m->items[i].removed) {
+      rex_collections_vec_push(keys, m->items[i].key);
+    }
   }
   return keys;
 }
 
 RexValue rex_collections_map_values(RexValue map) {
   map = rex_resolve(map);
-  if (map.tag != REX_MAP || !map.as.ptr) {
+  if (rex_value_tag(map) != REX_MAP || !rex_as_ptr(map)) {
     rex_panic("map_values expects map");
     return rex_nil();
   }
 
-  RexMap* m = (RexMap*)map.as.ptr;
+  RexMap* m = (RexMap*)rex_as_ptr(map);
   RexValue values = rex_collections_vec_new();
-  for (int i = 0; i < m->count; ++i) {
-    rex_collections_vec_push(values, m->items[i].value);
+  for (int i = 0; i < m->used; ++i) {
+    if (!m->items[i].removed) {
+      rex_collections_vec_push(values, m->items[i].value);
+    }
   }
   return values;
 }
 
 RexValue rex_collections_map_items(RexValue map) {
   map = rex_resolve(map);
-  if (map.tag != REX_MAP || !map.as.ptr) {
+  if (rex_value_tag(map) != REX_MAP || !rex_as_ptr(map)) {
     rex_panic("map_items expects map");
     return rex_nil();
   }
 
-  RexMap* m = (RexMap*)map.as.ptr;
+  RexMap* m = (RexMap*)rex_as_ptr(map);
   RexValue items = rex_collections_vec_new();
-  for (int i = 0; i < m->count; ++i) {
+  for (int i = 0; i < m->used; ++i) {
+    if (m->items[i].removed) {
+      continue;
+    }
     RexValue pair_values[2];
     pair_values[0] = m->items[i].key;
     pair_values[1] = m->items[i].value;
@@ -3292,95 +6167,249 @@ RexValue rex_collections_map_items(RexValue map) {
 
 RexValue rex_collections_map_len(RexValue map) {
   map = rex_resolve(map);
-  if (map.tag != REX_MAP || !map.as.ptr) {
+  if (rex_value_tag(map) != REX_MAP || !rex_as_ptr(map)) {
     rex_panic("map_len expects map");
     return rex_num(0);
   }
 
-  RexMap* m = (RexMap*)map.as.ptr;
+  RexMap* m = (RexMap*)rex_as_ptr(map);
   return rex_num((double)m->count);
 }
 
-static void set_grow(RexSet* s) {
-  if (s->capacity == 0) {
-    s->capacity = 4;
-    s->items = (RexValue*)rex_xmalloc(sizeof(RexValue) * (size_t)s->capacity);
-  } else if (s->count >= s->capacity) {
-    s->capacity *= 2;
-    s->items = (RexValue*)realloc(s->items, sizeof(RexValue) * (size_t)s->capacity);
-    if (!s->items) {
-      rex_panic("set realloc failed");
+static void set_reserve(RexSet* s, int needed) {
+  if (needed <= s->capacity) {
+    return;
+  }
+  int capacity = s->capacity == 0 ? 4 : s->capacity;
+  while (capacity < needed) {
+    capacity *= 2;
+  }
+  s->items = (RexValue*)rex_xrealloc_for(s, s->items, sizeof(RexValue) * (size_t)capacity);
+  s->hashes = (uint32_t*)rex_xrealloc_for(s, s->hashes, sizeof(uint32_t) * (size_t)capacity);
+  if (!s->items || !s->hashes) {
+    rex_panic("set realloc failed");
+  }
+  s->capacity = capacity;
+}
+
+static void set_index_rebuild(RexSet* s) {
+  if (s->count < REX_HASH_INDEX_MIN) {
+    rex_xfree(s->index.slots);
+    s->index.slots = NULL;
+    s->index.capacity = 0;
+    return;
+  }
+  hash_index_reset(s, &s->index, hash_index_capacity_for(s->count));
+  for (int i = 0; i < s->count; i++) {
+    hash_index_insert(&s->index, s->hashes[i], i);
+  }
+}
+
+static int set_find(RexSet* s, RexValue value, uint32_t hash) {
+  if (!s->index.slots) {
+    for (int i = 0; i < s->count; i++) {
+      if (s->hashes[i] == hash && rex_value_eq(s->items[i], value)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+  uint32_t mask = (uint32_t)s->index.capacity - 1;
+  uint32_t pos = hash & mask;
+  while (s->index.slots[pos].index >= 0) {
+    RexHashSlot slot = s->index.slots[pos];
+    if (slot.hash == hash && rex_value_eq(s->items[slot.index], value)) {
+      return slot.index;
     }
+    pos = (pos + 1) & mask;
   }
+  return -1;
 }
 
-RexValue rex_collections_set_new(void) {
+static void set_insert_hashed(RexSet* s, RexValue value, uint32_t hash) {
+  if (set_find(s, value, hash) >= 0) {
+    return;
+  }
+  set_reserve(s, s->count + 1);
+  s->items[s->count] = value;
+  s->hashes[s->count] = hash;
+  s->count += 1;
+  s->mods++;
+  if (s->count < REX_HASH_INDEX_MIN) {
+    return;
+  }
+  if (!s->index.slots || s->count * 2 > s->index.capacity) {
+    set_index_rebuild(s);
+  } else {
+    hash_index_insert(&s->index, hash, s->count - 1);
+  }
+}
+
+static RexValue set_value(RexSet* s) {
+  return rex_value_make(REX_SET, s);
+}
+
+static RexSet* set_alloc(void) {
   RexSet* s = (RexSet*)rex_xmalloc(sizeof(RexSet));
   s->items = NULL;
+  s->hashes = NULL;
   s->count = 0;
   s->capacity = 0;
-  RexValue out;
-  out.tag = REX_SET;
-  out.as.ptr = s;
-  return out;
+  s->mods = 0;
+  s->index.slots = NULL;
+  s->index.capacity = 0;
+  return s;
+}
+
+static RexSet* set_expect(RexValue set, const char* message) {
+  set = rex_resolve(set);
+  if (rex_value_tag(set) != REX_SET || !rex_as_ptr(set)) {
+    rex_panic(message);
+    return NULL;
+  }
+  return (RexSet*)rex_as_ptr(set);
+}
+
+RexValue rex_collections_set_new(void) {
+  return set_value(set_alloc());
 }
 
 void rex_collections_set_add(RexValue set, RexValue value) {
   set = rex_resolve_mut(set);
-  if (set.tag != REX_SET || !set.as.ptr) {
+  if (rex_value_tag(set) != REX_SET || !rex_as_ptr(set)) {
     rex_panic("set_add expects set");
     return;
   }
-  RexSet* s = (RexSet*)set.as.ptr;
-  for (int i = 0; i < s->count; i++) {
-    if (rex_value_eq(s->items[i], value)) {
-      return;
-    }
-  }
-  set_grow(s);
-  s->items[s->count++] = value;
+  set_insert_hashed((RexSet*)rex_as_ptr(set), value, rex_value_hash(value));
 }
 
 RexValue rex_collections_set_has(RexValue set, RexValue value) {
   set = rex_resolve(set);
-  if (set.tag != REX_SET || !set.as.ptr) {
+  if (rex_value_tag(set) != REX_SET || !rex_as_ptr(set)) {
     rex_panic("set_has expects set");
     return rex_bool(0);
   }
-  RexSet* s = (RexSet*)set.as.ptr;
-  for (int i = 0; i < s->count; i++) {
-    if (rex_value_eq(s->items[i], value)) {
-      return rex_bool(1);
-    }
-  }
-  return rex_bool(0);
+  RexSet* s = (RexSet*)rex_as_ptr(set);
+  return rex_bool(set_find(s, value, rex_value_hash(value)) >= 0);
 }
 
 RexValue rex_collections_set_remove(RexValue set, RexValue value) {
   set = rex_resolve_mut(set);
-  if (set.tag != REX_SET || !set.as.ptr) {
+  if (rex_value_tag(set) != REX_SET || !rex_as_ptr(set)) {
     rex_panic("set_remove expects set");
     return rex_bool(0);
   }
-  RexSet* s = (RexSet*)set.as.ptr;
-  for (int i = 0; i < s->count; i++) {
-    if (rex_value_eq(s->items[i], value)) {
-      s->items[i] = s->items[s->count - 1];
-      s->count -= 1;
-      return rex_bool(1);
+  RexSet* s = (RexSet*)rex_as_ptr(set);
+  uint32_t hash = rex_value_hash(value);
+  int found = set_find(s, value, hash);
+  if (found < 0) {
+    return rex_bool(0);
+  }
+  int last = s->count - 1;
+  if (s->index.slots) {
+    hash_index_remove_at(&s->index, (uint32_t)hash_index_slot_of(&s->index, hash, found));
+    if (found != last) {
+      int moved = hash_index_slot_of(&s->index, s->hashes[last], last);
+      s->index.slots[moved].index = found;
     }
   }
-  return rex_bool(0);
+  s->items[found] = s->items[last];
+  s->hashes[found] = s->hashes[last];
+  s->count -= 1;
+  s->mods++;
+  return rex_bool(1);
+}
+
+RexValue rex_collections_set_from_vec(RexValue vec) {
+  vec = rex_resolve(vec);
+  if (rex_value_tag(vec) != REX_VEC || !rex_as_ptr(vec)) {
+    rex_panic("set_from_vec expects vector");
+    return rex_nil();
+  }
+  RexVec* v = (RexVec*)rex_as_ptr(vec);
+  RexSet* out = set_alloc();
+  set_reserve(out, v->count);
+  for (int i = 0; i < v->count; i++) {
+    RexValue item = vec_load(v, i);
+    set_insert_hashed(out, item, rex_value_hash(item));
+  }
+  return set_value(out);
+}
+
+RexValue rex_collections_set_union(RexValue a, RexValue b) {
+  RexSet* sa = set_expect(a, "set_union expects sets");
+  RexSet* sb = set_expect(b, "set_union expects sets");
+  if (!sa || !sb) {
+    return rex_nil();
+  }
+  RexSet* out = set_alloc();
+  set_reserve(out, sa->count + sb->count);
+  if (sa->count > 0) {
+    memcpy(out->items, sa->items, sizeof(RexValue) * (size_t)sa->count);
+    memcpy(out->hashes, sa->hashes, sizeof(uint32_t) * (size_t)sa->count);
+  }
+  out->count = sa->count;
+  set_index_rebuild(out);
+  for (int i = 0; i < sb->count; i++) {
+    set_insert_hashed(out, sb->items[i], sb->hashes[i]);
+  }
+  return set_value(out);
+}
+
+RexValue rex_collections_set_intersect(RexValue a, RexValue b) {
+  RexSet* sa = set_expect(a, "set_intersect expects sets");
+  RexSet* sb = set_expect(b, "set_intersect expects sets");
+  if (!sa || !sb) {
+    return rex_nil();
+  }
+  RexSet* out = set_alloc();
+  for (int i = 0; i < sa->count; i++) {
+    if (set_find(sb, sa->items[i], sa->hashes[i]) >= 0) {
+      set_insert_hashed(out, sa->items[i], sa->hashes[i]);
+    }
+  }
+  return set_value(out);
+}
+
+RexValue rex_collections_set_difference(RexValue a, RexValue b) {
+  RexSet* sa = set_expect(a, "set_difference expects sets");
+  RexSet* sb = set_expect(b, "set_difference expects sets");
+  if (!sa || !sb) {
+    return rex_nil();
+  }
+  RexSet* out = set_alloc();
+  for (int i = 0; i < sa->count; i++) {
+    if (set_find(sb, sa->items[i], sa->hashes[i]) < 0) {
+      set_insert_hashed(out, sa->items[i], sa->hashes[i]);
+    }
+  }
+  return set_value(out);
+}
+
+RexValue rex_collections_set_values(RexValue set) {
+  RexSet* s = set_expect(set, "set_values expects set");
+  if (!s) {
+    return rex_nil();
+  }
+  RexValue values = rex_collections_vec_new();
+  RexVec* v = (RexVec*)rex_as_ptr(values);
+  if (s->count > 0) {
+    v->items = (RexValue*)rex_xmalloc(sizeof(RexValue) * (size_t)s->count);
+    memcpy(v->items, s->items, sizeof(RexValue) * (size_t)s->count);
+    v->count = s->count;
+    v->capacity = s->count;
+  }
+  return values;
 }
 
 RexValue rex_collections_set_len(RexValue set) {
   set = rex_resolve(set);
-  if (set.tag != REX_SET || !set.as.ptr) {
+  if (rex_value_tag(set) != REX_SET || !rex_as_ptr(set)) {
     rex_panic("set_len expects set");
     return rex_num(0);
   }
 
-  RexSet* s = (RexSet*)set.as.ptr;
+  RexSet* s = (RexSet*)rex_as_ptr(set);
   return rex_num((double)s->count);
 }
 
@@ -3390,13 +6419,14 @@ static void json_append_hex(RexStrBuilder* sb, unsigned char c) {
   sb_append_str(sb, buf);
 }
 
-static void json_append_string(RexStrBuilder* sb, const char* s) {
+static void json_append_string_n(RexStrBuilder* sb, const char* s, size_t len) {
   sb_append_char(sb, '"');
   if (!s) {
     s = "";
+    len = 0;
   }
-  for (const unsigned char* p = (const unsigned char*)s; *p; p++) {
-    unsigned char c = *p;
+  for (size_t i = 0; i < len; i++) {
+    unsigned char c = (unsigned char)s[i];
     switch (c) {
       case '"': sb_append_str(sb, "\\\""); break;
       case '\\': sb_append_str(sb, "\\\\"); break;
@@ -3415,6 +6445,10 @@ static void json_append_string(RexStrBuilder* sb, const char* s) {
   sb_append_char(sb, '"');
 }
 
+static void json_append_string(RexStrBuilder* sb, const char* s) {
+  json_append_string_n(sb, s, s ? strlen(s) : 0);
+}
+
 static void json_append_indent(RexStrBuilder* sb, int indent, int depth) {
   if (indent <= 0) {
     return;
@@ -3430,24 +6464,24 @@ static int json_encode_value(RexStrBuilder* sb, RexValue v, int depth, int inden
     return 0;
   }
   v = rex_resolve(v);
-  switch (v.tag) {
+  switch (rex_value_tag(v)) {
     case REX_NIL:
       sb_append_str(sb, "null");
       return 1;
     case REX_BOOL:
-      sb_append_str(sb, v.as.boolean ? "true" : "false");
+      sb_append_str(sb, rex_as_bool(v) ? "true" : "false");
       return 1;
     case REX_NUM: {
       char buf[64];
-      snprintf(buf, sizeof(buf), "%.14g", v.as.num);
+      rex_num_print(buf, sizeof(buf), v);
       sb_append_str(sb, buf);
       return 1;
     }
     case REX_STR:
-      json_append_string(sb, v.as.str);
+      json_append_string_n(sb, rex_str_bytes(&v), rex_str_size(&v));
       return 1;
     case REX_VEC: {
-      RexVec* vec = (RexVec*)v.as.ptr;
+      RexVec* vec = (RexVec*)rex_as_ptr(v);
       sb_append_char(sb, '[');
       if (vec && vec->count > 0) {
         if (pretty) {
@@ -3457,7 +6491,7 @@ static int json_encode_value(RexStrBuilder* sb, RexValue v, int depth, int inden
           if (pretty) {
             json_append_indent(sb, indent, depth + 1);
           }
-          if (!json_encode_value(sb, vec->items[i], depth + 1, indent, pretty)) {
+          if (!json_encode_value(sb, vec_load(vec, i), depth + 1, indent, pretty)) {
             return 0;
           }
           if (i < vec->count - 1) {
@@ -3475,18 +6509,26 @@ static int json_encode_value(RexStrBuilder* sb, RexValue v, int depth, int inden
       return 1;
     }
     case REX_MAP: {
-      RexMap* map = (RexMap*)v.as.ptr;
+      RexMap* map = (RexMap*)rex_as_ptr(v);
       sb_append_char(sb, '{');
       if (map && map->count > 0) {
         if (pretty) {
           sb_append_char(sb, '\n');
         }
-        for (int i = 0; i < map->count; i++) {
+        int written = 0;
+        for (int i = 0; i < map->used; i++) {
+          if (map->items[i].removed) {
+            continue;
+          }
           if (pretty) {
             json_append_indent(sb, indent, depth + 1);
           }
-          const char* key = rex_to_cstr(map->items[i].key);
-          json_append_string(sb, key);
+          RexValue key = rex_resolve(map->items[i].key);
+          if (rex_value_tag(key) == REX_STR) {
+            json_append_string_n(sb, rex_str_bytes(&key), rex_str_size(&key));
+          } else {
+            json_append_string(sb, rex_to_cstr(key));
+          }
           sb_append_char(sb, ':');
           if (pretty) {
             sb_append_char(sb, ' ');
@@ -3494,7 +6536,7 @@ static int json_encode_value(RexStrBuilder* sb, RexValue v, int depth, int inden
           if (!json_encode_value(sb, map->items[i].value, depth + 1, indent, pretty)) {
             return 0;
           }
-          if (i < map->count - 1) {
+          if (++written < map->count) {
             sb_append_char(sb, ',');
           }
           if (pretty) {
@@ -3509,7 +6551,7 @@ static int json_encode_value(RexStrBuilder* sb, RexValue v, int depth, int inden
       return 1;
     }
     case REX_STRUCT: {
-      RexStruct* s = (RexStruct*)v.as.ptr;
+      RexStruct* s = (RexStruct*)rex_as_ptr(v);
       sb_append_char(sb, '{');
       if (s && s->count > 0) {
         if (pretty) {
@@ -3524,7 +6566,7 @@ static int json_encode_value(RexStrBuilder* sb, RexValue v, int depth, int inden
           if (pretty) {
             sb_append_char(sb, ' ');
           }
-          if (!json_encode_value(sb, s->values[i], depth + 1, indent, pretty)) {
+          if (!json_encode_value(sb, rex_struct_load(s, i), depth + 1, indent, pretty)) {
             return 0;
           }
           if (i < s->count - 1) {
@@ -3542,7 +6584,7 @@ static int json_encode_value(RexStrBuilder* sb, RexValue v, int depth, int inden
       return 1;
     }
     case REX_TUPLE: {
-      RexTuple* t = (RexTuple*)v.as.ptr;
+      RexTuple* t = (RexTuple*)rex_as_ptr(v);
       sb_append_char(sb, '[');
       if (t && t->count > 0) {
         if (pretty) {
@@ -3583,7 +6625,7 @@ RexValue rex_json_encode(RexValue v) {
     sb_free(&sb);
     return rex_err(rex_str("json encode unsupported"));
   }
-  RexValue out = rex_ok(rex_str(sb.data ? sb.data : ""));
+  RexValue out = rex_ok(rex_str_n(sb.data ? sb.data : "", (size_t)sb.len));
   sb_free(&sb);
   return out;
 }
@@ -3591,11 +6633,11 @@ RexValue rex_json_encode(RexValue v) {
 RexValue rex_json_encode_pretty(RexValue v, RexValue indent) {
   v = rex_resolve(v);
   indent = rex_resolve(indent);
-  if (indent.tag != REX_NUM) {
+  if (rex_value_tag(indent) != REX_NUM) {
     rex_panic("json.encode_pretty expects number indent");
     return rex_err(rex_str("bad indent"));
   }
-  int spaces = (int)indent.as.num;
+  int spaces = (int)rex_as_num(indent);
   if (spaces < 0) {
     spaces = 0;
   }
@@ -3608,7 +6650,7 @@ RexValue rex_json_encode_pretty(RexValue v, RexValue indent) {
     sb_free(&sb);
     return rex_err(rex_str("json encode unsupported"));
   }
-  RexValue out = rex_ok(rex_str(sb.data ? sb.data : ""));
+  RexValue out = rex_ok(rex_str_n(sb.data ? sb.data : "", (size_t)sb.len));
   sb_free(&sb);
   return out;
 }
@@ -3707,7 +6749,7 @@ static RexValue json_parse_string(JsonParser* p) {
   while (p->pos < p->len) {
     char c = p->src[p->pos++];
     if (c == '"') {
-      RexValue out = rex_str(sb.data ? sb.data : "");
+      RexValue out = rex_str_n(sb.data ? sb.data : "", (size_t)sb.len);
       sb_free(&sb);
       return out;
     }
@@ -3879,11 +6921,11 @@ static RexValue json_parse_value(JsonParser* p) {
 
 RexValue rex_json_decode(RexValue s) {
   s = rex_resolve(s);
-  if (s.tag != REX_STR) {
+  if (rex_value_tag(s) != REX_STR) {
     rex_panic("json.decode expects string");
     return rex_err(rex_str("bad input"));
   }
-  const char* src = s.as.str ? s.as.str : "";
+  const char* src = rex_str_data(&s);
   JsonParser p;
   p.src = src;
   p.len = strlen(src);
@@ -3926,9 +6968,9 @@ static void rex_url_free(RexUrlParts* parts) {
   if (!parts) {
     return;
   }
-  free(parts->host);
-  free(parts->port);
-  free(parts->path);
+  rex_xfree(parts->host);
+  rex_xfree(parts->port);
+  rex_xfree(parts->path);
   parts->host = NULL;
   parts->port = NULL;
   parts->path = NULL;
@@ -4127,7 +7169,7 @@ static int rex_http_fetch_socket(const RexUrlParts* parts, RexHttpResponse* out,
     out->status = status;
     out->body = body;
   } else {
-    free(body);
+    rex_xfree(body);
   }
   return 1;
 }
@@ -4312,7 +7354,7 @@ static int rex_http_fetch_openssl(const RexUrlParts* parts, RexHttpResponse* out
     out->status = status;
     out->body = body;
   } else {
-    free(body);
+    rex_xfree(body);
   }
   return 1;
 }
@@ -4341,8 +7383,8 @@ static int rex_http_fetch_winhttp(const RexUrlParts* parts, RexHttpResponse* out
   wchar_t* host_w = rex_utf8_to_wide(parts->host);
   wchar_t* path_w = rex_utf8_to_wide(parts->path);
   if (!host_w || !path_w) {
-    free(host_w);
-    free(path_w);
+    rex_xfree(host_w);
+    rex_xfree(path_w);
     if (err) {
       *err = "winhttp utf8 failed";
     }
@@ -4352,8 +7394,8 @@ static int rex_http_fetch_winhttp(const RexUrlParts* parts, RexHttpResponse* out
   HINTERNET session = WinHttpOpen(L"Rex/1.0", WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
     WINHTTP_NO_PROXY_NAME, WINHTTP_NO_PROXY_BYPASS, 0);
   if (!session) {
-    free(host_w);
-    free(path_w);
+    rex_xfree(host_w);
+    rex_xfree(path_w);
     if (err) {
       *err = "winhttp init failed";
     }
@@ -4364,8 +7406,8 @@ static int rex_http_fetch_winhttp(const RexUrlParts* parts, RexHttpResponse* out
   HINTERNET connect = WinHttpConnect(session, host_w, port, 0);
   if (!connect) {
     WinHttpCloseHandle(session);
-    free(host_w);
-    free(path_w);
+    rex_xfree(host_w);
+    rex_xfree(path_w);
     if (err) {
       *err = "winhttp connect failed";
     }
@@ -4378,8 +7420,8 @@ static int rex_http_fetch_winhttp(const RexUrlParts* parts, RexHttpResponse* out
   if (!request) {
     WinHttpCloseHandle(connect);
     WinHttpCloseHandle(session);
-    free(host_w);
-    free(path_w);
+    rex_xfree(host_w);
+    rex_xfree(path_w);
     if (err) {
       *err = "winhttp request failed";
     }
@@ -4391,8 +7433,8 @@ static int rex_http_fetch_winhttp(const RexUrlParts* parts, RexHttpResponse* out
     WinHttpCloseHandle(request);
     WinHttpCloseHandle(connect);
     WinHttpCloseHandle(session);
-    free(host_w);
-    free(path_w);
+    rex_xfree(host_w);
+    rex_xfree(path_w);
     if (err) {
       *err = "winhttp send failed";
     }
@@ -4415,8 +7457,8 @@ static int rex_http_fetch_winhttp(const RexUrlParts* parts, RexHttpResponse* out
       WinHttpCloseHandle(request);
       WinHttpCloseHandle(connect);
       WinHttpCloseHandle(session);
-      free(host_w);
-      free(path_w);
+      rex_xfree(host_w);
+      rex_xfree(path_w);
       if (err) {
         *err = "winhttp read failed";
       }
@@ -4431,8 +7473,8 @@ static int rex_http_fetch_winhttp(const RexUrlParts* parts, RexHttpResponse* out
       WinHttpCloseHandle(request);
       WinHttpCloseHandle(connect);
       WinHttpCloseHandle(session);
-      free(host_w);
-      free(path_w);
+      rex_xfree(host_w);
+      rex_xfree(path_w);
       if (err) {
         *err = "winhttp out of memory";
       }
@@ -4440,13 +7482,13 @@ static int rex_http_fetch_winhttp(const RexUrlParts* parts, RexHttpResponse* out
     }
     DWORD read = 0;
     if (!WinHttpReadData(request, buf, size, &read)) {
-      free(buf);
+      rex_xfree(buf);
       sb_free(&resp);
       WinHttpCloseHandle(request);
       WinHttpCloseHandle(connect);
       WinHttpCloseHandle(session);
-      free(host_w);
-      free(path_w);
+      rex_xfree(host_w);
+      rex_xfree(path_w);
       if (err) {
         *err = "winhttp read failed";
       }
@@ -4455,14 +7497,14 @@ static int rex_http_fetch_winhttp(const RexUrlParts* parts, RexHttpResponse* out
     if (read > 0) {
       sb_append_bytes(&resp, buf, (int)read);
     }
-    free(buf);
+    rex_xfree(buf);
   }
 
   WinHttpCloseHandle(request);
   WinHttpCloseHandle(connect);
   WinHttpCloseHandle(session);
-  free(host_w);
-  free(path_w);
+  rex_xfree(host_w);
+  rex_xfree(path_w);
 
   if (!resp.data) {
     sb_free(&resp);
@@ -4479,7 +7521,7 @@ static int rex_http_fetch_winhttp(const RexUrlParts* parts, RexHttpResponse* out
     out->status = (int)status;
     out->body = body;
   } else {
-    free(body);
+    rex_xfree(body);
   }
   return 1;
 }
@@ -4532,33 +7574,33 @@ static int rex_http_fetch(const char* url, RexHttpResponse* out, const char** er
 
 RexValue rex_http_get(RexValue url) {
   url = rex_resolve(url);
-  if (url.tag != REX_STR) {
+  if (rex_value_tag(url) != REX_STR) {
     rex_panic("http.get expects string");
     return rex_err(rex_str("bad url"));
   }
   const char* err = NULL;
-  const char* url_str = url.as.str ? url.as.str : "";
+  const char* url_str = rex_str_data(&url);
   RexHttpResponse resp = { 0 };
   if (!rex_http_fetch(url_str, &resp, &err)) {
     return rex_err(rex_str(err ? err : "http error"));
   }
   if (resp.status >= 400) {
-    free(resp.body);
+    rex_xfree(resp.body);
     return rex_err(rex_str("http error"));
   }
   RexValue out = rex_ok(rex_str(resp.body ? resp.body : ""));
-  free(resp.body);
+  rex_xfree(resp.body);
   return out;
 }
 
 RexValue rex_http_get_status(RexValue url) {
   url = rex_resolve(url);
-  if (url.tag != REX_STR) {
+  if (rex_value_tag(url) != REX_STR) {
     rex_panic("http.get_status expects string");
     return rex_err(rex_str("bad url"));
   }
   const char* err = NULL;
-  const char* url_str = url.as.str ? url.as.str : "";
+  const char* url_str = rex_str_data(&url);
   RexHttpResponse resp = { 0 };
   if (!rex_http_fetch(url_str, &resp, &err)) {
     return rex_err(rex_str(err ? err : "http error"));
@@ -4566,28 +7608,28 @@ RexValue rex_http_get_status(RexValue url) {
   RexValue map = rex_collections_map_new();
   rex_collections_map_put(map, rex_str("status"), rex_num((double)resp.status));
   rex_collections_map_put(map, rex_str("body"), rex_str(resp.body ? resp.body : ""));
-  free(resp.body);
+  rex_xfree(resp.body);
   return rex_ok(map);
 }
 
 RexValue rex_http_get_json(RexValue url) {
   url = rex_resolve(url);
-  if (url.tag != REX_STR) {
+  if (rex_value_tag(url) != REX_STR) {
     rex_panic("http.get_json expects string");
     return rex_err(rex_str("bad url"));
   }
   const char* err = NULL;
-  const char* url_str = url.as.str ? url.as.str : "";
+  const char* url_str = rex_str_data(&url);
   RexHttpResponse resp = { 0 };
   if (!rex_http_fetch(url_str, &resp, &err)) {
     return rex_err(rex_str(err ? err : "http error"));
   }
   if (resp.status >= 400) {
-    free(resp.body);
+    rex_xfree(resp.body);
     return rex_err(rex_str("http error"));
   }
   RexValue text = rex_str(resp.body ? resp.body : "");
-  free(resp.body);
+  rex_xfree(resp.body);
   return rex_json_decode(text);
 }
 
@@ -4637,13 +7679,13 @@ void rex_ownership_cleanup(void) {
   if (rex_ownership_log) {
     for (int i = 0; i < rex_ownership_log_count; i++) {
       if (rex_ownership_log[i].variable) {
-        free(rex_ownership_log[i].variable);
+        rex_xfree(rex_ownership_log[i].variable);
       }
       if (rex_ownership_log[i].event) {
-        free(rex_ownership_log[i].event);
+        rex_xfree(rex_ownership_log[i].event);
       }
     }
-    free(rex_ownership_log);
+    rex_xfree(rex_ownership_log);
     rex_ownership_log = NULL;
   }
   rex_ownership_log_count = 0;
@@ -4665,19 +7707,19 @@ void rex_ownership_trace(const char* variable, const char* event) {
   }
   
   if (!rex_ownership_log) {
-    rex_ownership_log = (RexOwnershipTrace*)rex_xmalloc(
+    rex_ownership_log = (RexOwnershipTrace*)rex_xmalloc_raw(
       rex_ownership_log_capacity * sizeof(RexOwnershipTrace)
     );
   }
   
   if (rex_ownership_log_count >= rex_ownership_log_capacity) {
     rex_ownership_log_capacity *= 2;
-    RexOwnershipTrace* new_log = (RexOwnershipTrace*)rex_xmalloc(
+    RexOwnershipTrace* new_log = (RexOwnershipTrace*)rex_xmalloc_raw(
       rex_ownership_log_capacity * sizeof(RexOwnershipTrace)
     );
     memcpy(new_log, rex_ownership_log, 
            rex_ownership_log_count * sizeof(RexOwnershipTrace));
-    free(rex_ownership_log);
+    rex_xfree(rex_ownership_log);
     rex_ownership_log = new_log;
   }
   
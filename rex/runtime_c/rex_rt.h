@@ -1,7 +1,9 @@
 #ifndef REX_RT_H
 #define REX_RT_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,23 +24,269 @@ typedef enum RexTag {
   REX_RECEIVER,
   REX_VEC,
   REX_MAP,
-  REX_SET
+  REX_SET,
+  REX_ARENA
 } RexTag;
 
+/* How a REX_NUM holds its value: a double, or an exact 64-bit integer that
+   is signed or unsigned. rex_as_num converts integers; rex_as_int reads
+   them exactly. */
+typedef enum RexNumRepr {
+  REX_NUM_F64,
+  REX_NUM_I64,
+  REX_NUM_U64
+} RexNumRepr;
+
+#ifndef REX_NANBOX
+#define REX_NANBOX 0
+#endif
+
+#if REX_NANBOX
+
+/* NaN-boxed values (-DREX_NANBOX=1): a number is stored as its own bits
+   (NaNs canonicalized to a positive quiet NaN); every other tag lives in the
+   negative quiet-NaN space as tag << 47 plus a 47-bit pointer or bool.
+   Pointers must fit in 47 bits, which holds for 32-bit targets and for
+   x86-64 user space; other 64-bit targets (such as AArch64 with 48-bit
+   addresses) are rejected. Tags are 4 bits wide.
+
+   Integers use the rest of the positive quiet-NaN space: 0x7FFC << 48 plus
+   a sign-extended 50-bit payload for values in [-2^49, 2^49). Unboxed
+   integer locals keep all 64 bits, but boxing a wider integer panics:
+   there is no exact 8-byte form for it, and a heap cell would have no
+   owner to free it because numbers are copied freely. */
+#if UINTPTR_MAX > 0xFFFFFFFFu && !defined(__x86_64__) && !defined(_M_X64)
+#error "REX_NANBOX needs pointers that fit in 47 bits; use the boxed layout on this target"
+#endif
+
+typedef char rex_nanbox_tag_check[(REX_ARENA < 16) ? 1 : -1];
+
+typedef struct RexValue {
+  uint64_t bits;
+} RexValue;
+
+#define REX_SMALL_STR_MAX 0
+#define REX_NANBOX_BASE 0xFFF8000000000000ULL
+#define REX_NANBOX_PAYLOAD 0x00007FFFFFFFFFFFULL
+#define REX_NANBOX_INT 0x7FFC000000000000ULL
+#define REX_NANBOX_INT_PAYLOAD 0x0003FFFFFFFFFFFFULL
+#define REX_NANBOX_BITS(tag) (REX_NANBOX_BASE | ((uint64_t)(tag) << 47))
+#define REX_STR_LITERAL(s) { .bits = REX_NANBOX_BITS(REX_STR) + (uint64_t)(uintptr_t)(s) }
+
+static inline RexTag rex_value_tag(RexValue v) {
+  if ((v.bits & REX_NANBOX_BASE) != REX_NANBOX_BASE) {
+    return REX_NUM;
+  }
+  return (RexTag)((v.bits >> 47) & 15);
+}
+
+static inline int rex_num_repr(RexValue v) {
+  return (v.bits >> 50) == (REX_NANBOX_INT >> 50) ? REX_NUM_I64 : REX_NUM_F64;
+}
+
+static inline int64_t rex_as_int(RexValue v) {
+  return (int64_t)(v.bits << 14) >> 14;
+}
+
+static inline double rex_as_num(RexValue v) {
+  int repr = rex_num_repr(v);
+  if (repr != REX_NUM_F64) {
+    return repr == REX_NUM_U64 ? (double)(uint64_t)rex_as_int(v) : (double)rex_as_int(v);
+  }
+  double n;
+  memcpy(&n, &v.bits, sizeof(n));
+  return n;
+}
+
+static inline int rex_as_bool(RexValue v) {
+  return (int)(v.bits & 1);
+}
+
+static inline void* rex_as_ptr(RexValue v) {
+  return (void*)(uintptr_t)(v.bits & REX_NANBOX_PAYLOAD);
+}
+
+#if defined(REX_DEBUG) && REX_DEBUG
+void rex_panic(const char* msg);
+#endif
+
+static inline RexValue rex_value_make(RexTag tag, const void* ptr) {
+  RexValue v;
+#if defined(REX_DEBUG) && REX_DEBUG
+  if (((uint64_t)(uintptr_t)ptr & ~REX_NANBOX_PAYLOAD) != 0) {
+    rex_panic("pointer does not fit in a NaN-boxed value");
+  }
+#endif
+  v.bits = REX_NANBOX_BITS(tag) | ((uint64_t)(uintptr_t)ptr & REX_NANBOX_PAYLOAD);
+  return v;
+}
+
+static inline int rex_str_is_small(const RexValue* v) {
+  (void)v;
+  return 0;
+}
+
+static inline RexValue rex_nil(void) {
+  return rex_value_make(REX_NIL, NULL);
+}
+
+static inline RexValue rex_num(double n) {
+  RexValue v;
+  if (n != n) {
+    v.bits = 0x7FF8000000000000ULL;
+    return v;
+  }
+  memcpy(&v.bits, &n, sizeof(n));
+  return v;
+}
+
+static inline RexValue rex_bool(int b) {
+  RexValue v;
+  v.bits = REX_NANBOX_BITS(REX_BOOL) | (b ? 1u : 0u);
+  return v;
+}
+
+RexValue rex_int_too_wide(int64_t n, int repr);
+
+static inline RexValue rex_int(int64_t n) {
+  RexValue v;
+  if (n < -((int64_t)1 << 49) || n >= ((int64_t)1 << 49)) {
+    return rex_int_too_wide(n, REX_NUM_I64);
+  }
+  v.bits = REX_NANBOX_INT | ((uint64_t)n & REX_NANBOX_INT_PAYLOAD);
+  return v;
+}
+
+static inline RexValue rex_uint(uint64_t n) {
+  RexValue v;
+  if (n >= ((uint64_t)1 << 49)) {
+    return rex_int_too_wide((int64_t)n, REX_NUM_U64);
+  }
+  v.bits = REX_NANBOX_INT | n;
+  return v;
+}
+
+#else
+
+#define REX_SMALL_STR_MAX 10
+
+/* small_len is the inline length + 1 of a small string, the RexNumRepr of a
+   number, and 0 for every other value. eq and hash read it, so every
+   constructor sets it. */
 typedef struct RexValue {
   RexTag tag;
+  uint8_t small_len;
+  char small[3];
   union {
     double num;
+    int64_t i64;
     int boolean;
     const char* str;
     void* ptr;
   } as;
 } RexValue;
 
-RexValue rex_nil(void);
-RexValue rex_num(double n);
-RexValue rex_bool(int b);
+#define REX_STR_LITERAL(s) { .tag = REX_STR, .as = { .str = (s) } }
+
+static inline RexTag rex_value_tag(RexValue v) {
+  return v.tag;
+}
+
+static inline int rex_num_repr(RexValue v) {
+  return v.small_len;
+}
+
+static inline int64_t rex_as_int(RexValue v) {
+  return v.as.i64;
+}
+
+static inline double rex_as_num(RexValue v) {
+  if (v.small_len != REX_NUM_F64) {
+    return v.small_len == REX_NUM_U64 ? (double)(uint64_t)v.as.i64 : (double)v.as.i64;
+  }
+  return v.as.num;
+}
+
+static inline int rex_as_bool(RexValue v) {
+  return v.as.boolean;
+}
+
+static inline void* rex_as_ptr(RexValue v) {
+  return v.as.ptr;
+}
+
+static inline RexValue rex_value_make(RexTag tag, const void* ptr) {
+  RexValue v;
+  v.tag = tag;
+  v.small_len = 0;
+  v.as.ptr = (void*)ptr;
+  return v;
+}
+
+static inline int rex_str_is_small(const RexValue* v) {
+  return v->small_len != 0;
+}
+
+static inline RexValue rex_nil(void) {
+  RexValue v;
+  v.tag = REX_NIL;
+  v.small_len = 0;
+  v.as.ptr = NULL;
+  return v;
+}
+
+static inline RexValue rex_num(double n) {
+  RexValue v;
+  v.tag = REX_NUM;
+  v.small_len = REX_NUM_F64;
+  v.as.num = n;
+  return v;
+}
+
+static inline RexValue rex_int(int64_t n) {
+  RexValue v;
+  v.tag = REX_NUM;
+  v.small_len = REX_NUM_I64;
+  v.as.i64 = n;
+  return v;
+}
+
+static inline RexValue rex_uint(uint64_t n) {
+  RexValue v;
+  v.tag = REX_NUM;
+  v.small_len = REX_NUM_U64;
+  v.as.i64 = (int64_t)n;
+  return v;
+}
+
+static inline RexValue rex_bool(int b) {
+  RexValue v;
+  v.tag = REX_BOOL;
+  v.small_len = 0;
+  v.as.boolean = b ? 1 : 0;
+  return v;
+}
+
+#endif
+
+static inline const char* rex_as_str(RexValue v) {
+  return (const char*)rex_as_ptr(v);
+}
+
+typedef struct RexStrHeader {
+  uint32_t len;
+  uint32_t refs; /* live views borrowing this string's bytes */
+  uint32_t hash; /* cached by rex_str_hash, 0 until computed */
+  uint32_t flags;
+} RexStrHeader;
+
+#define REX_STR_STATIC 1u
+#define REX_STR_VIEW 4u
+
 RexValue rex_str(const char* s);
+RexValue rex_str_n(const char* s, size_t len);
+const char* rex_str_data(const RexValue* v);
+size_t rex_str_size(const RexValue* v);
 RexValue rex_ptr(void* p);
 RexValue rex_ref(RexValue* v);
 RexValue rex_ref_mut(RexValue* v);
@@ -74,16 +322,72 @@ int rex_tag_is(RexValue v, const char* tag);
 RexValue rex_tag_value(RexValue v);
 RexValue rex_try(RexValue v);
 
+void* rex_heap_alloc(size_t size);
 RexValue rex_alloc(void);
 void rex_free(RexValue p);
 RexValue rex_box(RexValue v);
 RexValue rex_unbox(RexValue p);
 RexValue rex_deref(RexValue p);
 void rex_deref_assign(RexValue p, RexValue v);
+RexValue rex_mem_arena_new(void);
+RexValue rex_mem_arena_reset(RexValue arena);
+void rex_mem_arena_enter(RexValue arena);
+void rex_mem_arena_leave(RexValue arena);
+
+typedef enum RexFieldKind {
+  REX_FIELD_NUM,
+  REX_FIELD_BOOL,
+  REX_FIELD_INT,
+  REX_FIELD_U64
+} RexFieldKind;
+
+typedef struct RexStructLayout {
+  const char* name;
+  const char** fields;
+  const unsigned char* kinds;
+  const size_t* offsets;
+  int count;
+  size_t size;
+} RexStructLayout;
 
 RexValue rex_struct_new(const char* name, const char** fields, RexValue* values, int count);
+RexValue rex_struct_new_native(const RexStructLayout* layout, const void* data);
+void* rex_struct_data(RexValue obj, const RexStructLayout* layout);
+void* rex_struct_data_mut(RexValue obj, const RexStructLayout* layout);
+double rex_unbox_num_slow(RexValue v);
+int rex_unbox_bool_slow(RexValue v);
+
+static inline double rex_unbox_num(RexValue v) {
+  return rex_value_tag(v) == REX_NUM ? rex_as_num(v) : rex_unbox_num_slow(v);
+}
+
+static inline int rex_unbox_bool(RexValue v) {
+  return rex_value_tag(v) == REX_BOOL ? rex_as_bool(v) : rex_unbox_bool_slow(v);
+}
+
+/* Converting a double to an integer truncates toward zero and wraps modulo
+   2^64, like the rex_int_* arithmetic; NaN and infinities become 0. */
+int64_t rex_int_from_num_wide(double n);
+
+static inline int64_t rex_int_from_num(double n) {
+  if (n > -9223372036854775808.0 && n < 9223372036854775808.0) {
+    return (int64_t)n;
+  }
+  return rex_int_from_num_wide(n);
+}
+
+int64_t rex_unbox_int_slow(RexValue v);
+
+static inline int64_t rex_unbox_int(RexValue v) {
+  if (rex_value_tag(v) == REX_NUM) {
+    return rex_num_repr(v) != REX_NUM_F64 ? rex_as_int(v) : rex_int_from_num(rex_as_num(v));
+  }
+  return rex_unbox_int_slow(v);
+}
 RexValue rex_struct_get(RexValue obj, const char* field);
 void rex_struct_set(RexValue obj, const char* field, RexValue value);
+RexValue rex_struct_get_at(RexValue obj, const char** fields, int index);
+void rex_struct_set_at(RexValue obj, const char** fields, int index, RexValue value);
 
 RexValue rex_tuple_new(int count, RexValue* values);
 RexValue rex_tuple_get(RexValue tuple, int index);
@@ -102,6 +406,7 @@ RexValue rex_now_s(void);
 RexValue rex_now_ns(void);
 RexValue rex_time_since(RexValue start);
 
+int rex_num_print(char* buf, size_t size, RexValue v);
 RexValue rex_format(RexValue v);
 RexValue rex_fmt_pad_left(RexValue value, RexValue width, RexValue fill);
 RexValue rex_fmt_pad_right(RexValue value, RexValue width, RexValue fill);
@@ -111,6 +416,7 @@ RexValue rex_fmt_hex(RexValue value);
 RexValue rex_fmt_bin(RexValue value);
 RexValue rex_sqrt(RexValue v);
 RexValue rex_abs(RexValue v);
+RexValue rex_math_trunc(RexValue v);
 RexValue rex_math_eval(RexValue expr);
 RexValue rex_text_initials(RexValue text);
 RexValue rex_text_lower_ascii(RexValue text);
@@ -175,17 +481,45 @@ RexValue rex_log_error(RexValue value);
 RexValue rex_log_set_level(RexValue value);
 RexValue rex_log_get_level(void);
 
+typedef enum RexVecKind {
+  REX_VEC_VALUE,
+  REX_VEC_F64,
+  REX_VEC_I64,
+  REX_VEC_U8,
+  REX_VEC_U64
+} RexVecKind;
+
 RexValue rex_collections_vec_new(void);
+RexValue rex_collections_vec_new_typed(int kind);
 void rex_collections_vec_push(RexValue vec, RexValue value);
+void rex_collections_vec_push_f64(RexValue vec, double value);
+void rex_collections_vec_push_i64(RexValue vec, int64_t value);
 RexValue rex_collections_vec_get(RexValue vec, RexValue index);
+RexValue rex_collections_vec_get_at(RexValue vec, int64_t index);
+double rex_collections_vec_get_f64(RexValue vec, int64_t index);
+int64_t rex_collections_vec_get_i64(RexValue vec, int64_t index);
 void rex_collections_vec_set(RexValue vec, RexValue index, RexValue value);
+void rex_collections_vec_set_at(RexValue vec, int64_t index, RexValue value);
+void rex_collections_vec_set_f64(RexValue vec, int64_t index, double value);
+void rex_collections_vec_set_i64(RexValue vec, int64_t index, int64_t value);
 RexValue rex_collections_vec_len(RexValue vec);
 RexValue rex_collections_vec_insert(RexValue vec, RexValue index, RexValue value);
 RexValue rex_collections_vec_slice(RexValue vec, RexValue start, RexValue finish);
+/* Storage for a borrowed `&v[a..b]` view. The generated code keeps it in the
+   borrowing statement's scope; the view shares the parent's elements. */
+typedef struct RexVecSlice {
+  void* storage[5];
+} RexVecSlice;
+RexValue rex_collections_vec_slice_view(RexVecSlice* slot, RexValue vec, RexValue start, RexValue finish);
+RexValue rex_collections_vec_clone(RexValue vec);
 RexValue rex_collections_vec_from(int count, RexValue* values);
+RexValue rex_collections_vec_from_typed(int kind, int count, RexValue* values);
+RexValue rex_collections_vec_bytes(RexValue vec);
 RexValue rex_collections_vec_pop(RexValue vec);
 RexValue rex_collections_vec_clear(RexValue vec);
 RexValue rex_collections_vec_sort(RexValue vec);
+RexValue rex_collections_vec_sort_by_key(RexValue vec, RexValue field);
+RexValue rex_collections_vec_par_sort(RexValue vec);
 RexValue rex_collections_vec_find(RexValue vec, RexValue value);
 RexValue rex_collections_vec_any(RexValue vec, RexValue value);
 RexValue rex_collections_vec_all(RexValue vec, RexValue value);
@@ -195,11 +529,20 @@ RexValue rex_collections_vec_reverse(RexValue vec);
 RexValue rex_collections_vec_first(RexValue vec);
 RexValue rex_collections_vec_last(RexValue vec);
 RexValue rex_collections_vec_join(RexValue vec, RexValue sep);
+RexValue rex_collections_vec_sum(RexValue vec);
+RexValue rex_collections_vec_min(RexValue vec);
+RexValue rex_collections_vec_max(RexValue vec);
+RexValue rex_collections_vec_dot(RexValue a, RexValue b);
+RexValue rex_collections_vec_scale(RexValue vec, RexValue factor);
+RexValue rex_collections_vec_add(RexValue vec, RexValue other);
 RexValue rex_collections_get(RexValue object, RexValue index);
 RexValue rex_collections_slice(RexValue object, RexValue start, RexValue finish);
 void rex_collections_set(RexValue object, RexValue index, RexValue value);
 
 RexValue rex_collections_map_new(void);
+RexValue rex_collections_map_clone(RexValue map);
+RexValue rex_collections_snapshot(RexValue value);
+void rex_collections_restore(RexValue target, RexValue snapshot);
 void rex_collections_map_put(RexValue map, RexValue key, RexValue value);
 RexValue rex_collections_map_get(RexValue map, RexValue key);
 RexValue rex_collections_map_remove(RexValue map, RexValue key);
@@ -214,6 +557,11 @@ void rex_collections_set_add(RexValue set, RexValue value);
 RexValue rex_collections_set_has(RexValue set, RexValue value);
 RexValue rex_collections_set_remove(RexValue set, RexValue value);
 RexValue rex_collections_set_len(RexValue set);
+RexValue rex_collections_set_from_vec(RexValue vec);
+RexValue rex_collections_set_union(RexValue a, RexValue b);
+RexValue rex_collections_set_intersect(RexValue a, RexValue b);
+RexValue rex_collections_set_difference(RexValue a, RexValue b);
+RexValue rex_collections_set_values(RexValue set);
 
 RexValue rex_result_is_ok(RexValue value);
 RexValue rex_result_is_err(RexValue value);
@@ -312,6 +660,197 @@ RexValue rex_ui_play_sound(RexValue path);
 
 void rex_panic(const char* msg);
 
+/* Integer arithmetic wraps on overflow (two's complement). */
+static inline int64_t rex_int_add(int64_t a, int64_t b) {
+  return (int64_t)((uint64_t)a + (uint64_t)b);
+}
+
+static inline int64_t rex_int_sub(int64_t a, int64_t b) {
+  return (int64_t)((uint64_t)a - (uint64_t)b);
+}
+
+static inline int64_t rex_int_mul(int64_t a, int64_t b) {
+  return (int64_t)((uint64_t)a * (uint64_t)b);
+}
+
+static inline int64_t rex_int_neg(int64_t a) {
+  return (int64_t)(0 - (uint64_t)a);
+}
+
+static inline int64_t rex_int_div(int64_t a, int64_t b) {
+  if (b == 0) {
+    rex_panic("division by zero");
+    return 0;
+  }
+  return b == -1 ? rex_int_neg(a) : a / b;
+}
+
+static inline int64_t rex_int_mod(int64_t a, int64_t b) {
+  if (b == 0) {
+    rex_panic("division by zero");
+    return 0;
+  }
+  return b == -1 ? 0 : a % b;
+}
+
+/* u64 values travel in the same int64_t as every other integer; only
+   division, remainder, comparison and conversion read them as unsigned. */
+static inline int64_t rex_uint_div(int64_t a, int64_t b) {
+  if (b == 0) {
+    rex_panic("division by zero");
+    return 0;
+  }
+  return (int64_t)((uint64_t)a / (uint64_t)b);
+}
+
+static inline int64_t rex_uint_mod(int64_t a, int64_t b) {
+  if (b == 0) {
+    rex_panic("division by zero");
+    return 0;
+  }
+  return (int64_t)((uint64_t)a % (uint64_t)b);
+}
+
+/* Narrowing to a declared width after each operation; the result is the
+   value's two's-complement truncation, sign- or zero-extended back. */
+static inline int64_t rex_wrap_i8(int64_t v) {
+  uint8_t u = (uint8_t)v;
+  return u & 0x80u ? (int64_t)u - 0x100 : (int64_t)u;
+}
+
+static inline int64_t rex_wrap_i16(int64_t v) {
+  uint16_t u = (uint16_t)v;
+  return u & 0x8000u ? (int64_t)u - 0x10000 : (int64_t)u;
+}
+
+static inline int64_t rex_wrap_i32(int64_t v) {
+  uint32_t u = (uint32_t)v;
+  return u & 0x80000000u ? (int64_t)u - 0x100000000LL : (int64_t)u;
+}
+
+static inline int64_t rex_wrap_u8(int64_t v) {
+  return (int64_t)(uint8_t)v;
+}
+
+static inline int64_t rex_wrap_u16(int64_t v) {
+  return (int64_t)(uint16_t)v;
+}
+
+static inline int64_t rex_wrap_u32(int64_t v) {
+  return (int64_t)(uint32_t)v;
+}
+
+/* Integer range loops: rex_range_end turns a float end into the equivalent
+   exclusive integer bound; rex_range_count panics on a zero step. */
+int64_t rex_range_end(double end, int64_t step);
+uint64_t rex_range_count(int64_t start, int64_t end, int64_t step);
+
+/* Read-only window over a vector's storage for for-in loops. The loop
+   checks live_count each iteration so a vector resized underneath it
+   panics instead of reading freed storage, and follows live_data when a
+   copy-on-write vector gets its own buffer mid-loop. live_mods catches
+   changes that keep the count, such as a set remove followed by an add. */
+typedef struct RexVecView {
+  const void* data;
+  int64_t count;
+  int kind;
+  const int* live_count;
+  const void* const* live_data;
+  unsigned mods;
+  const unsigned* live_mods;
+} RexVecView;
+
+RexVecView rex_collections_vec_view(RexValue vec);
+
+static inline void rex_vec_view_check(RexVecView* view) {
+  if (*view->live_count != view->count || *view->live_mods != view->mods) {
+    rex_panic("vector modified during iteration");
+  }
+  view->data = *view->live_data;
+}
+
+static inline RexValue rex_vec_view_get(const RexVecView* view, int64_t index) {
+  switch (view->kind) {
+    case REX_VEC_F64:
+      return rex_num(((const double*)view->data)[index]);
+    case REX_VEC_I64:
+      return rex_int(((const int64_t*)view->data)[index]);
+    case REX_VEC_U64:
+      return rex_uint(((const uint64_t*)view->data)[index]);
+    case REX_VEC_U8:
+      return rex_int(((const uint8_t*)view->data)[index]);
+    default:
+      return ((const RexValue*)view->data)[index];
+  }
+}
+
+static inline double rex_vec_view_f64(const RexVecView* view, int64_t index) {
+  switch (view->kind) {
+    case REX_VEC_F64:
+      return ((const double*)view->data)[index];
+    case REX_VEC_I64:
+      return (double)((const int64_t*)view->data)[index];
+    case REX_VEC_U64:
+      return (double)((const uint64_t*)view->data)[index];
+    case REX_VEC_U8:
+      return (double)((const uint8_t*)view->data)[index];
+    default:
+      return rex_unbox_num(((const RexValue*)view->data)[index]);
+  }
+}
+
+static inline int64_t rex_vec_view_i64(const RexVecView* view, int64_t index) {
+  switch (view->kind) {
+    case REX_VEC_I64:
+    case REX_VEC_U64:
+      return ((const int64_t*)view->data)[index];
+    case REX_VEC_U8:
+      return ((const uint8_t*)view->data)[index];
+    case REX_VEC_F64:
+      return rex_int_from_num(((const double*)view->data)[index]);
+    default:
+      return rex_unbox_int(((const RexValue*)view->data)[index]);
+  }
+}
+
+/* Sets iterate as a RexVecView over their dense item array; maps expose
+   their entry array with the key at offset 0, the value at value_offset
+   and a removed flag at removed_offset, so neither needs an intermediate
+   vector. Both check the container's modification counter each step. */
+RexVecView rex_collections_set_view(RexValue set);
+
+typedef struct RexMapView {
+  const char* entries;
+  size_t stride;
+  size_t value_offset;
+  size_t removed_offset;
+  int64_t count;
+  unsigned mods;
+  const unsigned* live_mods;
+  const void* const* live_entries;
+} RexMapView;
+
+RexMapView rex_collections_map_view(RexValue map);
+
+static inline void rex_map_view_check(RexMapView* view) {
+  if (*view->live_mods != view->mods) {
+    rex_panic("map modified during iteration");
+  }
+  view->entries = (const char*)*view->live_entries;
+}
+
+static inline int rex_map_view_removed(const RexMapView* view, int64_t index) {
+  return *(const uint32_t*)(view->entries + (size_t)index * view->stride + view->removed_offset) != 0;
+}
+
+static inline RexValue rex_map_view_key(const RexMapView* view, int64_t index) {
+  return *(const RexValue*)(view->entries + (size_t)index * view->stride);
+}
+
+static inline RexValue rex_map_view_value(const RexMapView* view, int64_t index) {
+  return *(const RexValue*)(view->entries + (size_t)index * view->stride + view->value_offset);
+}
+
 
 void rex_ownership_debug_enable(void);
 void rex_ownership_debug_disable(void);
@@ -328,7 +328,7 @@ static RexUIImage* ui_image_load_wic(const char* path) {
   if (count > ((SIZE_MAX - sizeof(RexUIImage)) / sizeof(uint32_t))) {
     goto done;
   }
-  out = (RexUIImage*)malloc(sizeof(RexUIImage) + count * sizeof(uint32_t));
+  out = (RexUIImage*)rex_heap_alloc(sizeof(RexUIImage) + count * sizeof(uint32_t));
   if (!out) {
     goto done;
   }
@@ -374,7 +374,7 @@ static RexUIImage* ui_image_load_stb(const char* path) {
     return NULL;
   }
 
-  RexUIImage* out = (RexUIImage*)malloc(sizeof(RexUIImage) + count * sizeof(uint32_t));
+  RexUIImage* out = (RexUIImage*)rex_heap_alloc(sizeof(RexUIImage) + count * sizeof(uint32_t));
   if (!out) {
     stbi_image_free(rgba);
     return NULL;
@@ -419,11 +419,11 @@ static const RexUITheme ui_theme_light = {
 static char ui_clipboard[UI_TEXT_MAX] = { 0 };
 
 static RexValue ui_resolve(RexValue v) {
-  while (v.tag == REX_REF || v.tag == REX_REF_MUT) {
-    if (!v.as.ptr) {
+  while (rex_value_tag(v) == REX_REF || rex_value_tag(v) == REX_REF_MUT) {
+    if (!rex_as_ptr(v)) {
       return rex_nil();
     }
-    v = *(RexValue*)v.as.ptr;
+    v = *(RexValue*)rex_as_ptr(v);
   }
   return v;
 }
@@ -533,17 +533,21 @@ static const char* ui_value_to_cstr(RexValue v) {
   static int index = 0;
   char* buf = buffers[index];
   index = (index + 1) % 4;
-  if (v.tag == REX_STR) {
-    return v.as.str ? v.as.str : "";
+  if (rex_value_tag(v) == REX_STR) {
+    if (rex_str_is_small(&v)) {
+      memcpy(buf, rex_str_data(&v), rex_str_size(&v) + 1);
+      return buf;
+    }
+    return rex_str_data(&v);
   }
-  if (v.tag == REX_NUM) {
-    snprintf(buf, sizeof(buffers[0]), "%.14g", v.as.num);
+  if (rex_value_tag(v) == REX_NUM) {
+    rex_num_print(buf, sizeof(buffers[0]), v);
     return buf;
   }
-  if (v.tag == REX_BOOL) {
-    return v.as.boolean ? "true" : "false";
+  if (rex_value_tag(v) == REX_BOOL) {
+    return rex_as_bool(v) ? "true" : "false";
   }
-  if (v.tag == REX_NIL) {
+  if (rex_value_tag(v) == REX_NIL) {
     return "nil";
   }
   snprintf(buf, sizeof(buffers[0]), "<value>");
@@ -693,14 +697,14 @@ static int ui_key_code_from_name(const char* name) {
 
 static int ui_key_code_from_value(RexValue v, int* ok) {
   v = ui_resolve(v);
-  if (v.tag == REX_NUM) {
+  if (rex_value_tag(v) == REX_NUM) {
     if (ok) {
       *ok = 1;
     }
-    return (int)v.as.num;
+    return (int)rex_as_num(v);
   }
-  if (v.tag == REX_STR) {
-    int code = ui_key_code_from_name(v.as.str ? v.as.str : "");
+  if (rex_value_tag(v) == REX_STR) {
+    int code = ui_key_code_from_name(rex_str_data(&v));
     if (ok) {
       *ok = (code != REX_KEY_UNKNOWN);
     }
@@ -726,14 +730,14 @@ static int ui_mouse_button_from_name(const char* name) {
 
 static int ui_mouse_button_from_value(RexValue v, int* ok) {
   v = ui_resolve(v);
-  if (v.tag == REX_NUM) {
+  if (rex_value_tag(v) == REX_NUM) {
     if (ok) {
       *ok = 1;
     }
-    return (int)v.as.num;
+    return (int)rex_as_num(v);
   }
-  if (v.tag == REX_STR) {
-    int code = ui_mouse_button_from_name(v.as.str ? v.as.str : "");
+  if (rex_value_tag(v) == REX_STR) {
+    int code = ui_mouse_button_from_name(rex_str_data(&v));
     if (ok) {
       *ok = (code >= 0);
     }
@@ -771,8 +775,8 @@ static int ui_clamp(int v, int lo, int hi) {
 
 static double ui_now_ms(void) {
   RexValue v = rex_now_ms();
-  if (v.tag == REX_NUM) {
-    return v.as.num;
+  if (rex_value_tag(v) == REX_NUM) {
+    return rex_as_num(v);
   }
   return 0.0;
 }
@@ -832,15 +836,15 @@ static int ui_hex_value(char c) {
 
 static uint32_t ui_color_from_value(RexValue v, uint32_t fallback) {
   v = ui_resolve(v);
-  if (v.tag == REX_NUM) {
-    uint32_t c = (uint32_t)v.as.num;
+  if (rex_value_tag(v) == REX_NUM) {
+    uint32_t c = (uint32_t)rex_as_num(v);
     if ((c & 0xFF000000u) == 0) {
       c |= 0xFF000000u;
     }
     return c;
   }
-  if (v.tag == REX_STR && v.as.str) {
-    const char* s = v.as.str;
+  if (rex_value_tag(v) == REX_STR) {
+    const char* s = rex_str_data(&v);
     if (s[0] == '#') {
       s++;
     }
@@ -1728,20 +1732,20 @@ RexValue rex_ui_begin(RexValue title, RexValue width, RexValue height) {
   title = ui_resolve(title);
   width = ui_resolve(width);
   height = ui_resolve(height);
-  if (title.tag != REX_STR || width.tag != REX_NUM || height.tag != REX_NUM) {
+  if (rex_value_tag(title) != REX_STR || rex_value_tag(width) != REX_NUM || rex_value_tag(height) != REX_NUM) {
     rex_panic("ui.begin expects (string, number, number)");
     return rex_bool(0);
   }
   if (ui.frame_started) {
     ui_end_frame();
   }
-  int w = (int)width.as.num;
-  int h = (int)height.as.num;
+  int w = (int)rex_as_num(width);
+  int h = (int)rex_as_num(height);
   if (w <= 0 || h <= 0) {
     rex_panic("ui.begin expects positive size");
     return rex_bool(0);
   }
-  ui_begin_frame(title.as.str ? title.as.str : "Rex", w, h);
+  ui_begin_frame(rex_value_tag(title) == REX_STR ? rex_str_data(&title) : "Rex", w, h);
   if (!ui.running) {
     return rex_bool(0);
   }
@@ -1783,11 +1787,11 @@ RexValue rex_ui_key_down(void) {
 
 RexValue rex_ui_key_code(RexValue name) {
   name = ui_resolve(name);
-  if (name.tag != REX_STR || !name.as.str) {
+  if (rex_value_tag(name) != REX_STR ) {
     rex_panic("ui.key_code expects string");
     return rex_num((double)REX_KEY_UNKNOWN);
   }
-  int code = ui_key_code_from_name(name.as.str);
+  int code = ui_key_code_from_name(rex_str_data(&name));
   return rex_num((double)code);
 }
 
@@ -1895,11 +1899,11 @@ RexValue rex_ui_text(RexValue x, RexValue y, RexValue text, RexValue color) {
   y = ui_resolve(y);
   const char* t = ui_value_to_cstr(text);
   uint32_t c = ui_color_from_value(color, ui.theme.text);
-  if (x.tag != REX_NUM || y.tag != REX_NUM) {
+  if (rex_value_tag(x) != REX_NUM || rex_value_tag(y) != REX_NUM) {
     rex_panic("ui.text expects (number, number, value, color)");
     return rex_nil();
   }
-  ui_draw_text((int)x.as.num, (int)y.as.num, t, c);
+  ui_draw_text((int)rex_as_num(x), (int)rex_as_num(y), t, c);
   return rex_nil();
 }
 
@@ -1908,12 +1912,12 @@ RexValue rex_ui_rect(RexValue x, RexValue y, RexValue w, RexValue h, RexValue co
   y = ui_resolve(y);
   w = ui_resolve(w);
   h = ui_resolve(h);
-  if (x.tag != REX_NUM || y.tag != REX_NUM || w.tag != REX_NUM || h.tag != REX_NUM) {
+  if (rex_value_tag(x) != REX_NUM || rex_value_tag(y) != REX_NUM || rex_value_tag(w) != REX_NUM || rex_value_tag(h) != REX_NUM) {
     rex_panic("ui.rect expects (number, number, number, number, color)");
     return rex_nil();
   }
   uint32_t c = ui_color_from_value(color, ui.theme.panel);
-  ui_draw_rect((int)x.as.num, (int)y.as.num, (int)w.as.num, (int)h.as.num, c);
+  ui_draw_rect((int)rex_as_num(x), (int)rex_as_num(y), (int)rex_as_num(w), (int)rex_as_num(h), c);
   return rex_nil();
 }
 
@@ -1986,7 +1990,7 @@ RexValue rex_ui_checkbox(RexValue label, RexValue checked) {
       ui_set_focus(id);
     }
   }
-  int value = checked.tag == REX_BOOL && checked.as.boolean;
+  int value = rex_value_tag(checked) == REX_BOOL && rex_as_bool(checked);
   if (ui.enabled) {
     if (ui.mouse_released && ui.active_id == id) {
       if (hot) {
@@ -2030,7 +2034,7 @@ RexValue rex_ui_radio(RexValue label, RexValue active) {
       ui_set_focus(id);
     }
   }
-  int value = active.tag == REX_BOOL && active.as.boolean;
+  int value = rex_value_tag(active) == REX_BOOL && rex_as_bool(active);
   if (ui.enabled) {
     if (ui.mouse_released && ui.active_id == id) {
       if (hot) {
@@ -2059,13 +2063,13 @@ RexValue rex_ui_radio(RexValue label, RexValue active) {
 RexValue rex_ui_textbox(RexValue value, RexValue width) {
   value = ui_resolve(value);
   width = ui_resolve(width);
-  if (value.tag != REX_STR) {
+  if (rex_value_tag(value) != REX_STR) {
     rex_panic("ui.textbox expects string");
     return value;
   }
   int w = 0;
-  if (width.tag == REX_NUM) {
-    w = (int)width.as.num;
+  if (rex_value_tag(width) == REX_NUM) {
+    w = (int)rex_as_num(width);
   }
   if (w <= 0) {
     w = 200;
@@ -2081,12 +2085,12 @@ RexValue rex_ui_textbox(RexValue value, RexValue width) {
 
   char buf[UI_TEXT_MAX];
   int len = 0;
-  if (value.as.str) {
-    len = (int)strlen(value.as.str);
+  if (rex_value_tag(value) == REX_STR) {
+    len = (int)rex_str_size(&value);
     if (len >= UI_TEXT_MAX) {
       len = UI_TEXT_MAX - 1;
     }
-    memcpy(buf, value.as.str, (size_t)len);
+    memcpy(buf, rex_str_data(&value), (size_t)len);
   }
   buf[len] = '\0';
 
@@ -2313,7 +2317,7 @@ RexValue rex_ui_textbox(RexValue value, RexValue width) {
   if (changed) {
     ui_mark_dirty();
   }
-  if (!value.as.str || strcmp(buf, value.as.str) != 0) {
+  if (rex_value_tag(value) != REX_STR || strcmp(buf, rex_str_data(&value)) != 0) {
     return rex_str(buf);
   }
   return value;
@@ -2324,13 +2328,13 @@ RexValue rex_ui_slider(RexValue label, RexValue value, RexValue min, RexValue ma
   value = ui_resolve(value);
   min = ui_resolve(min);
   max = ui_resolve(max);
-  if (value.tag != REX_NUM || min.tag != REX_NUM || max.tag != REX_NUM) {
+  if (rex_value_tag(value) != REX_NUM || rex_value_tag(min) != REX_NUM || rex_value_tag(max) != REX_NUM) {
     rex_panic("ui.slider expects (string, number, number, number)");
     return value;
   }
-  double v = value.as.num;
-  double minv = min.as.num;
-  double maxv = max.as.num;
+  double v = rex_as_num(value);
+  double minv = rex_as_num(min);
+  double maxv = rex_as_num(max);
   if (maxv <= minv) {
     maxv = minv + 1.0;
   }
@@ -2417,12 +2421,12 @@ RexValue rex_ui_slider(RexValue label, RexValue value, RexValue min, RexValue ma
 RexValue rex_ui_progress(RexValue value, RexValue max) {
   value = ui_resolve(value);
   max = ui_resolve(max);
-  if (value.tag != REX_NUM || max.tag != REX_NUM) {
+  if (rex_value_tag(value) != REX_NUM || rex_value_tag(max) != REX_NUM) {
     rex_panic("ui.progress expects (number, number)");
     return rex_nil();
   }
-  double v = value.as.num;
-  double mv = max.as.num;
+  double v = rex_as_num(value);
+  double mv = rex_as_num(max);
   if (mv <= 0.0) {
     mv = 1.0;
   }
@@ -2458,7 +2462,7 @@ RexValue rex_ui_switch(RexValue label, RexValue active) {
     ui.active_id = id;
     ui_set_focus(id);
   }
-  int value = active.tag == REX_BOOL && active.as.boolean;
+  int value = rex_value_tag(active) == REX_BOOL && rex_as_bool(active);
   if (ui.enabled) {
     if (ui.mouse_released && ui.active_id == id) {
       if (hot) {
@@ -2489,10 +2493,10 @@ RexValue rex_ui_switch(RexValue label, RexValue active) {
 
 static int ui_vec_len(RexValue items) {
   RexValue len = rex_collections_vec_len(items);
-  if (len.tag != REX_NUM) {
+  if (rex_value_tag(len) != REX_NUM) {
     return 0;
   }
-  return (int)len.as.num;
+  return (int)rex_as_num(len);
 }
 
 static RexValue ui_vec_get(RexValue items, int index) {
@@ -2503,12 +2507,12 @@ static RexValue ui_vec_get(RexValue items, int index) {
 RexValue rex_ui_select(RexValue items, RexValue selected) {
   items = ui_resolve(items);
   selected = ui_resolve(selected);
-  if (items.tag != REX_VEC) {
+  if (rex_value_tag(items) != REX_VEC) {
     rex_panic("ui.select expects vector");
     return selected;
   }
   int count = ui_vec_len(items);
-  int sel = (selected.tag == REX_NUM) ? (int)selected.as.num : -1;
+  int sel = (rex_value_tag(selected) == REX_NUM) ? (int)rex_as_num(selected) : -1;
   int list_h = count * ui.item_height + (count > 0 ? (count - 1) * ui.spacing : 0);
   RexUIRect r = ui_next_rect(0, list_h);
   ui_draw_rect(r.x, r.y, r.w, r.h, ui.enabled ? ui.theme.panel : ui_color_disabled(ui.theme.panel));
@@ -2535,12 +2539,12 @@ RexValue rex_ui_select(RexValue items, RexValue selected) {
 RexValue rex_ui_combo(RexValue items, RexValue selected) {
   items = ui_resolve(items);
   selected = ui_resolve(selected);
-  if (items.tag != REX_VEC) {
+  if (rex_value_tag(items) != REX_VEC) {
     rex_panic("ui.combo expects vector");
     return selected;
   }
   int count = ui_vec_len(items);
-  int sel = (selected.tag == REX_NUM) ? (int)selected.as.num : -1;
+  int sel = (rex_value_tag(selected) == REX_NUM) ? (int)rex_as_num(selected) : -1;
   const char* current = "";
   if (sel >= 0 && sel < count) {
     current = ui_value_to_cstr(ui_vec_get(items, sel));
@@ -2621,12 +2625,12 @@ RexValue rex_ui_combo(RexValue items, RexValue selected) {
 RexValue rex_ui_menu(RexValue items, RexValue selected) {
   items = ui_resolve(items);
   selected = ui_resolve(selected);
-  if (items.tag != REX_VEC) {
+  if (rex_value_tag(items) != REX_VEC) {
     rex_panic("ui.menu expects vector");
     return selected;
   }
   int count = ui_vec_len(items);
-  int sel = (selected.tag == REX_NUM) ? (int)selected.as.num : -1;
+  int sel = (rex_value_tag(selected) == REX_NUM) ? (int)rex_as_num(selected) : -1;
   RexUIRect r = ui_next_rect(0, ui.item_height);
   ui_draw_rect(r.x, r.y, r.w, r.h, ui.enabled ? ui.theme.panel : ui_color_disabled(ui.theme.panel));
   int x = r.x + ui.padding;
@@ -2672,12 +2676,12 @@ RexValue rex_ui_menu(RexValue items, RexValue selected) {
 RexValue rex_ui_tabs(RexValue items, RexValue selected) {
   items = ui_resolve(items);
   selected = ui_resolve(selected);
-  if (items.tag != REX_VEC) {
+  if (rex_value_tag(items) != REX_VEC) {
     rex_panic("ui.tabs expects vector");
     return selected;
   }
   int count = ui_vec_len(items);
-  int sel = (selected.tag == REX_NUM) ? (int)selected.as.num : -1;
+  int sel = (rex_value_tag(selected) == REX_NUM) ? (int)rex_as_num(selected) : -1;
   RexUIRect r = ui_next_rect(0, ui.item_height);
   int x = r.x;
   for (int i = 0; i < count; i++) {
@@ -2723,12 +2727,12 @@ RexValue rex_ui_tabs(RexValue items, RexValue selected) {
 
 RexValue rex_ui_layout_row(RexValue height) {
   height = ui_resolve(height);
-  if (height.tag != REX_NUM) {
+  if (rex_value_tag(height) != REX_NUM) {
     rex_panic("ui.row expects number");
     return rex_nil();
   }
   ui.layout_mode = UI_LAYOUT_ROW;
-  int next_height = (int)height.as.num;
+  int next_height = (int)rex_as_num(height);
   if (next_height != ui.row_height) {
     ui_mark_dirty();
   }
@@ -2742,12 +2746,12 @@ RexValue rex_ui_layout_row(RexValue height) {
 
 RexValue rex_ui_layout_column(RexValue height) {
   height = ui_resolve(height);
-  if (height.tag != REX_NUM) {
+  if (rex_value_tag(height) != REX_NUM) {
     rex_panic("ui.column expects number");
     return rex_nil();
   }
   ui.layout_mode = UI_LAYOUT_COLUMN;
-  int h = (int)height.as.num;
+  int h = (int)rex_as_num(height);
   if (h > 0) {
     if (ui.item_height != h) {
       ui_mark_dirty();
@@ -2763,14 +2767,14 @@ RexValue rex_ui_layout_grid(RexValue cols, RexValue cell_w, RexValue cell_h) {
   cols = ui_resolve(cols);
   cell_w = ui_resolve(cell_w);
   cell_h = ui_resolve(cell_h);
-  if (cols.tag != REX_NUM || cell_w.tag != REX_NUM || cell_h.tag != REX_NUM) {
+  if (rex_value_tag(cols) != REX_NUM || rex_value_tag(cell_w) != REX_NUM || rex_value_tag(cell_h) != REX_NUM) {
     rex_panic("ui.grid expects numbers");
     return rex_nil();
   }
   ui.layout_mode = UI_LAYOUT_GRID;
-  int next_cols = (int)cols.as.num;
-  int next_w = (int)cell_w.as.num;
-  int next_h = (int)cell_h.as.num;
+  int next_cols = (int)rex_as_num(cols);
+  int next_w = (int)rex_as_num(cell_w);
+  int next_h = (int)rex_as_num(cell_h);
   if (next_cols != ui.grid_cols || next_w != ui.grid_cell_w || next_h != ui.grid_cell_h) {
     ui_mark_dirty();
   }
@@ -2820,15 +2824,15 @@ RexValue rex_ui_clip_begin(RexValue x, RexValue y, RexValue w, RexValue h) {
   y = ui_resolve(y);
   w = ui_resolve(w);
   h = ui_resolve(h);
-  if (x.tag != REX_NUM || y.tag != REX_NUM || w.tag != REX_NUM || h.tag != REX_NUM) {
+  if (rex_value_tag(x) != REX_NUM || rex_value_tag(y) != REX_NUM || rex_value_tag(w) != REX_NUM || rex_value_tag(h) != REX_NUM) {
     rex_panic("ui.clip_begin expects numbers");
     return rex_nil();
   }
   RexUIRect r;
-  r.x = (int)x.as.num;
-  r.y = (int)y.as.num;
-  r.w = (int)w.as.num;
-  r.h = (int)h.as.num;
+  r.x = (int)rex_as_num(x);
+  r.y = (int)rex_as_num(y);
+  r.w = (int)rex_as_num(w);
+  r.h = (int)rex_as_num(h);
   ui_push_clip(r);
   return rex_nil();
 }
@@ -2840,11 +2844,11 @@ RexValue rex_ui_clip_end(void) {
 
 RexValue rex_ui_spacing(RexValue px) {
   px = ui_resolve(px);
-  if (px.tag != REX_NUM) {
+  if (rex_value_tag(px) != REX_NUM) {
     rex_panic("ui.spacing expects number");
     return rex_nil();
   }
-  int next = (int)px.as.num;
+  int next = (int)rex_as_num(px);
   if (next != ui.spacing) {
     ui_mark_dirty();
   }
@@ -2857,11 +2861,11 @@ RexValue rex_ui_spacing(RexValue px) {
 
 RexValue rex_ui_padding(RexValue px) {
   px = ui_resolve(px);
-  if (px.tag != REX_NUM) {
+  if (rex_value_tag(px) != REX_NUM) {
     rex_panic("ui.padding expects number");
     return rex_nil();
   }
-  int next = (int)px.as.num;
+  int next = (int)rex_as_num(px);
   if (next != ui.padding) {
     ui_mark_dirty();
   }
@@ -2881,11 +2885,11 @@ RexValue rex_ui_padding(RexValue px) {
 
 RexValue rex_ui_scroll_begin(RexValue height) {
   height = ui_resolve(height);
-  if (height.tag != REX_NUM) {
+  if (rex_value_tag(height) != REX_NUM) {
     rex_panic("ui.scroll_begin expects number");
     return rex_nil();
   }
-  int h = (int)height.as.num;
+  int h = (int)rex_as_num(height);
   if (h <= 0) {
     h = ui.item_height * 4;
   }
@@ -2994,11 +2998,11 @@ RexValue rex_ui_scroll_end(void) {
 
 RexValue rex_ui_enabled(RexValue enabled) {
   enabled = ui_resolve(enabled);
-  if (enabled.tag != REX_BOOL) {
+  if (rex_value_tag(enabled) != REX_BOOL) {
     rex_panic("ui.enabled expects bool");
     return rex_nil();
   }
-  int next = enabled.as.boolean ? 1 : 0;
+  int next = rex_as_bool(enabled) ? 1 : 0;
   if (next != ui.enabled) {
     ui.enabled = next;
     ui_mark_dirty();
@@ -3008,11 +3012,11 @@ RexValue rex_ui_enabled(RexValue enabled) {
 
 RexValue rex_ui_invert(RexValue enabled) {
   enabled = ui_resolve(enabled);
-  if (enabled.tag != REX_BOOL) {
+  if (rex_value_tag(enabled) != REX_BOOL) {
     rex_panic("ui.invert expects bool");
     return rex_nil();
   }
-  int next = enabled.as.boolean ? 1 : 0;
+  int next = rex_as_bool(enabled) ? 1 : 0;
   if (next != ui.invert) {
     ui.invert = next;
     ui_mark_dirty();
@@ -3022,11 +3026,11 @@ RexValue rex_ui_invert(RexValue enabled) {
 
 RexValue rex_ui_titlebar_dark(RexValue enabled) {
   enabled = ui_resolve(enabled);
-  if (enabled.tag != REX_BOOL) {
+  if (rex_value_tag(enabled) != REX_BOOL) {
     rex_panic("ui.titlebar_dark expects bool");
     return rex_nil();
   }
-  rex_ui_platform_set_titlebar_dark(enabled.as.boolean ? 1 : 0);
+  rex_ui_platform_set_titlebar_dark(rex_as_bool(enabled) ? 1 : 0);
   return rex_nil();
 }
 
@@ -3068,24 +3072,24 @@ RexValue rex_ui_theme_custom(
 
 RexValue rex_ui_image_load(RexValue path) {
   path = ui_resolve(path);
-  if (path.tag != REX_STR || !path.as.str) {
+  if (rex_value_tag(path) != REX_STR ) {
     rex_panic("ui.image_load expects string path");
     return rex_nil();
   }
   RexUIImage* img = NULL;
 #ifdef _WIN32
-  img = ui_image_load_wic(path.as.str);
+  img = ui_image_load_wic(rex_str_data(&path));
 #endif
   if (!img) {
-    img = ui_image_load_stb(path.as.str);
+    img = ui_image_load_stb(rex_str_data(&path));
   }
   if (!img) {
     const char* reason = stbi_failure_reason();
     char buf[256];
     if (reason && reason[0] != '\0') {
-      snprintf(buf, sizeof(buf), "ui.image_load failed: %s (%s)", path.as.str, reason);
+      snprintf(buf, sizeof(buf), "ui.image_load failed: %s (%s)", rex_str_data(&path), reason);
     } else {
-      snprintf(buf, sizeof(buf), "ui.image_load failed: %s", path.as.str);
+      snprintf(buf, sizeof(buf), "ui.image_load failed: %s", rex_str_data(&path));
     }
     rex_panic(buf);
     return rex_nil();
@@ -3095,21 +3099,21 @@ RexValue rex_ui_image_load(RexValue path) {
 
 RexValue rex_ui_image_w(RexValue img) {
   img = ui_resolve(img);
-  if (img.tag != REX_PTR || !img.as.ptr) {
+  if (rex_value_tag(img) != REX_PTR || !rex_as_ptr(img)) {
     rex_panic("ui.image_w expects image handle");
     return rex_num(0);
   }
-  RexUIImage* i = (RexUIImage*)img.as.ptr;
+  RexUIImage* i = (RexUIImage*)rex_as_ptr(img);
   return rex_num((double)i->w);
 }
 
 RexValue rex_ui_image_h(RexValue img) {
   img = ui_resolve(img);
-  if (img.tag != REX_PTR || !img.as.ptr) {
+  if (rex_value_tag(img) != REX_PTR || !rex_as_ptr(img)) {
     rex_panic("ui.image_h expects image handle");
     return rex_num(0);
   }
-  RexUIImage* i = (RexUIImage*)img.as.ptr;
+  RexUIImage* i = (RexUIImage*)rex_as_ptr(img);
   return rex_num((double)i->h);
 }
 
@@ -3117,11 +3121,11 @@ RexValue rex_ui_image(RexValue img, RexValue x, RexValue y) {
   img = ui_resolve(img);
   x = ui_resolve(x);
   y = ui_resolve(y);
-  if (img.tag != REX_PTR || !img.as.ptr || x.tag != REX_NUM || y.tag != REX_NUM) {
+  if (rex_value_tag(img) != REX_PTR || !rex_as_ptr(img) || rex_value_tag(x) != REX_NUM || rex_value_tag(y) != REX_NUM) {
     rex_panic("ui.image expects (image, number, number)");
     return rex_nil();
   }
-  ui_draw_image((RexUIImage*)img.as.ptr, (int)x.as.num, (int)y.as.num);
+  ui_draw_image((RexUIImage*)rex_as_ptr(img), (int)rex_as_num(x), (int)rex_as_num(y));
   return rex_nil();
 }
 
@@ -3130,11 +3134,11 @@ RexValue rex_ui_image_rot(RexValue img, RexValue x, RexValue y, RexValue angle_d
   x = ui_resolve(x);
   y = ui_resolve(y);
   angle_deg = ui_resolve(angle_deg);
-  if (img.tag != REX_PTR || !img.as.ptr || x.tag != REX_NUM || y.tag != REX_NUM || angle_deg.tag != REX_NUM) {
+  if (rex_value_tag(img) != REX_PTR || !rex_as_ptr(img) || rex_value_tag(x) != REX_NUM || rex_value_tag(y) != REX_NUM || rex_value_tag(angle_deg) != REX_NUM) {
     rex_panic("ui.image_rot expects (image, number, number, number)");
     return rex_nil();
   }
-  ui_draw_image_rot((RexUIImage*)img.as.ptr, x.as.num, y.as.num, angle_deg.as.num);
+  ui_draw_image_rot((RexUIImage*)rex_as_ptr(img), rex_as_num(x), rex_as_num(y), rex_as_num(angle_deg));
   return rex_nil();
 }
 
@@ -3148,19 +3152,19 @@ RexValue rex_ui_image_region(RexValue img, RexValue sx, RexValue sy, RexValue sw
   y = ui_resolve(y);
   w = ui_resolve(w);
   h = ui_resolve(h);
-  if (img.tag != REX_PTR || sx.tag != REX_NUM || sy.tag != REX_NUM || sw.tag != REX_NUM || sh.tag != REX_NUM || x.tag != REX_NUM || y.tag != REX_NUM || w.tag != REX_NUM || h.tag != REX_NUM) {
+  if (rex_value_tag(img) != REX_PTR || rex_value_tag(sx) != REX_NUM || rex_value_tag(sy) != REX_NUM || rex_value_tag(sw) != REX_NUM || rex_value_tag(sh) != REX_NUM || rex_value_tag(x) != REX_NUM || rex_value_tag(y) != REX_NUM || rex_value_tag(w) != REX_NUM || rex_value_tag(h) != REX_NUM) {
     rex_panic("ui.image_region expects (image, number, number, number, number, number, number, number, number)");
     return rex_nil();
   }
-  ui_draw_image_region((RexUIImage*)img.as.ptr, (int)sx.as.num, (int)sy.as.num, (int)sw.as.num, (int)sh.as.num, (int)x.as.num, (int)y.as.num, (int)w.as.num, (int)h.as.num);
+  ui_draw_image_region((RexUIImage*)rex_as_ptr(img), (int)rex_as_num(sx), (int)rex_as_num(sy), (int)rex_as_num(sw), (int)rex_as_num(sh), (int)rex_as_num(x), (int)rex_as_num(y), (int)rex_as_num(w), (int)rex_as_num(h));
   return rex_nil();
 }
 
 RexValue rex_ui_play_sound(RexValue path) {
   path = ui_resolve(path);
-  if (path.tag != REX_STR || !path.as.str) {
+  if (rex_value_tag(path) != REX_STR ) {
     rex_panic("ui.play_sound expects string path");
     return rex_bool(0);
   }
-  return rex_bool(rex_audio_platform_play(path.as.str) != 0);
+  return rex_bool(rex_audio_platform_play(rex_str_data(&path)) != 0);
 }